@@ -34,6 +34,7 @@
 // Common
 #include <Common/IComponent.h>
 #include <Common/ComRef.h>
+#include <Common/Dispatcher/DispatcherJob.h>
 
 // Std
 #include <mutex>
@@ -52,6 +53,9 @@ struct PipelineJob {
 
     /// Pipeline specific hash
     uint64_t combinedHash{ 0 };
+
+    /// Scheduling priority
+    DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
 };
 
 class PipelineCompiler : public TComponent<PipelineCompiler> {
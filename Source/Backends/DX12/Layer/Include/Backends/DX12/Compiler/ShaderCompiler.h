@@ -36,6 +36,7 @@
 // Common
 #include <Common/IComponent.h>
 #include <Common/ComRef.h>
+#include <Common/Dispatcher/DispatcherJob.h>
 
 // Std
 #include <mutex>
@@ -63,6 +64,9 @@ struct ShaderJob {
 
     /// Pipeline dependent specialization info
     MessageStream* dependentSpecialization{nullptr};
+
+    /// Scheduling priority
+    DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
 };
 
 class ShaderCompiler : public TComponent<ShaderCompiler> {
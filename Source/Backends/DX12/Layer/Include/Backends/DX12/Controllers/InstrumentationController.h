@@ -42,6 +42,7 @@
 // Common
 #include <Common/Dispatcher/EventCounter.h>
 #include <Common/Dispatcher/RelaxedAtomic.h>
+#include <Common/Dispatcher/DispatcherJob.h>
 #include <Common/ComRef.h>
 
 // Bridge
@@ -52,6 +53,7 @@
 #include <chrono>
 #include <set>
 #include <unordered_map>
+#include <mutex>
 
 // Forward declarations
 class Registry;
@@ -84,6 +86,11 @@ public:
     /// Commit all instrumentation changes
     void CommitInstrumentation();
 
+    /// Get the current commit index, incremented on every commit
+    uint64_t GetCommitIndex() const {
+        return commitIndex.load(std::memory_order_relaxed);
+    }
+
     /// Commit all bridges
     void Commit();
 
@@ -115,7 +122,8 @@ public:
     void CreatePipelineAndAdd(PipelineState* state);
 
 protected:
-    void CommitShaders(DispatcherBucket* bucket, void *data);
+    void CommitGraph(DispatcherBucket* bucket, void *data);
+    void CommitShader(DispatcherBucket* bucket, void *data);
     void CommitPipelines(DispatcherBucket* bucket, void *data);
     void CommitTable(DispatcherBucket* bucket, void *data);
 
@@ -165,6 +173,11 @@ private:
     /// Invoked on pipeline creation
     /// \param state given state
     void CreatePipelineNoLock(PipelineState* state);
+
+    /// Get the compilation priority of a pipeline
+    /// \param state given pipeline
+    /// \return job priority
+    DispatcherJobPriority GetPipelinePriority(const PipelineState* state) const;
     
 private:
     DeviceState* device;
@@ -190,11 +203,31 @@ private:
 private:
     struct Batch {
         struct CommitEntry {
+            /// Owning batch
+            Batch* batch{nullptr};
+
             /// Pending entry
             PipelineState* state{nullptr};
 
             /// Expected hash
             uint64_t combinedHash{0};
+
+            /// Was the pipeline submitted for compilation?
+            bool enqueued{false};
+        };
+
+        struct PipelineWave {
+            /// Owning batch
+            Batch* batch{nullptr};
+
+            /// Scheduling priority of all pipelines in this wave
+            DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
+
+            /// All entries of this priority
+            std::vector<CommitEntry*> entries;
+
+            /// All keys which failed to compile
+            std::vector<std::pair<ShaderState*, ShaderInstrumentationKey>> rejectedKeys;
         };
         
         Batch(const Allocators& allocators) : commitEntries(allocators), dirtyShaders(allocators), dirtyPipelines(allocators) {
@@ -211,9 +244,15 @@ private:
         /// All diagnostic messages
         DiagnosticBucket<DiagnosticType> messages;
         
-        /// All pending entries
+        /// All pending entries, one per dirty pipeline
         Vector<CommitEntry> commitEntries;
 
+        /// Pipelines are batched per priority, each wave waits on the shaders it consumes
+        PipelineWave pipelineWaves[static_cast<uint32_t>(DispatcherJobPriority::Count)];
+
+        /// All keys which failed to compile, merged from all waves
+        std::vector<std::pair<ShaderState*, ShaderInstrumentationKey>> rejectedKeys;
+
         /// Time stamps
         std::chrono::high_resolution_clock::time_point stampBegin;
         std::chrono::high_resolution_clock::time_point stampBeginShaders;
@@ -230,6 +269,9 @@ private:
         // All stage counters
         RelaxedAtomic<uint32_t> stageCounters[static_cast<uint32_t>(PipelineType::Count)];
 
+        // Pipeline stage counters, waves may overlap so these are kept apart from the shader stage
+        RelaxedAtomic<uint32_t> pipelineStageCounters[static_cast<uint32_t>(PipelineType::Count)];
+
         // Threading bucket
         DispatcherBucket* bucket{nullptr};
     };
@@ -261,4 +303,7 @@ private:
 
 private:
     bool synchronousRecording{false};
+
+    /// Number of commits, used to track recently bound pipelines
+    std::atomic<uint64_t> commitIndex{1};
 };
@@ -43,6 +43,7 @@
 
 // Std
 #include <vector>
+#include <mutex>
 
 // Forward declarations
 struct CommandListObject;
@@ -75,6 +76,19 @@ public:
     /// \param size the byte size of the new stream
     void SetStreamSize(ShaderExportID id, uint64_t size);
 
+    /// Report the usage of a stream after its segment has completed
+    ///   ? Streams are grown geometrically on overflow, and shrunk after sustained low usage
+    /// \param id the shader export id
+    /// \param requestedSize the byte size the device attempted to write
+    /// \param byteSize the byte size of the stream written to
+    /// \return the byte size of the next stream allocation
+    uint64_t ReportStreamUsage(ShaderExportID id, uint64_t requestedSize, uint64_t byteSize);
+
+    /// Update a pooled allocation to the current stream sizes
+    ///   ! Allocation must not be in flight
+    /// \param segment allocation to be updated
+    void UpdateSegment(ShaderExportSegmentInfo* segment);
+
 private:
     /// Allocate a new stream
     /// \param id the export id
@@ -85,6 +99,10 @@ private:
     /// \return counter info
     ShaderExportSegmentCounterInfo AllocateCounterInfo();
 
+    /// Free a stream
+    /// \param info stream to be free'd
+    void FreeStreamInfo(const ShaderExportStreamInfo& info);
+
 private:
     struct ExportInfo {
         /// Parent export id
@@ -95,6 +113,9 @@ private:
 
         /// Current data size
         uint64_t dataSize{0};
+
+        /// Number of consecutive low usage reports
+        uint32_t lowUsageCount{0};
     };
 
     /// All exports
@@ -111,6 +132,15 @@ private:
     /// Initial allocation size for all streams
     uint64_t baseDataSize = 10'000;
 
+    /// Upper bound for grown streams
+    uint64_t maxDataSize = 256'000'000;
+
+    /// Number of consecutive reports below a quarter of the stream size before shrinking
+    uint32_t shrinkLatency = 128;
+
+    /// Shared lock for export infos
+    std::mutex mutex;
+
     /// Current allocation mode
     ShaderExportAllocationMode allocationMode{ShaderExportAllocationMode::GlobalCyclicBufferNoOverwrite};
 };
@@ -38,12 +38,17 @@
 // Backend
 #include <Backend/CommandContextHandle.h>
 
+// Message
+#include <Message/MessageStream.h>
+
 // Common
 #include <Common/Containers/BucketPoolAllocator.h>
 #include <Common/Containers/LinearBlockAllocator.h>
+#include <Common/Dispatcher/EventCounter.h>
 
 // Std
 #include <vector>
+#include <atomic>
 #include <Backends/DX12/Resource/DescriptorDataSegment.h>
 
 // Forward declarations
@@ -202,7 +207,8 @@ struct ShaderExportStreamSegment {
         descriptorDataSegments(allocators),
         constantShaderDataBuffers(allocators),
         constantAllocator(allocators),
-        commandContextHandles(allocators) {
+        commandContextHandles(allocators),
+        messageStreams(allocators) {
         
     }
     
@@ -243,11 +249,23 @@ struct ShaderExportStreamSegment {
 
     /// Segmentation point during submission
     VersionSegmentationPoint versionSegPoint{};
+
+    /// Pooled decoding streams, one per export, recycled through the message storage
+    Vector<MessageStream> messageStreams;
+
+    /// Overflow diagnostics of the last decode
+    MessageStream overflowStream;
+
+    /// Set once the segment has been decoded and may be released
+    std::atomic<bool> decoded{false};
+
+    /// Decode event of the owning queue, valid while decoding
+    EventCounter* queueDecodeEvent{nullptr};
 };
 
 /// The queue state
 struct ShaderExportQueueState {
-    ShaderExportQueueState(const Allocators& allocators) : liveSegments(allocators) {
+    ShaderExportQueueState(const Allocators& allocators) : liveSegments(allocators), decodingSegments(allocators) {
         
     }
     
@@ -255,4 +273,10 @@ struct ShaderExportQueueState {
 
     /// All submitted segments
     Vector<ShaderExportStreamSegment*> liveSegments;
+
+    /// All completed segments pending decoding
+    Vector<ShaderExportStreamSegment*> decodingSegments;
+
+    /// All decodes launched for this queue, waited on at queue sync points
+    EventCounter decodeEvent;
 };
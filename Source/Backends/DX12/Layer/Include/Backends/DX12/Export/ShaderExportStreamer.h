@@ -41,6 +41,7 @@
 #include <Common/Containers/ObjectPool.h>
 #include <Common/Containers/TrivialObjectPool.h>
 #include <Common/Containers/TrivialStackVector.h>
+#include <Common/Dispatcher/EventCounter.h>
 
 // Std
 #include <mutex>
@@ -49,6 +50,7 @@
 class ShaderExportFixedTwoSidedDescriptorAllocator;
 class ShaderExportStreamAllocator;
 class DeviceAllocator;
+class Dispatcher;
 struct DeviceDispatchTable;
 struct PipelineState;
 struct FenceState;
@@ -260,7 +262,8 @@ public:
 
     /// Queue specific sync point
     /// \param queueState the queue state
-    void Process(CommandQueueState* queueState);
+    /// \param syncPoint if true, waits for all decodes launched for this queue
+    void Process(CommandQueueState* queueState, bool syncPoint = false);
 
 private:
     /// Map all segment agnostic data
@@ -275,7 +278,23 @@ private:
     void ProcessSegmentsNoQueueLock(CommandQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
 
     /// Process a segment
-    bool ProcessSegment(ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+    ///   ? Decoding is deferred to the dispatcher, the segment is released once decoded
+    /// \param queue the owning queue state
+    bool ProcessSegment(CommandQueueState* queue, ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+
+    /// Publish and release all decoded segments within a queue
+    ///   ? Segments are published in submission order, stops at the first pending decode
+    /// \param queue the queue state
+    void ReleaseDecodedSegmentsNoQueueLock(CommandQueueState* queue);
+
+    /// Publish all decoded messages of a segment and collapse its versioning
+    /// \param segment the decoded segment
+    void PublishSegment(ShaderExportStreamSegment* segment);
+
+    /// Decode a completed segment into the bridge output
+    ///   ? Invoked on the dispatcher
+    /// \param data the segment
+    void DecodeSegment(void* data);
 
     /// Free a segment
     void FreeSegmentNoQueueLock(CommandQueueState* queue, ShaderExportStreamSegment* segment);
@@ -318,6 +337,9 @@ private:
     /// Internal mutex
     std::mutex mutex;
 
+    /// Completion counter of all segment decodes
+    EventCounter decodeEvent;
+
     /// Shared offset allocator
     BucketPoolAllocator<uint32_t> dynamicOffsetAllocator;
 
@@ -350,4 +372,5 @@ private:
     ComRef<DeviceAllocator> deviceAllocator{nullptr};
     ComRef<ShaderExportStreamAllocator> streamAllocator{nullptr};
     ComRef<IBridge> bridge{nullptr};
+    ComRef<Dispatcher> dispatcher{nullptr};
 };
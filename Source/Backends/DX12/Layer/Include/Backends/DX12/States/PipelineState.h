@@ -81,6 +81,15 @@ struct __declspec(uuid("7C251A06-33FD-42DF-8850-40C1077FCAFE")) PipelineState :
         return it->second;
     }
 
+    /// Mark this pipeline as bound
+    /// \param commitIndex the current instrumentation commit index
+    void MarkBound(uint64_t commitIndex) {
+        // Avoid dirtying the cache line on every bind
+        if (lastBindCommitIndex.load(std::memory_order_relaxed) != commitIndex) {
+            lastBindCommitIndex.store(commitIndex, std::memory_order_relaxed);
+        }
+    }
+
     /// Check if there's an instrumentation request
     /// \return true if there's a request
     bool HasInstrumentationRequest() const {
@@ -112,6 +121,9 @@ struct __declspec(uuid("7C251A06-33FD-42DF-8850-40C1077FCAFE")) PipelineState :
     /// Optional debug name
     char* debugName{nullptr};
 
+    /// Instrumentation commit index at the last bind, zero if never bound
+    std::atomic<uint64_t> lastBindCommitIndex{0};
+
     /// Instrumentation info
     InstrumentationInfo instrumentationInfo;
 
@@ -876,6 +876,9 @@ void WINAPI HookID3D12CommandListSetPipelineState(ID3D12CommandList *list, ID3D1
 
     // Get pipeline
     PipelineState* pipelineState = GetState(pipeline);
+
+    // Mark as recently bound, prioritizes its instrumentation
+    pipelineState->MarkBound(device.state->instrumentationController->GetCommitIndex());
     
     // Get hot swap
     ID3D12PipelineState *hotSwap = pipelineState->hotSwapObject.load();
@@ -917,8 +920,8 @@ void HookID3D12CommandQueueExecuteCommandLists(ID3D12CommandQueue *queue, UINT c
     // Get device
     auto device = GetTable(table.state->parent);
 
-    // Process any remaining work on the queue
-    device.state->exportStreamer->Process(table.state);
+    // Process any remaining work on the queue, empty submissions are sync points
+    device.state->exportStreamer->Process(table.state, count == 0);
 
     // Special case, invoke a device sync point during empty submissions
     if (count == 0) {
@@ -954,6 +957,16 @@ void HookID3D12CommandQueueExecuteCommandLists(ID3D12CommandQueue *queue, UINT c
     // Record the streaming post patching
     unwrapped.Add(device.state->exportStreamer->RecordPostCommandList(table.state, segment));
 
+    // Invoke all proxies prior to submission, host writes made here are visible to the submission
+    for (uint32_t i = 0; i < count; i++) {
+        auto listTable = GetTable(lists[i]);
+
+        // Invoke all proxies
+        for (const FeatureHookTable &proxyTable: device.state->featureHookTables) {
+            proxyTable.preSubmit.TryInvoke(listTable.state->userContext.handle);
+        }
+    }
+
     // Pass down callchain
     table.bottom->next_ExecuteCommandLists(table.next, static_cast<uint32_t>(unwrapped.Size()), unwrapped.Data());
 
@@ -1010,8 +1023,8 @@ CommandQueueState::~CommandQueueState() {
     // Get device
     auto device = GetTable(parent);
 
-    // Clean the streaming state for this queue
-    device.state->exportStreamer->Process(this);
+    // Clean the streaming state for this queue, no decode may outlive it
+    device.state->exportStreamer->Process(this, true);
 
     // Remove state
     device.state->states_Queues.Remove(this);
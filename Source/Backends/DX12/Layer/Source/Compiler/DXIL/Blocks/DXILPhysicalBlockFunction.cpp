@@ -2324,6 +2324,11 @@ void DXILPhysicalBlockFunction::CompileFunction(const DXCompileJob& job, struct
         return;
     }
 
+    // Compile against linear instruction streams
+    for (IL::BasicBlock* basicBlock : fn->GetBasicBlocks()) {
+        basicBlock->Flatten();
+    }
+
     // Visit child blocks
     for (LLVMBlock *fnBlock: block->blocks) {
         switch (static_cast<LLVMReservedBlock>(fnBlock->id)) {
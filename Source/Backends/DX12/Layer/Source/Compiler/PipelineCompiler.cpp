@@ -80,6 +80,15 @@ void PipelineCompiler::AddBatch(PipelineCompilerDiagnostic* diagnostic, Pipeline
         }
     }
 
+    // Order by priority, batches never span multiple priorities
+    auto priorityOrder = [](const PipelineJob& lhs, const PipelineJob& rhs) {
+        return lhs.priority < rhs.priority;
+    };
+
+    // Sort all types
+    std::stable_sort(graphicsJobs.begin(), graphicsJobs.end(), priorityOrder);
+    std::stable_sort(computeJobs.begin(), computeJobs.end(), priorityOrder);
+
     // Submit jobs
     AddBatchOfType(diagnostic, graphicsJobs, PipelineType::Graphics, bucket);
     AddBatchOfType(diagnostic, computeJobs, PipelineType::Compute, bucket);
@@ -107,7 +116,15 @@ void PipelineCompiler::AddBatchOfType(PipelineCompilerDiagnostic* diagnostic, co
 
     // Create batches
     for (uint32_t offset = 0; offset < jobs.size();) {
-        const uint32_t count = std::min(static_cast<uint32_t>(jobs.size()) - offset, batchSize);
+        uint32_t count = std::min(static_cast<uint32_t>(jobs.size()) - offset, batchSize);
+
+        // Limit the batch to a single priority
+        for (uint32_t i = 1; i < count; i++) {
+            if (jobs[offset + i].priority != jobs[offset].priority) {
+                count = i;
+                break;
+            }
+        }
 
         // Create a copy of the states
         auto copy = new(allocators, kAllocInstrumentation) PipelineJob[count];
@@ -126,10 +143,10 @@ void PipelineCompiler::AddBatchOfType(PipelineCompilerDiagnostic* diagnostic, co
                 ASSERT(false, "Invalid job type");
                 break;
             case PipelineType::Graphics:
-                dispatcher->Add(BindDelegate(this, PipelineCompiler::WorkerGraphics), data, bucket);
+                dispatcher->Add(BindDelegate(this, PipelineCompiler::WorkerGraphics), data, bucket, jobs[offset].priority);
                 break;
             case PipelineType::Compute:
-                dispatcher->Add(BindDelegate(this, PipelineCompiler::WorkerCompute), data, bucket);
+                dispatcher->Add(BindDelegate(this, PipelineCompiler::WorkerCompute), data, bucket, jobs[offset].priority);
                 break;
         }
 
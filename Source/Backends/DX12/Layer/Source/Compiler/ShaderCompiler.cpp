@@ -103,7 +103,7 @@ bool ShaderCompiler::Install() {
 void ShaderCompiler::Add(const ShaderJob& job, DispatcherBucket *bucket) {
     auto data = new(registry->GetAllocators(), kAllocInstrumentation) ShaderJob(job);
     job.diagnostic->totalJobs++;
-    dispatcher->Add(BindDelegate(this, ShaderCompiler::Worker), data, bucket);
+    dispatcher->Add(BindDelegate(this, ShaderCompiler::Worker), data, bucket, job.priority);
 }
 
 void ShaderCompiler::Worker(void *data) {
@@ -77,10 +77,11 @@ ShaderExportStreamAllocator::~ShaderExportStreamAllocator() {
     for (ShaderExportSegmentInfo* segment : segmentPool) {
         // Release streams
         for (const ShaderExportStreamInfo& stream : segment->streams) {
-            deviceAllocator->Free(stream.allocation);
+            FreeStreamInfo(stream);
         }
 
         // Release counter
+        deviceAllocator->Unmap(segment->counter.allocation.host);
         deviceAllocator->Free(segment->counter.allocation);
     }
 }
@@ -88,6 +89,7 @@ ShaderExportStreamAllocator::~ShaderExportStreamAllocator() {
 ShaderExportSegmentInfo *ShaderExportStreamAllocator::AllocateSegment() {
     // Try existing allocation
     if (ShaderExportSegmentInfo* segment = segmentPool.TryPop()) {
+        UpdateSegment(segment);
         return segment;
     }
 
@@ -101,8 +103,11 @@ ShaderExportSegmentInfo *ShaderExportStreamAllocator::AllocateSegment() {
     segment->streams.resize(exportInfos.size());
 
     // Allocate all streams
-    for (const ExportInfo& exportInfo : exportInfos) {
-        segment->streams[exportInfo.id] = AllocateStreamInfo(exportInfo.id);
+    {
+        std::lock_guard guard(mutex);
+        for (const ExportInfo& exportInfo : exportInfos) {
+            segment->streams[exportInfo.id] = AllocateStreamInfo(exportInfo.id);
+        }
     }
 
 #if LOG_ALLOCATION
@@ -118,7 +123,67 @@ void ShaderExportStreamAllocator::FreeSegment(ShaderExportSegmentInfo *segment)
 }
 
 void ShaderExportStreamAllocator::SetStreamSize(ShaderExportID id, uint64_t size) {
+    std::lock_guard guard(mutex);
 
+    // Views are dword addressed
+    ExportInfo& exportInfo = exportInfos[id];
+    exportInfo.dataSize = std::max<uint64_t>((size + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1), sizeof(uint32_t));
+    exportInfo.lowUsageCount = 0;
+}
+
+uint64_t ShaderExportStreamAllocator::ReportStreamUsage(ShaderExportID id, uint64_t requestedSize, uint64_t byteSize) {
+    std::lock_guard guard(mutex);
+
+    // Get the export info
+    ExportInfo& exportInfo = exportInfos[id];
+
+    // Overflown? Grow geometrically until the request fits
+    if (requestedSize > byteSize) {
+        uint64_t dataSize = std::max(exportInfo.dataSize, byteSize * 2u);
+        while (dataSize < requestedSize && dataSize < maxDataSize) {
+            dataSize *= 2u;
+        }
+
+        // Never grow past the upper bound, never shrink on overflow
+        exportInfo.dataSize = std::max(exportInfo.dataSize, std::min(dataSize, maxDataSize));
+        exportInfo.lowUsageCount = 0;
+        return exportInfo.dataSize;
+    }
+
+    // Sustained usage?
+    if (requestedSize * 4u >= exportInfo.dataSize || exportInfo.dataSize <= baseDataSize) {
+        exportInfo.lowUsageCount = 0;
+        return exportInfo.dataSize;
+    }
+
+    // Shrink after sustained low usage
+    if (++exportInfo.lowUsageCount >= shrinkLatency) {
+        exportInfo.dataSize = std::max(exportInfo.dataSize / 2u, baseDataSize);
+        exportInfo.lowUsageCount = 0;
+    }
+
+    // OK
+    return exportInfo.dataSize;
+}
+
+void ShaderExportStreamAllocator::UpdateSegment(ShaderExportSegmentInfo *segment) {
+    std::lock_guard guard(mutex);
+
+    // Reallocate all streams that no longer match
+    for (const ExportInfo& exportInfo : exportInfos) {
+        ShaderExportStreamInfo& stream = segment->streams[exportInfo.id];
+
+        // Skip unused exports and matching streams
+        if (!exportInfo.dataSize || stream.byteSize == exportInfo.dataSize) {
+            continue;
+        }
+
+        // Release the previous stream, the segment is not in flight
+        FreeStreamInfo(stream);
+
+        // Allocate with the current size
+        stream = AllocateStreamInfo(exportInfo.id);
+    }
 }
 
 ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo() {
@@ -149,6 +214,9 @@ ShaderExportSegmentCounterInfo ShaderExportStreamAllocator::AllocateCounterInfo(
     info.allocation.host.resource->SetName(L"StreamCounterInfoHost");
 #endif // NDEBUG
 
+    // Keep the host counters mapped for the lifetime of the allocation
+    info.hostCounters = static_cast<const uint32_t*>(deviceAllocator->Map(info.allocation.host));
+
     // Setup view
     info.view.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
     info.view.Format = DXGI_FORMAT_R32_UINT;
@@ -193,6 +261,9 @@ ShaderExportStreamInfo ShaderExportStreamAllocator::AllocateStreamInfo(const Sha
     info.allocation.host.resource->SetName(L"StreamInfoHost");
 #endif // NDEBUG
 
+    // Keep the host data mapped for the lifetime of the allocation
+    info.hostData = deviceAllocator->Map(info.allocation.host);
+
     // Size for safe guarding
     info.byteSize = exportInfo.dataSize;
 
@@ -206,3 +277,8 @@ ShaderExportStreamInfo ShaderExportStreamAllocator::AllocateStreamInfo(const Sha
     // OK
     return info;
 }
+
+void ShaderExportStreamAllocator::FreeStreamInfo(const ShaderExportStreamInfo &info) {
+    deviceAllocator->Unmap(info.allocation.host);
+    deviceAllocator->Free(info.allocation);
+}
@@ -60,8 +60,12 @@
 #include <Message/IMessageStorage.h>
 #include <Message/MessageStream.h>
 
+// Schemas
+#include <Schemas/Diagnostic.h>
+
 // Common
 #include <Common/Registry.h>
+#include <Common/Dispatcher/Dispatcher.h>
 
 ShaderExportStreamer::ShaderExportStreamer(DeviceState *device)
     : device(device), dynamicOffsetAllocator(device->allocators),
@@ -78,6 +82,7 @@ bool ShaderExportStreamer::Install() {
     bridge = registry->Get<IBridge>();
     deviceAllocator = registry->Get<DeviceAllocator>();
     streamAllocator = registry->Get<ShaderExportStreamAllocator>();
+    dispatcher = registry->Get<Dispatcher>();
 
     // Somewhat safe (TODO, cyclic allocator) bound
     constexpr uint32_t kSharedHeapBound = 64'000;
@@ -112,12 +117,19 @@ bool ShaderExportStreamer::Install() {
 }
 
 ShaderExportStreamer::~ShaderExportStreamer() {
-    // Free all live segments
+    // Wait for all pending decodes
+    decodeEvent.Wait(decodeEvent.GetHead());
+
+    // Free all live and decoded segments
     for (CommandQueueState* state : device->states_Queues.GetLinear()) {
         if (state->exportState) {
             for (ShaderExportStreamSegment* segment : state->exportState->liveSegments) {
                 FreeSegmentNoQueueLock(state, segment);
             }
+
+            for (ShaderExportStreamSegment* segment : state->exportState->decodingSegments) {
+                FreeSegmentNoQueueLock(state, segment);
+            }
         }
     }
 
@@ -187,6 +199,8 @@ ShaderExportStreamSegment *ShaderExportStreamer::AllocateSegment() {
 
     // Try existing allocation
     if (ShaderExportStreamSegment* segment = segmentPool.TryPop()) {
+        // Match the current stream sizes
+        streamAllocator->UpdateSegment(segment->allocation);
         return segment;
     }
 
@@ -622,6 +636,21 @@ void ShaderExportStreamer::Process() {
             ProcessSegmentsNoQueueLock(queueState, completedHandles);
         }
     }
+
+    // Whole device sync points expect all messages to be committed, wait for pending decodes
+    decodeEvent.Wait(decodeEvent.GetHead());
+
+    // Release all decoded segments
+    {
+        // Maintain lock hierarchy, streamer -> queue
+        std::lock_guard guard(mutex);
+
+        // Release queues
+        // ! Linear view locks
+        for (CommandQueueState* queueState : device->states_Queues.GetLinear()) {
+            ReleaseDecodedSegmentsNoQueueLock(queueState);
+        }
+    }
     
     // Invoke proxies for all handles
     for (CommandContextHandle handle : completedHandles) {
@@ -631,7 +660,7 @@ void ShaderExportStreamer::Process() {
     }
 }
 
-void ShaderExportStreamer::Process(CommandQueueState* queueState) {
+void ShaderExportStreamer::Process(CommandQueueState* queueState, bool syncPoint) {
     // Released handles
     TrivialStackVector<CommandContextHandle, 32u> completedHandles;
 
@@ -644,6 +673,18 @@ void ShaderExportStreamer::Process(CommandQueueState* queueState) {
         std::lock_guard queueGuard(device->states_Queues.GetLock());
         ProcessSegmentsNoQueueLock(queueState, completedHandles);
     }
+
+    // Queue sync points expect all messages of the queue to be committed, wait for its pending decodes
+    if (syncPoint) {
+        queueState->exportState->decodeEvent.Wait(queueState->exportState->decodeEvent.GetHead());
+
+        // Maintain lock hierarchy, streamer -> queue
+        std::lock_guard guard(mutex);
+
+        // Release all decoded segments
+        std::lock_guard queueGuard(device->states_Queues.GetLock());
+        ReleaseDecodedSegmentsNoQueueLock(queueState);
+    }
     
     // Invoke proxies for all handles
     for (CommandContextHandle handle : completedHandles) {
@@ -1042,74 +1083,88 @@ void ShaderExportStreamer::SetComputeRootConstants(ShaderExportStreamState* stat
 }
 
 void ShaderExportStreamer::ProcessSegmentsNoQueueLock(CommandQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
+    // Release all previously decoded segments
+    ReleaseDecodedSegmentsNoQueueLock(queue);
+
     // TODO: Does not hold true for all queues
     auto it = queue->exportState->liveSegments.begin();
 
     // Segments are enqueued in order of completion
     for (; it != queue->exportState->liveSegments.end(); it++) {
         // If failed to process, none of the succeeding are ready
-        if (!ProcessSegment(*it, completedHandles)) {
+        if (!ProcessSegment(queue, *it, completedHandles)) {
             break;
         }
 
-        // Add back to pool
-        FreeSegmentNoQueueLock(queue, *it);
+        // Released once decoded
+        queue->exportState->decodingSegments.push_back(*it);
     }
 
     // Remove dead segments
     queue->exportState->liveSegments.erase(queue->exportState->liveSegments.begin(), it);
 }
 
-bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
-    // Ready?
-    if (!segment->fence->IsCommitted(segment->fenceNextCommitId)) {
-        return false;
-    }
-
-    // Output for messages
-    IMessageStorage* output = bridge->GetOutput();
-
-    // Map the counters
-    const MirrorAllocation& counterMirror = segment->allocation->counter.allocation;
-    auto* counters = static_cast<uint32_t*>(deviceAllocator->Map(counterMirror.host));
+void ShaderExportStreamer::ReleaseDecodedSegmentsNoQueueLock(CommandQueueState* queue) {
+    auto it = queue->exportState->decodingSegments.begin();
 
-    // Process all streams
-    for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
-        const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
-
-        // Get the written counter
-        uint32_t elementCount = counters[i];
-
-        // Limit the counter by the physical size of the buffer (may exceed)
-        elementCount = std::min(elementCount, static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize));
+    // Segments may be decoded out of order, but versions must collapse in order
+    for (; it != queue->exportState->decodingSegments.end(); it++) {
+        // If pending, none of the succeeding may be published
+        if (!(*it)->decoded.load(std::memory_order_acquire)) {
+            break;
+        }
 
-        // Map the stream
-        auto* stream = static_cast<uint8_t*>(deviceAllocator->Map(streamInfo.allocation.host));
+        // Push all messages
+        PublishSegment(*it);
 
-        // Size of the stream
-        size_t size = std::min<uint64_t>(elementCount * sizeof(uint32_t), streamInfo.allocation.host.allocation->GetSize());
+        // Add back to pool
+        FreeSegmentNoQueueLock(queue, *it);
+    }
 
-        // Copy into stream
-        MessageStream messageStream;
-        messageStream.SetSchema(streamInfo.typeInfo.messageSchema);
-        messageStream.SetVersionID(segment->versionSegPoint.id);
-        messageStream.SetData(stream, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
+    // Remove released segments
+    queue->exportState->decodingSegments.erase(queue->exportState->decodingSegments.begin(), it);
+}
 
-        // Add output
-        output->AddStream(messageStream);
+void ShaderExportStreamer::PublishSegment(ShaderExportStreamSegment *segment) {
+    // Output for messages
+    IMessageStorage* output = bridge->GetOutput();
 
-        // Unmap
-        deviceAllocator->Unmap(streamInfo.allocation.host);
+    // Add all decoded streams, empty streams are ignored
+    for (MessageStream& messageStream : segment->messageStreams) {
+        output->AddStreamAndSwap(messageStream);
     }
 
-    // Unmap host
-    deviceAllocator->Unmap(counterMirror.host);
+    // Any overflows?
+    if (!segment->overflowStream.IsEmpty()) {
+        output->AddStreamAndSwap(segment->overflowStream);
+    }
 
     // Inform the versioning controller of a collapse
     ASSERT(segment->versionSegPoint.id != UINT32_MAX, "Untracked versioning");
     device->versioningController->CollapseOnFork(segment->versionSegPoint);
+}
 
-    // Collect all handles
+bool ShaderExportStreamer::ProcessSegment(CommandQueueState* queue, ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
+    // Ready?
+    if (!segment->fence->IsCommitted(segment->fenceNextCommitId)) {
+        return false;
+    }
+
+    // Mark as pending, tracked on both the device and the owning queue
+    segment->decoded.store(false, std::memory_order_relaxed);
+    segment->queueDecodeEvent = &queue->exportState->decodeEvent;
+    segment->queueDecodeEvent->IncrementHead();
+    decodeEvent.IncrementHead();
+
+    // Decode on the dispatcher if possible, the submitting thread should not pay for the readback
+    //  ? Sync points wait on the decodes, never queue them behind compilation jobs
+    if (dispatcher) {
+        dispatcher->Add(BindDelegate(this, ShaderExportStreamer::DecodeSegment), segment, nullptr, DispatcherJobPriority::Blocking);
+    } else {
+        DecodeSegment(segment);
+    }
+
+    // Collect all handles, the device has completed the segment
     for (CommandContextHandle handle : segment->commandContextHandles) {
         completedHandles.Add(handle);
     }
@@ -1118,37 +1173,69 @@ bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, Tr
     return true;
 }
 
-void ShaderExportStreamer::FreeConstantAllocator(ShaderExportConstantAllocator& allocator) {
-    // Cleanup the staging data
-    if (!allocator.staging.empty()) {
-        // Free all staging allocations except the last
-        for (size_t i = 0; i < allocator.staging.size() - 1u; i++) {
-            device->deviceAllocator->Free(allocator.staging[i].allocation);
-        }
+void ShaderExportStreamer::DecodeSegment(void *data) {
+    auto* segment = static_cast<ShaderExportStreamSegment*>(data);
 
-        // Remove all but the last
-        allocator.staging.erase(allocator.staging.begin(), allocator.staging.begin() + (allocator.staging.size() - 1u));
+    // Counters are persistently mapped
+    const uint32_t* counters = segment->allocation->counter.hostCounters;
 
-        // Reset head counter
-        allocator.staging.back().head = 0;
-    }
+    // Ensure there's a pooled stream per export
+    segment->messageStreams.resize(segment->allocation->streams.size());
 
-    // Add to free pool
-    freeConstantAllocators.push_back(allocator);
-}
+    // Overflow diagnostics, published with the segment
+    segment->overflowStream.Clear();
+    MessageStreamView overflowView(segment->overflowStream);
 
-void ShaderExportStreamer::FreeDescriptorDataSegment(const DescriptorDataSegment &dataSegment) {
-    if (dataSegment.entries.empty()) {
-        return;
-    }
+    // Process all streams
+    for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
+        const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
+
+        // Get the written counter, in dwords
+        uint32_t requestedCount = counters[i];
+
+        // Number of dwords that fit the physical size of the buffer, in whole messages
+        auto capacity = static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize * streamInfo.typeInfo.typeSize / sizeof(uint32_t));
+
+        // Limit the counter by the physical size of the buffer (may exceed)
+        uint32_t elementCount = std::min(requestedCount, capacity);
+
+        // Let the allocator adapt the next streams to the demand
+        uint64_t nextByteSize = streamAllocator->ReportStreamUsage(static_cast<ShaderExportID>(i), requestedCount * sizeof(uint32_t), streamInfo.byteSize);
+
+        // Report truncation, silently losing messages would hide faults
+        if (requestedCount > capacity) {
+            auto* diagnostic = overflowView.Add<ExportStreamOverflowDiagnosticMessage>();
+            diagnostic->exportID = static_cast<uint32_t>(i);
+            diagnostic->droppedCount = static_cast<uint32_t>((requestedCount - capacity) * sizeof(uint32_t) / streamInfo.typeInfo.typeSize);
+            diagnostic->streamSize = static_cast<uint32_t>(streamInfo.byteSize);
+            diagnostic->nextStreamSize = static_cast<uint32_t>(nextByteSize);
+        }
 
-    // Free all re-chunked allocations
-    for (size_t i = 0; i < dataSegment.entries.size() - 1; i++) {
-        deviceAllocator->Free(dataSegment.entries[i].allocation);
+        // Nothing written?
+        if (!elementCount) {
+            segment->messageStreams[i].Clear();
+            continue;
+        }
+
+        // Size of the stream
+        size_t size = std::min<uint64_t>(elementCount * sizeof(uint32_t), streamInfo.allocation.host.allocation->GetSize());
+
+        // Copy into the pooled stream, swapped with a recycled one on publishing
+        MessageStream& messageStream = segment->messageStreams[i];
+        messageStream.SetSchema(streamInfo.typeInfo.messageSchema);
+        messageStream.SetVersionID(segment->versionSegPoint.id);
+        messageStream.SetData(streamInfo.hostData, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
     }
 
-    // Mark the last, and largest, chunk as free
-    freeDescriptorDataSegmentEntries.push_back(dataSegment.entries.back());
+    // The segment may be recycled once marked, keep the queue event around
+    EventCounter* queueDecodeEvent = segment->queueDecodeEvent;
+
+    // Segment may now be published and released
+    segment->decoded.store(true, std::memory_order_release);
+
+    // Queue before device, device sync points outlive the queue
+    queueDecodeEvent->IncrementCounter();
+    decodeEvent.IncrementCounter();
 }
 
 void ShaderExportStreamer::FreeSegmentNoQueueLock(CommandQueueState* queue, ShaderExportStreamSegment *segment) {
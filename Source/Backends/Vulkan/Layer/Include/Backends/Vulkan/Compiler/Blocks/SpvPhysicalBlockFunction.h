@@ -29,6 +29,8 @@
 // Layer
 #include <Backends/Vulkan/Compiler/Blocks/SpvPhysicalBlockSection.h>
 #include <Backends/Vulkan/Compiler/SpvCodeOffsetTraceback.h>
+#include <Backends/Vulkan/Compiler/SpvSourceAssociation.h>
+#include <Backends/Vulkan/Compiler/SpvPhysicalBlockSource.h>
 
 // Backend
 #include <Backend/IL/Source.h>
@@ -37,6 +39,7 @@
 
 // Std
 #include <set>
+#include <unordered_set>
 
 // Forward declarations
 struct SpvPhysicalBlockScan;
@@ -46,24 +49,22 @@ struct SpvParseContext;
 struct SpvIdMap;
 struct SpvJob;
 struct SpvStream;
+class Dispatcher;
 
 /// Function definition and declaration physical block
 struct SpvPhysicalBlockFunction : public SpvPhysicalBlockSection {
     using SpvPhysicalBlockSection::SpvPhysicalBlockSection;
 
     /// Parse all instructions
-    void Parse();
+    ///   ? Function bodies are independent after the headers, and are parsed in parallel if a dispatcher is given
+    /// \param dispatcher optional, the dispatcher to parse function bodies on
+    void Parse(Dispatcher* dispatcher = nullptr);
 
     /// Parse the function header
     /// \param function destination function
     /// \param ctx parsing context
     void ParseFunctionHeader(IL::Function *function, SpvParseContext &ctx);
 
-    /// Parse the function body
-    /// \param function destination function
-    /// \param ctx parsing context
-    void ParseFunctionBody(IL::Function *function, SpvParseContext &ctx);
-
     /// Compile the physical block
     /// \param job source job
     /// \param idMap
@@ -96,6 +97,38 @@ struct SpvPhysicalBlockFunction : public SpvPhysicalBlockSection {
     SpvCodeOffsetTraceback GetCodeOffsetTraceback(uint32_t codeOffset);
 
 private:
+    struct LoopContinueBlock {
+        IL::InstructionRef<> instruction;
+        IL::ID block;
+    };
+
+    /// Function body parsing state, bodies may be parsed concurrently
+    ///  ! Anything shared across functions is only read during body parsing, or merged afterwards
+    struct FunctionBodyState {
+        /// Destination function
+        IL::Function* function{nullptr};
+
+        /// Body bounds, excluding the function end
+        SpvPhysicalBlockSource source;
+
+        /// All traceback information
+        std::vector<std::pair<uint32_t, SpvCodeOffsetTraceback>> sourceTraceback;
+
+        /// All source associations
+        std::vector<std::pair<uint32_t, SpvSourceAssociation>> sourceAssociations;
+
+        /// All continue blocks
+        std::vector<LoopContinueBlock> loopContinueBlocks;
+    };
+
+    /// Scan a function body, resolving all shared state it depends on
+    /// \param ctx parsing context, positioned at the first body instruction, ends at the function end
+    void ScanFunctionBody(SpvParseContext &ctx);
+
+    /// Parse the function body
+    /// \param state the function body state
+    void ParseFunctionBody(FunctionBodyState& state);
+
     /// Patch all loop continues
     /// \param fn function
     void PostPatchLoopContinue(IL::Function* fn);
@@ -148,6 +181,16 @@ private:
     /// \param instr sampling instruction
     /// \return image identifier
     IL::ID MigrateCombinedImageSampler(SpvStream &stream, SpvIdMap &idMap, IL::BasicBlock *bb, const IL::SampleTextureInstruction *instr);
+
+    /// Check if a basic block may be split during compilation
+    /// \param bb source basic block
+    /// \return true if splittable
+    bool IsSplittable(IL::BasicBlock *bb);
+
+    /// Patch the parents of all phi instructions referencing blocks split during compilation
+    ///   ? A split block continues in a new block, which is then the actual predecessor of its successors
+    /// \param offset stream offset of the function
+    void PatchSplitBlockPhis(uint32_t offset);
     
 private:
     /// Identifier type
@@ -185,11 +228,13 @@ private:
     std::unordered_map<uint32_t, SpvCodeOffsetTraceback> sourceTraceback;
 
 private:
-    struct LoopContinueBlock {
-        IL::InstructionRef<> instruction;
-        IL::ID block;
-    };
-
     /// All continue blocks
     std::vector<LoopContinueBlock> loopContinueBlocks;
+
+private:
+    /// Blocks split during compilation of the current function, original block to the last split block
+    std::unordered_map<IL::ID, IL::ID> splitBlockExits;
+
+    /// All blocks created by splits in the current function
+    std::unordered_set<IL::ID> splitBlocks;
 };
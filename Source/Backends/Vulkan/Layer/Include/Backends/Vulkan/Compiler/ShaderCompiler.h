@@ -36,6 +36,7 @@
 // Common
 #include <Common/IComponent.h>
 #include <Common/ComRef.h>
+#include <Common/Dispatcher/DispatcherJob.h>
 
 // Std
 #include <mutex>
@@ -45,6 +46,7 @@ struct DispatcherBucket;
 class IFeature;
 class IShaderFeature;
 class ShaderCompilerDebug;
+class ShaderCompilerCache;
 class ShaderExportDescriptorAllocator;
 
 struct ShaderJob {
@@ -59,6 +61,9 @@ struct ShaderJob {
 
     /// Pipeline dependent specialization stream
     MessageStream* dependentSpecialization{nullptr};
+
+    /// Scheduling priority
+    DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
 };
 
 class ShaderCompiler : public TComponent<ShaderCompiler> {
@@ -97,6 +102,7 @@ private:
     /// Components
     ComRef<Dispatcher> dispatcher;
     ComRef<ShaderCompilerDebug> debug;
+    ComRef<ShaderCompilerCache> cache;
     ComRef<ShaderExportDescriptorAllocator> shaderExportDescriptorAllocator;
 
     /// All features
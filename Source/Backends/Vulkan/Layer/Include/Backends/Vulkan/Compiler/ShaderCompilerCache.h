@@ -0,0 +1,91 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Layer
+#include <Backends/Vulkan/Vulkan.h>
+#include <Backends/Vulkan/States/ShaderModuleInstrumentationKey.h>
+
+// Backend
+#include <Backend/ShaderExport.h>
+
+// Common
+#include <Common/IComponent.h>
+#include <Common/DiskCache.h>
+
+// Std
+#include <vector>
+
+// Forward declarations
+struct DeviceDispatchTable;
+struct ShaderModuleState;
+
+/// Persistent, content addressed cache of instrumented shader modules
+///  ? Entries hold the instrumented code and all sguid mappings bound during instrumentation, a hit
+///    restores the mappings and creates the module without parsing or instrumenting the source
+class ShaderCompilerCache : public TComponent<ShaderCompilerCache> {
+public:
+    COMPONENT(ShaderCompilerCache);
+
+    explicit ShaderCompilerCache(DeviceDispatchTable* table);
+
+    /// Install this cache
+    ///  ! Must be installed after all features, shader data and the export descriptor allocator
+    /// \return false if the cache directory is unavailable
+    bool Install();
+
+    /// Get the content key of an instrumented module
+    /// \param state the source shader
+    /// \param key the instrumentation key
+    /// \return content key
+    uint64_t GetKey(ShaderModuleState* state, const ShaderModuleInstrumentationKey& key);
+
+    /// Find and create an instrumented module
+    ///  ? Restores all sguid mappings of the instrumented module
+    /// \param key the content key
+    /// \param state the source shader
+    /// \param out the created module
+    /// \return false if not found, or if the sguids conflict with this session
+    bool Find(uint64_t key, ShaderModuleState* state, VkShaderModule* out);
+
+    /// Store an instrumented module
+    /// \param key the content key
+    /// \param code instrumented code
+    /// \param size byte size of the instrumented code
+    /// \param sguids all sguids bound during instrumentation
+    void Store(uint64_t key, const uint32_t* code, uint64_t size, const std::vector<ShaderSGUID>& sguids);
+
+private:
+    DeviceDispatchTable* table;
+
+    /// Underlying storage
+    DiskCache diskCache;
+
+    /// Hash of all inputs shared by every instrumented module
+    uint64_t environmentHash{0};
+};
@@ -48,6 +48,7 @@
 struct SpvDebugMap;
 struct SpvSourceMap;
 struct SpvPhysicalBlockTable;
+class Dispatcher;
 
 class SpvModule {
 public:
@@ -69,7 +70,8 @@ public:
     /// Parse a module
     /// \param code the SPIRV module pointer
     /// \param wordCount number of words within the module stream
-    bool ParseModule(const uint32_t* code, uint32_t wordCount);
+    /// \param dispatcher optional, the dispatcher to parse function bodies on
+    bool ParseModule(const uint32_t* code, uint32_t wordCount, Dispatcher* dispatcher = nullptr);
 
     /// Recompile the program, code must be the same as the originally parsed module
     /// \param code the SPIRV module pointer
@@ -77,6 +79,18 @@ public:
     /// \return success state
     bool Recompile(const uint32_t* code, uint32_t wordCount, const SpvJob& job);
 
+    /// Reorder and flatten all functions for compilation, first stage of Recompile
+    /// \return success state
+    bool ReorderForCompilation();
+
+    /// Compile all physical blocks, second stage of Recompile
+    /// \param job the compilation job
+    /// \return success state
+    bool CompilePhysicalBlocks(const SpvJob& job);
+
+    /// Stitch all physical blocks to the program, final stage of Recompile
+    void Stitch();
+
     /// Get code offset traceback
     /// \param codeOffset code offset, must originate from this module
     /// \return traceback
@@ -85,6 +85,12 @@ struct SpvParseContext {
         return Get()->GetWordCount() - instructionOffset;
     }
 
+    /// Get the current instruction, including its header
+    /// \return word pointer
+    const uint32_t* GetCode() const {
+        return code;
+    }
+
     /// Get the current instruction code
     /// \return word pointer
     const uint32_t* GetInstructionCode() const {
@@ -45,8 +45,9 @@ struct SpvPhysicalBlockTable {
     /// Parse a stream
     /// \param code stream start
     /// \param count stream word count
+    /// \param dispatcher optional, the dispatcher to parse function bodies on
     /// \return success state
-    bool Parse(const uint32_t *code, uint32_t count);
+    bool Parse(const uint32_t *code, uint32_t count, Dispatcher* dispatcher = nullptr);
 
     /// Compile the table
     /// \param job the job to compile against
@@ -52,11 +52,29 @@ struct SpvUtilShaderExport {
     /// \param value the value to be exported
     void Export(SpvStream& stream, uint32_t exportID, const IL::ID* value, uint32_t count);
 
+    /// Export a given value, reserving the stream space of all active lanes with a single atomic
+    ///   ? Splits the current block, the leading lane performs the reservation in a selection construct
+    ///   ! Must not be used in loop headers, the back edges must target the block holding the loop merge
+    /// \param stream the current spirv stream
+    /// \param blockLabel the label of the current block, replaced by the label of the block after the export
+    /// \param exportID the <compile time> identifier
+    /// \param value the value to be exported
+    void ExportWaveAggregated(SpvStream& stream, IL::ID& blockLabel, uint32_t exportID, const IL::ID* value, uint32_t count);
+
     /// Copy to a new block
     /// \param remote the new block table
     /// \param out the destination shader export
     void CopyTo(SpvPhysicalBlockTable& remote, SpvUtilShaderExport& out);
 
+private:
+    /// Write all values to the stream
+    /// \param stream the current spirv stream
+    /// \param streamOffsetId the stream index constant
+    /// \param atomicPositionId the reserved position of the first value
+    /// \param values all values to be written
+    /// \param valueCount number of values
+    void WriteValues(SpvStream& stream, uint32_t streamOffsetId, uint32_t atomicPositionId, const IL::ID* values, uint32_t valueCount);
+
 private:
     /// Shared allocators
     Allocators allocators;
@@ -77,3 +77,14 @@
 ///   An alternative implementations would extend each staged bit, and then append new stages if
 ///   needed. However, this complicates the user side updates.
 #define PIPELINE_MERGE_PC_RANGES 1
+
+/// Enable the persistent cache of instrumented shader modules
+///  ? Warm starts skip parsing, injection and recompilation of previously instrumented shaders
+#define SHADER_COMPILER_CACHE 1
+
+/// Maximum byte size of the persistent shader cache, least recently used entries are evicted
+#define SHADER_COMPILER_CACHE_BUDGET (512ull << 20)
+
+/// Enable wave aggregated shader exports on supporting devices
+///  ? Reserves the export stream space of all active lanes with a single atomic per wave
+#define SHADER_COMPILER_WAVE_AGGREGATION 1
@@ -31,6 +31,7 @@
 #include <Backends/Vulkan/Controllers/IController.h>
 #include <Backends/Vulkan/Controllers/InstrumentationStage.h>
 #include <Backends/Vulkan/States/PipelineType.h>
+#include <Backends/Vulkan/States/ShaderModuleInstrumentationKey.h>
 #include <Backends/Vulkan/Compiler/Diagnostic/ShaderCompilerDiagnostic.h>
 #include <Backends/Vulkan/Compiler/Diagnostic/PipelineCompilerDiagnostic.h>
 #include <Backends/Vulkan/Compiler/Diagnostic/DiagnosticType.h>
@@ -38,6 +39,7 @@
 // Common
 #include <Common/Dispatcher/EventCounter.h>
 #include <Common/Dispatcher/RelaxedAtomic.h>
+#include <Common/Dispatcher/DispatcherJob.h>
 #include <Common/ComRef.h>
 
 // Bridge
@@ -48,6 +50,7 @@
 #include <chrono>
 #include <set>
 #include <unordered_map>
+#include <mutex>
 
 // Forward declarations
 class Registry;
@@ -89,6 +92,11 @@ public:
     /// Commit all instrumentation changes
     void CommitInstrumentation();
 
+    /// Get the current commit index, incremented on every commit
+    uint64_t GetCommitIndex() const {
+        return commitIndex.load(std::memory_order_relaxed);
+    }
+
     /// Commit all bridges changes
     void Commit();
 
@@ -109,7 +117,8 @@ public:
     void CreatePipelineAndAdd(PipelineState* state);
 
 protected:
-    void CommitShaders(DispatcherBucket* bucket, void *data);
+    void CommitGraph(DispatcherBucket* bucket, void *data);
+    void CommitShader(DispatcherBucket* bucket, void *data);
     void CommitPipelines(DispatcherBucket* bucket, void *data);
     void CommitTable(DispatcherBucket* bucket, void *data);
 
@@ -160,6 +169,11 @@ private:
     /// \param state given state
     void CreatePipelineNoLock(PipelineState* state);
 
+    /// Get the compilation priority of a pipeline
+    /// \param state given pipeline
+    /// \return job priority
+    DispatcherJobPriority GetPipelinePriority(const PipelineState* state) const;
+
 private:
     DeviceDispatchTable* table;
     ComRef<ShaderCompiler> shaderCompiler;
@@ -184,11 +198,31 @@ private:
 private:
     struct Batch {
         struct CommitEntry {
+            /// Owning batch
+            Batch* batch{nullptr};
+
             /// Pending entry
             PipelineState* state{nullptr};
 
             /// Expected hash
             uint64_t combinedHash{0};
+
+            /// Was the pipeline submitted for compilation?
+            bool enqueued{false};
+        };
+
+        struct PipelineWave {
+            /// Owning batch
+            Batch* batch{nullptr};
+
+            /// Scheduling priority of all pipelines in this wave
+            DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
+
+            /// All entries of this priority
+            std::vector<CommitEntry*> entries;
+
+            /// All keys which failed to compile
+            std::vector<std::pair<ShaderModuleState*, ShaderModuleInstrumentationKey>> rejectedKeys;
         };
         
         /// Given feature set
@@ -206,9 +240,15 @@ private:
         std::chrono::high_resolution_clock::time_point stampBeginShaders;
         std::chrono::high_resolution_clock::time_point stampBeginPipelines;
 
-        /// All pending entries
+        /// All pending entries, one per dirty pipeline
         std::vector<CommitEntry> commitEntries;
 
+        /// Pipelines are batched per priority, each wave waits on the shaders it consumes
+        PipelineWave pipelineWaves[static_cast<uint32_t>(DispatcherJobPriority::Count)];
+
+        /// All keys which failed to compile, merged from all waves
+        std::vector<std::pair<ShaderModuleState*, ShaderModuleInstrumentationKey>> rejectedKeys;
+
         /// Dirty objects
         std::set<ReferenceObject*> dirtyObjects;
         std::vector<ShaderModuleState*> dirtyShaderModules;
@@ -220,6 +260,9 @@ private:
         // All stage counters
         RelaxedAtomic<uint32_t> stageCounters[static_cast<uint32_t>(PipelineType::Count)];
 
+        // Pipeline stage counters, waves may overlap so these are kept apart from the shader stage
+        RelaxedAtomic<uint32_t> pipelineStageCounters[static_cast<uint32_t>(PipelineType::Count)];
+
         // Threading bucket
         DispatcherBucket* bucket{nullptr};
     };
@@ -251,4 +294,7 @@ private:
 
 private:
     bool synchronousRecording{false};
+
+    /// Number of commits, used to track recently bound pipelines
+    std::atomic<uint64_t> commitIndex{1};
 };
@@ -54,6 +54,9 @@ struct ShaderExportStreamInfo {
 
     /// Actual byte size of the buffer (not allocation)
     uint64_t byteSize{0};
+
+    /// Persistently mapped host data
+    const void* hostData{nullptr};
 };
 
 /// A batch of counters (for each stream), used for a single allocation
@@ -67,6 +70,9 @@ struct ShaderExportSegmentCounterInfo {
 
     /// Counter allocation
     MirrorAllocation allocation;
+
+    /// Persistently mapped host counters
+    const uint32_t* hostCounters{nullptr};
 };
 
 /// A single allocation, partitioning is up to the allocation modes
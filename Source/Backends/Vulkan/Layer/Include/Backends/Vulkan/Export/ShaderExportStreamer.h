@@ -39,6 +39,7 @@
 #include <Common/Containers/ObjectPool.h>
 #include <Common/Containers/TrivialObjectPool.h>
 #include <Common/Containers/TrivialStackVector.h>
+#include <Common/Dispatcher/EventCounter.h>
 
 // Std
 #include <mutex>
@@ -47,6 +48,7 @@
 class ShaderExportDescriptorAllocator;
 class ShaderExportStreamAllocator;
 class DeviceAllocator;
+class Dispatcher;
 struct PhysicalResourceMappingTableQueueState;
 struct DeviceDispatchTable;
 struct PipelineState;
@@ -187,7 +189,8 @@ public:
 
     /// Queue specific sync point
     /// \param queueState the queue state
-    void Process(ShaderExportQueueState* queueState);
+    /// \param syncPoint if true, waits for all decodes launched for this queue
+    void Process(ShaderExportQueueState* queueState, bool syncPoint = false);
 
 private:
     /// Migrate the descriptor environment to a new pipeline state
@@ -201,7 +204,23 @@ private:
     void ProcessSegmentsNoQueueLock(ShaderExportQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
 
     /// Process a segment
-    bool ProcessSegment(ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+    ///   ? Decoding is deferred to the dispatcher, the segment is released once decoded
+    /// \param queue the owning queue state
+    bool ProcessSegment(ShaderExportQueueState* queue, ShaderExportStreamSegment* segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles);
+
+    /// Publish and release all decoded segments within a queue
+    ///   ? Segments are published in submission order, stops at the first pending decode
+    /// \param queue the queue state
+    void ReleaseDecodedSegmentsNoQueueLock(ShaderExportQueueState* queue);
+
+    /// Publish all decoded messages of a segment and collapse its versioning
+    /// \param segment the decoded segment
+    void PublishSegment(ShaderExportStreamSegment* segment);
+
+    /// Decode a completed segment into the bridge output
+    ///   ? Invoked on the dispatcher
+    /// \param data the segment
+    void DecodeSegment(void* data);
 
     /// Free a segment
     void FreeSegmentNoQueueLock(ShaderExportQueueState* queue, ShaderExportStreamSegment* segment);
@@ -215,6 +234,9 @@ private:
     /// Shared lock
     std::mutex mutex;
 
+    /// Completion counter of all segment decodes
+    EventCounter decodeEvent;
+
     /// Offset allocator
     BucketPoolAllocator<uint32_t> dynamicOffsetAllocator;
 
@@ -231,6 +253,7 @@ private:
     ComRef<ShaderExportDescriptorAllocator> descriptorAllocator{nullptr};
     ComRef<ShaderExportStreamAllocator> streamAllocator{nullptr};
     ComRef<IBridge> bridge{nullptr};
+    ComRef<Dispatcher> dispatcher{nullptr};
 
     /// Does the device require push state tracking?
     bool requiresPushStateTracking{false};
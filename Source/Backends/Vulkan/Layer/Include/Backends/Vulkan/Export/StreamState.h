@@ -37,11 +37,16 @@
 // Backend
 #include <Backend/CommandContextHandle.h>
 
+// Message
+#include <Message/MessageStream.h>
+
 // Common
 #include <Common/Containers/BucketPoolAllocator.h>
+#include <Common/Dispatcher/EventCounter.h>
 
 // Std
 #include <vector>
+#include <atomic>
 
 // Forward declarations
 struct ShaderExportSegmentInfo;
@@ -167,6 +172,18 @@ struct ShaderExportStreamSegment {
 
     /// Versioning segmentation point during submission
     VersionSegmentationPoint versionSegPoint{};
+
+    /// Pooled decoding streams, one per export, recycled through the message storage
+    std::vector<MessageStream> messageStreams;
+
+    /// Overflow diagnostics of the last decode
+    MessageStream overflowStream;
+
+    /// Set once the segment has been decoded and may be released
+    std::atomic<bool> decoded{false};
+
+    /// Decode event of the owning queue, valid while decoding
+    EventCounter* queueDecodeEvent{nullptr};
 };
 
 /// The queue state
@@ -175,4 +192,10 @@ struct ShaderExportQueueState {
 
     /// All submitted segments
     std::vector<ShaderExportStreamSegment*> liveSegments;
+
+    /// All completed segments pending decoding
+    std::vector<ShaderExportStreamSegment*> decodingSegments;
+
+    /// All decodes launched for this queue, waited on at queue sync points
+    EventCounter decodeEvent;
 };
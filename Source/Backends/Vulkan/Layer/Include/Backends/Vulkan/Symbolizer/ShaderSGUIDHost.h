@@ -32,6 +32,7 @@
 // Std
 #include <vector>
 #include <unordered_map>
+#include <string>
 #include <mutex>
 
 // Forward declarations
@@ -49,6 +50,24 @@ public:
     /// \param bridge
     void Commit(IBridge* bridge);
 
+    /// Begin recording all sguids bound against a program
+    /// \param program the program to record
+    void BeginRecording(const IL::Program& program);
+
+    /// End recording of a program
+    /// \param program the recorded program
+    /// \return all unique sguids bound since recording began
+    std::vector<ShaderSGUID> EndRecording(const IL::Program& program);
+
+    /// Restore previously bound mappings with their exact sguids, used for cached instrumentation
+    ///  ? Mappings are only restored if none of the sguids are allocated to different mappings
+    /// \param shaderGUID the shader to restore for, replaces the shader guid of all mappings
+    /// \param mappings all mappings, including their sguids
+    /// \param sources the source line of each mapping, used as the shader may not have been parsed
+    /// \param count number of mappings
+    /// \return false if any sguid conflicts
+    bool Restore(uint64_t shaderGUID, const ShaderSourceMapping* mappings, const std::string_view* sources, uint32_t count);
+
     /// Overrides
     ShaderSGUID Bind(const IL::Program &program, const IL::BasicBlock::ConstIterator& instruction) override;
     ShaderSourceMapping GetMapping(ShaderSGUID sguid) override;
@@ -58,8 +77,21 @@ public:
 private:
     struct ShaderEntry {
         std::unordered_map<ShaderSourceMapping, ShaderSourceMapping> mappings;
+
+        /// Restored source lines, keyed by file uid and line
+        std::unordered_map<uint64_t, std::string> restoredSources;
     };
 
+    /// Get the source code for a mapping
+    ///  ! Mutex must be acquired
+    /// \param mapping the mapping
+    /// \return the source code, empty if not found
+    std::string_view GetSourceUnsafe(const ShaderSourceMapping& mapping);
+
+    /// Check if a sguid is allocated
+    ///  ! Mutex must be acquired
+    bool IsAllocatedUnsafe(ShaderSGUID sguid) const;
+
     /// Get the source map from a guid
     /// \param shaderGUID the shader guid
     /// \return source map, nullptr if not found
@@ -84,4 +116,7 @@ private:
 
     /// All pending bridge submissions
     std::vector<ShaderSGUID> pendingSubmissions;
+
+    /// All active recordings
+    std::unordered_map<const IL::Program*, std::vector<ShaderSGUID>> recordings;
 };
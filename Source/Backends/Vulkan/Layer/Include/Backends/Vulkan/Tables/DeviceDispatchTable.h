@@ -271,6 +271,10 @@ struct DeviceDispatchTable {
     VkPhysicalDeviceFeatures2                  physicalDeviceFeatures{};
     VkPhysicalDeviceDescriptorIndexingFeatures physicalDeviceDescriptorIndexingFeatures{};
     VkPhysicalDeviceRobustness2FeaturesEXT     physicalDeviceRobustness2Features{};
+    VkPhysicalDeviceSubgroupProperties         physicalDeviceSubgroupProperties{};
+
+    /// Can shader exports be aggregated across waves?
+    bool supportsWaveAggregation{false};
 
     /// All queue families
     std::vector<VkQueueFamilyProperties> queueFamilyProperties;
@@ -110,6 +110,7 @@ struct InstanceDispatchTable {
     PFN_vkGetPhysicalDeviceMemoryProperties      next_vkGetPhysicalDeviceMemoryProperties;
     PFN_vkGetPhysicalDeviceMemoryProperties2KHR  next_vkGetPhysicalDeviceMemoryProperties2KHR;
     PFN_vkGetPhysicalDeviceProperties            next_vkGetPhysicalDeviceProperties;
+    PFN_vkGetPhysicalDeviceProperties2           next_vkGetPhysicalDeviceProperties2;
     PFN_vkGetPhysicalDeviceFeatures2             next_vkGetPhysicalDeviceFeatures2;
     PFN_vkEnumerateDeviceLayerProperties         next_vkEnumerateDeviceLayerProperties;
     PFN_vkEnumerateDeviceExtensionProperties     next_vkEnumerateDeviceExtensionProperties;
@@ -296,6 +296,9 @@ VKAPI_ATTR void VKAPI_CALL Hook_vkCmdBindPipeline(CommandBufferObject *commandBu
     // Get state
     PipelineState *state = commandBuffer->table->states_pipeline.Get(pipeline);
 
+    // Mark as recently bound, prioritizes its instrumentation
+    state->MarkBound(state->table->instrumentationController->GetCommitIndex());
+
     // Attempt to load the hot swapped object
     VkPipeline hotSwapObject = state->hotSwapObject.load();
 
@@ -37,11 +37,26 @@ void SpvPhysicalBlockEntryPoint::Parse() {
         switch (ctx->GetOp()) {
             default:
                 break;
-            case SpvOpEntryPoint:
-                ctx++;
+            case SpvOpEntryPoint: {
+                auto executionModel = static_cast<SpvExecutionModel>(ctx++);
+
+                // Wave aggregation is limited to stages without helper invocations, as the elected lane may be a helper
+                // whose atomics have no effect, see SpvUtilShaderExport::ExportWaveAggregated
+                switch (executionModel) {
+                    default:
+                        program.GetCapabilityTable().hasWaveAggregation = false;
+                        break;
+                    case SpvExecutionModelGLCompute:
+                    case SpvExecutionModelVertex:
+                    case SpvExecutionModelTessellationControl:
+                    case SpvExecutionModelTessellationEvaluation:
+                    case SpvExecutionModelGeometry:
+                        break;
+                }
 
                 program.SetEntryPoint(ctx++);
                 break;
+            }
         }
 
         // Next instruction
@@ -33,17 +33,42 @@
 // Backend
 #include <Backend/IL/Emitter.h>
 #include <Backend/IL/ID.h>
+#include <Backend/IL/InstructionCommon.h>
 
 // Common
 #include <Common/Alloca.h>
 #include <Common/Containers/TrivialStackVector.h>
+#include <Common/Dispatcher/ParallelFor.h>
 
-void SpvPhysicalBlockFunction::Parse() {
+void SpvPhysicalBlockFunction::Parse(Dispatcher* dispatcher) {
     block = table.scan.GetPhysicalBlock(SpvPhysicalBlockType::Function);
 
     // All metadata
     identifierMetadata.resize(table.scan.header.bound);
 
+    // Bodies only associate identifiers within the bound, never grow the shared lookups while parsing them
+    program.GetTypeMap().SetBound(table.scan.header.bound);
+    program.GetIdentifierMap().SetBlockBound(table.scan.header.bound);
+
+    // Access chains into matrices yield their column vectors, create them before any body is parsed
+    std::vector<const Backend::IL::MatrixType*> matrixTypes;
+    for (const Backend::IL::Type* type : program.GetTypeMap()) {
+        if (auto matrixType = type->Cast<Backend::IL::MatrixType>()) {
+            matrixTypes.push_back(matrixType);
+        }
+    }
+
+    // Add column types
+    for (const Backend::IL::MatrixType* matrixType : matrixTypes) {
+        program.GetTypeMap().FindTypeOrAdd(Backend::IL::VectorType {
+            .containedType = matrixType->containedType,
+            .dimension = matrixType->rows
+        });
+    }
+
+    // All function bodies
+    std::vector<FunctionBodyState> bodies;
+
     // Parse instructions
     SpvParseContext ctx(block->source);
     while (ctx) {
@@ -78,17 +103,57 @@ void SpvPhysicalBlockFunction::Parse() {
 
         // Any body?
         if (ctx->GetOp() != SpvOpFunctionEnd) {
-            // Parse the body
-            ParseFunctionBody(function, ctx);
-
-            // Perform post patching
-            PostPatchLoopContinue(function);
+            FunctionBodyState& state = bodies.emplace_back();
+            state.function = function;
+            state.source = block->source;
+            state.source.code = ctx.GetCode();
+
+            // Resolve shared state, the body itself is parsed later
+            ScanFunctionBody(ctx);
+            state.source.end = ctx.GetCode();
         }
 
         // Must be body
         ASSERT(ctx->GetOp() == SpvOpFunctionEnd, "Expected function end");
         ctx.Next();
     }
+
+    // Parse all bodies, shared state is only read from here on
+    ParallelFor(dispatcher, static_cast<uint32_t>(bodies.size()), [&](uint32_t index) {
+        ParseFunctionBody(bodies[index]);
+    });
+
+    // Merge in declaration order
+    for (FunctionBodyState& state : bodies) {
+        for (auto&& [codeOffset, traceback] : state.sourceTraceback) {
+            sourceTraceback[codeOffset] = traceback;
+        }
+
+        for (auto&& [codeOffset, association] : state.sourceAssociations) {
+            table.debugStringSource.sourceMap.AddSourceAssociation(codeOffset, association);
+        }
+
+        // Perform post patching, allocates blocks and identifiers
+        loopContinueBlocks = std::move(state.loopContinueBlocks);
+        PostPatchLoopContinue(state.function);
+    }
+}
+
+void SpvPhysicalBlockFunction::ScanFunctionBody(SpvParseContext &ctx) {
+    while (ctx && ctx->GetOp() != SpvOpFunctionEnd) {
+        // Results of unknown types are assumed unexposed, which adds to the type map
+        if (ctx.HasResult() && ctx.HasResultType() && !table.typeConstantVariable.typeMap.GetTypeFromId(ctx.GetResultType())) {
+            table.typeConstantVariable.AssignTypeAssociation(ctx);
+        }
+
+        // File indices are cached on first use
+        if (ctx->GetOp() == SpvOpLine) {
+            table.debugStringSource.GetFileIndex(ctx++);
+        }
+
+        // Next instruction
+        ctx.Next();
+    }
 }
 
 void SpvPhysicalBlockFunction::ParseFunctionHeader(IL::Function *function, SpvParseContext &ctx) {
@@ -125,7 +190,12 @@ void SpvPhysicalBlockFunction::ParseFunctionHeader(IL::Function *function, SpvPa
     }
 }
 
-void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvParseContext &ctx) {
+void SpvPhysicalBlockFunction::ParseFunctionBody(FunctionBodyState& state) {
+    IL::Function *function = state.function;
+
+    // Body context
+    SpvParseContext ctx(state.source);
+
     // Current basic block
     IL::BasicBlock *basicBlock{nullptr};
 
@@ -141,10 +211,10 @@ void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvPars
 
         // Provide traceback
         if (basicBlock != nullptr) {
-            sourceTraceback[source.codeOffset] = SpvCodeOffsetTraceback {
+            state.sourceTraceback.emplace_back(source.codeOffset, SpvCodeOffsetTraceback {
                 .basicBlockID = basicBlock->GetID(),
                 .instructionIndex = basicBlock->GetCount()
-            };
+            });
         }
 
         // Create type association
@@ -152,7 +222,7 @@ void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvPars
 
         // Create source association
         if (sourceAssociation) {
-            table.debugStringSource.sourceMap.AddSourceAssociation(source.codeOffset, sourceAssociation);
+            state.sourceAssociations.emplace_back(source.codeOffset, sourceAssociation);
         }
 
         // Handle instruction
@@ -495,7 +565,7 @@ void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvPars
                     LoopContinueBlock loopContinueBlock;
                     loopContinueBlock.instruction = ref;
                     loopContinueBlock.block = instr.controlFlow._continue;
-                    loopContinueBlocks.push_back(loopContinueBlock);
+                    state.loopContinueBlocks.push_back(loopContinueBlock);
                 }
                 break;
             }
@@ -535,7 +605,7 @@ void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvPars
                     LoopContinueBlock loopContinueBlock;
                     loopContinueBlock.instruction = ref;
                     loopContinueBlock.block = instr.controlFlow._continue;
-                    loopContinueBlocks.push_back(loopContinueBlock);
+                    state.loopContinueBlocks.push_back(loopContinueBlock);
                 }
                 break;
             }
@@ -850,10 +920,13 @@ void SpvPhysicalBlockFunction::ParseFunctionBody(IL::Function *function, SpvPars
                         }
                         case Backend::IL::TypeKind::Matrix: {
                             const auto* matrixType = elementType->As<Backend::IL::MatrixType>();
-                            elementType = program.GetTypeMap().FindTypeOrAdd(Backend::IL::VectorType {
+
+                            // Created ahead of parsing
+                            elementType = program.GetTypeMap().FindType(Backend::IL::VectorType {
                                 .containedType = matrixType->containedType,
                                 .dimension = matrixType->rows
                             });
+                            ASSERT(elementType, "Matrix column type not found");
                             break;
                         }
                         case Backend::IL::TypeKind::Pointer:{
@@ -951,6 +1024,9 @@ bool SpvPhysicalBlockFunction::CompileFunction(const SpvJob& job, SpvIdMap &idMa
     if (emitDefinition) {
         bool isModifiedScope = false;
 
+        // Function body offset
+        auto bodyOffset = static_cast<uint32_t>(block->stream.GetWordCount());
+
         // Check if any child block is modified
         for (IL::BasicBlock* basicBlock : fn.GetBasicBlocks()) {
             isModifiedScope |= basicBlock->IsModified();
@@ -961,6 +1037,15 @@ bool SpvPhysicalBlockFunction::CompileFunction(const SpvJob& job, SpvIdMap &idMa
                 return false;
             }
         }
+
+        // Successors of split blocks must refer to the last split block
+        if (!splitBlockExits.empty()) {
+            PatchSplitBlockPhis(bodyOffset);
+        }
+
+        // Cleanup
+        splitBlockExits.clear();
+        splitBlocks.clear();
     }
 
     // Emit function close
@@ -1050,6 +1135,12 @@ bool SpvPhysicalBlockFunction::CompileBasicBlock(const SpvJob& job, SpvIdMap &id
     SpvInstruction& label = stream.Allocate(SpvOpLabel, 2);
     label[1] = bb->GetID();
 
+    // Label of the current block, changes if split during compilation
+    IL::ID blockLabel = bb->GetID();
+
+    // Can this block be split?
+    const bool isSplittable = IsSplittable(bb);
+
     // First block?
     if (bb == *fn.GetBasicBlocks().begin()) {
         // Emit all variables, order doesn't matter
@@ -1681,8 +1772,14 @@ bool SpvPhysicalBlockFunction::CompileBasicBlock(const SpvJob& job, SpvIdMap &id
                 for (uint32_t i = 0; i < _export->values.count; i++) {
                     values[i] = idMap.Get(_export->values[i]);
                 }
-                
-                table.shaderExport.Export(stream, _export->exportID, values, _export->values.count);
+
+                // Aggregate across the wave if possible, splits the current block
+                if (program.GetCapabilityTable().hasWaveAggregation && isSplittable) {
+                    table.shaderExport.ExportWaveAggregated(stream, blockLabel, _export->exportID, values, _export->values.count);
+                    splitBlocks.insert(blockLabel);
+                } else {
+                    table.shaderExport.Export(stream, _export->exportID, values, _export->values.count);
+                }
                 break;
             }
             case IL::OpCode::ResourceToken: {
@@ -2032,10 +2129,68 @@ bool SpvPhysicalBlockFunction::CompileBasicBlock(const SpvJob& job, SpvIdMap &id
         }
     }
 
+    // Was the block split?
+    if (blockLabel != bb->GetID()) {
+        splitBlockExits[bb->GetID()] = blockLabel;
+    }
+
     // OK
     return true;
 }
 
+bool SpvPhysicalBlockFunction::IsSplittable(IL::BasicBlock *bb) {
+    IL::BranchControlFlow controlFlow;
+
+    // Loop headers must remain the targets of their back edges
+    if (Backend::IL::GetControlFlow(bb->GetTerminator(), controlFlow) && controlFlow._continue != IL::InvalidID) {
+        return false;
+    }
+
+    // Combined image samplers must be used within the block they were created in
+    for (auto it = bb->begin(); it != bb->end(); it++) {
+        if (it->result != IL::InvalidID && it->result < identifierMetadata.size() && identifierMetadata[it->result].type == IdentifierType::CombinedImageSampler) {
+            return false;
+        }
+    }
+
+    // OK
+    return true;
+}
+
+void SpvPhysicalBlockFunction::PatchSplitBlockPhis(uint32_t offset) {
+    // Label of the current block
+    IL::ID currentLabel = IL::InvalidID;
+
+    // Walk all emitted instructions
+    for (auto end = static_cast<uint32_t>(block->stream.GetWordCount()); offset < end;) {
+        SpvInstruction& instr = block->stream.Get(offset);
+
+        switch (instr.GetOp()) {
+            default:
+                break;
+            case SpvOpLabel:
+                currentLabel = instr[1];
+                break;
+            case SpvOpPhi: {
+                // Phis created by splits already refer to the split blocks
+                if (splitBlocks.count(currentLabel)) {
+                    break;
+                }
+
+                // Redirect all split parents
+                for (uint32_t i = 4; i < instr.GetWordCount(); i += 2) {
+                    if (auto it = splitBlockExits.find(instr[i]); it != splitBlockExits.end()) {
+                        instr[i] = it->second;
+                    }
+                }
+                break;
+            }
+        }
+
+        offset += instr.GetWordCount();
+    }
+}
+
 bool SpvPhysicalBlockFunction::PostPatchLoopContinueInstruction(IL::Instruction *instruction, IL::ID original, IL::ID redirect) {
     switch (instruction->opCode) {
         default:
@@ -26,6 +26,8 @@
 
 #include <Backends/Vulkan/Compiler/ShaderCompiler.h>
 #include <Backends/Vulkan/Compiler/ShaderCompilerDebug.h>
+#include <Backends/Vulkan/Compiler/ShaderCompilerCache.h>
+#include <Backends/Vulkan/Symbolizer/ShaderSGUIDHost.h>
 #include <Backends/Vulkan/Compiler/SpvModule.h>
 #include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
 #include <Backends/Vulkan/Export/ShaderExportDescriptorAllocator.h>
@@ -62,6 +64,9 @@ bool ShaderCompiler::Install() {
     // Optional debug
     debug = registry->Get<ShaderCompilerDebug>();
 
+    // Optional persistent cache
+    cache = registry->Get<ShaderCompilerCache>();
+
     // Get all shader features
     for (const ComRef<IFeature>& feature : table->features) {
         auto shaderFeature = Cast<IShaderFeature>(feature);
@@ -97,11 +102,11 @@ void ShaderCompiler::Add(DeviceDispatchTable *table, const ShaderJob& job, Dispa
 
     job.diagnostic->totalJobs++;
     
-    dispatcher->Add(BindDelegate(this, ShaderCompiler::Worker), data, bucket);
+    dispatcher->Add(BindDelegate(this, ShaderCompiler::Worker), data, bucket, job.priority);
 }
 
 bool ShaderCompiler::InitializeModule(ShaderModuleState *state) {
-    // Initial state parsing is *always* serial
+    // Initial state parsing is *always* serial, function bodies are parsed on the dispatcher
     std::lock_guard guard(state->mutex);
     
     // Create the module on demand
@@ -111,13 +116,17 @@ bool ShaderCompiler::InitializeModule(ShaderModuleState *state) {
         // Parse the module
         bool result = state->spirvModule->ParseModule(
             state->createInfoDeepCopy.createInfo.pCode,
-            static_cast<uint32_t>(state->createInfoDeepCopy.createInfo.codeSize / 4u)
+            static_cast<uint32_t>(state->createInfoDeepCopy.createInfo.codeSize / 4u),
+            dispatcher.GetUnsafe()
         );
 
         // Failed?
         if (!result) {
             return false;
         }
+
+        // The module may only aggregate exports if the device supports it
+        state->spirvModule->GetProgram()->GetCapabilityTable().hasWaveAggregation &= table->supportsWaveAggregation;
     }
 
     // OK
@@ -152,6 +161,22 @@ void ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
     // Diagnostic scope
     DiagnosticBucketScope scope(job.info.diagnostic->messages, job.info.state->uid);
 
+    // Content key of the instrumented module
+    uint64_t cacheKey{0};
+
+    // Try the persistent cache, skips the entire pipeline
+    if (cache) {
+        cacheKey = cache->GetKey(job.info.state, job.info.instrumentationKey);
+
+        // Previously instrumented?
+        VkShaderModule instrument;
+        if (cache->Find(cacheKey, job.info.state, &instrument)) {
+            job.info.state->AddInstrument(job.info.instrumentationKey, instrument);
+            ++job.info.diagnostic->passedJobs;
+            return;
+        }
+    }
+
     // Ensure state is initialized
     if (!InitializeModule(job.info.state)) {
         scope.Add(DiagnosticType::ShaderParsingFailed);
@@ -186,6 +211,11 @@ void ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         shaderDataMap.Add(info);
     }
 
+    // Record all bound sguids for the cache
+    if (cache) {
+        table->sguidHost->BeginRecording(*module->GetProgram());
+    }
+
     // Pass through all features
     for (size_t i = 0; i < shaderFeatures.size(); i++) {
         if (!(job.info.instrumentationKey.featureBitSet & (1ull << i))) {
@@ -196,6 +226,12 @@ void ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         shaderFeatures[i]->Inject(*module->GetProgram(), *job.info.dependentSpecialization);
     }
 
+    // All sguids are bound during injection
+    std::vector<ShaderSGUID> sguids;
+    if (cache) {
+        sguids = table->sguidHost->EndRecording(*module->GetProgram());
+    }
+
     // Spv job
     SpvJob spvJob;
     spvJob.instrumentationKey = job.info.instrumentationKey;
@@ -244,6 +280,11 @@ void ShaderCompiler::CompileShader(const ShaderJobEntry &job) {
         return;
     }
 
+    // Store for later sessions
+    if (cache) {
+        cache->Store(cacheKey, module->GetCode(), module->GetSize(), sguids);
+    }
+
     // Assign the instrument
     job.info.state->AddInstrument(job.info.instrumentationKey, instrument);
 
@@ -0,0 +1,236 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backends/Vulkan/Compiler/ShaderCompilerCache.h>
+#include <Backends/Vulkan/Tables/DeviceDispatchTable.h>
+#include <Backends/Vulkan/States/ShaderModuleState.h>
+#include <Backends/Vulkan/Export/ShaderExportDescriptorAllocator.h>
+#include <Backends/Vulkan/ShaderData/ShaderDataHost.h>
+#include <Backends/Vulkan/Symbolizer/ShaderSGUIDHost.h>
+#include <Backends/Vulkan/Compiler/Spv.h>
+
+// Backend
+#include <Backend/IFeature.h>
+#include <Backend/IShaderExportHost.h>
+
+// Common
+#include <Common/FileSystem.h>
+#include <Common/Registry.h>
+#include <Common/Hash.h>
+
+// Std
+#include <string_view>
+#include <cstring>
+
+/// Cache format and compiler version, must be bumped on any change to the instrumented output
+static constexpr uint32_t kShaderCompilerCacheVersion = 6;
+
+/// Entry header
+struct ShaderCompilerCacheHeader {
+    /// Byte size of the instrumented code
+    uint64_t codeSize{0};
+
+    /// Number of mappings
+    uint32_t mappingCount{0};
+
+    /// Byte size of all source lines
+    uint32_t sourceSize{0};
+};
+
+/// Single entry mapping
+struct ShaderCompilerCacheMapping {
+    /// Bound mapping, shader guids are session local and not stored
+    ShaderSourceMapping mapping;
+
+    /// Source line range
+    uint32_t sourceOffset{0};
+    uint32_t sourceLength{0};
+};
+
+/// Get the byte offset of the mappings
+static uint64_t GetMappingOffset(const ShaderCompilerCacheHeader& header) {
+    return (header.codeSize + alignof(ShaderCompilerCacheMapping) - 1) & ~static_cast<uint64_t>(alignof(ShaderCompilerCacheMapping) - 1);
+}
+
+ShaderCompilerCache::ShaderCompilerCache(DeviceDispatchTable *table) : table(table) {
+
+}
+
+bool ShaderCompilerCache::Install() {
+    size_t hash = kShaderCompilerCacheVersion;
+
+    // Features are identified by their bit index, any change in order or set invalidates
+    for (const ComRef<IFeature>& feature : table->features) {
+        CombineHash(hash, feature ? std::string_view(feature->GetInfo().name) : std::string_view());
+    }
+
+    // Get the export host
+    uint32_t exportCount;
+    registry->Get<IShaderExportHost>()->Enumerate(&exportCount, nullptr);
+    CombineHash(hash, exportCount);
+
+    // Get all shader data
+    uint32_t resourceCount;
+    table->dataHost->Enumerate(&resourceCount, nullptr, ShaderDataType::All);
+    std::vector<ShaderDataInfo> shaderData(resourceCount);
+    table->dataHost->Enumerate(&resourceCount, shaderData.data(), ShaderDataType::All);
+
+    // Shader data is referenced by identifier and type
+    for (const ShaderDataInfo& info : shaderData) {
+        CombineHash(hash, info.id);
+        CombineHash(hash, static_cast<uint32_t>(info.type));
+
+        // Buffer formats affect the instrumented loads and stores
+        if (info.type == ShaderDataType::Buffer) {
+            CombineHash(hash, static_cast<uint32_t>(info.buffer.format));
+        }
+    }
+
+    // Export bindings are embedded in all instrumented modules
+    PipelineLayoutBindingInfo bindingInfo = table->exportDescriptorAllocator->GetBindingInfo();
+    CombineHash(hash, bindingInfo.counterDescriptorOffset);
+    CombineHash(hash, bindingInfo.streamDescriptorOffset);
+    CombineHash(hash, bindingInfo.streamDescriptorCount);
+    CombineHash(hash, bindingInfo.prmtDescriptorOffset);
+    CombineHash(hash, bindingInfo.descriptorDataDescriptorOffset);
+    CombineHash(hash, bindingInfo.descriptorDataDescriptorLength);
+    CombineHash(hash, bindingInfo.shaderDataConstantsDescriptorOffset);
+    CombineHash(hash, bindingInfo.shaderDataDescriptorOffset);
+    CombineHash(hash, bindingInfo.shaderDataDescriptorCount);
+
+    // Device capabilities may affect instrumentation, keep entries per device and driver
+    CombineHash(hash, table->physicalDeviceProperties.vendorID);
+    CombineHash(hash, table->physicalDeviceProperties.deviceID);
+    CombineHash(hash, table->physicalDeviceProperties.driverVersion);
+    CombineHash(hash, table->supportsWaveAggregation);
+    environmentHash = hash;
+
+    // Open the storage
+    return diskCache.Install(GetIntermediateCachePath() / "Vulkan", SHADER_COMPILER_CACHE_BUDGET);
+}
+
+uint64_t ShaderCompilerCache::GetKey(ShaderModuleState *state, const ShaderModuleInstrumentationKey &key) {
+    size_t hash = environmentHash;
+
+    // Source code
+    CombineHash(hash, std::string_view(
+        reinterpret_cast<const char*>(state->createInfoDeepCopy.createInfo.pCode),
+        state->createInfoDeepCopy.createInfo.codeSize
+    ));
+
+    // Instrumentation, the combined hash includes the specialization and layout
+    CombineHash(hash, key.featureBitSet);
+    CombineHash(hash, key.combinedHash);
+    return hash;
+}
+
+bool ShaderCompilerCache::Find(uint64_t key, ShaderModuleState *state, VkShaderModule *out) {
+    DiskCacheEntry entry;
+    if (!diskCache.Find(key, entry)) {
+        return false;
+    }
+
+    // Validate header
+    auto header = reinterpret_cast<const ShaderCompilerCacheHeader*>(entry.GetData());
+    if (entry.GetSize() < sizeof(ShaderCompilerCacheHeader) ||
+        entry.GetSize() != sizeof(ShaderCompilerCacheHeader) + GetMappingOffset(*header) + header->mappingCount * sizeof(ShaderCompilerCacheMapping) + header->sourceSize) {
+        return false;
+    }
+
+    // Get sections
+    auto code = reinterpret_cast<const uint32_t*>(header + 1);
+    auto mappings = reinterpret_cast<const ShaderCompilerCacheMapping*>(reinterpret_cast<const uint8_t*>(code) + GetMappingOffset(*header));
+    auto sources = reinterpret_cast<const char*>(mappings + header->mappingCount);
+
+    // Unpack mappings
+    std::vector<ShaderSourceMapping> sourceMappings(header->mappingCount);
+    std::vector<std::string_view> sourceViews(header->mappingCount);
+    for (uint32_t i = 0; i < header->mappingCount; i++) {
+        if (mappings[i].sourceOffset + mappings[i].sourceLength > header->sourceSize) {
+            return false;
+        }
+
+        sourceMappings[i] = mappings[i].mapping;
+        sourceViews[i] = std::string_view(sources + mappings[i].sourceOffset, mappings[i].sourceLength);
+    }
+
+    // Restore all sguids, the instrumented code references them directly
+    if (!table->sguidHost->Restore(state->uid, sourceMappings.data(), sourceViews.data(), header->mappingCount)) {
+        return false;
+    }
+
+    // Create from the mapped code, retains the user extensions
+    VkShaderModuleCreateInfo createInfo = state->createInfoDeepCopy.createInfo;
+    createInfo.pCode = code;
+    createInfo.codeSize = header->codeSize;
+
+    // Naive validation
+    if (createInfo.codeSize < sizeof(uint32_t) || *createInfo.pCode != SpvMagicNumber) {
+        return false;
+    }
+
+    // Attempt to create the module
+    return table->next_vkCreateShaderModule(table->object, &createInfo, nullptr, out) == VK_SUCCESS;
+}
+
+void ShaderCompilerCache::Store(uint64_t key, const uint32_t *code, uint64_t size, const std::vector<ShaderSGUID> &sguids) {
+    std::vector<ShaderCompilerCacheMapping> mappings(sguids.size());
+    std::string sources;
+
+    // Get all mappings and their source lines
+    for (size_t i = 0; i < sguids.size(); i++) {
+        ShaderSourceMapping mapping = table->sguidHost->GetMapping(sguids[i]);
+        std::string_view source = table->sguidHost->GetSource(mapping);
+
+        // Assign mapping, session local guids are assigned on restore
+        mappings[i].mapping = mapping;
+        mappings[i].mapping.shaderGUID = 0;
+        mappings[i].sourceOffset = static_cast<uint32_t>(sources.length());
+        mappings[i].sourceLength = static_cast<uint32_t>(source.length());
+        sources.append(source);
+    }
+
+    // Setup header
+    ShaderCompilerCacheHeader header;
+    header.codeSize = size;
+    header.mappingCount = static_cast<uint32_t>(mappings.size());
+    header.sourceSize = static_cast<uint32_t>(sources.length());
+
+    // Linearize the entry, mappings are aligned after the code
+    std::vector<uint8_t> data(sizeof(header) + GetMappingOffset(header) + mappings.size() * sizeof(ShaderCompilerCacheMapping) + sources.length());
+    uint8_t* ptr = data.data();
+    std::memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+    std::memcpy(ptr, code, size);
+    ptr += GetMappingOffset(header);
+    std::memcpy(ptr, mappings.data(), mappings.size() * sizeof(ShaderCompilerCacheMapping));
+    ptr += mappings.size() * sizeof(ShaderCompilerCacheMapping);
+    std::memcpy(ptr, sources.data(), sources.length());
+
+    // Failure only affects the next session
+    diskCache.Store(key, data.data(), data.size());
+}
@@ -61,7 +61,7 @@ SpvModule *SpvModule::Copy() const {
     return module;
 }
 
-bool SpvModule::ParseModule(const uint32_t *code, uint32_t wordCount) {
+bool SpvModule::ParseModule(const uint32_t *code, uint32_t wordCount, Dispatcher* dispatcher) {
     // Create new program
     program = new(allocators) IL::Program(allocators, shaderGUID);
 
@@ -69,11 +69,14 @@ bool SpvModule::ParseModule(const uint32_t *code, uint32_t wordCount) {
     IL::CapabilityTable& caps = program->GetCapabilityTable();
     caps.hasControlFlow = true;
 
+    // Exports may be aggregated, narrowed by the entry points and device
+    caps.hasWaveAggregation = true;
+
     // Create physical block table
     physicalBlockTable = new(allocators) SpvPhysicalBlockTable(allocators, *program);
 
     // Attempt to parse the block table
-    if (!physicalBlockTable->Parse(code, wordCount)) {
+    if (!physicalBlockTable->Parse(code, wordCount, dispatcher)) {
         return false;
     }
 
@@ -82,24 +85,47 @@ bool SpvModule::ParseModule(const uint32_t *code, uint32_t wordCount) {
 }
 
 bool SpvModule::Recompile(const uint32_t *code, uint32_t wordCount, const SpvJob& job) {
-    for (IL::Function* fn : program->GetFunctionList()) {
-        if (!fn->ReorderByDominantBlocks(true)) {
-            return false;
-        }
+    // Prepare the functions
+    if (!ReorderForCompilation()) {
+        return false;
     }
 
     // Try to recompile for the given job
-    if (!physicalBlockTable->Compile(job)) {
+    if (!CompilePhysicalBlocks(job)) {
         return false;
     }
 
     // Stitch to the program
-    physicalBlockTable->Stitch(spirvProgram);
+    Stitch();
 
     // OK!
     return true;
 }
 
+bool SpvModule::ReorderForCompilation() {
+    for (IL::Function* fn : program->GetFunctionList()) {
+        if (!fn->ReorderByDominantBlocks(true)) {
+            return false;
+        }
+
+        // Compile against linear instruction streams
+        for (IL::BasicBlock* basicBlock : fn->GetBasicBlocks()) {
+            basicBlock->Flatten();
+        }
+    }
+
+    // OK
+    return true;
+}
+
+bool SpvModule::CompilePhysicalBlocks(const SpvJob &job) {
+    return physicalBlockTable->Compile(job);
+}
+
+void SpvModule::Stitch() {
+    physicalBlockTable->Stitch(spirvProgram);
+}
+
 SpvCodeOffsetTraceback SpvModule::GetCodeOffsetTraceback(uint32_t codeOffset) {
     return physicalBlockTable->function.GetCodeOffsetTraceback(codeOffset);
 }
@@ -42,7 +42,7 @@ SpvPhysicalBlockTable::SpvPhysicalBlockTable(const Allocators &allocators, IL::P
     /* */
 }
 
-bool SpvPhysicalBlockTable::Parse(const uint32_t *code, uint32_t count) {
+bool SpvPhysicalBlockTable::Parse(const uint32_t *code, uint32_t count, Dispatcher* dispatcher) {
     // Attempt to scan the blocks
     if (!scan.Scan(code, count)) {
         return false;
@@ -54,7 +54,7 @@ bool SpvPhysicalBlockTable::Parse(const uint32_t *code, uint32_t count) {
     annotation.Parse();
     debugStringSource.Parse();
     typeConstantVariable.Parse();
-    function.Parse();
+    function.Parse(dispatcher);
 
     // OK
     return true;
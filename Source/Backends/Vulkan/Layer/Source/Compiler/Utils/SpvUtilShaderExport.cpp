@@ -198,6 +198,247 @@ void SpvUtilShaderExport::Export(SpvStream &stream, uint32_t exportID, const IL:
     atom[5] = memSemanticId;
     atom[6] = offsetAdditionId;
 
+    // Write all values
+    WriteValues(stream, streamOffsetId, atomicPositionId, values, valueCount);
+}
+
+void SpvUtilShaderExport::ExportWaveAggregated(SpvStream &stream, IL::ID& blockLabel, uint32_t exportID, const IL::ID *values, uint32_t valueCount) {
+    Backend::IL::TypeMap &ilTypeMap = program.GetTypeMap();
+
+    // Group operations require SPIR-V 1.3
+    table.scan.header.version = std::max(table.scan.header.version, 0x00010300u);
+
+    // Subgroup capabilities
+    table.capability.Add(SpvCapabilityGroupNonUniform);
+    table.capability.Add(SpvCapabilityGroupNonUniformBallot);
+
+    // Identifiable header
+    stream.Allocate(SpvOpNop, 1);
+
+    // Bool
+    const Backend::IL::Type *boolType = ilTypeMap.FindTypeOrAdd(Backend::IL::BoolType{});
+
+    // UInt32
+    const Backend::IL::Type *uintType = ilTypeMap.FindTypeOrAdd(Backend::IL::IntType{
+        .bitWidth = 32,
+        .signedness = false
+    });
+
+    // UInt32x4
+    const Backend::IL::Type *uint4Type = ilTypeMap.FindTypeOrAdd(Backend::IL::VectorType{
+        .containedType = uintType,
+        .dimension = 4
+    });
+
+    // Uint32*
+    const Backend::IL::Type *uintImagePtrType = ilTypeMap.FindTypeOrAdd(Backend::IL::PointerType{
+        .pointee = uintType,
+        .addressSpace = Backend::IL::AddressSpace::Texture
+    });
+
+    // Spv types
+    SpvId boolTypeId = table.typeConstantVariable.typeMap.GetSpvTypeId(boolType);
+    SpvId uintTypeId = table.typeConstantVariable.typeMap.GetSpvTypeId(uintType);
+    SpvId uint4TypeId = table.typeConstantVariable.typeMap.GetSpvTypeId(uint4Type);
+
+    // Constant identifiers
+    uint32_t trueId = table.scan.header.bound++;
+    uint32_t zeroUintId = table.scan.header.bound++;
+    uint32_t streamOffsetId = table.scan.header.bound++;
+    uint32_t deviceScopeId = table.scan.header.bound++;
+    uint32_t subgroupScopeId = table.scan.header.bound++;
+    uint32_t memSemanticId = table.scan.header.bound++;
+    uint32_t valueCountId = table.scan.header.bound++;
+
+    // True
+    SpvInstruction &spvTrue = table.typeConstantVariable.block->stream.Allocate(SpvOpConstantTrue, 3);
+    spvTrue[1] = boolTypeId;
+    spvTrue[2] = trueId;
+
+    // 0
+    SpvInstruction &spvZero = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvZero[1] = uintTypeId;
+    spvZero[2] = zeroUintId;
+    spvZero[3] = 0;
+
+    // Index of the stream
+    SpvInstruction &spvOffset = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvOffset[1] = uintTypeId;
+    spvOffset[2] = streamOffsetId;
+    spvOffset[3] = exportID;
+
+    // Device scope
+    SpvInstruction &spvDeviceScope = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvDeviceScope[1] = uintTypeId;
+    spvDeviceScope[2] = deviceScopeId;
+    spvDeviceScope[3] = SpvScopeDevice;
+
+    // Subgroup scope
+    SpvInstruction &spvSubgroupScope = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvSubgroupScope[1] = uintTypeId;
+    spvSubgroupScope[2] = subgroupScopeId;
+    spvSubgroupScope[3] = SpvScopeSubgroup;
+
+    // No memory mask
+    SpvInstruction &spvMemSem = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvMemSem[1] = uintTypeId;
+    spvMemSem[2] = memSemanticId;
+    spvMemSem[3] = SpvMemorySemanticsMaskNone;
+
+    // Dwords per lane
+    SpvInstruction &spvSize = table.typeConstantVariable.block->stream.Allocate(SpvOpConstant, 4);
+    spvSize[1] = uintTypeId;
+    spvSize[2] = valueCountId;
+    spvSize[3] = valueCount;
+
+    // Block identifiers
+    uint32_t leaderLabelId = table.scan.header.bound++;
+    uint32_t mergeLabelId = table.scan.header.bound++;
+
+    uint32_t ballotId = table.scan.header.bound++;
+
+    // Mask of all active lanes
+    SpvInstruction &ballot = stream.Allocate(SpvOpGroupNonUniformBallot, 5);
+    ballot[1] = uint4TypeId;
+    ballot[2] = ballotId;
+    ballot[3] = subgroupScopeId;
+    ballot[4] = trueId;
+
+    uint32_t activeCountId = table.scan.header.bound++;
+
+    // Number of active lanes
+    SpvInstruction &activeCount = stream.Allocate(SpvOpGroupNonUniformBallotBitCount, 6);
+    activeCount[1] = uintTypeId;
+    activeCount[2] = activeCountId;
+    activeCount[3] = subgroupScopeId;
+    activeCount[4] = SpvGroupOperationReduce;
+    activeCount[5] = ballotId;
+
+    uint32_t lanePrefixId = table.scan.header.bound++;
+
+    // Number of active lanes preceding this lane
+    SpvInstruction &lanePrefix = stream.Allocate(SpvOpGroupNonUniformBallotBitCount, 6);
+    lanePrefix[1] = uintTypeId;
+    lanePrefix[2] = lanePrefixId;
+    lanePrefix[3] = subgroupScopeId;
+    lanePrefix[4] = SpvGroupOperationExclusiveScan;
+    lanePrefix[5] = ballotId;
+
+    uint32_t reservationId = table.scan.header.bound++;
+
+    // Total number of dwords for the wave
+    SpvInstruction &reservation = stream.Allocate(SpvOpIMul, 5);
+    reservation[1] = uintTypeId;
+    reservation[2] = reservationId;
+    reservation[3] = activeCountId;
+    reservation[4] = valueCountId;
+
+    uint32_t electId = table.scan.header.bound++;
+
+    // Elect the lowest active lane as the leader
+    SpvInstruction &elect = stream.Allocate(SpvOpGroupNonUniformElect, 4);
+    elect[1] = boolTypeId;
+    elect[2] = electId;
+    elect[3] = subgroupScopeId;
+
+    // Only the leader reserves
+    SpvInstruction &selection = stream.Allocate(SpvOpSelectionMerge, 3);
+    selection[1] = mergeLabelId;
+    selection[2] = SpvSelectionControlMaskNone;
+
+    // Branch to the leader block
+    SpvInstruction &branchLeader = stream.Allocate(SpvOpBranchConditional, 4);
+    branchLeader[1] = electId;
+    branchLeader[2] = leaderLabelId;
+    branchLeader[3] = mergeLabelId;
+
+    // Leader block
+    SpvInstruction &leaderLabel = stream.Allocate(SpvOpLabel, 2);
+    leaderLabel[1] = leaderLabelId;
+
+    uint32_t texelPtrId = table.scan.header.bound++;
+
+    // Get the address of the texel to be atomically incremented
+    SpvInstruction &texelPtr = stream.Allocate(SpvOpImageTexelPointer, 6);
+    texelPtr[1] = table.typeConstantVariable.typeMap.GetSpvTypeId(uintImagePtrType);
+    texelPtr[2] = texelPtrId;
+    texelPtr[3] = counterId;
+    texelPtr[4] = streamOffsetId;
+    texelPtr[5] = zeroUintId;
+
+    uint32_t leaderPositionId = table.scan.header.bound++;
+
+    // Atomically reserve for all active lanes
+    SpvInstruction &atom = stream.Allocate(SpvOpAtomicIAdd, 7);
+    atom[1] = uintTypeId;
+    atom[2] = leaderPositionId;
+    atom[3] = texelPtrId;
+    atom[4] = deviceScopeId;
+    atom[5] = memSemanticId;
+    atom[6] = reservationId;
+
+    // Rejoin
+    SpvInstruction &branchMerge = stream.Allocate(SpvOpBranch, 2);
+    branchMerge[1] = mergeLabelId;
+
+    // Merge block
+    SpvInstruction &mergeLabel = stream.Allocate(SpvOpLabel, 2);
+    mergeLabel[1] = mergeLabelId;
+
+    uint32_t phiPositionId = table.scan.header.bound++;
+
+    // Leader position, zero for all other lanes
+    SpvInstruction &phi = stream.Allocate(SpvOpPhi, 7);
+    phi[1] = uintTypeId;
+    phi[2] = phiPositionId;
+    phi[3] = leaderPositionId;
+    phi[4] = leaderLabelId;
+    phi[5] = zeroUintId;
+    phi[6] = blockLabel;
+
+    uint32_t wavePositionId = table.scan.header.bound++;
+
+    // Read the leader position, the leader is the lowest active lane
+    SpvInstruction &broadcast = stream.Allocate(SpvOpGroupNonUniformBroadcastFirst, 5);
+    broadcast[1] = uintTypeId;
+    broadcast[2] = wavePositionId;
+    broadcast[3] = subgroupScopeId;
+    broadcast[4] = phiPositionId;
+
+    uint32_t laneOffsetId = table.scan.header.bound++;
+
+    // Lane relative offset
+    SpvInstruction &laneOffset = stream.Allocate(SpvOpIMul, 5);
+    laneOffset[1] = uintTypeId;
+    laneOffset[2] = laneOffsetId;
+    laneOffset[3] = lanePrefixId;
+    laneOffset[4] = valueCountId;
+
+    uint32_t atomicPositionId = table.scan.header.bound++;
+
+    // Wave position + lane offset
+    SpvInstruction &position = stream.Allocate(SpvOpIAdd, 5);
+    position[1] = uintTypeId;
+    position[2] = atomicPositionId;
+    position[3] = wavePositionId;
+    position[4] = laneOffsetId;
+
+    // Write all values
+    WriteValues(stream, streamOffsetId, atomicPositionId, values, valueCount);
+
+    // Instructions after the export now belong to the merge block
+    blockLabel = mergeLabelId;
+}
+
+void SpvUtilShaderExport::WriteValues(SpvStream &stream, uint32_t streamOffsetId, uint32_t atomicPositionId, const IL::ID *values, uint32_t valueCount) {
+    Backend::IL::TypeMap &ilTypeMap = program.GetTypeMap();
+
+    // UInt32
+    const Backend::IL::Type *uintType = ilTypeMap.FindTypeOrAdd(Backend::IL::IntType{
+        .bitWidth = 32,
+        .signedness = false
+    });
+
     uint32_t accessId = table.scan.header.bound++;
 
     // Get the destination stream
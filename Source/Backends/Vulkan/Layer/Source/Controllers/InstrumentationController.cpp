@@ -51,6 +51,7 @@
 // Common
 #include <Common/Registry.h>
 #include <Common/Dispatcher/TaskGroup.h>
+#include <Common/Dispatcher/TaskGraph.h>
 #include <Common/Hash.h>
 
 // Schemas
@@ -61,6 +62,11 @@
 
 // Std
 #include <sstream>
+#include <map>
+#include <tuple>
+
+/// Number of commits after which a bound pipeline is no longer considered recent
+static constexpr uint64_t kRecentBindCommitWindow = 256;
 
 InstrumentationController::InstrumentationController(DeviceDispatchTable *table) : table(table) {
 
@@ -97,7 +103,11 @@ uint32_t InstrumentationController::GetJobCount() {
         case InstrumentationStage::Shaders:
             return static_cast<uint32_t>(compilationBatch->shaderCompilerDiagnostic.GetRemainingJobs());
         case InstrumentationStage::Pipelines:
-            return static_cast<uint32_t>(compilationBatch->pipelineCompilerDiagnostic.GetRemainingJobs());
+            // Shaders of other pipelines may still be compiling
+            return static_cast<uint32_t>(
+                compilationBatch->shaderCompilerDiagnostic.GetRemainingJobs() +
+                compilationBatch->pipelineCompilerDiagnostic.GetRemainingJobs()
+            );
     }
 }
 
@@ -186,7 +196,7 @@ void InstrumentationController::PropagateInstrumentationInfo(PipelineState *stat
 
     // Compute hash
     state->instrumentationInfo.specializationHash = BufferCRC32Short(
-        state->instrumentationInfo.specialization.GetDataBegin(),
+        state->instrumentationInfo.specialization.Linearize(),
         state->instrumentationInfo.specialization.GetByteSize()
     );
 
@@ -228,7 +238,7 @@ void InstrumentationController::PropagateInstrumentationInfo(ShaderModuleState *
 
     // Compute hash
     state->instrumentationInfo.specializationHash = BufferCRC32Short(
-        state->instrumentationInfo.specialization.GetDataBegin(),
+        state->instrumentationInfo.specialization.Linearize(),
         state->instrumentationInfo.specialization.GetByteSize()
     );
 }
@@ -248,6 +258,23 @@ bool InstrumentationController::FilterPipeline(PipelineState *state, const Filte
     return true;
 }
 
+DispatcherJobPriority InstrumentationController::GetPipelinePriority(const PipelineState *state) const {
+    uint64_t lastBindCommitIndex = state->lastBindCommitIndex.load(std::memory_order_relaxed);
+
+    // Never bound? Cold pipelines make up the bulk of load time floods, let hot pipelines go first
+    if (!lastBindCommitIndex) {
+        return DispatcherJobPriority::Background;
+    }
+
+    // Not bound in a while? Nothing is waiting on it
+    if (GetCommitIndex() - lastBindCommitIndex > kRecentBindCommitWindow) {
+        return DispatcherJobPriority::Background;
+    }
+
+    // Recently bound, if recording is synchronous the next bind will stall on it
+    return synchronousRecording ? DispatcherJobPriority::Blocking : DispatcherJobPriority::Interactive;
+}
+
 void InstrumentationController::Handle(const MessageStream *streams, uint32_t count) {
     std::lock_guard guard(mutex);
     
@@ -689,11 +716,8 @@ void InstrumentationController::CommitInstrumentation() {
     // Task group
     // TODO: Tie lifetime of this task group to the controller
     TaskGroup group(dispatcher.GetUnsafe());
-    if (!batch->dirtyShaderModules.empty()) {
-        group.Chain(BindDelegate(this, InstrumentationController::CommitShaders), batch);
-    }
-    if (!batch->dirtyPipelines.empty()) {
-        group.Chain(BindDelegate(this, InstrumentationController::CommitPipelines), batch);
+    if (!batch->dirtyShaderModules.empty() || !batch->dirtyPipelines.empty()) {
+        group.Chain(BindDelegate(this, InstrumentationController::CommitGraph), batch);
     }
     group.Chain(BindDelegate(this, InstrumentationController::CommitTable), batch);
 
@@ -718,6 +742,9 @@ void InstrumentationController::CommitInstrumentation() {
 void InstrumentationController::Commit() {
     uint32_t count = GetJobCount();
 
+    // Advance commit index, bound pipelines are tagged with it
+    commitIndex.fetch_add(1, std::memory_order_relaxed);
+
     // Serial
     std::lock_guard guard(mutex);
 
@@ -729,9 +756,13 @@ void InstrumentationController::Commit() {
 
         // Set batch stage information
         if (compilationBatch) {
-            message->stage = static_cast<uint32_t>(compilationBatch->stage.load());
-            message->graphicsJobs = compilationBatch->stageCounters[static_cast<uint32_t>(PipelineType::Graphics)].load();
-            message->computeJobs = compilationBatch->stageCounters[static_cast<uint32_t>(PipelineType::Compute)].load();
+            InstrumentationStage stage = compilationBatch->stage.load();
+
+            // Report the counters of the current stage only
+            const RelaxedAtomic<uint32_t>* counters = stage == InstrumentationStage::Pipelines ? compilationBatch->pipelineStageCounters : compilationBatch->stageCounters;
+            message->stage = static_cast<uint32_t>(stage);
+            message->graphicsJobs = counters[static_cast<uint32_t>(PipelineType::Graphics)].load();
+            message->computeJobs = counters[static_cast<uint32_t>(PipelineType::Compute)].load();
         } else {
             message->stage = 0;
             message->graphicsJobs = 0;
@@ -751,18 +782,65 @@ void InstrumentationController::Commit() {
     CommitInstrumentation();
 }
 
-void InstrumentationController::CommitShaders(DispatcherBucket* bucket, void *data) {
+void InstrumentationController::CommitGraph(DispatcherBucket* bucket, void *data) {
     auto* batch = static_cast<Batch*>(data);
     batch->stampBeginShaders = std::chrono::high_resolution_clock::now();
+    batch->stampBeginPipelines = batch->stampBeginShaders;
 
     // Configure
     batch->stage = InstrumentationStage::Shaders;
     batch->shaderCompilerDiagnostic.messages = &batch->messages;
+    batch->pipelineCompilerDiagnostic.messages = &batch->messages;
 
     // Reset counters
     std::fill_n(batch->stageCounters, static_cast<uint32_t>(PipelineType::Count), 0u);
+    std::fill_n(batch->pipelineStageCounters, static_cast<uint32_t>(PipelineType::Count), 0u);
+
+    // Pipelines are batched per priority, and each wave only depends on the shader jobs it
+    // consumes, so hot pipelines start compiling as soon as their own shaders are done
+    TaskGraph graph(dispatcher.GetUnsafe());
+
+    // One entry per dirty pipeline
+    batch->commitEntries.resize(batch->dirtyPipelines.size());
+
+    // Assign all pipelines to their waves
+    for (size_t dirtyIndex = 0; dirtyIndex < batch->dirtyPipelines.size(); dirtyIndex++) {
+        Batch::CommitEntry& entry = batch->commitEntries[dirtyIndex];
+        entry.batch = batch;
+        entry.state = batch->dirtyPipelines[dirtyIndex];
+
+        // Add to wave
+        batch->pipelineWaves[static_cast<uint32_t>(GetPipelinePriority(entry.state))].entries.push_back(&entry);
+    }
+
+    // Create all wave nodes
+    std::unordered_map<PipelineState*, TaskGraphNode*> pipelineNodes;
+    for (uint32_t priority = 0; priority < static_cast<uint32_t>(DispatcherJobPriority::Count); priority++) {
+        Batch::PipelineWave& wave = batch->pipelineWaves[priority];
+        wave.batch = batch;
+        wave.priority = static_cast<DispatcherJobPriority>(priority);
 
-    // Submit compiler jobs
+        // Nothing to compile?
+        if (wave.entries.empty()) {
+            continue;
+        }
+
+        // Create node
+        TaskGraphNode* node = graph.Add(BindDelegate(this, InstrumentationController::CommitPipelines), &wave, wave.priority);
+
+        // Map all pipelines
+        for (Batch::CommitEntry* entry : wave.entries) {
+            pipelineNodes[entry->state] = node;
+        }
+    }
+
+    // All dependencies between shader and wave nodes, waves consume many shaders
+    std::set<std::pair<TaskGraphNode*, TaskGraphNode*>> dependencies;
+
+    // All shader nodes created in this batch, keyed by the shader and instrumentation key
+    std::map<std::tuple<ShaderModuleState*, uint64_t, uint64_t>, TaskGraphNode*> shaderNodes;
+
+    // Create all shader nodes
     for (ShaderModuleState* state : batch->dirtyShaderModules) {
         uint64_t shaderFeatureBitSet = state->instrumentationInfo.featureBitSet;
 
@@ -805,59 +883,80 @@ void InstrumentationController::CommitShaders(DispatcherBucket* bucket, void *da
 #endif // PRMT_METHOD == PRMT_METHOD_UB_PC
             CombineHash(instrumentationKey.combinedHash, instrumentationKey.physicalMapping->layoutHash);
 
-            // Attempt to reserve
-            if (!state->Reserve(instrumentationKey)) {
-                continue;
-            }
+            // Already created in this batch?
+            TaskGraphNode*& shaderNode = shaderNodes[std::make_tuple(state, instrumentationKey.featureBitSet, instrumentationKey.combinedHash)];
+            if (!shaderNode) {
+                // Attempt to reserve, if already reserved it was compiled by a previous batch
+                if (!state->Reserve(instrumentationKey)) {
+                    continue;
+                }
 
-            // Increment counter
-            batch->stageCounters[static_cast<uint32_t>(dependentObject->type)]++;
+                // Increment counter
+                batch->stageCounters[static_cast<uint32_t>(dependentObject->type)]++;
 
-            // Determine the shader module index within the dependent object
-            uint64_t dependentIndex = std::ranges::find(dependentObject->shaderModules, state) - dependentObject->shaderModules.begin();
+                // Determine the shader module index within the dependent object
+                uint64_t dependentIndex = std::ranges::find(dependentObject->shaderModules, state) - dependentObject->shaderModules.begin();
 
-            // Inject the feedback state
-            shaderCompiler->Add(table, ShaderJob {
-                .state = state,
-                .instrumentationKey = instrumentationKey,
-                .diagnostic = &batch->shaderCompilerDiagnostic,
-                .dependentSpecialization = &dependentObject->dependentInstrumentationInfo.specializations[dependentIndex]
-            }, bucket);
+                // Create the job, released by the node
+                auto job = new (registry->GetAllocators()) ShaderJob {
+                    .state = state,
+                    .instrumentationKey = instrumentationKey,
+                    .diagnostic = &batch->shaderCompilerDiagnostic,
+                    .dependentSpecialization = &dependentObject->dependentInstrumentationInfo.specializations[dependentIndex],
+                    .priority = GetPipelinePriority(dependentObject)
+                };
+
+                // Create node
+                shaderNode = graph.Add(BindDelegate(this, InstrumentationController::CommitShader), job, job->priority);
+            }
+
+            // The dependent wave waits on this shader
+            if (auto it = pipelineNodes.find(dependentObject); it != pipelineNodes.end() && dependencies.emplace(shaderNode, it->second).second) {
+                graph.AddDependency(shaderNode, it->second);
+            }
         }
     }
+
+    // Start the graph, the bucket is kept alive until all nodes have completed
+    graph.Commit(bucket);
 }
 
-void InstrumentationController::CommitPipelines(DispatcherBucket* bucket, void *data) {
-    auto* batch = static_cast<Batch*>(data);
-    batch->stampBeginPipelines = std::chrono::high_resolution_clock::now();
+void InstrumentationController::CommitShader(DispatcherBucket* bucket, void *data) {
+    auto* job = static_cast<ShaderJob*>(data);
 
-    // Set configure
-    batch->stage = InstrumentationStage::Pipelines;
-    batch->pipelineCompilerDiagnostic.messages = &batch->messages;
+    // Submit the job, node completes with the compilation
+    shaderCompiler->Add(table, *job, bucket);
 
-    // Reset counters
-    std::fill_n(batch->stageCounters, static_cast<uint32_t>(PipelineType::Count), 0u);
+    // Release the job
+    destroy(job, registry->GetAllocators());
+}
 
-    // Collection of keys which failed
-    std::vector<std::pair<ShaderModuleState*, ShaderModuleInstrumentationKey>> rejectedKeys;
+void InstrumentationController::CommitPipelines(DispatcherBucket* bucket, void *data) {
+    auto* wave = static_cast<Batch::PipelineWave*>(data);
+    Batch* batch = wave->batch;
 
-    // Allocate batch
-    auto jobs = new (registry->GetAllocators()) PipelineJob[batch->dirtyPipelines.size()];
+    // First wave of the batch?
+    if (batch->stage.exchange(InstrumentationStage::Pipelines) != InstrumentationStage::Pipelines) {
+        batch->stampBeginPipelines = std::chrono::high_resolution_clock::now();
+    }
 
-    // Enqueued jobs
-    uint32_t enqueuedJobs{0};
+    // All jobs of this wave
+    std::vector<PipelineJob> jobs;
+    jobs.reserve(wave->entries.size());
 
-    // Submit compiler jobs
-    for (size_t dirtyIndex = 0; dirtyIndex < batch->dirtyPipelines.size(); dirtyIndex++) {
-        PipelineState *state = batch->dirtyPipelines[dirtyIndex];
+    // Create all jobs
+    for (Batch::CommitEntry* entry : wave->entries) {
+        // Get state
+        PipelineState *state = entry->state;
 
         // Was this job skipped?
         bool isSkipped = false;
 
         // Setup the job
-        PipelineJob& job = jobs[enqueuedJobs];
+        PipelineJob job;
         job.state = state;
         job.combinedHash = 0x0;
+        job.priority = wave->priority;
 
         // Allocate feature bit sets
         job.shaderModuleInstrumentationKeys = new (registry->GetAllocators()) ShaderModuleInstrumentationKey[state->shaderModules.size()];
@@ -915,10 +1014,10 @@ void InstrumentationController::CommitPipelines(DispatcherBucket* bucket, void *
 
             // Combine parent hash
             CombineHash(job.combinedHash, instrumentationKey.combinedHash);
-            
+        
             // Shader may have failed to compile for whatever reason, skip if need be
             if (!shaderState->HasInstrument(instrumentationKey)) {
-                rejectedKeys.push_back(std::make_pair(shaderState, instrumentationKey));
+                wave->rejectedKeys.push_back(std::make_pair(shaderState, instrumentationKey));
                 isSkipped = true;
             }
         }
@@ -937,29 +1036,46 @@ void InstrumentationController::CommitPipelines(DispatcherBucket* bucket, void *
         }
 
         // Increment counter
-        batch->stageCounters[static_cast<uint32_t>(state->type)]++;
+        batch->pipelineStageCounters[static_cast<uint32_t>(state->type)]++;
 
-        // Append commit entry
-        batch->commitEntries.push_back(Batch::CommitEntry {
-            .state = state,
-            .combinedHash = job.combinedHash,
-        });
+        // Mark for commit
+        entry->combinedHash = job.combinedHash;
+        entry->enqueued = true;
 
-        // Next job
-        enqueuedJobs++;
+        // Add to wave
+        jobs.push_back(job);
     }
 
-    // Submit all jobs
-    pipelineCompiler->AddBatch(table, &batch->pipelineCompilerDiagnostic, jobs, enqueuedJobs, bucket);
+    // Nothing to compile?
+    if (jobs.empty()) {
+        return;
+    }
+
+    // Submit as a single batch, split by type and priority, node completes with the compilation
+    pipelineCompiler->AddBatch(table, &batch->pipelineCompilerDiagnostic, jobs.data(), static_cast<uint32_t>(jobs.size()), bucket);
+}
+
+void InstrumentationController::CommitTable(DispatcherBucket* bucket, void *data) {
+    auto* batch = static_cast<Batch*>(data);
+
+    // Determine time difference
+    auto msTotal = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -  batch->stampBegin).count());
+    auto msPipelines = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -  batch->stampBeginPipelines).count());
+    auto msShaders = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(batch->stampBeginPipelines -  batch->stampBeginShaders).count());
+
+    // Merge all rejected keys
+    for (const Batch::PipelineWave& wave : batch->pipelineWaves) {
+        batch->rejectedKeys.insert(batch->rejectedKeys.end(), wave.rejectedKeys.begin(), wave.rejectedKeys.end());
+    }
 
     // Report all rejected keys
-    if (!rejectedKeys.empty()) {
+    if (!batch->rejectedKeys.empty()) {
 #if LOG_REJECTED_KEYS
         std::stringstream keyMessage;
         keyMessage << "Instrumentation failed for the following shaders and keys:\n";
 
         // Compose keys
-        for (auto&& kv : rejectedKeys) {
+        for (auto&& kv : batch->rejectedKeys) {
             keyMessage << "\tShader " << kv.first->uid << " [" << kv.second.featureBitSet << "] with " << kv.second.pipelineLayoutUserSlots << " user slots\n";
         }
 
@@ -968,24 +1084,16 @@ void InstrumentationController::CommitPipelines(DispatcherBucket* bucket, void *
 #endif // LOG_REJECTED_KEYS
     }
 
-    // Free up
-    destroy(jobs, registry->GetAllocators());
-}
-
-void InstrumentationController::CommitTable(DispatcherBucket* bucket, void *data) {
-    auto* batch = static_cast<Batch*>(data);
-
-    // Determine time difference
-    auto msTotal = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -  batch->stampBegin).count());
-    auto msPipelines = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() -  batch->stampBeginPipelines).count());
-    auto msShaders = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(batch->stampBeginPipelines -  batch->stampBeginShaders).count());
-
     // Commit all sguid changes
     auto bridge = registry->Get<IBridge>();
     table->sguidHost->Commit(bridge.GetUnsafe());
     
     // Commit all pending entries
-    for (Batch::CommitEntry entry : batch->commitEntries) {
+    for (const Batch::CommitEntry& entry : batch->commitEntries) {
+        if (!entry.enqueued) {
+            continue;
+        }
+        
         if (auto pipeline = entry.state->GetInstrument(entry.combinedHash)) {
             entry.state->hotSwapObject.store(pipeline);
         }
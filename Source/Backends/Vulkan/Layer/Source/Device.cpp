@@ -44,6 +44,7 @@
 #include <Backends/Vulkan/Export/ShaderExportHost.h>
 #include <Backends/Vulkan/Compiler/ShaderCompiler.h>
 #include <Backends/Vulkan/Compiler/PipelineCompiler.h>
+#include <Backends/Vulkan/Compiler/ShaderCompilerCache.h>
 #include <Backends/Vulkan/States/QueueState.h>
 #include <Backends/Vulkan/Resource/PhysicalResourceMappingTable.h>
 #include <Backends/Vulkan/ShaderProgram/ShaderProgramHost.h>
@@ -246,6 +247,32 @@ VkResult VKAPI_PTR Hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const Vk
     // Get the device features
     table->parent->next_vkGetPhysicalDeviceFeatures2(physicalDevice, &table->physicalDeviceFeatures);
 
+    // Instrumentation may only rely on 1.1 functionality if both the application and device are 1.1
+    const VkApplicationInfo* applicationInfo = table->parent->createInfo->pApplicationInfo;
+    bool isVulkan11 = table->physicalDeviceProperties.apiVersion >= VK_API_VERSION_1_1 && applicationInfo && applicationInfo->apiVersion >= VK_API_VERSION_1_1;
+
+    // Get the subgroup properties
+    table->physicalDeviceSubgroupProperties = {VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES};
+    if (isVulkan11 && table->parent->next_vkGetPhysicalDeviceProperties2) {
+        VkPhysicalDeviceProperties2 properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+        properties.pNext = &table->physicalDeviceSubgroupProperties;
+        table->parent->next_vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+    }
+
+    // Wave aggregated exports require ballots in all stages that may aggregate, see SpvPhysicalBlockEntryPoint
+#if SHADER_COMPILER_WAVE_AGGREGATION
+    {
+        constexpr VkSubgroupFeatureFlags kOperations = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_BALLOT_BIT;
+        constexpr VkShaderStageFlags kStages = VK_SHADER_STAGE_COMPUTE_BIT | VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT | VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT | VK_SHADER_STAGE_GEOMETRY_BIT;
+
+        // Check subgroup support
+        const VkPhysicalDeviceSubgroupProperties& subgroup = table->physicalDeviceSubgroupProperties;
+        table->supportsWaveAggregation = isVulkan11 &&
+            (subgroup.supportedOperations & kOperations) == kOperations &&
+            (subgroup.supportedStages & kStages) == kStages;
+    }
+#endif // SHADER_COMPILER_WAVE_AGGREGATION
+
     // Create a deep copy
     table->createInfo.DeepCopy(table->allocators, *pCreateInfo);
 
@@ -357,6 +384,14 @@ VkResult VKAPI_PTR Hook_vkCreateDevice(VkPhysicalDevice physicalDevice, const Vk
     table->exportStreamer = table->registry.AddNew<ShaderExportStreamer>(table);
     ENSURE(table->exportStreamer->Install(), "Failed to install export streamer allocator");
 
+    // Install the persistent shader cache, optional
+#if SHADER_COMPILER_CACHE
+    auto shaderCompilerCache = table->registry.AddNew<ShaderCompilerCache>(table);
+    if (!shaderCompilerCache->Install()) {
+        table->registry.Remove(shaderCompilerCache);
+    }
+#endif // SHADER_COMPILER_CACHE
+
     // Install the shader compiler
     auto shaderCompiler = table->registry.AddNew<ShaderCompiler>(table);
     ENSURE(shaderCompiler->Install(), "Failed to install shader compiler");
@@ -52,8 +52,12 @@
 #include <Message/IMessageStorage.h>
 #include <Message/MessageStream.h>
 
+// Schemas
+#include <Schemas/Diagnostic.h>
+
 // Common
 #include <Common/Registry.h>
+#include <Common/Dispatcher/Dispatcher.h>
 #include <Backends/Vulkan/Translation.h>
 
 ShaderExportStreamer::ShaderExportStreamer(DeviceDispatchTable *table) : table(table), dynamicOffsetAllocator(table->allocators) {
@@ -65,6 +69,7 @@ bool ShaderExportStreamer::Install() {
     deviceAllocator = registry->Get<DeviceAllocator>();
     descriptorAllocator = registry->Get<ShaderExportDescriptorAllocator>();
     streamAllocator = registry->Get<ShaderExportStreamAllocator>();
+    dispatcher = registry->Get<Dispatcher>();
 
     // Check if push descriptor tracking is required
     for (const char* extension : table->enabledExtensions) {
@@ -79,11 +84,18 @@ bool ShaderExportStreamer::Install() {
 }
 
 ShaderExportStreamer::~ShaderExportStreamer() {
-    // Free all live segments
+    // Wait for all pending decodes
+    decodeEvent.Wait(decodeEvent.GetHead());
+
+    // Free all live and decoded segments
     for (ShaderExportQueueState* queue : queuePool) {
         for (ShaderExportStreamSegment* segment : queue->liveSegments) {
             FreeSegmentNoQueueLock(queue, segment);
         }
+
+        for (ShaderExportStreamSegment* segment : queue->decodingSegments) {
+            FreeSegmentNoQueueLock(queue, segment);
+        }
     }
 
     // Free all segments
@@ -166,6 +178,8 @@ ShaderExportStreamSegment *ShaderExportStreamer::AllocateSegment() {
 
     // Try existing allocation
     if (ShaderExportStreamSegment* segment = segmentPool.TryPop()) {
+        // Match the current stream sizes
+        streamAllocator->UpdateSegment(segment->allocation);
         return segment;
     }
 
@@ -382,6 +396,21 @@ void ShaderExportStreamer::Process() {
             ProcessSegmentsNoQueueLock(queueState->exportState, completedHandles);
         }
     }
+
+    // Whole device sync points expect all messages to be committed, wait for pending decodes
+    decodeEvent.Wait(decodeEvent.GetHead());
+
+    // Release all decoded segments
+    {
+        // Maintain lock hierarchy, streamer -> queue
+        std::lock_guard guard(mutex);
+
+        // Release queues
+        // ! Linear view locks
+        for (QueueState* queueState : table->states_queue.GetLinear()) {
+            ReleaseDecodedSegmentsNoQueueLock(queueState->exportState);
+        }
+    }
     
     // Invoke proxies for all handles
     for (CommandContextHandle handle : completedHandles) {
@@ -391,7 +420,7 @@ void ShaderExportStreamer::Process() {
     }
 }
 
-void ShaderExportStreamer::Process(ShaderExportQueueState* queueState) {
+void ShaderExportStreamer::Process(ShaderExportQueueState* queueState, bool syncPoint) {
     // Released handles
     TrivialStackVector<CommandContextHandle, 32u> completedHandles;
 
@@ -404,6 +433,18 @@ void ShaderExportStreamer::Process(ShaderExportQueueState* queueState) {
         std::lock_guard queueGuard(table->states_queue.GetLock());
         ProcessSegmentsNoQueueLock(queueState, completedHandles);
     }
+
+    // Queue sync points expect all messages of the queue to be committed, wait for its pending decodes
+    if (syncPoint) {
+        queueState->decodeEvent.Wait(queueState->decodeEvent.GetHead());
+
+        // Maintain lock hierarchy, streamer -> queue
+        std::lock_guard guard(mutex);
+
+        // Release all decoded segments
+        std::lock_guard queueGuard(table->states_queue.GetLock());
+        ReleaseDecodedSegmentsNoQueueLock(queueState);
+    }
     
     // Invoke proxies for all handles
     for (CommandContextHandle handle : completedHandles) {
@@ -664,80 +705,159 @@ void ShaderExportStreamer::MapSegment(ShaderExportStreamState *state, ShaderExpo
 }
 
 void ShaderExportStreamer::ProcessSegmentsNoQueueLock(ShaderExportQueueState* queue, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
+    // Release all previously decoded segments
+    ReleaseDecodedSegmentsNoQueueLock(queue);
+
     // TODO: Does not hold true for all queues
     auto it = queue->liveSegments.begin();
 
     // Segments are enqueued in order of completion
     for (; it != queue->liveSegments.end(); it++) {
         // If failed to process, none of the succeeding are ready
-        if (!ProcessSegment(*it, completedHandles)) {
+        if (!ProcessSegment(queue, *it, completedHandles)) {
             break;
         }
 
-        // Add back to pool
-        FreeSegmentNoQueueLock(queue, *it);
+        // Released once decoded
+        queue->decodingSegments.push_back(*it);
     }
 
     // Remove dead segments
     queue->liveSegments.erase(queue->liveSegments.begin(), it);
 }
 
-bool ShaderExportStreamer::ProcessSegment(ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
+void ShaderExportStreamer::ReleaseDecodedSegmentsNoQueueLock(ShaderExportQueueState* queue) {
+    auto it = queue->decodingSegments.begin();
+
+    // Segments may be decoded out of order, but versions must collapse in order
+    for (; it != queue->decodingSegments.end(); it++) {
+        // If pending, none of the succeeding may be published
+        if (!(*it)->decoded.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        // Push all messages
+        PublishSegment(*it);
+
+        // Add back to pool
+        FreeSegmentNoQueueLock(queue, *it);
+    }
+
+    // Remove released segments
+    queue->decodingSegments.erase(queue->decodingSegments.begin(), it);
+}
+
+void ShaderExportStreamer::PublishSegment(ShaderExportStreamSegment *segment) {
+    // Output for messages
+    IMessageStorage* output = bridge->GetOutput();
+
+    // Add all decoded streams, empty streams are ignored
+    for (MessageStream& messageStream : segment->messageStreams) {
+        output->AddStreamAndSwap(messageStream);
+    }
+
+    // Any overflows?
+    if (!segment->overflowStream.IsEmpty()) {
+        output->AddStreamAndSwap(segment->overflowStream);
+    }
+
+    // Inform the versioning controller of a collapse
+    ASSERT(segment->versionSegPoint.id != UINT32_MAX, "Untracked versioning");
+    table->versioningController->CollapseOnFork(segment->versionSegPoint);
+}
+
+bool ShaderExportStreamer::ProcessSegment(ShaderExportQueueState* queue, ShaderExportStreamSegment *segment, TrivialStackVector<CommandContextHandle, 32u>& completedHandles) {
     // Ready?
     if (!segment->fence->IsCommitted(segment->fenceNextCommitId)) {
         return false;
     }
 
-    // Output for messages
-    IMessageStorage* output = bridge->GetOutput();
+    // Mark as pending, tracked on both the device and the owning queue
+    segment->decoded.store(false, std::memory_order_relaxed);
+    segment->queueDecodeEvent = &queue->decodeEvent;
+    segment->queueDecodeEvent->IncrementHead();
+    decodeEvent.IncrementHead();
+
+    // Decode on the dispatcher if possible, the submitting thread should not pay for the readback
+    //  ? Sync points wait on the decodes, never queue them behind compilation jobs
+    if (dispatcher) {
+        dispatcher->Add(BindDelegate(this, ShaderExportStreamer::DecodeSegment), segment, nullptr, DispatcherJobPriority::Blocking);
+    } else {
+        DecodeSegment(segment);
+    }
+
+    // Collect all handles, the device has completed the segment
+    for (CommandContextHandle handle : segment->commandContextHandles) {
+        completedHandles.Add(handle);
+    }
+
+    // Done!
+    return true;
+}
+
+void ShaderExportStreamer::DecodeSegment(void *data) {
+    auto* segment = static_cast<ShaderExportStreamSegment*>(data);
+
+    // Counters are persistently mapped
+    const uint32_t* counters = segment->allocation->counter.hostCounters;
+
+    // Ensure there's a pooled stream per export
+    segment->messageStreams.resize(segment->allocation->streams.size());
 
-    // Map the counters
-    const MirrorAllocation& counterMirror = segment->allocation->counter.allocation;
-    auto* counters = static_cast<uint32_t*>(deviceAllocator->Map(counterMirror.host));
+    // Overflow diagnostics, published with the segment
+    segment->overflowStream.Clear();
+    MessageStreamView overflowView(segment->overflowStream);
 
     // Process all streams
     for (size_t i = 0; i < segment->allocation->streams.size(); i++) {
         const ShaderExportStreamInfo& streamInfo = segment->allocation->streams[i];
 
-        // Get the written counter
-        uint32_t elementCount = counters[i];
+        // Get the written counter, in dwords
+        uint32_t requestedCount = counters[i];
+
+        // Number of dwords that fit the physical size of the buffer, in whole messages
+        auto capacity = static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize * streamInfo.typeInfo.typeSize / sizeof(uint32_t));
 
         // Limit the counter by the physical size of the buffer (may exceed)
-        elementCount = std::min(elementCount, static_cast<uint32_t>(streamInfo.byteSize / streamInfo.typeInfo.typeSize));
+        uint32_t elementCount = std::min(requestedCount, capacity);
+
+        // Let the allocator adapt the next streams to the demand
+        uint64_t nextByteSize = streamAllocator->ReportStreamUsage(static_cast<ShaderExportID>(i), requestedCount * sizeof(uint32_t), streamInfo.byteSize);
+
+        // Report truncation, silently losing messages would hide faults
+        if (requestedCount > capacity) {
+            auto* diagnostic = overflowView.Add<ExportStreamOverflowDiagnosticMessage>();
+            diagnostic->exportID = static_cast<uint32_t>(i);
+            diagnostic->droppedCount = static_cast<uint32_t>((requestedCount - capacity) * sizeof(uint32_t) / streamInfo.typeInfo.typeSize);
+            diagnostic->streamSize = static_cast<uint32_t>(streamInfo.byteSize);
+            diagnostic->nextStreamSize = static_cast<uint32_t>(nextByteSize);
+        }
 
-        // Map the stream
-        auto* stream = static_cast<uint8_t*>(deviceAllocator->Map(streamInfo.allocation.host));
+        // Nothing written?
+        if (!elementCount) {
+            segment->messageStreams[i].Clear();
+            continue;
+        }
 
         // Size of the stream
         size_t size = elementCount * sizeof(uint32_t);
 
-        // Copy into stream
-        MessageStream messageStream;
+        // Copy into the pooled stream, swapped with a recycled one on publishing
+        MessageStream& messageStream = segment->messageStreams[i];
         messageStream.SetSchema(streamInfo.typeInfo.messageSchema);
         messageStream.SetVersionID(segment->versionSegPoint.id);
-        messageStream.SetData(stream, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
-
-        // Add output
-        output->AddStream(messageStream);
-
-        // Unmap
-        deviceAllocator->Unmap(streamInfo.allocation.host);
+        messageStream.SetData(streamInfo.hostData, size, static_cast<uint32_t>(size / streamInfo.typeInfo.typeSize));
     }
 
-    // Unmap host
-    deviceAllocator->Unmap(counterMirror.host);
+    // The segment may be recycled once marked, keep the queue event around
+    EventCounter* queueDecodeEvent = segment->queueDecodeEvent;
 
-    // Inform the versioning controller of a collapse
-    ASSERT(segment->versionSegPoint.id != UINT32_MAX, "Untracked versioning");
-    table->versioningController->CollapseOnFork(segment->versionSegPoint);
+    // Segment may now be published and released
+    segment->decoded.store(true, std::memory_order_release);
 
-    // Collect all handles
-    for (CommandContextHandle handle : segment->commandContextHandles) {
-        completedHandles.Add(handle);
-    }
-
-    // Done!
-    return true;
+    // Queue before device, device sync points outlive the queue
+    queueDecodeEvent->IncrementCounter();
+    decodeEvent.IncrementCounter();
 }
 
 void ShaderExportStreamer::FreeSegmentNoQueueLock(ShaderExportQueueState* queue, ShaderExportStreamSegment *segment) {
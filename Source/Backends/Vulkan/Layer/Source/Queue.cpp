@@ -237,6 +237,18 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueSubmit(VkQueue queue, uint32_t submit
     postPatchInfo.commandBufferCount = 1;
     postPatchInfo.pCommandBuffers = &postPatchCommandBuffer;
 
+    // Invoke all proxies prior to submission, host writes made here are visible to the submission
+    for (uint32_t i = 0; i < submitCount; i++) {
+        for (uint32_t bufferIndex = 0; bufferIndex < pSubmits[i].commandBufferCount; bufferIndex++) {
+            auto *unwrapped = reinterpret_cast<CommandBufferObject *>(pSubmits[i].pCommandBuffers[bufferIndex]);
+
+            // Invoke all proxies
+            for (const FeatureHookTable &proxyTable: table->featureHookTables) {
+                proxyTable.preSubmit.TryInvoke(unwrapped->userContext.handle);
+            }
+        }
+    }
+
     // Serialize queue access
     {
         std::lock_guard guard(queueState->mutex);
@@ -279,8 +291,8 @@ VKAPI_ATTR VkResult VKAPI_CALL Hook_vkQueueWaitIdle(VkQueue queue) {
         return result;
     }
 
-    // Inform the streamer of the sync point
-    table->exportStreamer->Process(queueState->exportState);
+    // Inform the streamer of the sync point, wait for all pending decodes
+    table->exportStreamer->Process(queueState->exportState, true);
 
     // Commit bridge data
     BridgeDeviceSyncPoint(table);
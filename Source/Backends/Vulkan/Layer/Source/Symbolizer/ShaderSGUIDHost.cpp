@@ -44,6 +44,9 @@
 // Schemas
 #include <Schemas/SGUID.h>
 
+// Std
+#include <algorithm>
+
 ShaderSGUIDHost::ShaderSGUIDHost(DeviceDispatchTable *table) : table(table) {
 
 }
@@ -65,7 +68,7 @@ void ShaderSGUIDHost::Commit(IBridge *bridge) {
         ShaderSourceMapping mapping = sguidLookup.at(sguid);
 
         // Get source
-        std::string_view sourceContents = GetSource(mapping);
+        std::string_view sourceContents = GetSourceUnsafe(mapping);
 
         // Allocate message
         ShaderSourceMappingMessage* message = view.Add(ShaderSourceMappingMessage::AllocationInfo {
@@ -158,11 +161,111 @@ ShaderSGUID ShaderSGUIDHost::Bind(const IL::Program &program, const IL::BasicBlo
         // Insert mappings
         shaderEntry.mappings[mapping] = mapping;
         sguidLookup.at(mapping.sguid) = mapping;
-        return mapping.sguid;
+    } else {
+        mapping.sguid = ssmIt->second.sguid;
+    }
+
+    // Recording?
+    if (!recordings.empty()) {
+        if (auto recordingIt = recordings.find(&program); recordingIt != recordings.end()) {
+            recordingIt->second.push_back(mapping.sguid);
+        }
     }
 
     // Return the SGUID
-    return ssmIt->second.sguid;
+    return mapping.sguid;
+}
+
+void ShaderSGUIDHost::BeginRecording(const IL::Program &program) {
+    std::lock_guard guard(mutex);
+    recordings[&program].clear();
+}
+
+std::vector<ShaderSGUID> ShaderSGUIDHost::EndRecording(const IL::Program &program) {
+    std::lock_guard guard(mutex);
+
+    // Get recording
+    auto it = recordings.find(&program);
+    if (it == recordings.end()) {
+        return {};
+    }
+
+    // Features may bind the same instruction multiple times
+    std::vector<ShaderSGUID> sguids = std::move(it->second);
+    std::sort(sguids.begin(), sguids.end());
+    sguids.erase(std::unique(sguids.begin(), sguids.end()), sguids.end());
+
+    // OK
+    recordings.erase(it);
+    return sguids;
+}
+
+bool ShaderSGUIDHost::Restore(uint64_t shaderGUID, const ShaderSourceMapping *mappings, const std::string_view *sources, uint32_t count) {
+    std::lock_guard guard(mutex);
+
+    // Validate all sguids before restoring any
+    for (uint32_t i = 0; i < count; i++) {
+        ShaderSourceMapping mapping = mappings[i];
+        mapping.shaderGUID = shaderGUID;
+
+        // Out of range?
+        if (mapping.sguid == InvalidShaderSGUID || mapping.sguid >= (1u << kShaderSGUIDBitCount)) {
+            return false;
+        }
+
+        // Allocated to a different mapping?
+        if (IsAllocatedUnsafe(mapping.sguid) && sguidLookup.at(mapping.sguid) != mapping) {
+            return false;
+        }
+    }
+
+    // Get entry
+    ShaderEntry& shaderEntry = shaderEntries[shaderGUID];
+
+    // Restore all mappings
+    for (uint32_t i = 0; i < count; i++) {
+        ShaderSourceMapping mapping = mappings[i];
+        mapping.shaderGUID = shaderGUID;
+
+        // Keep the restored source line, the shader may never be parsed
+        if (mapping.fileUID != kInvalidShaderSourceFileUID) {
+            shaderEntry.restoredSources.emplace((static_cast<uint64_t>(mapping.fileUID) << 32u) | mapping.line, sources[i]);
+        }
+
+        // Already restored or bound?
+        if (IsAllocatedUnsafe(mapping.sguid)) {
+            continue;
+        }
+
+        // Allocate the exact sguid, skipped indices are free'd
+        if (mapping.sguid >= counter) {
+            for (ShaderSGUID sguid = counter; sguid < mapping.sguid; sguid++) {
+                freeIndices.push_back(sguid);
+            }
+
+            counter = mapping.sguid + 1;
+        } else {
+            freeIndices.erase(std::find(freeIndices.begin(), freeIndices.end(), mapping.sguid));
+        }
+
+        // Add to pending
+        pendingSubmissions.push_back(mapping.sguid);
+
+        // Insert mappings, an equal mapping may already be bound under a different sguid
+        shaderEntry.mappings.emplace(mapping, mapping);
+        sguidLookup.at(mapping.sguid) = mapping;
+    }
+
+    // OK
+    return true;
+}
+
+bool ShaderSGUIDHost::IsAllocatedUnsafe(ShaderSGUID sguid) const {
+    if (sguid >= counter) {
+        return false;
+    }
+
+    return std::find(freeIndices.begin(), freeIndices.end(), sguid) == freeIndices.end();
 }
 
 ShaderSourceMapping ShaderSGUIDHost::GetMapping(ShaderSGUID sguid) {
@@ -192,10 +295,15 @@ std::string_view ShaderSGUIDHost::GetSource(ShaderSGUID sguid) {
     }
 
     std::lock_guard guard(mutex);
-    return GetSource(sguidLookup.at(sguid));
+    return GetSourceUnsafe(sguidLookup.at(sguid));
 }
 
 std::string_view ShaderSGUIDHost::GetSource(const ShaderSourceMapping &mapping) {
+    std::lock_guard guard(mutex);
+    return GetSourceUnsafe(mapping);
+}
+
+std::string_view ShaderSGUIDHost::GetSourceUnsafe(const ShaderSourceMapping &mapping) {
     // May not be mapped (IL only)
     if (mapping.fileUID == kInvalidShaderSourceFileUID) {
         return {};
@@ -204,6 +312,22 @@ std::string_view ShaderSGUIDHost::GetSource(const ShaderSourceMapping &mapping)
     // Get source map
     const SpvSourceMap* map = GetSourceMap(mapping.shaderGUID);
 
+    // Not parsed, restored from cached instrumentation
+    if (!map) {
+        auto entryIt = shaderEntries.find(mapping.shaderGUID);
+        if (entryIt == shaderEntries.end()) {
+            return {};
+        }
+
+        // Restored lines are already trimmed
+        auto sourceIt = entryIt->second.restoredSources.find((static_cast<uint64_t>(mapping.fileUID) << 32u) | mapping.line);
+        if (sourceIt == entryIt->second.restoredSources.end()) {
+            return {};
+        }
+
+        return sourceIt->second;
+    }
+
     // Get line
     std::string_view view = map->GetLine(mapping.fileUID, mapping.line);
 
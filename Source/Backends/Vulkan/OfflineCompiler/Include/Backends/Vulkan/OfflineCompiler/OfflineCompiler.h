@@ -0,0 +1,142 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// OfflineCompiler
+#include <Backends/Vulkan/OfflineCompiler/OfflineCompilerResult.h>
+
+// Layer
+#include <Backends/Vulkan/Vulkan.h>
+#include <Backends/Vulkan/States/PipelineLayoutPhysicalMapping.h>
+#include <Backends/Vulkan/Compiler/Diagnostic/DiagnosticType.h>
+
+// Backend
+#include <Backend/Environment.h>
+#include <Backend/ShaderData/ShaderDataInfo.h>
+#include <Backend/FeatureInfo.h>
+#include <Backend/Diagnostic/DiagnosticBucket.h>
+
+// Common
+#include <Common/Registry.h>
+#include <Common/ComRef.h>
+
+// Std
+#include <vector>
+
+// Forward declarations
+struct SpvJob;
+class IFeature;
+class IShaderFeature;
+class Dispatcher;
+class OfflineShaderSGUIDHost;
+
+/// Offline compiler creation info
+struct OfflineCompilerInfo {
+    /// Parse function bodies on the dispatcher
+    bool parallelParse{true};
+
+    /// Aggregate exports across waves, assumes subgroup ballot support in all aggregating stages
+    bool waveAggregation{false};
+
+    /// Byte offset of the instrumentation push constant data
+    ///  ? There is no pipeline layout offline, this must lie past all user push constant data
+    uint32_t pushConstantOffset{256};
+};
+
+/// Device independent shader compiler
+///  ? Mirrors the instrumentation path of the shader compiler without any device, useful for
+///    measuring and debugging the compiler in isolation
+class OfflineCompiler {
+public:
+    OfflineCompiler();
+    ~OfflineCompiler();
+
+    /// Install this compiler, loads all feature plugins
+    /// \param info creation info
+    /// \return success state
+    bool Install(const OfflineCompilerInfo& info);
+
+    /// Compile a module
+    /// \param code the SPIRV module pointer
+    /// \param wordCount number of words within the module stream
+    /// \param featureBitSet all features to be injected, bits are indices into the installed features
+    /// \param out the compilation result
+    /// \return success state
+    bool Compile(const uint32_t* code, uint32_t wordCount, uint64_t featureBitSet, OfflineCompilerResult& out);
+
+    /// Get the info of all installed features
+    const std::vector<FeatureInfo>& GetFeatureInfos() const {
+        return featureInfos;
+    }
+
+private:
+    /// Create the job for a given module
+    /// \param code the SPIRV module pointer
+    /// \param wordCount number of words within the module stream
+    /// \param featureBitSet all injected features
+    /// \param mapping the physical mapping to be filled
+    /// \param job the destination job
+    void CreateJob(const uint32_t* code, uint32_t wordCount, uint64_t featureBitSet, PipelineLayoutPhysicalMapping& mapping, SpvJob& job);
+
+private:
+    /// Creation info
+    OfflineCompilerInfo info;
+
+    /// Shared environment, hosts all plugins
+    Backend::Environment environment;
+
+    /// Local registry
+    Registry registry;
+
+    /// Shared dispatcher
+    ComRef<Dispatcher> dispatcher;
+
+    /// Local sguid host
+    ComRef<OfflineShaderSGUIDHost> sguidHost;
+
+    /// All installed features
+    std::vector<ComRef<IFeature>> features;
+
+    /// All installed feature infos
+    std::vector<FeatureInfo> featureInfos;
+
+    /// All shader features, null if not a shader feature
+    std::vector<ComRef<IShaderFeature>> shaderFeatures;
+
+    /// All shader data
+    std::vector<ShaderDataInfo> shaderData;
+
+    /// Number of exports
+    uint32_t exportCount{0};
+
+    /// All compiler diagnostics
+    DiagnosticBucket<DiagnosticType> diagnostic;
+
+    /// Shader guid allocation counter
+    uint64_t shaderGUIDCounter{0};
+};
@@ -0,0 +1,67 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <vector>
+#include <cstdint>
+
+/// Per phase compilation timings, all in nanoseconds
+struct OfflineCompilerTimings {
+    /// Parsing of the source module
+    uint64_t parse{0};
+
+    /// Copying of the parsed module
+    uint64_t copy{0};
+
+    /// Injection time per installed feature, zero if not injected
+    std::vector<uint64_t> inject;
+
+    /// Dominant block reordering and flattening
+    uint64_t reorder{0};
+
+    /// Compilation of all physical blocks
+    uint64_t compile{0};
+
+    /// Stitching of all physical blocks
+    uint64_t stitch{0};
+};
+
+/// Offline compilation result
+struct OfflineCompilerResult {
+    /// Instrumented module
+    std::vector<uint32_t> code;
+
+    /// All timings
+    OfflineCompilerTimings timings;
+
+    /// Instrumented program statistics
+    uint32_t functionCount{0};
+    uint32_t basicBlockCount{0};
+    uint32_t instructionCount{0};
+};
@@ -0,0 +1,69 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Backend
+#include <Backend/ShaderData/IShaderDataHost.h>
+
+// Std
+#include <vector>
+#include <cstdint>
+
+/// Device independent data host, all data is host memory
+class OfflineShaderDataHost final : public IShaderDataHost {
+public:
+    /// Overrides
+    ShaderDataID CreateBuffer(const ShaderDataBufferInfo &info) override;
+    ShaderDataID CreateEventData(const ShaderDataEventInfo &info) override;
+    ShaderDataID CreateDescriptorData(const ShaderDataDescriptorInfo &info) override;
+    void *Map(ShaderDataID rid) override;
+    void FlushMappedRange(ShaderDataID rid, size_t offset, size_t length) override;
+    void Destroy(ShaderDataID rid) override;
+    void Enumerate(uint32_t *count, ShaderDataInfo *out, ShaderDataTypeSet mask) override;
+
+private:
+    /// Allocate a new entry
+    /// \param type the data type
+    /// \return the entry info
+    ShaderDataInfo& Allocate(ShaderDataType type);
+
+private:
+    struct ResourceEntry {
+        /// Underlying info
+        ShaderDataInfo info;
+
+        /// Host data, only valid for buffers
+        std::vector<uint8_t> data;
+
+        /// Has this entry been destroyed?
+        bool destroyed{false};
+    };
+
+    /// All resources, indexed by the data id
+    std::vector<ResourceEntry> resources;
+};
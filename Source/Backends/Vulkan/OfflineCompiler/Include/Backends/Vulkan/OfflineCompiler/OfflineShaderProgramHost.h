@@ -0,0 +1,54 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Backend
+#include <Backend/ShaderProgram/IShaderProgramHost.h>
+#include <Backend/ShaderProgram/IShaderProgram.h>
+
+// Std
+#include <vector>
+
+/// Device independent program host, programs are kept alive but never compiled
+class OfflineShaderProgramHost final : public IShaderProgramHost {
+public:
+    /// Overrides
+    ShaderProgramID Register(const ComRef<IShaderProgram> &program) override {
+        programs.push_back(program);
+        return static_cast<ShaderProgramID>(programs.size() - 1);
+    }
+
+    /// Overrides
+    void Deregister(ShaderProgramID program) override {
+        programs.at(program) = nullptr;
+    }
+
+private:
+    /// All registered programs
+    std::vector<ComRef<IShaderProgram>> programs;
+};
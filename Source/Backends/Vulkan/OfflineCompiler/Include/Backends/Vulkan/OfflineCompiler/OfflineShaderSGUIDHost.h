@@ -0,0 +1,78 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Backend
+#include <Backend/IShaderSGUIDHost.h>
+
+// Std
+#include <unordered_map>
+#include <vector>
+#include <mutex>
+
+// Forward declarations
+class SpvModule;
+
+/// Device independent sguid host, binds against registered modules
+class OfflineShaderSGUIDHost final : public IShaderSGUIDHost {
+public:
+    /// Register a module for binding
+    /// \param shaderGUID the global shader guid
+    /// \param module the source module, must outlive all bindings against it
+    void Register(uint64_t shaderGUID, SpvModule* module);
+
+    /// Deregister a module, all mappings are kept
+    /// \param shaderGUID the global shader guid
+    void Deregister(uint64_t shaderGUID);
+
+    /// Get the number of bound sguids
+    uint32_t GetBound() const {
+        return counter;
+    }
+
+    /// Overrides
+    ShaderSGUID Bind(const IL::Program &program, const IL::BasicBlock::ConstIterator& instruction) override;
+    ShaderSourceMapping GetMapping(ShaderSGUID sguid) override;
+    std::string_view GetSource(ShaderSGUID sguid) override;
+    std::string_view GetSource(const ShaderSourceMapping &mapping) override;
+
+private:
+    std::mutex mutex;
+
+    /// All registered modules
+    std::unordered_map<uint64_t, SpvModule*> modules;
+
+    /// All unique mappings
+    std::unordered_map<ShaderSourceMapping, ShaderSGUID> mappings;
+
+    /// Reverse sguid lookup
+    std::vector<ShaderSourceMapping> sguidLookup;
+
+    /// Current allocation counter
+    ShaderSGUID counter{0};
+};
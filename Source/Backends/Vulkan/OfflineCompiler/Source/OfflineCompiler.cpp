@@ -0,0 +1,344 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backends/Vulkan/OfflineCompiler/OfflineCompiler.h>
+#include <Backends/Vulkan/OfflineCompiler/OfflineShaderSGUIDHost.h>
+#include <Backends/Vulkan/OfflineCompiler/OfflineShaderDataHost.h>
+#include <Backends/Vulkan/OfflineCompiler/OfflineShaderProgramHost.h>
+#include <Backends/Vulkan/OfflineCompiler/OfflineScheduler.h>
+
+// Layer
+#include <Backends/Vulkan/Compiler/SpvModule.h>
+#include <Backends/Vulkan/Compiler/SpvJob.h>
+#include <Backends/Vulkan/Compiler/Spv.h>
+#include <Backends/Vulkan/Export/ShaderExportHost.h>
+
+// Backend
+#include <Backend/EnvironmentInfo.h>
+#include <Backend/IFeatureHost.h>
+#include <Backend/IFeature.h>
+#include <Backend/IShaderFeature.h>
+#include <Backend/IL/Program.h>
+
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+
+// Std
+#include <chrono>
+#include <map>
+
+/// Uniform range of the descriptor data, the device limit is unknown offline
+static constexpr uint32_t kDescriptorDataLength = 65'536;
+
+/// Timing clock
+using OfflineClock = std::chrono::high_resolution_clock;
+
+/// Get the elapsed time
+/// \param begin starting time point
+/// \return elapsed nanoseconds
+static uint64_t GetElapsedNanoseconds(OfflineClock::time_point begin) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(OfflineClock::now() - begin).count());
+}
+
+OfflineCompiler::OfflineCompiler() {
+
+}
+
+OfflineCompiler::~OfflineCompiler() {
+    // Release all features before the plugins are unloaded
+    shaderFeatures.clear();
+    features.clear();
+}
+
+bool OfflineCompiler::Install(const OfflineCompilerInfo& compilerInfo) {
+    info = compilerInfo;
+
+    // Intra process environment, nothing is ever streamed out
+    Backend::EnvironmentInfo environmentInfo;
+    environmentInfo.memoryBridge = true;
+    environmentInfo.device.applicationName = "OfflineCompiler";
+    environmentInfo.device.apiName = "Vulkan";
+
+    // Try to install the environment
+    if (!environment.Install(environmentInfo)) {
+        return false;
+    }
+
+    // Inherit all shared components
+    registry.SetParent(environment.GetRegistry());
+
+    // Get the shared dispatcher
+    dispatcher = registry.Get<Dispatcher>();
+
+    // Install the device independent hosts
+    registry.AddNew<ShaderExportHost>();
+    registry.AddNew<OfflineShaderDataHost>();
+    registry.AddNew<OfflineShaderProgramHost>();
+    registry.AddNew<OfflineScheduler>();
+    sguidHost = registry.AddNew<OfflineShaderSGUIDHost>();
+
+    // Get the feature host
+    auto host = registry.Get<IFeatureHost>();
+    if (!host) {
+        return false;
+    }
+
+    // Pool feature count
+    uint32_t featureCount;
+    host->Install(&featureCount, nullptr, nullptr);
+
+    // Install all features
+    features.resize(featureCount);
+    if (!host->Install(&featureCount, features.data(), &registry)) {
+        return false;
+    }
+
+    // Get all shader features
+    for (const ComRef<IFeature>& feature : features) {
+        featureInfos.push_back(feature->GetInfo());
+
+        // Append null even if not found
+        shaderFeatures.push_back(Cast<IShaderFeature>(feature));
+    }
+
+    // Get the number of exports
+    registry.Get<IShaderExportHost>()->Enumerate(&exportCount, nullptr);
+
+    // Get number of resources
+    auto shaderDataHost = registry.Get<IShaderDataHost>();
+    uint32_t resourceCount;
+    shaderDataHost->Enumerate(&resourceCount, nullptr, ShaderDataType::All);
+
+    // Fill resources
+    shaderData.resize(resourceCount);
+    shaderDataHost->Enumerate(&resourceCount, shaderData.data(), ShaderDataType::All);
+
+    // OK
+    return true;
+}
+
+bool OfflineCompiler::Compile(const uint32_t *code, uint32_t wordCount, uint64_t featureBitSet, OfflineCompilerResult &out) {
+    Allocators allocators = registry.GetAllocators();
+
+    // Reset timings
+    out.timings = {};
+    out.timings.inject.resize(features.size(), 0u);
+
+    // Each compilation is a unique shader
+    uint64_t shaderGUID = shaderGUIDCounter++;
+
+    // Create the source module
+    auto* sourceModule = new (allocators) SpvModule(allocators, shaderGUID);
+
+    // Parse the module
+    OfflineClock::time_point parseBegin = OfflineClock::now();
+    bool parsed = sourceModule->ParseModule(code, wordCount, info.parallelParse ? dispatcher.GetUnsafe() : nullptr);
+    out.timings.parse = GetElapsedNanoseconds(parseBegin);
+
+    // Failed?
+    if (!parsed) {
+        destroy(sourceModule, allocators);
+        return false;
+    }
+
+    // There is no device offline, the module may only aggregate exports if requested
+    sourceModule->GetProgram()->GetCapabilityTable().hasWaveAggregation &= info.waveAggregation;
+
+    // Bind against the source module
+    sguidHost->Register(shaderGUID, sourceModule);
+
+    // Create a copy of the module, don't modify the source
+    OfflineClock::time_point copyBegin = OfflineClock::now();
+    SpvModule *module = sourceModule->Copy();
+    out.timings.copy = GetElapsedNanoseconds(copyBegin);
+
+    // Add resources
+    IL::ShaderDataMap& shaderDataMap = module->GetProgram()->GetShaderDataMap();
+    for (const ShaderDataInfo& dataInfo : shaderData) {
+        shaderDataMap.Add(dataInfo);
+    }
+
+    // No specialization
+    MessageStream specializationStream;
+    MessageStreamView<> specialization(specializationStream);
+
+    // Pass through all features
+    for (size_t i = 0; i < shaderFeatures.size(); i++) {
+        if (!(featureBitSet & (1ull << i)) || !shaderFeatures[i]) {
+            continue;
+        }
+
+        // Inject marked shader feature
+        OfflineClock::time_point injectBegin = OfflineClock::now();
+        shaderFeatures[i]->Inject(*module->GetProgram(), specialization);
+        out.timings.inject[i] = GetElapsedNanoseconds(injectBegin);
+    }
+
+    // Create the job
+    PipelineLayoutPhysicalMapping physicalMapping;
+    SpvJob spvJob;
+    CreateJob(code, wordCount, featureBitSet, physicalMapping, spvJob);
+
+    // Compile in stages, see SpvModule::Recompile
+    bool result = false;
+    {
+        OfflineClock::time_point reorderBegin = OfflineClock::now();
+        bool reordered = module->ReorderForCompilation();
+        out.timings.reorder = GetElapsedNanoseconds(reorderBegin);
+
+        // Compile the blocks
+        if (reordered) {
+            OfflineClock::time_point compileBegin = OfflineClock::now();
+            bool compiled = module->CompilePhysicalBlocks(spvJob);
+            out.timings.compile = GetElapsedNanoseconds(compileBegin);
+
+            // Stitch the program
+            if (compiled) {
+                OfflineClock::time_point stitchBegin = OfflineClock::now();
+                module->Stitch();
+                out.timings.stitch = GetElapsedNanoseconds(stitchBegin);
+                result = true;
+            }
+        }
+    }
+
+    // Copy the instrumented code
+    if (result) {
+        out.code.assign(module->GetCode(), module->GetCode() + module->GetSize() / sizeof(uint32_t));
+    }
+
+    // Summarize the program
+    out.functionCount = 0;
+    out.basicBlockCount = 0;
+    out.instructionCount = 0;
+    for (IL::Function* fn : module->GetProgram()->GetFunctionList()) {
+        out.functionCount++;
+
+        for (IL::BasicBlock* basicBlock : fn->GetBasicBlocks()) {
+            out.basicBlockCount++;
+            out.instructionCount += basicBlock->GetCount();
+        }
+    }
+
+    // Release the modules
+    sguidHost->Deregister(shaderGUID);
+    destroy(module, allocators);
+    destroy(sourceModule, allocators);
+
+    // OK
+    return result;
+}
+
+void OfflineCompiler::CreateJob(const uint32_t *code, uint32_t wordCount, uint64_t featureBitSet, PipelineLayoutPhysicalMapping &mapping, SpvJob &job) {
+    // Descriptor decorations, keyed by identifier
+    std::map<uint32_t, uint32_t> descriptorSets;
+    std::map<uint32_t, uint32_t> bindings;
+
+    // There is no pipeline layout offline, derive the user layout from the module decorations
+    for (uint32_t offset = 5; offset < wordCount;) {
+        uint32_t instructionWordCount = code[offset] >> SpvWordCountShift;
+        auto op = static_cast<SpvOp>(code[offset] & SpvOpCodeMask);
+
+        // Malformed?
+        if (!instructionWordCount) {
+            break;
+        }
+
+        // Descriptor decoration?
+        if (op == SpvOpDecorate && instructionWordCount >= 4) {
+            switch (static_cast<SpvDecoration>(code[offset + 2])) {
+                default:
+                    break;
+                case SpvDecorationDescriptorSet:
+                    descriptorSets[code[offset + 1]] = code[offset + 3];
+                    break;
+                case SpvDecorationBinding:
+                    bindings[code[offset + 1]] = code[offset + 3];
+                    break;
+            }
+        }
+
+        offset += instructionWordCount;
+    }
+
+    // Create the physical mapping
+    for (auto&& [id, set] : descriptorSets) {
+        auto bindingIt = bindings.find(id);
+        if (bindingIt == bindings.end()) {
+            continue;
+        }
+
+        // Ensure the set exists
+        if (set >= mapping.descriptorSets.size()) {
+            mapping.descriptorSets.resize(set + 1);
+        }
+
+        // Ensure the binding exists
+        DescriptorLayoutPhysicalMapping& setMapping = mapping.descriptorSets[set];
+        if (bindingIt->second >= setMapping.bindings.size()) {
+            setMapping.bindings.resize(bindingIt->second + 1);
+        }
+
+        // Single descriptor per binding
+        setMapping.bindings[bindingIt->second].bindingCount = 1;
+    }
+
+    // Assign linear PRMT offsets
+    uint32_t prmtOffset = 0;
+    for (DescriptorLayoutPhysicalMapping& setMapping : mapping.descriptorSets) {
+        for (BindingPhysicalMapping& binding : setMapping.bindings) {
+            binding.prmtOffset = prmtOffset;
+            prmtOffset += binding.bindingCount;
+        }
+    }
+
+    // Instrumentation key
+    job.instrumentationKey.featureBitSet = featureBitSet;
+    job.instrumentationKey.physicalMapping = &mapping;
+    job.instrumentationKey.pipelineLayoutUserSlots = static_cast<uint32_t>(mapping.descriptorSets.size());
+    job.instrumentationKey.pipelineLayoutDataPCOffset = info.pushConstantOffset;
+#if PRMT_METHOD == PRMT_METHOD_UB_PC
+    job.instrumentationKey.pipelineLayoutPRMTPCOffset = info.pushConstantOffset;
+    job.instrumentationKey.pipelineLayoutDataPCOffset += sizeof(uint32_t);
+#endif // PRMT_METHOD == PRMT_METHOD_UB_PC
+
+    // Binding layout, see ShaderExportDescriptorAllocator::CreateBindingLayout
+    uint32_t offset{0};
+    job.bindingInfo.counterDescriptorOffset = offset++;
+    job.bindingInfo.streamDescriptorOffset = offset;
+    job.bindingInfo.streamDescriptorCount = exportCount;
+    offset += exportCount;
+    job.bindingInfo.prmtDescriptorOffset = offset++;
+    job.bindingInfo.descriptorDataDescriptorOffset = offset++;
+    job.bindingInfo.descriptorDataDescriptorLength = kDescriptorDataLength;
+    job.bindingInfo.shaderDataConstantsDescriptorOffset = offset++;
+    job.bindingInfo.shaderDataDescriptorOffset = offset;
+    job.bindingInfo.shaderDataDescriptorCount = static_cast<uint32_t>(shaderData.size());
+
+    // Diagnostics
+    job.messages = DiagnosticBucketScope<DiagnosticType, uint64_t>(&diagnostic, job.instrumentationKey.combinedHash);
+}
@@ -0,0 +1,96 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backends/Vulkan/OfflineCompiler/OfflineShaderDataHost.h>
+
+// Backend
+#include <Backend/IL/Format.h>
+
+ShaderDataID OfflineShaderDataHost::CreateBuffer(const ShaderDataBufferInfo &info) {
+    ShaderDataInfo& entry = Allocate(ShaderDataType::Buffer);
+    entry.buffer = info;
+
+    // Host backed storage
+    resources[entry.id].data.resize(Backend::IL::GetSize(info.format) * info.elementCount);
+    return entry.id;
+}
+
+ShaderDataID OfflineShaderDataHost::CreateEventData(const ShaderDataEventInfo &info) {
+    ShaderDataInfo& entry = Allocate(ShaderDataType::Event);
+    entry.event = info;
+    return entry.id;
+}
+
+ShaderDataID OfflineShaderDataHost::CreateDescriptorData(const ShaderDataDescriptorInfo &info) {
+    ShaderDataInfo& entry = Allocate(ShaderDataType::Descriptor);
+    entry.descriptor = info;
+    return entry.id;
+}
+
+void *OfflineShaderDataHost::Map(ShaderDataID rid) {
+    ResourceEntry& entry = resources.at(rid);
+    return entry.data.empty() ? nullptr : entry.data.data();
+}
+
+void OfflineShaderDataHost::FlushMappedRange(ShaderDataID rid, size_t offset, size_t length) {
+    /* host memory */
+}
+
+void OfflineShaderDataHost::Destroy(ShaderDataID rid) {
+    ResourceEntry& entry = resources.at(rid);
+    entry.destroyed = true;
+    entry.data.clear();
+}
+
+void OfflineShaderDataHost::Enumerate(uint32_t *count, ShaderDataInfo *out, ShaderDataTypeSet mask) {
+    uint32_t value = 0;
+
+    for (const ResourceEntry& entry : resources) {
+        if (entry.destroyed || !(mask & entry.info.type)) {
+            continue;
+        }
+
+        // Filling?
+        if (out) {
+            out[value] = entry.info;
+        }
+
+        value++;
+    }
+
+    // Pooling?
+    if (!out) {
+        *count = value;
+    }
+}
+
+ShaderDataInfo &OfflineShaderDataHost::Allocate(ShaderDataType type) {
+    ResourceEntry& entry = resources.emplace_back();
+    entry.info.id = static_cast<ShaderDataID>(resources.size() - 1);
+    entry.info.type = type;
+    return entry.info;
+}
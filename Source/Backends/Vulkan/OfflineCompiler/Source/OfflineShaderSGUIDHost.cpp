@@ -0,0 +1,130 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Backends/Vulkan/OfflineCompiler/OfflineShaderSGUIDHost.h>
+
+// Layer
+#include <Backends/Vulkan/Compiler/SpvModule.h>
+#include <Backends/Vulkan/Compiler/SpvSourceMap.h>
+
+// Backend
+#include <Backend/IL/Program.h>
+
+void OfflineShaderSGUIDHost::Register(uint64_t shaderGUID, SpvModule *module) {
+    std::lock_guard guard(mutex);
+    modules[shaderGUID] = module;
+}
+
+void OfflineShaderSGUIDHost::Deregister(uint64_t shaderGUID) {
+    std::lock_guard guard(mutex);
+    modules.erase(shaderGUID);
+}
+
+ShaderSGUID OfflineShaderSGUIDHost::Bind(const IL::Program &program, const IL::BasicBlock::ConstIterator &instruction) {
+    // Get instruction pointer
+    const IL::Instruction* ptr = IL::ConstInstructionRef<>(instruction).Get();
+
+    // Serial
+    std::lock_guard guard(mutex);
+
+    // Get the module
+    auto moduleIt = modules.find(program.GetShaderGUID());
+    if (moduleIt == modules.end()) {
+        return InvalidShaderSGUID;
+    }
+
+    // Default mapping
+    ShaderSourceMapping mapping{};
+    mapping.shaderGUID = program.GetShaderGUID();
+
+    // Mapping il association
+    if (ptr->source.IsValid()) {
+        SpvCodeOffsetTraceback traceback = moduleIt->second->GetCodeOffsetTraceback(ptr->source.codeOffset);
+        mapping.basicBlockId = traceback.basicBlockID;
+        mapping.instructionIndex = traceback.instructionIndex;
+
+        // Try to get the association
+        if (const SpvSourceMap* sourceMap = moduleIt->second->GetSourceMap()) {
+            if (SpvSourceAssociation sourceAssociation = sourceMap->GetSourceAssociation(ptr->source.codeOffset)) {
+                mapping.fileUID = sourceAssociation.fileUID;
+                mapping.line = sourceAssociation.line;
+                mapping.column = sourceAssociation.column;
+            }
+        }
+    }
+
+    // Existing mapping?
+    if (auto it = mappings.find(mapping); it != mappings.end()) {
+        return it->second;
+    }
+
+    // Out of indices?
+    if (counter >= (1u << kShaderSGUIDBitCount) - 1u) {
+        return InvalidShaderSGUID;
+    }
+
+    // Allocate new sguid
+    mapping.sguid = counter++;
+    mappings[mapping] = mapping.sguid;
+    sguidLookup.push_back(mapping);
+    return mapping.sguid;
+}
+
+ShaderSourceMapping OfflineShaderSGUIDHost::GetMapping(ShaderSGUID sguid) {
+    std::lock_guard guard(mutex);
+    return sguidLookup.at(sguid);
+}
+
+std::string_view OfflineShaderSGUIDHost::GetSource(ShaderSGUID sguid) {
+    if (sguid == InvalidShaderSGUID) {
+        return {};
+    }
+
+    std::lock_guard guard(mutex);
+    return GetSource(sguidLookup.at(sguid));
+}
+
+std::string_view OfflineShaderSGUIDHost::GetSource(const ShaderSourceMapping &mapping) {
+    // May not be mapped (IL only)
+    if (mapping.fileUID == kInvalidShaderSourceFileUID) {
+        return {};
+    }
+
+    // Source may have been deregistered
+    auto moduleIt = modules.find(mapping.shaderGUID);
+    if (moduleIt == modules.end()) {
+        return {};
+    }
+
+    // Get source map
+    const SpvSourceMap* map = moduleIt->second->GetSourceMap();
+    if (!map) {
+        return {};
+    }
+
+    return map->GetLine(mapping.fileUID, mapping.line);
+}
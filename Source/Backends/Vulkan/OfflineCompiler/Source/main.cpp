@@ -0,0 +1,325 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+// OfflineCompiler
+#include <Backends/Vulkan/OfflineCompiler/OfflineCompiler.h>
+
+// Layer
+#include <Backends/Vulkan/Compiler/Spv.h>
+
+// Argparse
+#include <argparse/argparse.hpp>
+
+// Json
+#include <nlohmann/json.hpp>
+
+// Std
+#include <iostream>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+/// DXBC container magic, 'DXBC'
+static constexpr uint32_t kDXBCMagic = 0x43425844;
+
+/// Convert nanoseconds to milliseconds
+static double ToMilliseconds(uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1e6;
+}
+
+/// Collect all modules from a path
+/// \param path a module file or a corpus directory
+/// \param out all module paths, sorted for stable reports
+static void CollectModules(const std::filesystem::path& path, std::vector<std::filesystem::path>& out) {
+    if (!std::filesystem::is_directory(path)) {
+        out.push_back(path);
+        return;
+    }
+
+    // Collect all binaries in the corpus
+    for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path)) {
+        if (entry.is_regular_file() && (entry.path().extension() == ".spv" || entry.path().extension() == ".dxil")) {
+            out.push_back(entry.path());
+        }
+    }
+
+    // Stable order
+    std::sort(out.begin(), out.end());
+}
+
+/// Get the feature bit set from a comma separated list of names
+/// \param compiler the installed compiler
+/// \param names all names, or "all"
+/// \param out the resulting bit set
+/// \return false if a feature was not found
+static bool GetFeatureBitSet(const OfflineCompiler& compiler, const std::string& names, uint64_t& out) {
+    const std::vector<FeatureInfo>& infos = compiler.GetFeatureInfos();
+
+    // All features?
+    if (names == "all") {
+        out = infos.size() >= 64 ? ~0ull : (1ull << infos.size()) - 1;
+        return true;
+    }
+
+    // Find each feature
+    std::stringstream stream(names);
+    for (std::string name; std::getline(stream, name, ',');) {
+        auto it = std::find_if(infos.begin(), infos.end(), [&](const FeatureInfo& info) { return info.name == name; });
+        if (it == infos.end()) {
+            std::cerr << "Unknown feature: " << name << std::endl;
+            return false;
+        }
+
+        out |= 1ull << std::distance(infos.begin(), it);
+    }
+
+    // OK
+    return true;
+}
+
+int main(int argc, char *const argv[]) {
+    argparse::ArgumentParser argParser("GPU Reshape - Vulkan Offline Compiler");
+
+    // Setup parameters
+    argParser.add_argument("-input").help("Module file or corpus directory").required();
+    argParser.add_argument("-output").help("Optional, directory of the instrumented modules").default_value(std::string(""));
+    argParser.add_argument("-json").help("Optional, report json file, written to stdout if empty").default_value(std::string(""));
+    argParser.add_argument("-features").help("Comma separated feature names, or all").default_value(std::string("all"));
+    argParser.add_argument("-iterations").help("Number of compilations per module").default_value(std::string("1"));
+    argParser.add_argument("-baseline").help("Optional, report json to compare against").default_value(std::string(""));
+    argParser.add_argument("-tolerance").help("Allowed relative slowdown against the baseline").default_value(std::string("0.1"));
+    argParser.add_argument("-serial").help("Parse all function bodies serially").default_value(false).implicit_value(true);
+    argParser.add_argument("-wave-aggregation").help("Aggregate exports across waves").default_value(false).implicit_value(true);
+
+    // Attempt to parse the input
+    try {
+        argParser.parse_args(argc, argv);
+    } catch (const std::runtime_error &err) {
+        std::cerr << err.what() << std::endl;
+        std::cerr << argParser;
+        return 1;
+    }
+
+    // Arguments
+    auto &&inputPath = argParser.get<std::string>("-input");
+    auto &&outputPath = argParser.get<std::string>("-output");
+    auto &&jsonPath = argParser.get<std::string>("-json");
+    auto &&featureNames = argParser.get<std::string>("-features");
+    auto &&baselinePath = argParser.get<std::string>("-baseline");
+    uint32_t iterations = std::max(1, std::stoi(argParser.get<std::string>("-iterations")));
+    double tolerance = std::stod(argParser.get<std::string>("-tolerance"));
+
+    // Compiler info
+    OfflineCompilerInfo info;
+    info.parallelParse = !argParser.get<bool>("-serial");
+    info.waveAggregation = argParser.get<bool>("-wave-aggregation");
+
+    // Try to install the compiler
+    OfflineCompiler compiler;
+    if (!compiler.Install(info)) {
+        std::cerr << "Failed to install offline compiler" << std::endl;
+        return 1;
+    }
+
+    // Get the features to inject
+    uint64_t featureBitSet{0};
+    if (!GetFeatureBitSet(compiler, featureNames, featureBitSet)) {
+        return 1;
+    }
+
+    // Collect all modules
+    std::vector<std::filesystem::path> modulePaths;
+    CollectModules(inputPath, modulePaths);
+
+    // Create output directory if requested
+    if (!outputPath.empty()) {
+        std::filesystem::create_directories(outputPath);
+    }
+
+    // Report
+    nlohmann::json report;
+    report["iterations"] = iterations;
+    report["parallelParse"] = info.parallelParse;
+    report["waveAggregation"] = info.waveAggregation;
+
+    // Report all injected features
+    const std::vector<FeatureInfo>& featureInfos = compiler.GetFeatureInfos();
+    for (size_t i = 0; i < featureInfos.size(); i++) {
+        if (featureBitSet & (1ull << i)) {
+            report["features"].push_back(featureInfos[i].name);
+        }
+    }
+
+    // Summed timings
+    OfflineCompilerTimings totals;
+    totals.inject.resize(featureInfos.size(), 0u);
+
+    // Number of failed modules
+    uint32_t failedCount{0};
+
+    // Compile all modules
+    for (const std::filesystem::path& path : modulePaths) {
+        nlohmann::json& moduleReport = report["modules"].emplace_back();
+        moduleReport["path"] = path.generic_string();
+
+        // Read the module
+        std::ifstream stream(path, std::ios::binary);
+        std::vector<uint32_t> code((std::filesystem::file_size(path) + 3) / sizeof(uint32_t));
+        stream.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(std::filesystem::file_size(path)));
+
+        // Determine the container
+        if (code.empty() || code[0] != SpvMagicNumber) {
+            moduleReport["status"] = !code.empty() && code[0] == kDXBCMagic ? "unsupported" : "invalid";
+            continue;
+        }
+
+        // Compile all iterations, keep the fastest
+        OfflineCompilerResult result;
+        OfflineCompilerTimings fastest;
+        uint64_t fastestTotal = UINT64_MAX;
+        bool passed = true;
+        for (uint32_t iteration = 0; iteration < iterations && passed; iteration++) {
+            passed = compiler.Compile(code.data(), static_cast<uint32_t>(code.size()), featureBitSet, result);
+
+            // Total time of this iteration
+            uint64_t total = result.timings.parse + result.timings.copy + result.timings.reorder + result.timings.compile + result.timings.stitch;
+            for (uint64_t inject : result.timings.inject) {
+                total += inject;
+            }
+
+            // Faster?
+            if (total < fastestTotal) {
+                fastest = result.timings;
+                fastestTotal = total;
+            }
+        }
+
+        // Report the instrumented module
+        moduleReport["status"] = passed ? "ok" : "failed";
+        moduleReport["words"] = code.size();
+        moduleReport["instrumentedWords"] = result.code.size();
+        moduleReport["functions"] = result.functionCount;
+        moduleReport["basicBlocks"] = result.basicBlockCount;
+        moduleReport["instructions"] = result.instructionCount;
+
+        // Failed?
+        if (!passed) {
+            failedCount++;
+            continue;
+        }
+
+        // Report the fastest timings, in milliseconds
+        nlohmann::json& timings = moduleReport["timings"];
+        timings["parse"] = ToMilliseconds(fastest.parse);
+        timings["copy"] = ToMilliseconds(fastest.copy);
+        timings["reorder"] = ToMilliseconds(fastest.reorder);
+        timings["compile"] = ToMilliseconds(fastest.compile);
+        timings["stitch"] = ToMilliseconds(fastest.stitch);
+        timings["total"] = ToMilliseconds(fastestTotal);
+
+        // Report injection per feature
+        for (size_t i = 0; i < featureInfos.size(); i++) {
+            if (featureBitSet & (1ull << i)) {
+                timings["inject"][featureInfos[i].name] = ToMilliseconds(fastest.inject[i]);
+                totals.inject[i] += fastest.inject[i];
+            }
+        }
+
+        // Accumulate
+        totals.parse += fastest.parse;
+        totals.copy += fastest.copy;
+        totals.reorder += fastest.reorder;
+        totals.compile += fastest.compile;
+        totals.stitch += fastest.stitch;
+
+        // Write the instrumented module
+        if (!outputPath.empty()) {
+            std::ofstream out(std::filesystem::path(outputPath) / path.filename(), std::ios::binary);
+            out.write(reinterpret_cast<const char*>(result.code.data()), static_cast<std::streamsize>(result.code.size() * sizeof(uint32_t)));
+        }
+    }
+
+    // Summarize totals, in milliseconds
+    uint64_t total = totals.parse + totals.copy + totals.reorder + totals.compile + totals.stitch;
+    nlohmann::json& totalReport = report["totals"];
+    totalReport["parse"] = ToMilliseconds(totals.parse);
+    totalReport["copy"] = ToMilliseconds(totals.copy);
+    totalReport["reorder"] = ToMilliseconds(totals.reorder);
+    totalReport["compile"] = ToMilliseconds(totals.compile);
+    totalReport["stitch"] = ToMilliseconds(totals.stitch);
+    for (size_t i = 0; i < featureInfos.size(); i++) {
+        if (featureBitSet & (1ull << i)) {
+            totalReport["inject"][featureInfos[i].name] = ToMilliseconds(totals.inject[i]);
+            total += totals.inject[i];
+        }
+    }
+    totalReport["total"] = ToMilliseconds(total);
+    totalReport["failed"] = failedCount;
+
+    // Write the report
+    if (jsonPath.empty()) {
+        std::cout << report.dump(4) << std::endl;
+    } else {
+        std::ofstream out(jsonPath);
+        out << report.dump(4) << std::endl;
+    }
+
+    // Any failures?
+    if (failedCount) {
+        std::cerr << failedCount << " module(s) failed to compile" << std::endl;
+        return 1;
+    }
+
+    // Compare against the baseline if requested
+    if (!baselinePath.empty()) {
+        std::ifstream stream(baselinePath);
+        if (!stream.good()) {
+            std::cerr << "Failed to open baseline json file: " << baselinePath << std::endl;
+            return 1;
+        }
+
+        // Parse json
+        nlohmann::json baseline{};
+        try {
+            stream >> baseline;
+        } catch(nlohmann::json::exception& ex) {
+            std::cerr << "Failed to parse baseline json file: " << baselinePath << ", " << ex.what() << std::endl;
+            return 1;
+        }
+
+        // Compare the aggregate, individual modules are too noisy
+        double baselineTotal = baseline["totals"].value("total", 0.0);
+        if (baselineTotal > 0.0 && ToMilliseconds(total) > baselineTotal * (1.0 + tolerance)) {
+            std::cerr << "Compiler regression, " << ToMilliseconds(total) << "ms against a baseline of " << baselineTotal << "ms" << std::endl;
+            return 1;
+        }
+    }
+
+    // OK
+    return 0;
+}
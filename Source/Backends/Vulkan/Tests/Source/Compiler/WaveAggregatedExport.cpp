@@ -0,0 +1,240 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+// Catch2
+#include <catch2/catch.hpp>
+
+// Layer
+#include <Backends/Vulkan/Compiler/SpvModule.h>
+#include <Backends/Vulkan/Compiler/SpvJob.h>
+#include <Backends/Vulkan/Compiler/Spv.h>
+#include <Backends/Vulkan/States/PipelineLayoutPhysicalMapping.h>
+
+// Backend
+#include <Backend/IL/Program.h>
+#include <Backend/IL/Emitter.h>
+
+// Data
+#include <Data/WaveExportVulkan.h>
+
+// Std
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/// Summary of a recompiled module
+struct WaveExportSummary {
+    /// Module version
+    uint32_t version{0};
+
+    /// Number of ballot capabilities
+    uint32_t ballotCapabilityCount{0};
+
+    /// Number of ballots
+    uint32_t ballotCount{0};
+
+    /// Number of atomic reservations
+    uint32_t atomicCount{0};
+
+    /// Number of atomic reservations in elected blocks
+    uint32_t electedAtomicCount{0};
+
+    /// Number of phi parents not branching to the phi block
+    uint32_t invalidPhiParentCount{0};
+};
+
+/// Recompile the test module with an export in every block
+/// \param waveAggregation enable wave aggregation
+/// \param exportCount number of injected exports
+/// \return summary of the recompiled module
+static WaveExportSummary RecompileWithExports(bool waveAggregation, uint32_t& exportCount) {
+    Allocators allocators;
+
+    // Parse the source module
+    SpvModule sourceModule(allocators, 0u);
+    REQUIRE(sourceModule.ParseModule(reinterpret_cast<const uint32_t*>(kSPIRVWaveExportVulkan), static_cast<uint32_t>(sizeof(kSPIRVWaveExportVulkan) / sizeof(uint32_t))));
+
+    // Copy, don't modify the source
+    SpvModule* module = sourceModule.Copy();
+
+    // Toggle aggregation
+    IL::Program& program = *module->GetProgram();
+    program.GetCapabilityTable().hasWaveAggregation &= waveAggregation;
+
+    // Exported constant
+    const Backend::IL::Constant* value = program.GetConstants().FindConstantOrAdd(
+        program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType{.bitWidth = 32, .signedness = false}),
+        Backend::IL::IntConstant{.value = 42}
+    );
+
+    // Export from every block, including loop headers and phi blocks
+    exportCount = 0;
+    for (IL::Function* fn : program.GetFunctionList()) {
+        for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+            IL::Emitter<>(program, *bb, bb->GetTerminator()).Export(0u, value->id);
+            exportCount++;
+        }
+    }
+
+    // Single user set, single export stream
+    PipelineLayoutPhysicalMapping physicalMapping;
+    physicalMapping.descriptorSets.resize(1);
+    physicalMapping.descriptorSets[0].bindings.resize(1);
+    physicalMapping.descriptorSets[0].bindings[0].bindingCount = 1;
+
+    // Create the job, see OfflineCompiler::CreateJob
+    SpvJob job;
+    job.instrumentationKey.physicalMapping = &physicalMapping;
+    job.instrumentationKey.pipelineLayoutUserSlots = 1;
+    job.bindingInfo.counterDescriptorOffset = 0;
+    job.bindingInfo.streamDescriptorOffset = 1;
+    job.bindingInfo.streamDescriptorCount = 1;
+    job.bindingInfo.prmtDescriptorOffset = 2;
+    job.bindingInfo.descriptorDataDescriptorOffset = 3;
+    job.bindingInfo.descriptorDataDescriptorLength = 65'536;
+    job.bindingInfo.shaderDataConstantsDescriptorOffset = 4;
+    job.bindingInfo.shaderDataDescriptorOffset = 5;
+
+    // Compile in stages
+    REQUIRE(module->ReorderForCompilation());
+    REQUIRE(module->CompilePhysicalBlocks(job));
+    module->Stitch();
+
+    // Recompiled code
+    const uint32_t* code = module->GetCode();
+    auto wordCount = static_cast<uint32_t>(module->GetSize() / sizeof(uint32_t));
+
+    WaveExportSummary summary;
+    summary.version = code[1];
+
+    // Control flow edges and elected blocks
+    std::unordered_map<uint32_t, std::unordered_set<uint32_t>> successors;
+    std::unordered_set<uint32_t> electIds;
+    std::unordered_set<uint32_t> electedLabels;
+
+    // Phis, (block, parent)
+    std::vector<std::pair<uint32_t, uint32_t>> phiParents;
+
+    // Collect all edges
+    uint32_t label = 0;
+    for (uint32_t offset = 5; offset < wordCount;) {
+        const uint32_t* instr = code + offset;
+        uint32_t instrWordCount = instr[0] >> SpvWordCountShift;
+        REQUIRE(instrWordCount > 0);
+
+        switch (static_cast<SpvOp>(instr[0] & SpvOpCodeMask)) {
+            default:
+                break;
+            case SpvOpCapability:
+                summary.ballotCapabilityCount += instr[1] == SpvCapabilityGroupNonUniformBallot;
+                break;
+            case SpvOpLabel:
+                label = instr[1];
+                break;
+            case SpvOpBranch:
+                successors[label].insert(instr[1]);
+                break;
+            case SpvOpBranchConditional:
+                successors[label].insert(instr[2]);
+                successors[label].insert(instr[3]);
+
+                // Branching on an election?
+                if (electIds.count(instr[1])) {
+                    electedLabels.insert(instr[2]);
+                }
+                break;
+            case SpvOpSwitch:
+                successors[label].insert(instr[2]);
+                for (uint32_t i = 4; i < instrWordCount; i += 2) {
+                    successors[label].insert(instr[i]);
+                }
+                break;
+            case SpvOpPhi:
+                for (uint32_t i = 4; i < instrWordCount; i += 2) {
+                    phiParents.emplace_back(label, instr[i]);
+                }
+                break;
+            case SpvOpGroupNonUniformElect:
+                electIds.insert(instr[2]);
+                break;
+            case SpvOpGroupNonUniformBallot:
+                summary.ballotCount++;
+                break;
+            case SpvOpAtomicIAdd:
+                summary.atomicCount++;
+                summary.electedAtomicCount += electedLabels.count(label) > 0;
+                break;
+        }
+
+        offset += instrWordCount;
+    }
+
+    // Validate all phi parents
+    for (auto&& [block, parent] : phiParents) {
+        summary.invalidPhiParentCount += !successors[parent].count(block);
+    }
+
+    // Cleanup
+    destroy(module, allocators);
+
+    // OK
+    return summary;
+}
+
+TEST_CASE("Backends.Vulkan.Compiler.WaveAggregatedExport", "[Vulkan]") {
+    uint32_t exportCount;
+    WaveExportSummary summary = RecompileWithExports(true, exportCount);
+
+    // Group operations require 1.3
+    REQUIRE(summary.version >= 0x00010300);
+    REQUIRE(summary.ballotCapabilityCount == 1);
+
+    // One reservation per export, loop headers remain per lane
+    REQUIRE(summary.atomicCount == exportCount);
+    REQUIRE(summary.ballotCount > 0);
+    REQUIRE(summary.ballotCount < exportCount);
+
+    // All aggregated reservations are made by the elected lane
+    REQUIRE(summary.electedAtomicCount == summary.ballotCount);
+
+    // Splitting must not break successor phis
+    REQUIRE(summary.invalidPhiParentCount == 0);
+}
+
+TEST_CASE("Backends.Vulkan.Compiler.WaveAggregatedExport.Disabled", "[Vulkan]") {
+    uint32_t exportCount;
+    WaveExportSummary summary = RecompileWithExports(false, exportCount);
+
+    // Source version is retained
+    REQUIRE(summary.version == reinterpret_cast<const uint32_t*>(kSPIRVWaveExportVulkan)[1]);
+    REQUIRE(summary.ballotCapabilityCount == 0);
+
+    // Per lane reservations
+    REQUIRE(summary.ballotCount == 0);
+    REQUIRE(summary.atomicCount == exportCount);
+    REQUIRE(summary.electedAtomicCount == 0);
+    REQUIRE(summary.invalidPhiParentCount == 0);
+}
@@ -33,6 +33,7 @@
 #include <Backend/IFeature.h>
 #include <Backend/IShaderFeature.h>
 #include <Backend/ShaderExport.h>
+#include <Backend/ShaderExportFilter.h>
 #include <Backend/ShaderData/IShaderDataHost.h>
 #include <Backend/IL/BasicBlock.h>
 #include <Backend/IL/VisitContext.h>
@@ -76,6 +77,8 @@ public:
 
 public:
     /// Proxies
+    void OnOpen(CommandContext* context);
+    void OnPreSubmit(CommandContextHandle contextHandle);
     void OnDrawInstanced(CommandContext* context, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance);
     void OnDrawIndexedInstanced(CommandContext* context, uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance);
     void OnDispatch(CommandContext* context, uint32_t threadGroupX, uint32_t threadGroupY, uint32_t threadGroupZ);
@@ -92,6 +95,9 @@ private:
     ShaderDataID lockBufferID{InvalidShaderDataID};
     ShaderDataID eventID{InvalidShaderDataID};
 
+    /// Device side duplicate filter
+    ShaderExportFilter exportFilter;
+
     /// Cyclic event counter
     std::atomic<uint32_t> eventCounter{720};
 
@@ -74,12 +74,19 @@ bool ConcurrencyFeature::Install() {
     //   ? Lightweight event data
     eventID = shaderDataHost->CreateEventData(ShaderDataEventInfo { });
 
+    // Install the duplicate filter
+    if (!exportFilter.Install(shaderDataHost, exportID)) {
+        return false;
+    }
+
     // OK
     return true;
 }
 
 FeatureHookTable ConcurrencyFeature::GetHookTable() {
     FeatureHookTable table{};
+    table.open = BindDelegate(this, ConcurrencyFeature::OnOpen);
+    table.preSubmit = BindDelegate(this, ConcurrencyFeature::OnPreSubmit);
     table.dispatch = BindDelegate(this, ConcurrencyFeature::OnDispatch);
     table.drawInstanced = BindDelegate(this, ConcurrencyFeature::OnDrawInstanced);
     table.drawIndexedInstanced = BindDelegate(this, ConcurrencyFeature::OnDrawIndexedInstanced);
@@ -92,6 +99,9 @@ void ConcurrencyFeature::CollectExports(const MessageStream &exports) {
 
 void ConcurrencyFeature::CollectMessages(IMessageStorage *storage) {
     storage->AddStreamAndSwap(stream);
+
+    // Report filter statistics
+    exportFilter.CollectMessages(storage);
 }
 
 void ConcurrencyFeature::Inject(IL::Program &program, const MessageStreamView<> &specialization) {
@@ -204,8 +214,12 @@ void ConcurrencyFeature::Inject(IL::Program &program, const MessageStreamView<>
             msg.detail.token = token.GetToken();
         }
         
-        // Export the message
-        oob.Export(exportID, msg);
+        // Export the message, optionally only first occurrences
+        if (config.filterDuplicates) {
+            exportFilter.Export(program, oob, context.function.GetBasicBlocks(), msg);
+        } else {
+            oob.Export(exportID, msg);
+        }
 
         // Branch back
         oob.Branch(resumeBlock);
@@ -237,6 +251,16 @@ FeatureInfo ConcurrencyFeature::GetInfo() {
     return info;
 }
 
+void ConcurrencyFeature::OnOpen(CommandContext *context) {
+    // Assign the filter epoch slot
+    exportFilter.OnOpen(context);
+}
+
+void ConcurrencyFeature::OnPreSubmit(CommandContextHandle contextHandle) {
+    // New filter epoch
+    exportFilter.OnPreSubmit(contextHandle);
+}
+
 void ConcurrencyFeature::OnDrawInstanced(CommandContext *context, uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance) {
     // Assign next event UID, small chance of collision if any event lingers past UINT32_MAX
     context->eventStack.Set(eventID, eventCounter++);
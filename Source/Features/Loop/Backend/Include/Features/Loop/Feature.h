@@ -36,6 +36,8 @@
 #include <Backend/ShaderData/IShaderDataHost.h>
 #include <Backend/IL/BasicBlock.h>
 #include <Backend/IL/VisitContext.h>
+#include <Backend/IL/BasicBlockList.h>
+#include <Backend/IL/CFG/DominatorTree.h>
 
 // Message
 #include <Message/MessageStream.h>
@@ -43,6 +45,7 @@
 // Std
 #include <atomic>
 #include <unordered_map>
+#include <vector>
 #include <chrono>
 #include <thread>
 #include <mutex>
@@ -101,6 +104,28 @@ private:
     /// Allocate a new termination id
     uint32_t AllocateTerminationIDNoLock();
 
+private:
+    /// Default number of loop iterations between termination polls
+    static constexpr uint32_t kDefaultIterationPollInterval = 64;
+
+    /// All edges from unreachable blocks, keyed by the successor
+    ///   ? The dominator tree only maps edges from reachable blocks
+    using UnreachableEdgeMap = std::unordered_map<IL::ID, std::vector<IL::BasicBlock*>>;
+
+    /// Gather all edges from unreachable blocks
+    /// \param dominatorTree computed dominators of the function
+    /// \param out destination edges
+    void GatherUnreachableEdges(const IL::DominatorTree& dominatorTree, UnreachableEdgeMap& out);
+
+    /// Emit a per-invocation iteration counter for a loop
+    ///   ? Must be emitted before the loop header is split, the increment is placed at the end of the header
+    /// \param program program being instrumented
+    /// \param dominatorTree dominators of the current state of the owning function
+    /// \param unreachableEdges all edges from unreachable blocks of the owning function
+    /// \param header loop header, receives the counter phi
+    /// \return the counter value at the start of the current iteration
+    IL::ID EmitIterationCounter(IL::Program& program, const IL::DominatorTree& dominatorTree, const UnreachableEdgeMap& unreachableEdges, IL::BasicBlock* header);
+
 private:
     struct CommandContextState {
         /// Time point of the submission
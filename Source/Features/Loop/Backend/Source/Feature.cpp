@@ -42,14 +42,21 @@
 
 // Generated schema
 #include <Schemas/Features/Loop.h>
+#include <Schemas/Instrumentation.h>
+#include <Schemas/InstrumentationCommon.h>
 
 // Message
 #include <Message/IMessageStorage.h>
+#include <Message/MessageStreamCommon.h>
 
 // Common
 #include <Common/Registry.h>
 #include <Common/Sink.h>
 
+// Std
+#include <bit>
+#include <algorithm>
+
 LoopFeature::LoopFeature() {
     // Start the heart beat thread
     heartBeatThread = std::thread(&LoopFeature::HeartBeatThreadWorker, this);
@@ -120,8 +127,57 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
     // Get the program capabilities
     const IL::CapabilityTable &capabilityTable = program.GetCapabilityTable();
 
+    // Get the loop configuration
+    const SetLoopInstrumentationConfigMessage config = CollapseOrDefault<SetLoopInstrumentationConfigMessage>(specialization, SetLoopInstrumentationConfigMessage {
+        .iterationPollInterval = kDefaultIterationPollInterval
+    });
+
+    // Polling mask, the interval is rounded up to the next power of two
+    // A mask of zero polls on every iteration with atomics, matching the legacy behaviour
+    uint32_t pollMask = 0;
+    if (config.iterationPollInterval > 1u) {
+        pollMask = std::bit_ceil(config.iterationPollInterval) - 1u;
+    }
+
     // If the program has structured control flow, we can take quite a few liberties in instrumentation
     if (capabilityTable.hasControlFlow) {
+        // All iteration counters, keyed by the loop header
+        std::unordered_map<IL::ID, IL::ID> iterationCounters;
+
+        // Emit the iteration counters while all loop blocks are intact
+        if (pollMask) {
+            for (IL::Function *fn: program.GetFunctionList()) {
+                if (fn->HasFlag(FunctionFlag::NoInstrumentation)) {
+                    continue;
+                }
+
+                // Counters do not alter the cfg, the same dominators serve all loops of the function
+                IL::DominatorTree dominatorTree(fn->GetBasicBlocks());
+                dominatorTree.Compute();
+
+                // Gather the edges not mapped by the tree
+                UnreachableEdgeMap unreachableEdges;
+                GatherUnreachableEdges(dominatorTree, unreachableEdges);
+
+                for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+                    if (bb->IsEmpty() || bb->HasFlag(BasicBlockFlag::NoInstrumentation)) {
+                        continue;
+                    }
+
+                    // Must be an instrumented loop header, see the visitor below
+                    auto terminator = bb->GetTerminator();
+                    IL::BranchControlFlow controlFlow;
+                    if (!terminator->IsUserInstruction() || !Backend::IL::GetControlFlow(terminator, controlFlow) || controlFlow._continue == IL::InvalidID) {
+                        continue;
+                    }
+
+                    if (terminator->opCode == IL::OpCode::Branch || terminator->opCode == IL::OpCode::BranchConditional) {
+                        iterationCounters[bb->GetID()] = EmitIterationCounter(program, dominatorTree, unreachableEdges, bb);
+                    }
+                }
+            }
+        }
+
         // Visit all instructions
         IL::VisitUserInstructions(program, [&](IL::VisitContext &context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
             IL::BranchControlFlow controlFlow;
@@ -137,6 +193,12 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
             // Bind the SGUID
             ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
 
+            // Get the iteration counter, if any
+            IL::ID iterationCounterID = IL::InvalidID;
+            if (auto counterIt = iterationCounters.find(context.basicBlock.GetID()); counterIt != iterationCounters.end()) {
+                iterationCounterID = counterIt->second;
+            }
+
             // Get merge block
             // On termination this is the block we reach
             IL::BasicBlock* mergeBlock = context.function.GetBasicBlocks().GetBlock(controlFlow.merge);
@@ -191,7 +253,36 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
             entryBlock->Split(postEntry, entryBlock->begin());
 
             // Emit into pre-guard
-            {
+            if (iterationCounterID != IL::InvalidID) {
+                IL::BasicBlock *pollBlock = basicBlocks.AllocBlock();
+                IL::BasicBlock *pollMergeBlock = basicBlocks.AllocBlock();
+
+                // Only poll on every n'th iteration
+                IL::Emitter<> pre(program, *entryBlock);
+                IL::ID skippedID = pre.UInt32(0u);
+                pre.BranchConditional(
+                    pre.Equal(pre.BitAnd(iterationCounterID, pre.UInt32(pollMask)), pre.UInt32(0u)),
+                    pollBlock,
+                    pollMergeBlock,
+                    IL::ControlFlow::Selection(pollMergeBlock)
+                );
+
+                // Atomically read the termination data, the host may write it at any point during execution,
+                // so only the polling frequency is amortized, never the coherency of the read
+                IL::Emitter<> poll(program, *pollBlock);
+                IL::ID polledID = poll.AtomicAnd(poll.AddressOf(terminationBufferDataID, terminationAllocationDataID), poll.UInt32(1u));
+                poll.Branch(pollMergeBlock);
+
+                // Early exit if termination was requested
+                IL::Emitter<> merge(program, *pollMergeBlock);
+                IL::ID terminationID = merge.Phi(entryBlock, skippedID, pollBlock, polledID);
+                merge.BranchConditional(
+                    merge.Equal(terminationID, merge.UInt32(1u)),
+                    terminationBlock,
+                    selectionMerge,
+                    IL::ControlFlow::Selection(selectionMerge)
+                );
+            } else {
                 IL::Emitter<> pre(program, *entryBlock);
 
                 // Atomically read the termination data
@@ -247,10 +338,14 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
     } else {
         // The program does not have structured control flow, therefore we need to perform cfg loop analysis, and pray.
         for (IL::Function *fn: program.GetFunctionList()) {
-            // Computer all dominators
+            // Computer all dominators, kept current with the edits of each loop
             IL::DominatorTree dominatorTree(fn->GetBasicBlocks());
             dominatorTree.Compute();
 
+            // Gather the edges not mapped by the tree, unreachable blocks are never edited
+            UnreachableEdgeMap unreachableEdges;
+            GatherUnreachableEdges(dominatorTree, unreachableEdges);
+
             // Compute all loops
             IL::LoopTree loopTree(dominatorTree);
             loopTree.Compute();
@@ -262,6 +357,12 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
                    continue;
                 }
 
+                // Emit the iteration counter while all loop blocks are intact
+                IL::ID iterationCounterID = IL::InvalidID;
+                if (pollMask) {
+                    iterationCounterID = EmitIterationCounter(program, dominatorTree, unreachableEdges, loop.header);
+                }
+
                 // Allocate blocks
                 IL::BasicBlock* postGuardBlock   = fn->GetBasicBlocks().AllocBlock();
                 IL::BasicBlock *terminationBlock = fn->GetBasicBlocks().AllocBlock();
@@ -271,9 +372,44 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
 
                 // Split just prior to loop header
                 loop.header->Split(postGuardBlock, loop.header->GetTerminator());
+                dominatorTree.SplitBlock(loop.header, postGuardBlock);
 
                 // Emit into pre-guard
-                {
+                if (iterationCounterID != IL::InvalidID) {
+                    IL::BasicBlock *pollBlock = fn->GetBasicBlocks().AllocBlock();
+                    IL::BasicBlock *pollMergeBlock = fn->GetBasicBlocks().AllocBlock();
+
+                    // Only poll on every n'th iteration
+                    IL::Emitter<> pre(program, *loop.header);
+                    IL::ID skippedID = pre.UInt32(0u);
+                    pre.BranchConditional(
+                        pre.Equal(pre.BitAnd(iterationCounterID, pre.UInt32(pollMask)), pre.UInt32(0u)),
+                        pollBlock,
+                        pollMergeBlock,
+                        IL::ControlFlow::None()
+                    );
+
+                    // Atomically read the termination data, the host may write it at any point during execution,
+                    // so only the polling frequency is amortized, never the coherency of the read
+                    IL::Emitter<> poll(program, *pollBlock);
+                    IL::ID polledID = poll.AtomicAnd(poll.AddressOf(terminationBufferDataID, terminationAllocationDataID), poll.UInt32(1u));
+                    poll.Branch(pollMergeBlock);
+
+                    // Early exit if termination was requested
+                    IL::Emitter<> merge(program, *pollMergeBlock);
+                    IL::ID terminationID = merge.Phi(loop.header, skippedID, pollBlock, polledID);
+                    merge.BranchConditional(
+                        merge.Equal(terminationID, merge.UInt32(1u)),
+                        terminationBlock,
+                        postGuardBlock,
+                        IL::ControlFlow::None()
+                    );
+
+                    // header -> (poll | merge) -> (termination | post-guard)
+                    dominatorTree.SplitBlock(loop.header, pollMergeBlock);
+                    dominatorTree.InsertSideBlock(loop.header, pollBlock, pollMergeBlock);
+                    dominatorTree.InsertSideBlock(pollMergeBlock, terminationBlock, nullptr);
+                } else {
                     IL::Emitter<> pre(program, *loop.header);
 
                     // Atomically read the termination data
@@ -286,6 +422,9 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
                         postGuardBlock,
                         IL::ControlFlow::None()
                     );
+
+                    // header -> (termination | post-guard)
+                    dominatorTree.InsertSideBlock(loop.header, terminationBlock, nullptr);
                 }
 
                 // Emit into termination block
@@ -306,6 +445,107 @@ void LoopFeature::Inject(IL::Program &program, const MessageStreamView<> &specia
     }
 }
 
+void LoopFeature::GatherUnreachableEdges(const IL::DominatorTree& dominatorTree, UnreachableEdgeMap& out) {
+    for (IL::BasicBlock* bb : dominatorTree.GetBasicBlocks()) {
+        // Reachable blocks are mapped by the tree
+        if (bb->IsEmpty() || dominatorTree.GetImmediateDominator(bb)) {
+            continue;
+        }
+
+        // Add a single edge per successor, a block may branch to the same successor more than once
+        auto addEdge = [&](IL::ID successor) {
+            std::vector<IL::BasicBlock*>& predecessors = out[successor];
+            if (predecessors.empty() || predecessors.back() != bb) {
+                predecessors.push_back(bb);
+            }
+        };
+
+        // Get the terminator
+        auto terminator = bb->GetTerminator();
+
+        // Handle terminator
+        switch (terminator->opCode) {
+            default:
+                break;
+            case IL::OpCode::Branch: {
+                addEdge(terminator->As<IL::BranchInstruction>()->branch);
+                break;
+            }
+            case IL::OpCode::BranchConditional: {
+                auto* instr = terminator->As<IL::BranchConditionalInstruction>();
+                addEdge(instr->pass);
+                addEdge(instr->fail);
+                break;
+            }
+            case IL::OpCode::Switch: {
+                auto* instr = terminator->As<IL::SwitchInstruction>();
+                addEdge(instr->_default);
+                for (uint32_t caseIndex = 0; caseIndex < instr->cases.count; caseIndex++) {
+                    addEdge(instr->cases[caseIndex].branch);
+                }
+                break;
+            }
+        }
+    }
+}
+
+IL::ID LoopFeature::EmitIterationCounter(IL::Program& program, const IL::DominatorTree& dominatorTree, const UnreachableEdgeMap& unreachableEdges, IL::BasicBlock* header) {
+    // Zero constant, used for all entering edges
+    const Backend::IL::Constant* zero = program.GetConstants().FindConstantOrAdd(
+        program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType{.bitWidth=32, .signedness=false}),
+        Backend::IL::IntConstant{.value=0}
+    );
+
+    // Gather all incoming edges, each block is only a single edge
+    std::vector<IL::BasicBlock*> predecessors;
+    for (IL::BasicBlock* predecessor : dominatorTree.GetPredecessors(header)) {
+        if (std::find(predecessors.begin(), predecessors.end(), predecessor) == predecessors.end()) {
+            predecessors.push_back(predecessor);
+        }
+    }
+
+    // Phis must account for all predecessors, including unreachable ones
+    if (auto edgeIt = unreachableEdges.find(header->GetID()); edgeIt != unreachableEdges.end()) {
+        predecessors.insert(predecessors.end(), edgeIt->second.begin(), edgeIt->second.end());
+    }
+
+    // Unreachable header, the counter never advances
+    if (predecessors.empty()) {
+        return zero->id;
+    }
+
+    // Default all incoming values to zero, back edges are fixed up once the next counter is known
+    auto* values = ALLOCA_ARRAY(IL::PhiValue, predecessors.size());
+    for (size_t i = 0; i < predecessors.size(); i++) {
+        values[i] = IL::PhiValue {
+            .value = zero->id,
+            .branch = predecessors[i]->GetID()
+        };
+    }
+
+    // Emit the placeholder counter phi, must be the first instruction of the header
+    IL::ID counterID = program.GetIdentifierMap().AllocID();
+    IL::OpaqueInstructionRef phiRef = IL::Emitter<>(program, *header, header->begin()).Phi(counterID, static_cast<uint32_t>(predecessors.size()), values);
+
+    // Increment the counter at the end of the header, visible to all back edges
+    IL::Emitter<> inc(program, *header, header->GetTerminator());
+    IL::ID nextID = inc.Add(counterID, inc.UInt32(1u));
+
+    // Back edges carry the incremented counter
+    // A block is a back edge if the header dominates it, which includes the header itself
+    for (size_t i = 0; i < predecessors.size(); i++) {
+        if (predecessors[i] == header || dominatorTree.Dominates(header, predecessors[i])) {
+            values[i].value = nextID;
+        }
+    }
+
+    // Replace the placeholder
+    IL::Emitter<IL::Op::Replace>(program, header->GetIterator(phiRef)).Phi(counterID, static_cast<uint32_t>(predecessors.size()), values);
+
+    // OK
+    return counterID;
+}
+
 FeatureInfo LoopFeature::GetInfo() {
     FeatureInfo info;
     info.name = "Loop";
@@ -0,0 +1,392 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <catch2/catch.hpp>
+
+// Loop
+#include <Features/Loop/Feature.h>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/CFG/DominatorTree.h>
+#include <Backend/IShaderExportHost.h>
+#include <Backend/ShaderData/IShaderDataHost.h>
+
+// Schemas
+#include <Schemas/Instrumentation.h>
+
+// Common
+#include <Common/Registry.h>
+
+// Std
+#include <vector>
+#include <algorithm>
+
+class TestShaderExportHost final : public IShaderExportHost {
+public:
+    ShaderExportID Allocate(const ShaderExportTypeInfo& typeInfo) override {
+        return 0;
+    }
+
+    ShaderExportTypeInfo GetTypeInfo(ShaderExportID id) override {
+        return {};
+    }
+
+    void Enumerate(uint32_t* count, ShaderExportID* out) override {
+        *count = 0;
+    }
+
+    uint32_t GetBound() override {
+        return 1;
+    }
+};
+
+class TestShaderDataHost final : public IShaderDataHost {
+public:
+    ShaderDataID CreateBuffer(const ShaderDataBufferInfo& info) override {
+        ShaderDataInfo& data = datas.emplace_back();
+        data.id = static_cast<ShaderDataID>(datas.size() - 1);
+        data.type = ShaderDataType::Buffer;
+        data.buffer = info;
+        return data.id;
+    }
+
+    ShaderDataID CreateEventData(const ShaderDataEventInfo& info) override {
+        ShaderDataInfo& data = datas.emplace_back();
+        data.id = static_cast<ShaderDataID>(datas.size() - 1);
+        data.type = ShaderDataType::Event;
+        data.event = info;
+        return data.id;
+    }
+
+    ShaderDataID CreateDescriptorData(const ShaderDataDescriptorInfo& info) override {
+        ShaderDataInfo& data = datas.emplace_back();
+        data.id = static_cast<ShaderDataID>(datas.size() - 1);
+        data.type = ShaderDataType::Descriptor;
+        data.descriptor = info;
+        return data.id;
+    }
+
+    void* Map(ShaderDataID rid) override {
+        return nullptr;
+    }
+
+    void FlushMappedRange(ShaderDataID rid, size_t offset, size_t length) override {
+
+    }
+
+    void Destroy(ShaderDataID rid) override {
+
+    }
+
+    void Enumerate(uint32_t* count, ShaderDataInfo* out, ShaderDataTypeSet mask) override {
+        if (out) {
+            std::copy(datas.begin(), datas.begin() + *count, out);
+        } else {
+            *count = static_cast<uint32_t>(datas.size());
+        }
+    }
+
+    /// All created data
+    std::vector<ShaderDataInfo> datas;
+};
+
+/// Loop blocks of the test program
+struct TestLoopProgram {
+    IL::BasicBlock* entry{nullptr};
+    IL::BasicBlock* header{nullptr};
+    IL::BasicBlock* body{nullptr};
+    IL::BasicBlock* _continue{nullptr};
+    IL::BasicBlock* exit{nullptr};
+};
+
+/// Create a structured loop
+///   entry -> header -> body -> continue -> header
+///              |
+///             exit
+/// \param program destination program
+/// \param dataHost host of all shader data to be mapped
+/// \return all loop blocks
+static TestLoopProgram CreateLoopProgram(IL::Program& program, TestShaderDataHost* dataHost) {
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Structured control flow takes the merge based instrumentation path
+    program.GetCapabilityTable().hasControlFlow = true;
+
+    // Map all shader data
+    for (const ShaderDataInfo& info : dataHost->datas) {
+        program.GetShaderDataMap().Add(info);
+    }
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    TestLoopProgram loop;
+    loop.entry = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    loop.header = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    loop.body = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    loop._continue = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    loop.exit = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    IL::Emitter<>(program, *loop.entry).Branch(loop.header);
+
+    // The loop branch must originate from the source module to be instrumented
+    IL::BranchConditionalInstruction branch{};
+    branch.opCode = IL::OpCode::BranchConditional;
+    branch.source = IL::Source::Code(0);
+    branch.result = IL::InvalidID;
+    branch.cond = program.GetConstants().FindConstantOrAdd(
+        program.GetTypeMap().FindTypeOrAdd(Backend::IL::BoolType{}),
+        IL::BoolConstant{.value = true}
+    )->id;
+    branch.pass = loop.body->GetID();
+    branch.fail = loop.exit->GetID();
+    branch.controlFlow.merge = loop.exit->GetID();
+    branch.controlFlow._continue = loop._continue->GetID();
+    loop.header->Append(branch);
+
+    IL::Emitter<>(program, *loop.body).Branch(loop._continue);
+    IL::Emitter<>(program, *loop._continue).Branch(loop.header);
+    IL::Emitter<>(program, *loop.exit).Return();
+    return loop;
+}
+
+/// Blocks of the unstructured test program
+struct TestUnstructuredProgram {
+    IL::Function* fn{nullptr};
+    IL::BasicBlock* first{nullptr};
+    IL::BasicBlock* second{nullptr};
+    IL::BasicBlock* unreachable{nullptr};
+};
+
+/// Create two consecutive unstructured loops, the second with an unreachable predecessor
+///   entry -> first <-> firstBody
+///              |
+///            second <-> secondBody
+///              |   ^
+///            exit  unreachable
+/// \param program destination program
+/// \param dataHost host of all shader data to be mapped
+/// \return all loop headers
+static TestUnstructuredProgram CreateUnstructuredProgram(IL::Program& program, TestShaderDataHost* dataHost) {
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Map all shader data
+    for (const ShaderDataInfo& info : dataHost->datas) {
+        program.GetShaderDataMap().Add(info);
+    }
+
+    TestUnstructuredProgram out;
+    out.fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    IL::BasicBlock* entry = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    out.first = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* firstBody = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    out.second = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* secondBody = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* exit = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    out.unreachable = out.fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    IL::Emitter<>(program, *entry).Branch(out.first);
+    IL::Emitter<>(program, *out.first).BranchConditional(map.AllocID(), firstBody, out.second, IL::ControlFlow::None());
+    IL::Emitter<>(program, *firstBody).Branch(out.first);
+    IL::Emitter<>(program, *out.second).BranchConditional(map.AllocID(), secondBody, exit, IL::ControlFlow::None());
+    IL::Emitter<>(program, *secondBody).Branch(out.second);
+    IL::Emitter<>(program, *exit).Return();
+    IL::Emitter<>(program, *out.unreachable).Branch(out.second);
+    return out;
+}
+
+/// Instrument a test program
+/// \param program destination program
+/// \param iterationPollInterval requested polling interval
+/// \param create program creation functor, invoked with the data host
+/// \return the created program
+template<typename F>
+static auto InstrumentProgram(IL::Program& program, uint32_t iterationPollInterval, F&& create) {
+    Registry registry;
+    registry.AddNew<TestShaderExportHost>();
+    auto dataHost = registry.AddNew<TestShaderDataHost>();
+
+    auto feature = registry.New<LoopFeature>();
+    REQUIRE(feature->Install());
+
+    auto created = create(program, dataHost.GetUnsafe());
+
+    // Specialize the polling interval
+    MessageStream specialization;
+    MessageStreamView<> view(specialization);
+    view.Add<SetLoopInstrumentationConfigMessage>()->iterationPollInterval = iterationPollInterval;
+
+    feature->Inject(program, view);
+    return created;
+}
+
+/// Instrument a test loop program
+/// \param program destination program
+/// \param iterationPollInterval requested polling interval
+/// \return all loop blocks
+static TestLoopProgram InstrumentLoopProgram(IL::Program& program, uint32_t iterationPollInterval) {
+    return InstrumentProgram(program, iterationPollInterval, CreateLoopProgram);
+}
+
+/// Find the first instruction of a given type
+/// \param program program to search
+/// \return nullptr if not found
+template<typename T>
+static const T* FindInstruction(IL::Program& program) {
+    for (IL::Function* fn : program.GetFunctionList()) {
+        for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+            for (auto it = bb->begin(); it != bb->end(); ++it) {
+                if (it->Is<T>()) {
+                    return it->As<T>();
+                }
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+/// Get the value of an integral constant or literal
+/// \param program owning program
+/// \param id value identifier
+/// \return integral value
+static int64_t GetIntegralValue(IL::Program& program, IL::ID id) {
+    // Interned constants are not id mapped
+    for (const Backend::IL::Constant* constant : program.GetConstants()) {
+        if (constant->id == id && constant->Is<IL::IntConstant>()) {
+            return constant->As<IL::IntConstant>()->value;
+        }
+    }
+
+    // Emitted literals
+    for (IL::Function* fn : program.GetFunctionList()) {
+        for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+            for (auto it = bb->begin(); it != bb->end(); ++it) {
+                if (it->result == id && it->Is<IL::LiteralInstruction>()) {
+                    return it->As<IL::LiteralInstruction>()->value.integral;
+                }
+            }
+        }
+    }
+
+    FAIL("Value is not integral");
+    return 0;
+}
+
+TEST_CASE("Features.Loop.Instrumentation.Amortized") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    // Rounded up to the next power of two
+    TestLoopProgram loop = InstrumentLoopProgram(program, 48u);
+
+    // The counter phi must lead the header
+    REQUIRE(loop.header->begin()->Is<IL::PhiInstruction>());
+    auto* counter = loop.header->begin()->As<IL::PhiInstruction>();
+    REQUIRE(counter->values.count == 2u);
+
+    // The increment is emitted into the header
+    const IL::AddInstruction* increment = nullptr;
+    for (auto it = loop.header->begin(); it != loop.header->end(); ++it) {
+        if (it->Is<IL::AddInstruction>() && it->As<IL::AddInstruction>()->lhs == counter->result) {
+            increment = it->As<IL::AddInstruction>();
+        }
+    }
+
+    REQUIRE(increment);
+    REQUIRE(GetIntegralValue(program, increment->rhs) == 1);
+
+    // Entry edges start at zero, back edges carry the incremented counter
+    for (uint32_t i = 0; i < counter->values.count; i++) {
+        const IL::PhiValue& value = counter->values[i];
+        if (value.branch == loop.entry->GetID()) {
+            REQUIRE(GetIntegralValue(program, value.value) == 0);
+        } else {
+            REQUIRE(value.branch == loop._continue->GetID());
+            REQUIRE(value.value == increment->result);
+        }
+    }
+
+    // Polling is gated on the counter mask
+    auto* gate = FindInstruction<IL::BitAndInstruction>(program);
+    REQUIRE(gate);
+    REQUIRE(gate->lhs == counter->result);
+    REQUIRE(GetIntegralValue(program, gate->rhs) == 63);
+
+    // Polls must remain coherent with host writes
+    REQUIRE(FindInstruction<IL::AtomicAndInstruction>(program));
+    REQUIRE(!FindInstruction<IL::LoadBufferInstruction>(program));
+}
+
+TEST_CASE("Features.Loop.Instrumentation.Legacy") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    // An interval of one polls on every iteration
+    TestLoopProgram loop = InstrumentLoopProgram(program, 1u);
+
+    // No counter, no gating
+    REQUIRE(!loop.header->begin()->Is<IL::PhiInstruction>());
+    REQUIRE(!FindInstruction<IL::BitAndInstruction>(program));
+
+    // Atomically polled
+    REQUIRE(FindInstruction<IL::AtomicAndInstruction>(program));
+}
+
+TEST_CASE("Features.Loop.Instrumentation.Unstructured") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    TestUnstructuredProgram loops = InstrumentProgram(program, 64u, CreateUnstructuredProgram);
+
+    // Dominators of the instrumented function
+    IL::DominatorTree dominatorTree(loops.fn->GetBasicBlocks());
+    dominatorTree.Compute();
+
+    for (IL::BasicBlock* header : {loops.first, loops.second}) {
+        REQUIRE(header->begin()->Is<IL::PhiInstruction>());
+        auto* counter = header->begin()->As<IL::PhiInstruction>();
+
+        // Each predecessor of the instrumented cfg must have exactly one value
+        std::vector<IL::ID> predecessors;
+        for (IL::BasicBlock* predecessor : dominatorTree.GetPredecessors(header)) {
+            if (std::find(predecessors.begin(), predecessors.end(), predecessor->GetID()) == predecessors.end()) {
+                predecessors.push_back(predecessor->GetID());
+            }
+        }
+
+        // Unreachable predecessors are not mapped by the tree
+        if (header == loops.second) {
+            predecessors.push_back(loops.unreachable->GetID());
+        }
+
+        REQUIRE(counter->values.count == predecessors.size());
+        for (uint32_t i = 0; i < counter->values.count; i++) {
+            REQUIRE(std::find(predecessors.begin(), predecessors.end(), counter->values[i].branch) != predecessors.end());
+        }
+    }
+}
@@ -33,15 +33,24 @@
 #include <Backend/IFeature.h>
 #include <Backend/IShaderFeature.h>
 #include <Backend/ShaderExport.h>
+#include <Backend/ShaderExportFilter.h>
 #include <Backend/IL/BasicBlock.h>
 #include <Backend/IL/VisitContext.h>
 
 // Message
 #include <Message/MessageStream.h>
 
+// Std
+#include <atomic>
+
 // Forward declarations
 class IShaderSGUIDHost;
 
+namespace IL {
+    struct Function;
+    struct BoundsCheckAccess;
+}
+
 class ResourceBoundsFeature final : public IFeature, public IShaderFeature {
 public:
     COMPONENT(ResourceBoundsFeature);
@@ -70,6 +79,34 @@ public:
         return nullptr;
     }
 
+    /// Get the total number of checks eliminated by static analysis
+    uint64_t GetEliminatedCheckCount() const {
+        return eliminatedCheckCount.load();
+    }
+
+    /// Get the total number of checks hoisted out of loops
+    uint64_t GetHoistedCheckCount() const {
+        return hoistedCheckCount.load();
+    }
+
+private:
+    /// Feature hooks
+    void OnOpen(CommandContext *context);
+    void OnPreSubmit(CommandContextHandle contextHandle);
+
+private:
+    /// Inject a bounds check
+    /// \param program destination program
+    /// \param function function to allocate blocks in
+    /// \param basicBlock the block to check in, split at the given point
+    /// \param splitPoint the first instruction executed after the check
+    /// \param access the access to check
+    /// \param sguid the sguid to report
+    /// \param detail if true, include detailed information
+    /// \param filterDuplicates if true, suppress duplicate messages on the device
+    /// \return the first iterator of the resume block
+    IL::BasicBlock::Iterator InjectCheck(IL::Program& program, IL::Function& function, IL::BasicBlock& basicBlock, const IL::BasicBlock::Iterator& splitPoint, const IL::BoundsCheckAccess& access, ShaderSGUID sguid, bool detail, bool filterDuplicates);
+
 private:
     /// Shader SGUID
     ComRef<IShaderSGUIDHost> sguidHost{nullptr};
@@ -77,6 +114,13 @@ private:
     /// Export id for this feature
     ShaderExportID exportID{};
 
+    /// Device side duplicate filter
+    ShaderExportFilter exportFilter;
+
     /// Shared stream
     MessageStream stream;
+
+    /// Analysis statistics, injection may be invoked from multiple threads
+    std::atomic<uint64_t> eliminatedCheckCount{0};
+    std::atomic<uint64_t> hoistedCheckCount{0};
 };
\ No newline at end of file
@@ -34,6 +34,9 @@
 #include <Backend/IL/Visitor.h>
 #include <Backend/IL/TypeCommon.h>
 #include <Backend/IL/ResourceTokenEmitter.h>
+#include <Backend/IL/Analysis/BoundsCheckAnalysis.h>
+#include <Backend/ShaderData/IShaderDataHost.h>
+#include <Backend/CommandContext.h>
 
 // Generated schema
 #include <Schemas/Features/ResourceBounds.h>
@@ -60,12 +63,20 @@ bool ResourceBoundsFeature::Install() {
     // Optional sguid host
     sguidHost = registry->Get<IShaderSGUIDHost>();
 
+    // Install the duplicate filter
+    if (!exportFilter.Install(registry->Get<IShaderDataHost>(), exportID)) {
+        return false;
+    }
+
     // OK
     return true;
 }
 
 FeatureHookTable ResourceBoundsFeature::GetHookTable() {
-    return FeatureHookTable{};
+    FeatureHookTable table{};
+    table.open = BindDelegate(this, ResourceBoundsFeature::OnOpen);
+    table.preSubmit = BindDelegate(this, ResourceBoundsFeature::OnPreSubmit);
+    return table;
 }
 
 void ResourceBoundsFeature::CollectExports(const MessageStream &exports) {
@@ -74,202 +85,150 @@ void ResourceBoundsFeature::CollectExports(const MessageStream &exports) {
 
 void ResourceBoundsFeature::CollectMessages(IMessageStorage *storage) {
     storage->AddStreamAndSwap(stream);
+
+    // Report filter statistics
+    exportFilter.CollectMessages(storage);
 }
 
 void ResourceBoundsFeature::Inject(IL::Program &program, const MessageStreamView<> &specialization) {
     // Options
     const SetInstrumentationConfigMessage config = CollapseOrDefault<SetInstrumentationConfigMessage>(specialization);
 
-    // Unsigned target type
-    const Backend::IL::Type* uint32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType {.bitWidth = 32, .signedness = false});
+    // Determine all checks that are proven or loop invariant
+    //  ? Detailed instrumentation reports the coordinates, only identical coordinates may be proven
+    IL::BoundsCheckAnalysis analysis(program);
+    analysis.Compute(!config.detail);
+
+    // Bind all hoisted sguids to the original accesses, prior to modification
+    std::vector<ShaderSGUID> hoistSGUIDs;
+    for (const IL::BoundsCheckHoist& hoist : analysis.GetHoists()) {
+        hoistSGUIDs.push_back(sguidHost ? sguidHost->Bind(program, hoist.instruction.basicBlock->GetIterator(hoist.instruction)) : InvalidShaderSGUID);
+    }
+
+    // Perform all hoisted checks at the end of the preheaders
+    for (size_t i = 0; i < analysis.GetHoists().size(); i++) {
+        const IL::BoundsCheckHoist& hoist = analysis.GetHoists()[i];
+        InjectCheck(program, *hoist.function, *hoist.preheader, hoist.preheader->GetTerminator(), hoist.access, hoistSGUIDs[i], config.detail, config.filterDuplicates);
+    }
 
     // Visit all instructions
     IL::VisitUserInstructions(program, [&](IL::VisitContext& context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
-        bool isTexture;
-        bool isWrite;
-
         // Instruction of interest?
-        switch (it->opCode) {
-            default:
-                return it;
-
-            /* Handled cases */
-            case IL::OpCode::StoreBuffer: {
-                isWrite = true;
-                isTexture = false;
-                break;
-            }
-            case IL::OpCode::LoadBuffer: {
-                isWrite = false;
-                isTexture = false;
-                break;
-            }
-            case IL::OpCode::StoreTexture: {
-                isWrite = true;
-                isTexture = true;
-                break;
-            }
-            case IL::OpCode::LoadTexture: {
-                isWrite = false;
-                isTexture = true;
-
-                // Get texture type
-                auto instr = it->As<IL::LoadTextureInstruction>();
-                auto type = program.GetTypeMap().GetType(instr->texture)->As<Backend::IL::TextureType>();
-
-                // Sub-pass inputs are not validated
-                if (type->dimension == Backend::IL::TextureDimension::SubPass) {
-                    return it;
-                }
-                break;
-            }
+        IL::BoundsCheckAccess access;
+        if (!IL::BoundsCheckAnalysis::GetAccess(program, it.Get(), access)) {
+            return it;
         }
 
-        // Instrumentation Segmentation
-        //
-        //             BEFORE                                 AFTER
-        //
-        //   ┌─────┬─────────────┬───────┐      ┌─────┐                   ┌─────────────┬──────┐
-        //   │     │             │       │      │     │        OK         │             │      │
-        //   │ Pre │ Instruction │ Post  │      │ Pre ├───────────────────┤ Instruction │ Post │
-        //   │     │             │       │      │     │                   │   [RESUME]  │      │
-        //   └─────┴─────────────┴───────┘      └──┬──┘                   └──────┬──────┴──────┘
-        //                                         │    ┌───────────────┐        │
-        //                                     OOB │    │               │        │
-        //                                         └────┤ Out of Bounds ├────────┘
-        //                                              │     [OOB]     │
-        //                                              └───────────────┘
+        // Already proven or hoisted?
+        if (analysis.GetResolution(it) != IL::BoundsCheckResolution::Required) {
+            return it;
+        }
 
         // Bind the SGUID
         ShaderSGUID sguid = sguidHost ? sguidHost->Bind(program, it) : InvalidShaderSGUID;
 
-        // Allocate resume
-        IL::BasicBlock* resumeBlock = context.function.GetBasicBlocks().AllocBlock();
-
-        // Split this basic block, move all instructions post and including the instrumented instruction to resume
-        // ! iterator invalidated
-        auto instr = context.basicBlock.Split(resumeBlock, it);
-
-        // Out of bounds block
-        IL::Emitter<> oob(program, *context.function.GetBasicBlocks().AllocBlock());
-        oob.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
-
-        // Setup message
-        ResourceIndexOutOfBoundsMessage::ShaderExport msg;
-        msg.sguid = oob.UInt32(sguid);
-        msg.isTexture = oob.UInt32(isTexture);
-        msg.isWrite = oob.UInt32(isWrite);
-
-        // Detailed instrumentation?
-        if (config.detail) {
-            msg.chunks |= ResourceIndexOutOfBoundsMessage::Chunk::Detail;
-
-            // Convenient zero
-            IL::ID zero = oob.UInt32(0);
-
-            // Get detailed information on the op code
-            switch (it->opCode) {
-                default:
-                    ASSERT(false, "Invalid op code");
-                    break;
-
-                    /* Handled cases */
-                case IL::OpCode::StoreBuffer: {
-                    auto _instr = instr->As<IL::StoreBufferInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetToken();
-                    msg.detail.coordinate[0] = _instr->index;
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::LoadBuffer: {
-                    auto _instr = instr->As<IL::LoadBufferInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->buffer).GetToken();
-                    msg.detail.coordinate[0] = _instr->index;
-                    msg.detail.coordinate[1] = zero;
-                    msg.detail.coordinate[2] = zero;
-                    break;
-                }
-                case IL::OpCode::StoreTexture: {
-                    auto _instr = instr->As<IL::StoreTextureInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->texture).GetToken();
-
-                    // Vectorized index?
-                    if (const Backend::IL::Type* indexType = program.GetTypeMap().GetType(_instr->index); indexType->Is<Backend::IL::VectorType>()) {
-                        const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
-
-                        msg.detail.coordinate[0] = oob.Extract(_instr->index, 0);
-                        msg.detail.coordinate[1] = dimension > 1 ? oob.Extract(_instr->index, 1) : zero;
-                        msg.detail.coordinate[2] = dimension > 2 ? oob.Extract(_instr->index, 2) : zero;
-                    } else {
-                        msg.detail.coordinate[0] = _instr->index;
-                        msg.detail.coordinate[1] = zero;
-                        msg.detail.coordinate[2] = zero;
-                    }
-                    break;
-                }
-                case IL::OpCode::LoadTexture: {
-                    auto _instr = instr->As<IL::LoadTextureInstruction>();
-                    msg.detail.token = IL::ResourceTokenEmitter(oob, _instr->texture).GetToken();
-
-                    // Vectorized index?
-                    if (const Backend::IL::Type* indexType = program.GetTypeMap().GetType(_instr->index); indexType->Is<Backend::IL::VectorType>()) {
-                        const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
-
-                        msg.detail.coordinate[0] = oob.Extract(_instr->index, 0);
-                        msg.detail.coordinate[1] = dimension > 1 ? oob.Extract(_instr->index, 1) : zero;
-                        msg.detail.coordinate[2] = dimension > 2 ? oob.Extract(_instr->index, 2) : zero;
-                    } else {
-                        msg.detail.coordinate[0] = _instr->index;
-                        msg.detail.coordinate[1] = zero;
-                        msg.detail.coordinate[2] = zero;
-                    }
-                    break;
-                }
-            }
+        // Check prior to the instruction
+        return InjectCheck(program, context.function, context.basicBlock, it, access, sguid, config.detail, config.filterDuplicates);
+    });
+
+    // Accumulate statistics
+    const IL::BoundsCheckStatistics& statistics = analysis.GetStatistics();
+    eliminatedCheckCount += statistics.dominated + statistics.folded;
+    hoistedCheckCount += statistics.hoisted;
+}
+
+IL::BasicBlock::Iterator ResourceBoundsFeature::InjectCheck(IL::Program& program, IL::Function& function, IL::BasicBlock& basicBlock, const IL::BasicBlock::Iterator& splitPoint, const IL::BoundsCheckAccess& access, ShaderSGUID sguid, bool detail, bool filterDuplicates) {
+    // Unsigned target type
+    const Backend::IL::Type* uint32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType {.bitWidth = 32, .signedness = false});
+
+    // Instrumentation Segmentation
+    //
+    //             BEFORE                                 AFTER
+    //
+    //   ┌─────┬─────────────┬───────┐      ┌─────┐                   ┌─────────────┬──────┐
+    //   │     │             │       │      │     │        OK         │             │      │
+    //   │ Pre │ Instruction │ Post  │      │ Pre ├───────────────────┤ Instruction │ Post │
+    //   │     │             │       │      │     │                   │   [RESUME]  │      │
+    //   └─────┴─────────────┴───────┘      └──┬──┘                   └──────┬──────┴──────┘
+    //                                         │    ┌───────────────┐        │
+    //                                     OOB │    │               │        │
+    //                                         └────┤ Out of Bounds ├────────┘
+    //                                              │     [OOB]     │
+    //                                              └───────────────┘
+    //
+    // Hoisted checks split the loop preheader at its terminator, the instruction being the branch into the loop.
+
+    // Allocate resume
+    IL::BasicBlock* resumeBlock = function.GetBasicBlocks().AllocBlock();
+
+    // Split this basic block, move all instructions post and including the split point to resume
+    // ! iterator invalidated
+    auto instr = basicBlock.Split(resumeBlock, splitPoint);
+
+    // Out of bounds block
+    IL::BasicBlock* oobBlock = function.GetBasicBlocks().AllocBlock();
+    IL::Emitter<> oob(program, *oobBlock);
+    oob.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+
+    // Setup message
+    ResourceIndexOutOfBoundsMessage::ShaderExport msg;
+    msg.sguid = oob.UInt32(sguid);
+    msg.isTexture = oob.UInt32(access.isTexture);
+    msg.isWrite = oob.UInt32(access.isWrite);
+
+    // Detailed instrumentation?
+    if (detail) {
+        msg.chunks |= ResourceIndexOutOfBoundsMessage::Chunk::Detail;
+
+        // Convenient zero
+        IL::ID zero = oob.UInt32(0);
+
+        // Get the resource token
+        msg.detail.token = IL::ResourceTokenEmitter(oob, access.resource, IL::ResourceTokenScope::Local).GetToken();
+
+        // Vectorized index?
+        if (const Backend::IL::Type* indexType = program.GetTypeMap().GetType(access.index); access.isTexture && indexType->Is<Backend::IL::VectorType>()) {
+            const uint32_t dimension = indexType->As<Backend::IL::VectorType>()->dimension;
+
+            msg.detail.coordinate[0] = oob.Extract(access.index, 0);
+            msg.detail.coordinate[1] = dimension > 1 ? oob.Extract(access.index, 1) : zero;
+            msg.detail.coordinate[2] = dimension > 2 ? oob.Extract(access.index, 2) : zero;
+        } else {
+            msg.detail.coordinate[0] = access.index;
+            msg.detail.coordinate[1] = zero;
+            msg.detail.coordinate[2] = zero;
         }
+    }
 
-        // Export the message
+    // Export the message, optionally only first occurrences
+    if (filterDuplicates) {
+        exportFilter.Export(program, oob, function.GetBasicBlocks(), msg);
+    } else {
         oob.Export(exportID, msg);
+    }
 
-        // Branch back
-        oob.Branch(resumeBlock);
-
-        // Perform instrumentation check
-        IL::Emitter<> pre(program, context.basicBlock);
-
-        // Is any of the indices larger than the resource size
-        IL::ID cond{};
-        switch (instr->opCode) {
-            default:
-                ASSERT(false, "Unexpected opcode");
-                break;
-            case IL::OpCode::StoreBuffer: {
-                auto* storeBuffer = instr->As<IL::StoreBufferInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(storeBuffer->index, SplatToValue(program, uint32Type, storeBuffer->index)), pre.ResourceSize(storeBuffer->buffer)));
-                break;
-            }
-            case IL::OpCode::LoadBuffer: {
-                auto* loadBuffer = instr->As<IL::LoadBufferInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(loadBuffer->index, SplatToValue(program, uint32Type, loadBuffer->index)), pre.ResourceSize(loadBuffer->buffer)));
-                break;
-            }
-            case IL::OpCode::StoreTexture: {
-                auto* storeTexture = instr->As<IL::StoreTextureInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(storeTexture->index, SplatToValue(program, uint32Type, storeTexture->index)), pre.ResourceSize(storeTexture->texture)));
-                break;
-            }
-            case IL::OpCode::LoadTexture: {
-                auto* loadTexture = instr->As<IL::LoadTextureInstruction>();
-                cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(loadTexture->index, SplatToValue(program, uint32Type, loadTexture->index)), pre.ResourceSize(loadTexture->texture)));
-                break;
-            }
-        }
+    // Branch back
+    oob.Branch(resumeBlock);
 
-        // If so, branch to failure, otherwise resume
-        pre.BranchConditional(cond, oob.GetBasicBlock(), resumeBlock, IL::ControlFlow::Selection(resumeBlock));
-        return instr;
-    });
+    // Perform instrumentation check
+    IL::Emitter<> pre(program, basicBlock);
+
+    // Is any of the indices larger than the resource size
+    IL::ID cond = pre.Any(pre.GreaterThanEqual(pre.BitCast(access.index, SplatToValue(program, uint32Type, access.index)), pre.ResourceSize(access.resource)));
+
+    // If so, branch to failure, otherwise resume
+    pre.BranchConditional(cond, oobBlock, resumeBlock, IL::ControlFlow::Selection(resumeBlock));
+    return instr;
+}
+
+void ResourceBoundsFeature::OnOpen(CommandContext *context) {
+    // Assign the filter epoch slot
+    exportFilter.OnOpen(context);
+}
+
+void ResourceBoundsFeature::OnPreSubmit(CommandContextHandle contextHandle) {
+    // New filter epoch
+    exportFilter.OnPreSubmit(contextHandle);
 }
 
 FeatureInfo ResourceBoundsFeature::GetInfo() {
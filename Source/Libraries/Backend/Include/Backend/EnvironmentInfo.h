@@ -55,6 +55,10 @@ namespace Backend {
         /// In memory bridge?
         bool memoryBridge{false};
 
+        /// Dispatch bridge listeners in parallel?
+        ///  ? Listeners of different messages must then be thread safe against each other
+        bool parallelBridgeListeners{false};
+
         /// Load plugins?
         bool loadPlugins{true};
     };
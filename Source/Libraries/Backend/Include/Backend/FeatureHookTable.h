@@ -62,6 +62,7 @@ namespace Hooks {
     /// Submission
     using Open = Delegate<void(CommandContext* context)>;
     using Close = Delegate<void(CommandContextHandle contextHandle)>;
+    using PreSubmit = Delegate<void(CommandContextHandle contextHandle)>;
     using Submit = Delegate<void(CommandContextHandle contextHandle)>;
     using Join = Delegate<void(CommandContextHandle contextHandle)>;
 }
@@ -87,6 +88,7 @@ public:
     /// Submission
     Hooks::Open open;
     Hooks::Close close;
+    Hooks::PreSubmit preSubmit;
     Hooks::Submit submit;
     Hooks::Join join;
 };
@@ -0,0 +1,490 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include <Backend/IL/Program.h>
+#include <Backend/IL/CFG/DominatorTree.h>
+#include <Backend/IL/CFG/LoopTree.h>
+
+// Std
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <cstdint>
+
+namespace IL {
+    /// A bounds checked resource access
+    struct BoundsCheckAccess {
+        /// Op code of the access
+        OpCode opCode{OpCode::None};
+
+        /// Accessed resource
+        ID resource{InvalidID};
+
+        /// Accessed index, scalar or vector
+        ID index{InvalidID};
+
+        /// Access properties
+        bool isTexture{false};
+        bool isWrite{false};
+    };
+
+    /// Resolution of a bounds check
+    enum class BoundsCheckResolution {
+        /// Check must be performed on the access
+        Required,
+
+        /// Proven by a dominating check on the same resource and index
+        Dominated,
+
+        /// Proven by a dominating check on the same resource with a larger or equal constant index
+        Folded,
+
+        /// Loop invariant, performed once in the loop preheader
+        Hoisted
+    };
+
+    /// A loop invariant check hoisted to the loop preheader
+    struct BoundsCheckHoist {
+        /// Function of the loop
+        Function* function{nullptr};
+
+        /// Preheader to perform the check in, before its terminator
+        BasicBlock* preheader{nullptr};
+
+        /// Hoisted access
+        BoundsCheckAccess access;
+
+        /// Instruction of the hoisted access
+        OpaqueInstructionRef instruction;
+    };
+
+    /// Bounds check statistics
+    struct BoundsCheckStatistics {
+        /// Get the number of checks not performed on the access itself
+        uint32_t GetEliminated() const {
+            return dominated + folded + hoisted;
+        }
+
+        /// Number of analysed accesses
+        uint32_t accesses{0};
+
+        /// Resolution counters
+        uint32_t dominated{0};
+        uint32_t folded{0};
+        uint32_t hoisted{0};
+    };
+
+    /// Static bounds check elimination
+    ///   Determines which resource accesses require a bounds check on the access itself. Checks are
+    ///   eliminated if a dominating check has already validated the same, or a larger constant, index on the same
+    ///   resource, and loop invariant checks guaranteed to execute on each loop entry are hoisted to the preheader.
+    ///   Results are tracked by relocation offsets, and remain valid while the program is instrumented.
+    class BoundsCheckAnalysis {
+    public:
+        /// Constructor
+        /// \param program program to analyse
+        BoundsCheckAnalysis(Program& program) : program(program) {
+
+        }
+
+        /// Compute all resolutions
+        /// \param allowFolding if true, checks may be proven by dominating checks on larger constant indices
+        void Compute(bool allowFolding = true) {
+            for (Function* fn : program.GetFunctionList()) {
+                ComputeFunction(*fn, allowFolding);
+            }
+        }
+
+        /// Get the bounds checked access of an instruction
+        /// \param program program of the instruction
+        /// \param instr instruction to query
+        /// \param out destination access
+        /// \return false if the instruction is not bounds checked
+        static bool GetAccess(Program& program, const Instruction* instr, BoundsCheckAccess& out) {
+            out.opCode = instr->opCode;
+
+            switch (instr->opCode) {
+                default: {
+                    return false;
+                }
+                case OpCode::StoreBuffer: {
+                    auto _instr = instr->As<StoreBufferInstruction>();
+                    out.resource = _instr->buffer;
+                    out.index = _instr->index;
+                    out.isTexture = false;
+                    out.isWrite = true;
+                    return true;
+                }
+                case OpCode::LoadBuffer: {
+                    auto _instr = instr->As<LoadBufferInstruction>();
+                    out.resource = _instr->buffer;
+                    out.index = _instr->index;
+                    out.isTexture = false;
+                    out.isWrite = false;
+                    return true;
+                }
+                case OpCode::StoreTexture: {
+                    auto _instr = instr->As<StoreTextureInstruction>();
+                    out.resource = _instr->texture;
+                    out.index = _instr->index;
+                    out.isTexture = true;
+                    out.isWrite = true;
+                    return true;
+                }
+                case OpCode::LoadTexture: {
+                    auto _instr = instr->As<LoadTextureInstruction>();
+                    out.resource = _instr->texture;
+                    out.index = _instr->index;
+                    out.isTexture = true;
+                    out.isWrite = false;
+
+                    // Sub-pass inputs are not validated
+                    auto type = program.GetTypeMap().GetType(_instr->texture)->As<Backend::IL::TextureType>();
+                    return type->dimension != Backend::IL::TextureDimension::SubPass;
+                }
+            }
+        }
+
+        /// Get the resolution of an access
+        /// \param ref instruction reference
+        /// \return resolution, required if not analysed
+        BoundsCheckResolution GetResolution(const ConstOpaqueInstructionRef& ref) const {
+            auto it = resolutions.find(ref.relocationOffset);
+            if (it == resolutions.end()) {
+                return BoundsCheckResolution::Required;
+            }
+
+            return it->second;
+        }
+
+        /// Get all hoisted checks
+        const std::vector<BoundsCheckHoist>& GetHoists() const {
+            return hoists;
+        }
+
+        /// Get the statistics
+        const BoundsCheckStatistics& GetStatistics() const {
+            return statistics;
+        }
+
+    private:
+        struct Access {
+            /// Underlying access
+            BoundsCheckAccess access;
+
+            /// Instruction of the access
+            OpaqueInstructionRef instruction;
+
+            /// Owning block
+            BasicBlock* basicBlock{nullptr};
+
+            /// Linear index within the owning block
+            uint32_t blockIndex{0};
+
+            /// Optional constant index
+            bool isConstant{false};
+            uint32_t constant{0};
+
+            /// Current resolution
+            BoundsCheckResolution resolution{BoundsCheckResolution::Required};
+        };
+
+        /// Compute all resolutions of a function
+        /// \param fn function to analyse
+        /// \param allowFolding if true, checks may be proven by dominating checks on larger constant indices
+        void ComputeFunction(Function& fn, bool allowFolding) {
+            DominatorTree dominatorTree(fn.GetBasicBlocks());
+            dominatorTree.Compute();
+
+            LoopTree loopTree(dominatorTree);
+            loopTree.Compute();
+
+            // Only reachable blocks have valid dominators
+            const BasicBlockTraversal::BlockView& reachable = dominatorTree.GetPostOrderTraversal().GetView();
+
+            // All accesses, grouped by resource and access type
+            std::vector<Access> accesses;
+            std::unordered_map<uint64_t, std::vector<uint32_t>> groups;
+
+            // Collect in reverse post-order, dominating accesses are always visited first
+            for (auto blockIt = reachable.rbegin(); blockIt != reachable.rend(); ++blockIt) {
+                BasicBlock* basicBlock = *blockIt;
+
+                // Not instrumented
+                if (basicBlock->HasFlag(BasicBlockFlag::NoInstrumentation)) {
+                    continue;
+                }
+
+                uint32_t blockIndex = 0;
+                for (auto it = basicBlock->begin(); it != basicBlock->end(); ++it, ++blockIndex) {
+                    Access access;
+                    if (!GetAccess(program, *it, access.access)) {
+                        continue;
+                    }
+
+                    access.instruction = it.Ref();
+                    access.basicBlock = basicBlock;
+                    access.blockIndex = blockIndex;
+
+                    // Scalar integral constant? Negative or truncated indices never prove other checks
+                    auto constant = program.GetConstants().GetConstant<IntConstant>(access.access.index);
+                    if (constant && constant->value >= 0 && constant->value <= static_cast<int64_t>(UINT32_MAX)) {
+                        access.isConstant = true;
+                        access.constant = static_cast<uint32_t>(constant->value);
+                    }
+
+                    // Reads and writes are reported separately
+                    uint64_t key = (static_cast<uint64_t>(GetResourceKey(access.access.resource)) << 1u) | static_cast<uint64_t>(access.access.isWrite);
+                    groups[key].push_back(static_cast<uint32_t>(accesses.size()));
+                    accesses.push_back(access);
+                }
+            }
+
+            statistics.accesses += static_cast<uint32_t>(accesses.size());
+
+            // Eliminate all checks proven by a dominating check
+            for (auto&& [key, group] : groups) {
+                for (uint32_t i = 1; i < group.size(); i++) {
+                    Access& access = accesses[group[i]];
+
+                    // Any preceding access may prove this one
+                    for (uint32_t j = 0; j < i; j++) {
+                        const Access& candidate = accesses[group[j]];
+
+                        // Must be executed prior to the access
+                        if (!IsDominating(dominatorTree, candidate, access)) {
+                            continue;
+                        }
+
+                        // Same index?
+                        if (candidate.access.index == access.access.index) {
+                            access.resolution = BoundsCheckResolution::Dominated;
+                            break;
+                        }
+
+                        // Constant index within the dominating one? A larger index is never proven, and keeps its own check
+                        if (allowFolding && candidate.isConstant && access.isConstant && access.constant <= candidate.constant) {
+                            access.resolution = BoundsCheckResolution::Folded;
+                            break;
+                        }
+                    }
+                }
+            }
+
+            // Hoist loop invariant checks, outer loops first
+            const LoopTree::LoopView& loops = loopTree.GetView();
+            for (auto loopIt = loops.rbegin(); loopIt != loops.rend(); ++loopIt) {
+                HoistLoop(fn, dominatorTree, *loopIt, accesses);
+            }
+
+            // Summarize
+            for (const Access& access : accesses) {
+                switch (access.resolution) {
+                    case BoundsCheckResolution::Required:
+                        continue;
+                    case BoundsCheckResolution::Dominated:
+                        statistics.dominated++;
+                        break;
+                    case BoundsCheckResolution::Folded:
+                        statistics.folded++;
+                        break;
+                    case BoundsCheckResolution::Hoisted:
+                        statistics.hoisted++;
+                        break;
+                }
+
+                resolutions[access.instruction.relocationOffset] = access.resolution;
+            }
+        }
+
+        /// Hoist all loop invariant checks of a loop
+        /// \param fn function of the loop
+        /// \param dominatorTree function dominator tree
+        /// \param loop loop to hoist from
+        /// \param accesses all accesses of the function
+        void HoistLoop(Function& fn, const DominatorTree& dominatorTree, const Loop& loop, std::vector<Access>& accesses) {
+            if (loop.header->HasFlag(BasicBlockFlag::NoInstrumentation)) {
+                return;
+            }
+
+            // Get the preheader
+            BasicBlock* preheader = GetPreheader(dominatorTree, loop);
+            if (!preheader) {
+                return;
+            }
+
+            for (Access& access : accesses) {
+                if (access.resolution != BoundsCheckResolution::Required || !IsInLoop(loop, access.basicBlock)) {
+                    continue;
+                }
+
+                // Resource and index must not change between iterations
+                if (!IsLoopInvariant(loop, access.access.resource) || !IsLoopInvariant(loop, access.access.index)) {
+                    continue;
+                }
+
+                // The access must be executed on each loop entry, otherwise the check may report unreachable accesses
+                if (!IsExecutedOnEntry(dominatorTree, loop, access.basicBlock)) {
+                    continue;
+                }
+
+                access.resolution = BoundsCheckResolution::Hoisted;
+
+                // Add hoist
+                BoundsCheckHoist& hoist = hoists.emplace_back();
+                hoist.function = &fn;
+                hoist.preheader = preheader;
+                hoist.access = access.access;
+                hoist.instruction = access.instruction;
+            }
+        }
+
+        /// Get the preheader of a loop
+        /// \param dominatorTree function dominator tree
+        /// \param loop given loop
+        /// \return nullptr if there is no unique preheader with the header as its only successor
+        BasicBlock* GetPreheader(const DominatorTree& dominatorTree, const Loop& loop) const {
+            BasicBlock* preheader{nullptr};
+
+            // Find the unique out-of-loop predecessor
+            for (BasicBlock* predecessor : dominatorTree.GetPredecessors(loop.header)) {
+                if (IsInLoop(loop, predecessor)) {
+                    continue;
+                }
+
+                if (preheader) {
+                    return nullptr;
+                }
+
+                preheader = predecessor;
+            }
+
+            // Must unconditionally branch into the header
+            if (!preheader || preheader->HasFlag(BasicBlockFlag::NoInstrumentation) || preheader->GetTerminator()->opCode != OpCode::Branch) {
+                return nullptr;
+            }
+
+            return preheader;
+        }
+
+        /// Check if a block is executed at least once on each loop entry
+        /// \param dominatorTree function dominator tree
+        /// \param loop given loop
+        /// \param basicBlock block to check
+        /// \return true if executed
+        bool IsExecutedOnEntry(const DominatorTree& dominatorTree, const Loop& loop, BasicBlock* basicBlock) const {
+            for (BasicBlock* loopBlock : loop.blocks) {
+                const DominatorTree::BlockView& successors = dominatorTree.GetSuccessors(loopBlock);
+
+                // Leaves the loop or function?
+                bool isExiting = successors.empty() || std::any_of(successors.begin(), successors.end(), [&](BasicBlock* successor) {
+                    return !IsInLoop(loop, successor);
+                });
+
+                // All exits must pass the block
+                if (isExiting && loopBlock != basicBlock && !dominatorTree.Dominates(basicBlock, loopBlock)) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /// Check if an identifier is invariant to a loop
+        /// \param loop given loop
+        /// \param id identifier to check
+        /// \return true if invariant
+        bool IsLoopInvariant(const Loop& loop, ID id) const {
+            const OpaqueInstructionRef& ref = program.GetIdentifierMap().Get(id);
+
+            // Constants, variables and parameters are always invariant
+            if (!ref.IsValid()) {
+                return true;
+            }
+
+            return !IsInLoop(loop, ref.basicBlock);
+        }
+
+        /// Check if a block is part of a loop
+        static bool IsInLoop(const Loop& loop, BasicBlock* basicBlock) {
+            return std::find(loop.blocks.begin(), loop.blocks.end(), basicBlock) != loop.blocks.end();
+        }
+
+        /// Check if an access is executed prior to another
+        /// \param dominatorTree function dominator tree
+        /// \param candidate the candidate dominating access
+        /// \param access the dominated access
+        /// \return true if dominating
+        static bool IsDominating(const DominatorTree& dominatorTree, const Access& candidate, const Access& access) {
+            if (candidate.basicBlock == access.basicBlock) {
+                return candidate.blockIndex < access.blockIndex;
+            }
+
+            return dominatorTree.Dominates(candidate.basicBlock, access.basicBlock);
+        }
+
+        /// Get the identity of a resource
+        ///  ? Resources loaded from the same variable are the same resource, regardless of the load
+        /// \param resource resource identifier
+        /// \return resource key
+        ID GetResourceKey(ID resource) const {
+            const OpaqueInstructionRef& ref = program.GetIdentifierMap().Get(resource);
+            if (!ref.IsValid()) {
+                return resource;
+            }
+
+            // Load from a variable?
+            auto instr = ref.basicBlock->GetRelocationInstruction(ref.relocationOffset);
+            if (instr->opCode != OpCode::Load) {
+                return resource;
+            }
+
+            // Only non-instruction addresses are immutable
+            ID address = instr->As<LoadInstruction>()->address;
+            if (program.GetIdentifierMap().Get(address).IsValid()) {
+                return resource;
+            }
+
+            return address;
+        }
+
+    private:
+        /// Analysed program
+        Program& program;
+
+        /// All non-required resolutions
+        std::unordered_map<const RelocationOffset*, BoundsCheckResolution> resolutions;
+
+        /// All hoisted checks
+        std::vector<BoundsCheckHoist> hoists;
+
+        /// Statistics
+        BoundsCheckStatistics statistics;
+    };
+}
@@ -37,6 +37,8 @@
 
 // Std
 #include <vector>
+#include <algorithm>
+#include <cstring>
 
 // Cleanup
 #undef OPAQUE
@@ -102,10 +104,32 @@ namespace IL {
     template<typename T = Instruction>
     using ConstInstructionRef = TInstructionRef<T, ConstOpaqueInstructionRef>;
 
+    /// Basic block segment, a contiguous run of instructions
+    struct BasicBlockSegment : public RelocationSegment {
+        /// Constructor
+        BasicBlockSegment(const Allocators &allocators) : data(allocators), relocations(allocators) {
+
+        }
+
+        /// Instruction stream
+        Vector<uint8_t> data;
+
+        /// Relocation offsets of all instructions, in stream order
+        Vector<RelocationOffset *> relocations;
+
+        /// Index of this segment within the owning block
+        uint32_t index{0};
+    };
+
     /// Basic block, holds a list of instructions
-    ///   Instructions are laid out linearly in memory, however still allow for instruction references
-    ///   while the block is being modified.
+    ///   Instructions are laid out in linear segments of bounded size, and allow for instruction references
+    ///   while the block is being modified. Modifications only touch the affected segment, and splits migrate
+    ///   whole segments to the destination block. Copied blocks share the segments of their source block, until
+    ///   first modified or referenced.
     struct BasicBlock {
+        /// Preferred byte size of a segment, segments grown past twice the size are divided
+        static constexpr uint32_t kSegmentSize = 4096;
+
         /// Mutable iterator
         struct Iterator {
             using iterator_category = std::forward_iterator_tag;
@@ -118,7 +142,7 @@ namespace IL {
             bool operator!=(const Iterator &other) const {
                 Validate();
 
-                return ptr != other.ptr;
+                return relocationIndex != other.relocationIndex || segmentIndex != other.segmentIndex;
             }
 
             /// Get the instruction
@@ -129,10 +153,11 @@ namespace IL {
             }
 
             /// Get the instruction
+            ///  ? Materializes shared blocks, the current pointer may still address the source block
             Instruction *GetMutable() const {
                 Validate();
 
-                return reinterpret_cast<Instruction *>(ptr);
+                return block->GetRelocationInstruction(block->GetRelocationOffset(segmentIndex, relocationIndex));
             }
 
             /// Dereference
@@ -174,7 +199,7 @@ namespace IL {
 
                 InstructionRef<T> ref;
                 ref.basicBlock = block;
-                ref.relocationOffset = block->GetRelocationOffset(relocationIndex);
+                ref.relocationOffset = block->GetRelocationOffset(segmentIndex, relocationIndex);
                 return ref;
             }
 
@@ -184,7 +209,7 @@ namespace IL {
 
                 OpaqueInstructionRef ref;
                 ref.basicBlock = block;
-                ref.relocationOffset = block->GetRelocationOffset(relocationIndex);
+                ref.relocationOffset = block->GetRelocationOffset(segmentIndex, relocationIndex);
                 return ref;
             }
 
@@ -214,6 +239,14 @@ namespace IL {
             Iterator &operator++() {
                 ptr = ptr + GetSize(Get());
                 relocationIndex++;
+
+                // Continue with the next segment, the end of the last segment is the end of the block
+                if (relocationIndex == block->segments[segmentIndex]->relocations.size() && segmentIndex + 1 < block->segments.size()) {
+                    segmentIndex++;
+                    relocationIndex = 0;
+                    ptr = block->segments[segmentIndex]->data.data();
+                }
+
                 return *this;
             }
 
@@ -234,7 +267,7 @@ namespace IL {
                 return block;
             }
 
-            /// Get the index
+            /// Get the index within the segment
             uint32_t GetIndex() const {
                 return relocationIndex;
             }
@@ -242,7 +275,10 @@ namespace IL {
             /// Current offset
             uint8_t *ptr{nullptr};
 
-            /// Relocation index for references
+            /// Current segment
+            uint32_t segmentIndex{0};
+
+            /// Relocation index within the segment for references
             uint32_t relocationIndex{0};
 
             /// Parent block
@@ -305,7 +341,7 @@ namespace IL {
             ConstIterator() = default;
 
             /// Construct from mutable
-            ConstIterator(const Iterator& it) : ptr(it.ptr), relocationIndex(it.relocationIndex), block(it.block) {
+            ConstIterator(const Iterator& it) : ptr(it.ptr), segmentIndex(it.segmentIndex), relocationIndex(it.relocationIndex), block(it.block) {
 #ifndef NDEBUG
                 debugRevision = it.debugRevision;
 #endif // NDEBUG
@@ -315,7 +351,7 @@ namespace IL {
             bool operator!=(const ConstIterator &other) const {
                 Validate();
 
-                return ptr != other.ptr;
+                return relocationIndex != other.relocationIndex || segmentIndex != other.segmentIndex;
             }
 
             /// Get the instruction
@@ -357,7 +393,7 @@ namespace IL {
 
                 ConstInstructionRef<T> ref;
                 ref.basicBlock = block;
-                ref.relocationOffset = block->GetRelocationOffset(relocationIndex);
+                ref.relocationOffset = block->GetRelocationOffset(segmentIndex, relocationIndex);
                 return ref;
             }
 
@@ -367,7 +403,7 @@ namespace IL {
 
                 ConstOpaqueInstructionRef ref;
                 ref.basicBlock = block;
-                ref.relocationOffset = block->GetRelocationOffset(relocationIndex);
+                ref.relocationOffset = block->GetRelocationOffset(segmentIndex, relocationIndex);
                 return ref;
             }
 
@@ -399,6 +435,14 @@ namespace IL {
             ConstIterator &operator++() {
                 ptr = ptr + GetSize(Get());
                 relocationIndex++;
+
+                // Continue with the next segment, the end of the last segment is the end of the block
+                if (relocationIndex == block->segments[segmentIndex]->relocations.size() && segmentIndex + 1 < block->segments.size()) {
+                    segmentIndex++;
+                    relocationIndex = 0;
+                    ptr = block->segments[segmentIndex]->data.data();
+                }
+
                 return *this;
             }
 
@@ -419,7 +463,7 @@ namespace IL {
                 return block;
             }
 
-            /// Get the index
+            /// Get the index within the segment
             uint32_t GetIndex() const {
                 return relocationIndex;
             }
@@ -427,7 +471,10 @@ namespace IL {
             /// Current offset
             const uint8_t *ptr{nullptr};
 
-            /// Current relocation index for references
+            /// Current segment
+            uint32_t segmentIndex{0};
+
+            /// Current relocation index within the segment for references
             uint32_t relocationIndex{0};
 
             /// Parent block
@@ -443,14 +490,16 @@ namespace IL {
         BasicBlock(const Allocators &allocators, IdentifierMap &map, ID id) :
             allocators(allocators),
             id(id), map(map),
-            data(allocators.Tag("BasicBlock"_AllocTag)),
-            relocationTable(allocators.Tag("BasicBlock"_AllocTag)),
+            segments(allocators.Tag("BasicBlock"_AllocTag)),
             relocationAllocator(allocators) {
 
         }
 
+        /// Destructor
+        ~BasicBlock();
+
         /// Allow move
-        BasicBlock(BasicBlock&& other) = default;
+        BasicBlock(BasicBlock&& other);
 
         /// No copy
         BasicBlock(const BasicBlock& other) = delete;
@@ -460,13 +509,26 @@ namespace IL {
         BasicBlock& operator=(BasicBlock&& other) = delete;
 
         /// Copy this basic block
-        /// \param map the new identifier map
-        /// \return the new basic block
+        ///   ! Parent lifetime tied to the copy, instructions are shared until first modified or referenced
+        /// \param out the destination block, its identifier map must be a copy of this blocks map
         void CopyTo(BasicBlock* out) const;
 
+        /// Materialize all instructions shared with the source block
+        ///  ? Logically const, the instruction stream is unchanged
+        void Materialize() const;
+
+        /// Check if this block still shares its instructions with a source block
+        bool IsShared() const {
+            return sharedSource != nullptr;
+        }
+
         /// Reindex all users
         void IndexUsers();
 
+        /// Flatten all segments into a single segment
+        ///  ? Intended before compilation, after which the block is no longer heavily modified
+        void Flatten();
+
         /// Add a new flag to this block
         /// \param value flag to be added
         void AddFlag(BasicBlockFlagSet value) {
@@ -492,16 +554,22 @@ namespace IL {
         Iterator Append(const Instruction* instruction, uint32_t size) {
             MarkAsDirty();
 
-            size_t offset = data.size();
-            data.resize(data.size() + size);
-            std::memcpy(&data[offset], instruction, size);
+            // Start a new segment if the last one is full
+            if (segments.empty() || segments.back()->data.size() >= kSegmentSize) {
+                InsertSegment(static_cast<uint32_t>(segments.size()));
+            }
+
+            BasicBlockSegment* segment = segments.back();
+
+            size_t offset = segment->data.size();
+            segment->data.resize(segment->data.size() + size);
+            std::memcpy(&segment->data[offset], instruction, size);
 
             InstructionRef<> ref;
             ref.basicBlock = this;
-            ref.relocationOffset = relocationAllocator.Allocate();
-            ref.relocationOffset->offset = static_cast<uint32_t>(offset);
+            ref.relocationOffset = AllocateRelocationOffset(segment, static_cast<uint32_t>(offset));
 
-            relocationTable.push_back(ref.relocationOffset);
+            segment->relocations.push_back(ref.relocationOffset);
 
             AddInstructionReferences(instruction, ref);
 
@@ -511,7 +579,7 @@ namespace IL {
             debugRevision++;
 #endif
 
-            return Offset(ref.relocationOffset, static_cast<uint32_t>(relocationTable.size()) - 1);
+            return Offset(ref.relocationOffset, static_cast<uint32_t>(segment->relocations.size()) - 1);
         }
 
         /// Append an instruction
@@ -535,19 +603,21 @@ namespace IL {
         /// \return the inserted reference
         template<typename T>
         TypedIterator<T> Insert(const ConstOpaqueInstructionRef &insertion, const T &instr) {
-            ASSERT(insertion.basicBlock == this, "Instruction offset not from the same basic block");
+            ASSERT(insertion.relocationOffset->segment->basicBlock == this, "Instruction offset not from the same basic block");
 
             MarkAsDirty();
 
+            // Only the owning segment is shifted
+            BasicBlockSegment* segment = GetSegment(insertion.relocationOffset);
+
             size_t offset = insertion.relocationOffset->offset;
 
             auto *newPtr = reinterpret_cast<const uint8_t *>(&instr);
-            data.insert(data.begin() + offset, newPtr, newPtr + IL::GetSize(&instr));
+            segment->data.insert(segment->data.begin() + offset, newPtr, newPtr + IL::GetSize(&instr));
 
             InstructionRef<T> ref;
             ref.basicBlock = this;
-            ref.relocationOffset = relocationAllocator.Allocate();
-            ref.relocationOffset->offset = static_cast<uint32_t>(offset);
+            ref.relocationOffset = AllocateRelocationOffset(segment, static_cast<uint32_t>(offset));
 
             if (instr.result != InvalidID) {
                 map.AddInstruction(ref, instr.result);
@@ -561,13 +631,13 @@ namespace IL {
             debugRevision++;
 #endif
 
-            return InsertRelocationOffset(insertion.relocationOffset, ref.relocationOffset);
+            return InsertRelocationOffset(segment, insertion.relocationOffset, ref.relocationOffset);
         }
 
         /// Remove an instruction
         /// \param instruction the instruction reference
         void Remove(const OpaqueInstructionRef &instruction) {
-            ASSERT(instruction.basicBlock == this, "Instruction offset not from the same basic block");
+            ASSERT(instruction.relocationOffset->segment->basicBlock == this, "Instruction offset not from the same basic block");
 
             MarkAsDirty();
 
@@ -577,15 +647,25 @@ namespace IL {
                 map.RemoveInstruction(ptr->result);
             }
 
+            // Only the owning segment is shifted
+            BasicBlockSegment* segment = GetSegment(instruction.relocationOffset);
+
             size_t offset = instruction.relocationOffset->offset;
-            data.erase(data.begin() + offset, data.begin() + offset + GetSize(ptr));
+            segment->data.erase(segment->data.begin() + offset, segment->data.begin() + offset + GetSize(ptr));
 
-            const uint64_t relocationIndex = std::find(relocationTable.begin(), relocationTable.end(), instruction.relocationOffset) - relocationTable.begin();
+            const uint32_t relocationIndex = GetRelocationIndex(segment, instruction.relocationOffset);
 
             // Remove relocation offset
-            RemoveRelocationOffset(instruction.relocationOffset);
-
-            ResummarizeRelocationTable(instruction.relocationOffset, static_cast<uint32_t>(relocationIndex));
+            segment->relocations.erase(segment->relocations.begin() + relocationIndex);
+            instruction.relocationOffset->segment = nullptr;
+            relocationAllocator.Free(instruction.relocationOffset);
+
+            // Empty segments are never kept
+            if (segment->relocations.empty()) {
+                RemoveSegment(segment);
+            } else {
+                ResummarizeSegment(segment, relocationIndex);
+            }
 
             count--;
 
@@ -600,7 +680,7 @@ namespace IL {
         /// \return the replaced reference
         template<typename T>
         TypedIterator<T> Replace(const OpaqueInstructionRef &instruction, const T &replacement) {
-            ASSERT(instruction.basicBlock == this, "Instruction offset not from the same basic block");
+            ASSERT(instruction.relocationOffset->segment->basicBlock == this, "Instruction offset not from the same basic block");
 
             MarkAsDirty();
 
@@ -610,6 +690,9 @@ namespace IL {
                 map.RemoveInstruction(ptr->result);
             }
 
+            // Only the owning segment is shifted
+            BasicBlockSegment* segment = GetSegment(instruction.relocationOffset);
+
             size_t size = GetSize(ptr);
             size_t offset = instruction.relocationOffset->offset;
 
@@ -618,14 +701,14 @@ namespace IL {
             // Compare size
             if (size > replacementSize) {
                 // Current instruction is too large, remove unused space
-                data.erase(data.begin() + offset + replacementSize, data.begin() + offset + size);
+                segment->data.erase(segment->data.begin() + offset + replacementSize, segment->data.begin() + offset + size);
             } else if (size < replacementSize) {
                 // Current instruction is too small, add new space
-                data.insert(data.begin() + offset + size, replacementSize - size, 0x0);
+                segment->data.insert(segment->data.begin() + offset + size, replacementSize - size, 0x0);
             }
 
             // Replace the instruction data
-            std::memcpy(data.data() + offset, &replacement, replacementSize);
+            std::memcpy(segment->data.data() + offset, &replacement, replacementSize);
 
             if (replacement.result != InvalidID) {
                 map.AddInstruction(instruction, replacement.result);
@@ -635,7 +718,10 @@ namespace IL {
             debugRevision++;
 #endif
 
-            return ResummarizeRelocationTable(instruction.relocationOffset);
+            // Resummarize all succeeding instructions
+            const uint32_t relocationIndex = GetRelocationIndex(segment, instruction.relocationOffset);
+            ResummarizeSegment(segment, relocationIndex);
+            return Offset(instruction.relocationOffset, relocationIndex);
         }
 
         /// Split this basic block from an iterator onwards
@@ -666,44 +752,35 @@ namespace IL {
         /// \return the terminator instruction
         Iterator GetTerminator() {
             ASSERT(count, "No instructions");
-            return Offset(relocationTable.back(), static_cast<uint32_t>(relocationTable.size()) - 1);
+            return Offset(segments.back()->relocations.back(), static_cast<uint32_t>(segments.back()->relocations.size()) - 1);
         }
 
         /// Get the terminator instruction
         /// \return the terminator instruction
         ConstIterator GetTerminator() const {
             ASSERT(count, "No instructions");
-            return Offset(relocationTable.back(), static_cast<uint32_t>(relocationTable.size()) - 1);
+            return Offset(segments.back()->relocations.back(), static_cast<uint32_t>(segments.back()->relocations.size()) - 1);
         }
 
         /// Get an iterator from a reference
         Iterator GetIterator(const ConstOpaqueInstructionRef& ref) {
-            ASSERT(ref.basicBlock == this, "Invalid reference");
-
-            // Find location
-            auto relocationIt = std::find(relocationTable.begin(), relocationTable.end(), ref.relocationOffset);
-            ASSERT(relocationIt != relocationTable.end(), "Missing relocation offset");
-
-            // Get the relocation index
-            uint32_t index = static_cast<uint32_t>(relocationIt - relocationTable.begin());
-            return Offset(ref.relocationOffset, index);
+            ASSERT(ref.relocationOffset->segment->basicBlock == this, "Invalid reference");
+            return Offset(ref.relocationOffset, GetRelocationIndex(GetSegment(ref.relocationOffset), ref.relocationOffset));
         }
 
         /// Get an iterator from a reference
         ConstIterator GetIterator(const ConstOpaqueInstructionRef& ref) const {
-            ASSERT(ref.basicBlock == this, "Invalid reference");
-
-            // Find location
-            auto relocationIt = std::find(relocationTable.begin(), relocationTable.end(), ref.relocationOffset);
-            ASSERT(relocationIt != relocationTable.end(), "Missing relocation offset");
-
-            // Get the relocation index
-            uint32_t index = static_cast<uint32_t>(relocationIt - relocationTable.begin());
-            return Offset(ref.relocationOffset, index);
+            ASSERT(ref.relocationOffset->segment->basicBlock == this, "Invalid reference");
+            return Offset(ref.relocationOffset, GetRelocationIndex(GetSegment(ref.relocationOffset), ref.relocationOffset));
         }
 
         /// Mark this basic block as dirty
+        ///  ? All modifications mark the block first, which materializes shared instructions
         void MarkAsDirty() {
+            if (sharedSource) {
+                Materialize();
+            }
+
             dirty = true;
         }
 
@@ -714,7 +791,7 @@ namespace IL {
 
         /// Check if this basic block is empty
         bool IsEmpty() const {
-            return data.empty();
+            return segments.empty();
         }
 
         /// Set the source span
@@ -743,6 +820,11 @@ namespace IL {
             return count;
         }
 
+        /// Get the number of segments
+        uint32_t GetSegmentCount() const {
+            return static_cast<uint32_t>(segments.size());
+        }
+
         /// Get the id of this basic block
         ID GetID() const {
             return id;
@@ -752,7 +834,7 @@ namespace IL {
         Iterator begin() {
             Iterator it;
             it.block = this;
-            it.ptr = data.data();
+            it.ptr = segments.empty() ? nullptr : segments.front()->data.data();
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
 #endif
@@ -763,7 +845,7 @@ namespace IL {
         ConstIterator begin() const {
             ConstIterator it;
             it.block = this;
-            it.ptr = data.data();
+            it.ptr = segments.empty() ? nullptr : segments.front()->data.data();
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
 #endif
@@ -774,10 +856,17 @@ namespace IL {
         Iterator end() {
             Iterator it;
             it.block = this;
-            it.ptr = data.data() + data.size();
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
 #endif
+
+            // End of the last segment
+            if (!segments.empty()) {
+                it.segmentIndex = static_cast<uint32_t>(segments.size()) - 1;
+                it.relocationIndex = static_cast<uint32_t>(segments.back()->relocations.size());
+                it.ptr = segments.back()->data.data() + segments.back()->data.size();
+            }
+
             return it;
         }
 
@@ -785,10 +874,17 @@ namespace IL {
         ConstIterator end() const {
             ConstIterator it;
             it.block = this;
-            it.ptr = data.data() + data.size();
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
 #endif
+
+            // End of the last segment
+            if (!segments.empty()) {
+                it.segmentIndex = static_cast<uint32_t>(segments.size()) - 1;
+                it.relocationIndex = static_cast<uint32_t>(segments.back()->relocations.size());
+                it.ptr = segments.back()->data.data() + segments.back()->data.size();
+            }
+
             return it;
         }
 
@@ -798,10 +894,16 @@ namespace IL {
         }
 
         /// Get a relocation offset from an index
-        /// \param index the linear index
+        /// \param segmentIndex the segment index
+        /// \param index the linear index within the segment
         /// \return the offset
-        RelocationOffset *GetRelocationOffset(uint32_t index) const {
-            return relocationTable.at(index);
+        RelocationOffset *GetRelocationOffset(uint32_t segmentIndex, uint32_t index) const {
+            // References never address shared instructions
+            if (sharedSource) {
+                Materialize();
+            }
+
+            return segments.at(segmentIndex)->relocations.at(index);
         }
 
         /// Get a relocation instruction
@@ -809,7 +911,7 @@ namespace IL {
         /// \return the instruction pointer
         template<typename T = Instruction>
         T *GetRelocationInstruction(const RelocationOffset *relocationOffset) {
-            auto* instruction = reinterpret_cast<Instruction *>(data.data() + relocationOffset->offset);
+            auto* instruction = reinterpret_cast<Instruction *>(GetSegment(relocationOffset)->data.data() + relocationOffset->offset);
 
             // Validation
             if constexpr(!std::is_same_v<T, Instruction>) {
@@ -824,7 +926,7 @@ namespace IL {
         /// \return the instruction pointer
         template<typename T = Instruction>
         const T *GetRelocationInstruction(const RelocationOffset *relocationOffset) const {
-            auto* instruction = reinterpret_cast<const Instruction *>(data.data() + relocationOffset->offset);
+            auto* instruction = reinterpret_cast<const Instruction *>(GetSegment(relocationOffset)->data.data() + relocationOffset->offset);
 
             // Validation
             if constexpr(!std::is_same_v<T, Instruction>) {
@@ -852,64 +954,105 @@ namespace IL {
         /// \param ref appended reference
         void AddInstructionReferences(const Instruction* instruction, const OpaqueInstructionRef& ref);
 
+        /// Rebind all instruction references from a source instruction
+        /// \param source the source relocation offset, previously referenced
+        /// \param ref the new reference
+        void RebindInstructionReferences(const RelocationOffset* source, const OpaqueInstructionRef& ref);
+
+        /// Allocate a new segment
+        /// \param index the segment index to insert at
+        /// \return the new segment
+        BasicBlockSegment* InsertSegment(uint32_t index);
+
+        /// Remove a segment, must be empty
+        /// \param segment the segment to remove
+        void RemoveSegment(BasicBlockSegment* segment);
+
+        /// Divide a segment, all instructions from the relocation index are moved to a new succeeding segment
+        /// \param segment the segment to divide
+        /// \param relocationIndex the first relocation index to move
+        /// \return the new segment
+        BasicBlockSegment* DivideSegment(BasicBlockSegment* segment, uint32_t relocationIndex);
+
+        /// Divide a segment until all parts are within the preferred size
+        /// \param segment the segment to rebalance
+        void RebalanceSegment(BasicBlockSegment* segment);
+
+        /// Allocate a new relocation offset
+        /// \param segment the owning segment
+        /// \param offset the byte offset within the segment
+        /// \return the relocation offset
+        RelocationOffset* AllocateRelocationOffset(BasicBlockSegment* segment, uint32_t offset) {
+            RelocationOffset* relocationOffset = relocationAllocator.Allocate();
+            relocationOffset->offset = offset;
+            relocationOffset->segment = segment;
+            return relocationOffset;
+        }
+
+        /// Get the segment of a relocation offset
+        static BasicBlockSegment* GetSegment(const RelocationOffset* offset) {
+            return static_cast<BasicBlockSegment*>(offset->segment);
+        }
+
+        /// Get the index of a relocation offset within its segment
+        static uint32_t GetRelocationIndex(const BasicBlockSegment* segment, const RelocationOffset* offset) {
+            auto relocationIt = std::find(segment->relocations.begin(), segment->relocations.end(), offset);
+            ASSERT(relocationIt != segment->relocations.end(), "Missing relocation offset");
+            return static_cast<uint32_t>(relocationIt - segment->relocations.begin());
+        }
+
         /// Insert a new relocation offset
+        /// \param segment the owning segment
         /// \param insertion the insertion relocation offset
         /// \param offset the new offset to be inserted
         /// \return the new iterator
-        Iterator InsertRelocationOffset(const RelocationOffset* insertion, RelocationOffset* offset) {
-            auto relocationIt = std::find(relocationTable.begin(), relocationTable.end(), insertion);
-            ASSERT(relocationIt != relocationTable.end(), "Missing relocation offset");
+        Iterator InsertRelocationOffset(BasicBlockSegment* segment, const RelocationOffset* insertion, RelocationOffset* offset) {
+            uint32_t index = GetRelocationIndex(segment, insertion);
 
-            // Get the relocation index
-            auto it = relocationTable.insert(relocationIt, offset);
-            uint32_t index = static_cast<uint32_t>(it - relocationTable.begin());
+            // Insert before the insertion point
+            segment->relocations.insert(segment->relocations.begin() + index, offset);
 
             // Resumarrize from the index
-            ResummarizeRelocationTable(offset, index);
-            return Offset(offset, index);
-        }
-
-        /// Resummarize the relocation table for references
-        /// \param offset the starting offset
-        /// \return the iterator for a given offset
-        Iterator ResummarizeRelocationTable(const RelocationOffset* offset) {
-            auto relocationIt = std::find(relocationTable.begin(), relocationTable.end(), offset);
-            ASSERT(relocationIt != relocationTable.end(), "Missing relocation offset");
+            ResummarizeSegment(segment, index);
 
-            // Get the relocation index
-            uint32_t index = static_cast<uint32_t>(relocationIt - relocationTable.begin());
+            // Keep the segment bounded, may migrate the offset
+            if (segment->data.size() > kSegmentSize * 2) {
+                RebalanceSegment(segment);
+                index = GetRelocationIndex(GetSegment(offset), offset);
+            }
 
-            // Resumarrize from the index
-            ResummarizeRelocationTable(offset, index);
             return Offset(offset, index);
         }
 
-        /// Resummarize the relocation table for references
-        /// \param offset the offset to start from
+        /// Resummarize the relocation offsets of a segment
+        /// \param segment the segment to resummarize
         /// \param relocationIndex the relocation index to start from
-        void ResummarizeRelocationTable(const RelocationOffset* offset, uint32_t relocationIndex) {
-            for (auto it = Offset(offset, relocationIndex); it != end(); it++) {
-                // TODO: Stop when the offset is the same! (Not guaranteed atm, for the future)
-                relocationTable[it.relocationIndex]->offset = static_cast<uint32_t>(it.ptr - data.data());
+        static void ResummarizeSegment(BasicBlockSegment* segment, uint32_t relocationIndex) {
+            uint32_t offset = 0;
+
+            // Continue from the preceding instruction
+            if (relocationIndex) {
+                const RelocationOffset* previous = segment->relocations[relocationIndex - 1];
+                offset = previous->offset + static_cast<uint32_t>(GetSize(reinterpret_cast<const Instruction*>(segment->data.data() + previous->offset)));
             }
-        }
 
-        /// Resummarize the relocation table for references
-        void ResummarizeRelocationTable() {
-            for (auto it = begin(); it != end(); it++) {
-                // TODO: Stop when the offset is the same! (Not guaranteed atm, for the future)
-                relocationTable[it.relocationIndex]->offset = static_cast<uint32_t>(it.ptr - data.data());
+            for (uint32_t i = relocationIndex; i < segment->relocations.size(); i++) {
+                segment->relocations[i]->offset = offset;
+                offset += static_cast<uint32_t>(GetSize(reinterpret_cast<const Instruction*>(segment->data.data() + offset)));
             }
         }
 
         /// Get an iterator from a relocation offset
         /// \param offset the relocation offset
-        /// \param relocationIndex the index of the relocation offset
+        /// \param relocationIndex the index of the relocation offset within its segment
         /// \return
         Iterator Offset(const RelocationOffset* offset, uint32_t relocationIndex) {
+            BasicBlockSegment* segment = GetSegment(offset);
+
             Iterator it;
             it.block = this;
-            it.ptr = data.data() + offset->offset;
+            it.ptr = segment->data.data() + offset->offset;
+            it.segmentIndex = segment->index;
             it.relocationIndex = relocationIndex;
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
@@ -919,12 +1062,15 @@ namespace IL {
 
         /// Get an iterator from a relocation offset
         /// \param offset the relocation offset
-        /// \param relocationIndex the index of the relocation offset
+        /// \param relocationIndex the index of the relocation offset within its segment
         /// \return
         ConstIterator Offset(const RelocationOffset* offset, uint32_t relocationIndex) const {
+            const BasicBlockSegment* segment = GetSegment(offset);
+
             ConstIterator it;
             it.block = this;
-            it.ptr = data.data() + offset->offset;
+            it.ptr = segment->data.data() + offset->offset;
+            it.segmentIndex = segment->index;
             it.relocationIndex = relocationIndex;
 #ifndef NDEBUG
             it.debugRevision = debugRevision;
@@ -932,14 +1078,6 @@ namespace IL {
             return it;
         }
 
-        /// Remove a relocation offset
-        void RemoveRelocationOffset(RelocationOffset *offset) {
-            auto it = std::find(relocationTable.begin(), relocationTable.end(), offset);
-            ASSERT(it != relocationTable.end(), "Dangling relocation offset");
-            relocationTable.erase(it);
-            relocationAllocator.Free(offset);
-        }
-
     private:
         Allocators allocators;
 
@@ -955,15 +1093,15 @@ namespace IL {
         /// The shared identifier map
         IdentifierMap &map;
 
-        /// Instruction stream
-        Vector<uint8_t> data;
-
-        /// The current relocation table for resummarization
-        Vector<RelocationOffset *> relocationTable;
+        /// All instruction segments, never empty
+        Vector<BasicBlockSegment *> segments;
 
         /// Relocation block allocator
         RelocationAllocator relocationAllocator;
 
+        /// Source block owning the shared segments, null if owned by this block
+        const BasicBlock* sharedSource{nullptr};
+
         /// Block flags
         BasicBlockFlagSet flags{0};
 
@@ -29,7 +29,11 @@
 // Backend
 #include <Backend/IL/BasicBlockList.h>
 
+// Common
+#include <Common/Assert.h>
+
 // Std
+#include <unordered_map>
 #include <variant>
 #include <vector>
 
@@ -47,8 +51,21 @@ namespace IL {
             TraversePostOrder(basicBlocks, basicBlocks.GetEntryPoint());
         }
 
+        /// Insert a basic block into the traversal
+        ///   ? Insertions are deferred until the view is requested
+        /// \param position the block to insert before, must be part of the traversal
+        /// \param bb the block to insert
+        void Insert(BasicBlock* position, BasicBlock* bb) {
+            insertions[position].push_back(bb);
+            insertionCount++;
+        }
+
         /// Get the current traversal view
         const BlockView &GetView() const {
+            if (insertionCount) {
+                ApplyInsertions();
+            }
+
             return blocks;
         }
 
@@ -115,12 +132,49 @@ namespace IL {
             return true;
         }
 
+        /// Apply all deferred insertions
+        void ApplyInsertions() const {
+            BlockView view;
+            view.reserve(blocks.size() + insertionCount);
+
+            // Pending blocks, and the next inserted block to visit
+            std::vector<std::pair<BasicBlock*, uint32_t>> stack;
+
+            for (BasicBlock* bb : blocks) {
+                stack.emplace_back(bb, 0u);
+
+                // Blocks inserted before a block may have insertions of their own
+                while (!stack.empty()) {
+                    auto&& [top, index] = stack.back();
+
+                    // Any inserted blocks left?
+                    if (auto it = insertions.find(top); it != insertions.end() && index < it->second.size()) {
+                        BasicBlock* inserted = it->second[index++];
+                        stack.emplace_back(inserted, 0u);
+                        continue;
+                    }
+
+                    view.push_back(top);
+                    stack.pop_back();
+                }
+            }
+
+            // Validate positions
+            ASSERT(view.size() == blocks.size() + insertionCount, "Insertion position not part of traversal");
+
+            blocks.swap(view);
+            insertions.clear();
+            insertionCount = 0;
+        }
+
         /// Clear the state
         /// \param basicBlocks all basic blocks
         void Clear(BasicBlockList& basicBlocks) {
             // Cleanup
             visitedStates.clear();
             blocks.clear();
+            insertions.clear();
+            insertionCount = 0;
 
             // Determine the effective bound
             uint32_t bound = 0;
@@ -136,7 +190,13 @@ namespace IL {
         /// All visitation states
         std::vector<uint32_t> visitedStates;
 
-        /// All blocks
-        std::vector<BasicBlock*> blocks;
+        /// All blocks, mutable for deferred insertions
+        mutable std::vector<BasicBlock*> blocks;
+
+        /// Deferred insertions, keyed by the block they precede
+        mutable std::unordered_map<BasicBlock*, BlockView> insertions;
+
+        /// Number of deferred insertions
+        mutable size_t insertionCount{0};
     };
 }
\ No newline at end of file
@@ -32,9 +32,12 @@
 #include <Backend/IL/BasicBlockList.h>
 #include <Backend/IL/CFG/BasicBlockTraversal.h>
 
+// Common
+#include <Common/Assert.h>
+
 // Std
 #include <vector>
-#include <unordered_map>
+#include <algorithm>
 
 namespace IL {
     class DominatorTree {
@@ -63,12 +66,16 @@ namespace IL {
             // Map out all blocks
             MapBlocks();
 
+            // Get final order
+            const BasicBlockTraversal::BlockView& view = poTraversal.GetView();
+
             // Mutation loop
             for (;;) {
                 bool mutated = false;
 
-                // Post order
-                for (BasicBlock* bb : poTraversal.GetView()) {
+                // Reverse post order, predecessors are visited first and converge in few iterations
+                for (auto it = view.rbegin(); it != view.rend(); it++) {
+                    BasicBlock* bb = *it;
                     if (bb == entryPoint) {
                         continue;
                     }
@@ -117,9 +124,117 @@ namespace IL {
                     break;
                 }
             }
+
+            // Construct the tree from the immediate dominators, visited in reverse post-order for stable numbering
+            for (auto it = view.rbegin(); it != view.rend(); it++) {
+                if (*it != entryPoint) {
+                    GetBlock(GetBlock(*it).immediateDominator).children.push_back(*it);
+                }
+            }
+
+            // Number the tree for constant time queries
+            NumberBlocks();
+        }
+
+        /// Update the tree after splitting a basic block
+        ///   ? Expects all successors of the block to be moved to the resume block, and the block to branch to the resume block
+        /// \param bb the block that was split
+        /// \param resume the new resume block, must not be part of the tree
+        void SplitBlock(BasicBlock* bb, BasicBlock* resume) {
+            Block& resumeBlock = AddBlock(resume);
+            Block& block = GetBlock(bb);
+
+            // Resume inherits all successors
+            resumeBlock.successors.swap(block.successors);
+            block.successors.push_back(resume);
+            resumeBlock.predecessors.push_back(bb);
+
+            // Redirect the predecessors of all successors
+            for (BasicBlock* successor : resumeBlock.successors) {
+                BlockView& predecessors = GetBlock(successor).predecessors;
+                std::replace(predecessors.begin(), predecessors.end(), bb, resume);
+            }
+
+            // Unreachable blocks have no dominators
+            if (!block.immediateDominator) {
+                return;
+            }
+
+            // All paths to the immediately dominated blocks now pass through resume
+            resumeBlock.children.swap(block.children);
+            block.children.push_back(resume);
+
+            for (BasicBlock* child : resumeBlock.children) {
+                GetBlock(child).immediateDominator = resume;
+            }
+
+            resumeBlock.immediateDominator = bb;
+
+            // Resume must encapsulate the previous children, and leave space for succeeding children of the block
+            if (resumeBlock.children.empty()) {
+                resumeBlock.preIndex = block.preIndex + (block.postIndex - block.preIndex) / 3;
+                resumeBlock.postIndex = block.preIndex + (block.postIndex - block.preIndex) * 2 / 3;
+            } else {
+                resumeBlock.preIndex = block.preIndex + (GetBlock(resumeBlock.children.front()).preIndex - block.preIndex) / 2;
+                resumeBlock.postIndex = block.postIndex - (block.postIndex - GetBlock(resumeBlock.children.back()).postIndex) / 2;
+            }
+
+            // Out of space?
+            if (!IsNumberingValid(block, resumeBlock)) {
+                NumberBlocks();
+            }
+
+            // Resume precedes the block in post-order
+            poTraversal.Insert(bb, resume);
+        }
+
+        /// Update the tree after inserting a side block, branching from a block and rejoining one of its successors
+        ///   ? Expects the block to branch to the side block, and the side block to branch to the rejoin block, if any
+        /// \param bb the block branching to the side block
+        /// \param side the new side block, must not be part of the tree
+        /// \param rejoin the rejoined block, must be an existing successor of the block, null if the side block exits the function
+        void InsertSideBlock(BasicBlock* bb, BasicBlock* side, BasicBlock* rejoin) {
+            Block& sideBlock = AddBlock(side);
+            Block& block = GetBlock(bb);
+
+            // Link the side block
+            block.successors.push_back(side);
+            sideBlock.predecessors.push_back(bb);
+
+            // Link the rejoin block
+            if (rejoin) {
+                ASSERT(std::find(block.successors.begin(), block.successors.end(), rejoin) != block.successors.end(), "Rejoin block must be a successor");
+                sideBlock.successors.push_back(rejoin);
+                GetBlock(rejoin).predecessors.push_back(side);
+            }
+
+            // Unreachable blocks have no dominators
+            if (!block.immediateDominator) {
+                return;
+            }
+
+            // All paths to the rejoin block already passed through the block, only the side block is dominated
+            uint64_t lowerBound = block.children.empty() ? block.preIndex : GetBlock(block.children.back()).postIndex;
+            sideBlock.preIndex = lowerBound + (block.postIndex - lowerBound) / 3;
+            sideBlock.postIndex = lowerBound + (block.postIndex - lowerBound) * 2 / 3;
+            sideBlock.immediateDominator = bb;
+
+            // Out of space?
+            bool isNumberingValid = IsNumberingValid(block, sideBlock) && lowerBound < sideBlock.preIndex;
+
+            // Append after all other children
+            block.children.push_back(side);
+
+            if (!isNumberingValid) {
+                NumberBlocks();
+            }
+
+            // Side block precedes the block in post-order
+            poTraversal.Insert(bb, side);
         }
 
         /// Determine if a basic block dominates another
+        ///   ? Dominance is strict, except for the entry point which dominates all blocks
         /// \param first domainating block
         /// \param second block being dominated
         /// \return true if first dominates second
@@ -129,37 +244,32 @@ namespace IL {
                 return true;
             }
 
-            // First dominator
-            BasicBlock* immediateDominator = GetImmediateDominator(second);
-
-            // Walk backwards
-            while (immediateDominator != first && immediateDominator != entryPoint) {
-                immediateDominator = GetImmediateDominator(immediateDominator);
-            }
+            const Block& firstBlock = GetBlock(first);
+            const Block& secondBlock = GetBlock(second);
 
-            // Found?
-            return immediateDominator == first;
+            // Unreachable blocks are not numbered, and never satisfy the interval
+            return firstBlock.preIndex < secondBlock.preIndex && secondBlock.postIndex < firstBlock.postIndex;
         }
 
         /// Get the immediate dominator of a basic block
         /// \param bb basic block
         /// \return immediate dominator
         BasicBlock* GetImmediateDominator(BasicBlock* bb) const {
-            return blocks.at(bb->GetID()).immediateDominator;
+            return GetBlock(bb).immediateDominator;
         }
 
         /// Get the predecessors of a basic block
         /// \param bb basic block
         /// \return predecessors
         const BlockView& GetPredecessors(BasicBlock* bb) const {
-            return blocks.at(bb->GetID()).predecessors;
+            return GetBlock(bb).predecessors;
         }
 
         /// Get the successprs of a basic block
         /// \param bb basic block
         /// \return successors
         const BlockView& GetSuccessors(BasicBlock* bb) const {
-            return blocks.at(bb->GetID()).successors;
+            return GetBlock(bb).successors;
         }
 
         /// Get the post order traversal
@@ -172,8 +282,11 @@ namespace IL {
         /// \param id block identifier
         /// \return nullptr if not found
         BasicBlock* GetBlock(IL::ID id) const {
-            auto it = blocks.find(id);
-            return it != blocks.end() ? it->second.basicBlock : nullptr;
+            if (id >= indices.size() || indices[id] == kInvalidIndex) {
+                return nullptr;
+            }
+
+            return blocks[indices[id]].basicBlock;
         }
         
         /// Get all basic blocks
@@ -195,27 +308,63 @@ namespace IL {
             /// All successors
             BlockView successors;
 
+            /// All immediately dominated blocks, in numbering order
+            BlockView children;
+
             /// Ordering index
             uint32_t orderIndex{0};
+
+            /// Tree numbering, a block dominates all blocks within its interval
+            ///  ? Zero if unreachable
+            uint64_t preIndex{0};
+            uint64_t postIndex{0};
         };
 
+        /// Invalid dense index
+        static constexpr uint32_t kInvalidIndex = ~0u;
+
+        /// Spacing between numbered blocks, reserved for incremental updates
+        static constexpr uint64_t kNumberingSpacing = 1ull << 16;
+
     private:
         /// Get the block
         Block& GetBlock(BasicBlock* bb) {
-            return blocks[bb->GetID()];
+            return blocks[indices[bb->GetID()]];
+        }
+
+        /// Get the block
+        const Block& GetBlock(BasicBlock* bb) const {
+            ASSERT(bb->GetID() < indices.size() && indices[bb->GetID()] != kInvalidIndex, "Block not part of tree");
+            return blocks[indices[bb->GetID()]];
+        }
+
+        /// Add a new block
+        /// \param bb the block to add
+        /// \return the new block
+        Block& AddBlock(BasicBlock* bb) {
+            if (bb->GetID() >= indices.size()) {
+                indices.resize(bb->GetID() + 1, kInvalidIndex);
+            }
+
+            ASSERT(indices[bb->GetID()] == kInvalidIndex, "Block already part of tree");
+            indices[bb->GetID()] = static_cast<uint32_t>(blocks.size());
+
+            Block& block = blocks.emplace_back();
+            block.basicBlock = bb;
+            return block;
         }
 
         /// Initialize all blocks
         void InitializeBlocks() {
             blocks.clear();
+            blocks.reserve(basicBlocks.GetBlockCount());
+
+            // Reset dense lookup
+            indices.assign(basicBlocks.GetBlockBound(), kInvalidIndex);
 
             // Reset block states
             for (BasicBlock* bb : basicBlocks) {
-                Block& block = blocks[bb->GetID()];
-                block.basicBlock = bb;
-                block.immediateDominator = nullptr;
-                block.predecessors.clear();
-                block.orderIndex = 0;
+                AddBlock(bb);
             }
         }
 
@@ -232,7 +381,7 @@ namespace IL {
                 BasicBlock* bb = view[i];
 
                 // Assign order index, used for finger comparison
-                blocks[bb->GetID()].orderIndex = static_cast<uint32_t>(i) + 1;
+                GetBlock(bb).orderIndex = static_cast<uint32_t>(i) + 1;
 
                 // Get the terminator
                 const Instruction* terminator = bb->GetTerminator();
@@ -244,20 +393,20 @@ namespace IL {
                         break;
                     case OpCode::Branch: {
                         auto* instr = terminator->As<BranchInstruction>();
-                        AddPredecessor(basicBlocks.GetBlock(instr->branch), bb);
+                        AddPredecessor(instr->branch, bb);
                         break;
                     }
                     case OpCode::BranchConditional: {
                         auto* instr = terminator->As<BranchConditionalInstruction>();
-                        AddPredecessor(basicBlocks.GetBlock(instr->pass), bb);
-                        AddPredecessor(basicBlocks.GetBlock(instr->fail), bb);
+                        AddPredecessor(instr->pass, bb);
+                        AddPredecessor(instr->fail, bb);
                         break;
                     }
                     case OpCode::Switch: {
                         auto* instr = terminator->As<SwitchInstruction>();
-                        AddPredecessor(basicBlocks.GetBlock(instr->_default), bb);
+                        AddPredecessor(instr->_default, bb);
                         for (uint32_t caseIndex = 0; caseIndex < instr->cases.count; caseIndex++) {
-                            AddPredecessor(basicBlocks.GetBlock(instr->cases[caseIndex].branch), bb);
+                            AddPredecessor(instr->cases[caseIndex].branch, bb);
                         }
                         break;
                     }
@@ -271,14 +420,64 @@ namespace IL {
         /// Add a block predecessor
         /// \param block destination block
         /// \param from given predecessor
-        void AddPredecessor(BasicBlock* block, BasicBlock* from) {
-            blocks[block->GetID()].predecessors.push_back(from);
-            blocks[from->GetID()].successors.push_back(block);
+        void AddPredecessor(IL::ID block, BasicBlock* from) {
+            Block& to = blocks[indices[block]];
+            to.predecessors.push_back(from);
+            GetBlock(from).successors.push_back(to.basicBlock);
+        }
+
+        /// Number all blocks by a depth first traversal of the tree
+        void NumberBlocks() {
+            for (Block& block : blocks) {
+                block.preIndex = 0;
+                block.postIndex = 0;
+            }
+
+            // Pending blocks, and the next child to visit
+            std::vector<std::pair<Block*, uint32_t>> stack;
+
+            // Start at entry
+            Block& entryBlock = GetBlock(basicBlocks.GetEntryPoint());
+            stack.emplace_back(&entryBlock, 0u);
+
+            // Running numbering
+            uint64_t index = kNumberingSpacing;
+            entryBlock.preIndex = index;
+
+            // Walk until exhausted
+            while (!stack.empty()) {
+                auto&& [block, childIndex] = stack.back();
+
+                // All children visited?
+                if (childIndex == block->children.size()) {
+                    index += kNumberingSpacing;
+                    block->postIndex = index;
+                    stack.pop_back();
+                    continue;
+                }
+
+                // Visit next child
+                Block& child = GetBlock(block->children[childIndex++]);
+                index += kNumberingSpacing;
+                child.preIndex = index;
+                stack.emplace_back(&child, 0u);
+            }
+        }
+
+        /// Check if the numbering of a newly dominated block is valid
+        /// \param block the dominating block
+        /// \param dominated the newly dominated block
+        /// \return false if out of space
+        static bool IsNumberingValid(const Block& block, const Block& dominated) {
+            return block.preIndex < dominated.preIndex && dominated.preIndex < dominated.postIndex && dominated.postIndex < block.postIndex;
         }
 
     private:
-        /// All blocks
-        std::unordered_map<IL::ID, Block> blocks;
+        /// All blocks, densely indexed
+        std::vector<Block> blocks;
+
+        /// Dense index of all blocks, indexed by block identifier
+        std::vector<uint32_t> indices;
 
     private:
         /// Source basic blocks
@@ -287,4 +486,4 @@ namespace IL {
         /// Post-order traversal
         BasicBlockTraversal poTraversal;
     };
-}
\ No newline at end of file
+}
@@ -35,5 +35,8 @@ namespace IL {
 
         /// Does the program represent integer signs as unique types?
         bool integerSignIsUnique = true;
+
+        /// Can exports reserve stream space for all active lanes of a wave at once?
+        bool hasWaveAggregation = false;
     };
 }
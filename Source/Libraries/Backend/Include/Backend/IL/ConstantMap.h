@@ -30,9 +30,14 @@
 #include "Constant.h"
 #include "TypeMap.h"
 #include "IdentifierMap.h"
+#include "SortKeyHash.h"
 
 // Common
 #include <Common/Containers/LinearBlockAllocator.h>
+#include <Common/Containers/CopyOnWrite.h>
+
+// UnorderedDense
+#include <ankerl/unordered_dense.h>
 
 // Std
 #include <unordered_map>
@@ -41,6 +46,7 @@ namespace Backend::IL {
     using namespace ::IL;
 
     /// Constant map, provides unique constants
+    ///  ? Constants are hash-consed and immutable, the interned set and id lookup are shared between copies until changed
     struct ConstantMap {
         using Container = std::vector<Constant*>;
         
@@ -52,18 +58,17 @@ namespace Backend::IL {
         /// Create a copy of this constant map
         /// \param out destination map
         void CopyTo(ConstantMap& out) const {
-            // Copy the maps
+            // Share the maps
+            out.interned = interned;
             out.idMap = idMap;
-            out.maps = maps;
-            out.constants = constants;
         }
 
         /// Find a constant from his map
         /// \param constant the constant declaration
         /// \return the constant pointer, nullptr if not found
         template<typename T>
-        const T* FindConstant(const typename T::Type* type, const T &constant) {
-            auto&& sortMap = GetSortMap<T>();
+        const T* FindConstant(const typename T::Type* type, const T &constant) const {
+            auto&& sortMap = interned->maps.*GetSortMap<T>();
 
             if (auto it = sortMap.find(constant.SortKey(type)); it != sortMap.end()) {
                 return it->second;
@@ -77,29 +82,28 @@ namespace Backend::IL {
         /// \return the constant pointer
         template<typename T>
         const T* FindConstantOrAdd(const typename T::Type* type, const T &constant) {
-            auto&& sortMap = GetSortMap<T>();
-
-            auto &constantPtr = sortMap[constant.SortKey(type)];
-            if (!constantPtr) {
-                constantPtr = AllocateConstant<T>(identifierMap.AllocID(), type, constant);
+            // Existing constants never detach the shared maps
+            if (const T* existing = FindConstant(type, constant)) {
+                return existing;
             }
 
-            return constantPtr;
+            T* allocation = AllocateConstant<T>(identifierMap.AllocID(), type, constant);
+            (interned.GetMutable().maps.*GetSortMap<T>())[constant.SortKey(type)] = allocation;
+            return allocation;
         }
 
         /// Add a constant to this map, must be unique
         /// \param constant the constant to be added
         template<typename T>
         const Constant* AddConstant(ID id, const typename T::Type* type, const T &constant) {
-            auto&& sortMap = GetSortMap<T>();
-
-            auto &constantPtr = sortMap[constant.SortKey(type)];
-            if (!constantPtr) {
-                constantPtr = AllocateConstant<T>(id, type, constant);
-                idMap[id] = constantPtr;
+            if (const T* existing = FindConstant(type, constant)) {
+                return existing;
             }
 
-            return constantPtr;
+            T* allocation = AllocateConstant<T>(id, type, constant);
+            (interned.GetMutable().maps.*GetSortMap<T>())[constant.SortKey(type)] = allocation;
+            idMap.GetMutable()[id] = allocation;
+            return allocation;
         }
 
         /// Add a constant to this map, must be unique
@@ -107,7 +111,7 @@ namespace Backend::IL {
         template<typename T>
         const Constant* AddUnsortedConstant(ID id, const Backend::IL::Type* type, const T &constant) {
             auto constantPtr = AllocateConstant<T>(id, type, constant);
-            idMap[id] = constantPtr;
+            idMap.GetMutable()[id] = constantPtr;
             return constantPtr;
         }
 
@@ -116,23 +120,27 @@ namespace Backend::IL {
         /// \param constant the resulting constant
         void SetConstant(ID id, const Constant *constant) {
             ASSERT(id != InvalidID, "SetConstant must have a valid id");
-            idMap[id] = constant;
+            idMap.GetMutable()[id] = constant;
         }
 
         /// Get the constant for a given id
         /// \param id the id to be looked up
         /// \return the resulting constant, may be nullptr
-        const Constant *GetConstant(ID id) {
-            const Constant *constant = idMap[id];
-            return constant;
+        const Constant *GetConstant(ID id) const {
+            auto it = idMap->find(id);
+            if (it == idMap->end()) {
+                return nullptr;
+            }
+
+            return it->second;
         }
 
         /// Get the constant for a given id
         /// \param id the id to be looked up
         /// \return the resulting constant, may be nullptr
         template<typename T>
-        const T *GetConstant(ID id) {
-            const Constant *constant = idMap[id];
+        const T *GetConstant(ID id) const {
+            const Constant *constant = GetConstant(id);
             return constant ? constant->Cast<T>() : nullptr;
         }
 
@@ -147,14 +155,10 @@ namespace Backend::IL {
         }
 
         /// Iterator accessors
-        Container::iterator begin() { return constants.begin(); }
-        Container::reverse_iterator rbegin() { return constants.rbegin(); }
-        Container::iterator end() { return constants.end(); }
-        Container::reverse_iterator rend() { return constants.rend(); }
-        Container::const_iterator begin() const { return constants.begin(); }
-        Container::const_reverse_iterator rbegin() const { return constants.rbegin(); }
-        Container::const_iterator end() const { return constants.end(); }
-        Container::const_reverse_iterator rend() const { return constants.rend(); }
+        Container::const_iterator begin() const { return interned->constants.begin(); }
+        Container::const_reverse_iterator rbegin() const { return interned->constants.rbegin(); }
+        Container::const_iterator end() const { return interned->constants.end(); }
+        Container::const_reverse_iterator rend() const { return interned->constants.rend(); }
 
     private:
         /// Allocate a new constant
@@ -169,25 +173,45 @@ namespace Backend::IL {
             constant->id = id;
             constant->type = type;
             constant->kind = T::kKind;
-            constants.push_back(constant);
+            interned.GetMutable().constants.push_back(constant);
             return constant;
         }
 
         template<typename T>
-        using SortMap = std::map<ConstantSortKey<T>, T*>;
+        using SortMap = ankerl::unordered_dense::map<ConstantSortKey<T>, T*, SortKeyHash>;
+
+        /// Constant cache
+        struct ConstantMaps {
+            SortMap<UnexposedConstant> unexposedMap;
+            SortMap<BoolConstant> boolMap;
+            SortMap<IntConstant> intMap;
+            SortMap<FPConstant> fpMap;
+            SortMap<StructConstant> structMap;
+            SortMap<UndefConstant> undefMap;
+            SortMap<NullConstant> nullMap;
+        };
 
         /// Map fetchers
         template<typename T>
-        SortMap<T>& GetSortMap() {}
+        static SortMap<T> ConstantMaps::* GetSortMap() {}
 
         /// Map fetcher impl
-        template<> SortMap<UnexposedConstant>& GetSortMap<UnexposedConstant>() { return maps.unexposedMap; }
-        template<> SortMap<BoolConstant>& GetSortMap<BoolConstant>() { return maps.boolMap; }
-        template<> SortMap<IntConstant>& GetSortMap<IntConstant>() { return maps.intMap; }
-        template<> SortMap<FPConstant>& GetSortMap<FPConstant>() { return maps.fpMap; }
-        template<> SortMap<StructConstant>& GetSortMap<StructConstant>() { return maps.structMap; }
-        template<> SortMap<UndefConstant>& GetSortMap<UndefConstant>() { return maps.undefMap; }
-        template<> SortMap<NullConstant>& GetSortMap<NullConstant>() { return maps.nullMap; }
+        template<> SortMap<UnexposedConstant> ConstantMaps::* GetSortMap<UnexposedConstant>() { return &ConstantMaps::unexposedMap; }
+        template<> SortMap<BoolConstant> ConstantMaps::* GetSortMap<BoolConstant>() { return &ConstantMaps::boolMap; }
+        template<> SortMap<IntConstant> ConstantMaps::* GetSortMap<IntConstant>() { return &ConstantMaps::intMap; }
+        template<> SortMap<FPConstant> ConstantMaps::* GetSortMap<FPConstant>() { return &ConstantMaps::fpMap; }
+        template<> SortMap<StructConstant> ConstantMaps::* GetSortMap<StructConstant>() { return &ConstantMaps::structMap; }
+        template<> SortMap<UndefConstant> ConstantMaps::* GetSortMap<UndefConstant>() { return &ConstantMaps::undefMap; }
+        template<> SortMap<NullConstant> ConstantMaps::* GetSortMap<NullConstant>() { return &ConstantMaps::nullMap; }
+
+        /// Interned constants
+        struct InternedConstants {
+            /// Unique constants
+            ConstantMaps maps;
+
+            /// Declaration order
+            Container constants;
+        };
 
     private:
         Allocators allocators;
@@ -198,30 +222,16 @@ namespace Backend::IL {
         /// Unique constraints for type mapping
         const CapabilityTable& capabilityTable;
 
-        /// Constant cache
-        struct ConstantMaps {
-            SortMap<UnexposedConstant> unexposedMap;
-            SortMap<BoolConstant> boolMap;
-            SortMap<IntConstant> intMap;
-            SortMap<FPConstant> fpMap;
-            SortMap<StructConstant> structMap;
-            SortMap<UndefConstant> undefMap;
-            SortMap<NullConstant> nullMap;
-        };
-        
-        /// Declaration order
-        std::vector<Constant*> constants;
-
         /// Identifiers
         IdentifierMap& identifierMap;
 
         /// Types
         TypeMap& typeMap;
 
-        /// All maps
-        ConstantMaps maps;
+        /// All interned constants, shared between copies
+        CopyOnWrite<InternedConstants> interned;
 
-        /// Id lookup
-        std::unordered_map<ID, const Constant *> idMap;
+        /// Id lookup, shared between copies
+        CopyOnWrite<ankerl::unordered_dense::map<ID, const Constant*>> idMap;
     };
 }
@@ -981,6 +981,28 @@ namespace IL {
             return Op(*instr);
         }
 
+        /// Export an already constructed shader export
+        /// \param exportID the allocation id for the export
+        /// \param values all constructed dwords to be exported
+        /// \param count the number of dwords
+        /// \return instruction reference
+        BasicBlock::TypedIterator <ExportInstruction> Export(ShaderExportID exportID, const ID* values, uint32_t count) {
+            auto instr = ALLOCA_SIZE(IL::ExportInstruction, IL::ExportInstruction::GetSize(count));
+            instr->opCode = OpCode::Export;
+            instr->source = Source::Invalid();
+            instr->result = map->AllocID();
+            instr->exportID = exportID;
+            instr->values.count = count;
+
+            // Copy dwords
+            for (uint32_t i = 0; i < count; i++) {
+                ASSERT(IsMapped(values[i]), "Unmapped identifier");
+                instr->values[i] = values[i];
+            }
+
+            return Op(*instr);
+        }
+
         /// Construct and export a shader export
         /// \param exportID the allocation id for the export
         /// \param value the value to be exported, constructed internally
@@ -0,0 +1,148 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include "ID.h"
+#include "Emitter.h"
+#include "BasicBlockList.h"
+#include <Backend/ShaderExport.h>
+
+// Std
+#include <vector>
+
+namespace IL {
+    /// Number of bits addressing the device side export filter table
+    static constexpr uint32_t kExportFilterTableBits = 12u;
+
+    /// Number of slots in the device side export filter table
+    static constexpr uint32_t kExportFilterTableSize = 1u << kExportFilterTableBits;
+
+    /// Device side export filter counters
+    enum class ExportFilterCounter : uint32_t {
+        /// Number of first occurrences passed through the filter
+        Hit,
+
+        /// Number of duplicate exports suppressed by the filter
+        Drop,
+
+        /// Number of counters
+        Count
+    };
+
+    /// Multiplicative hashing constant, golden ratio
+    static constexpr uint32_t kExportFilterHashMultiplier = 0x9E3779B1u;
+
+    template<typename E>
+    struct ExportFilterEmitter {
+        /// Constructor
+        /// \param emitter emitter to filter exports in, must append to its block
+        /// \param basicBlocks block list of the owning function
+        /// \param tableDataID table buffer, one tag per slot
+        /// \param counterDataID counter buffer, see ExportFilterCounter
+        /// \param epochID epoch value of the current submission
+        ExportFilterEmitter(E& emitter, BasicBlockList& basicBlocks, ID tableDataID, ID counterDataID, ID epochID) :
+            emitter(emitter),
+            basicBlocks(basicBlocks),
+            tableDataID(tableDataID),
+            counterDataID(counterDataID),
+            epochID(epochID) {
+
+        }
+
+        /// Export a message if its key has not been exported during the current epoch
+        ///   ? The table is direct mapped, each slot holds the last key tag exchanged into it. Tags are offset by the
+        ///     submission epoch, so entries of previous submissions never match and the table needs no reset.
+        ///   ? Colliding keys evict each other, which only lets more messages through, never fewer.
+        /// \param exportID the allocation id for the export
+        /// \param message the message to be exported, constructed internally
+        template<typename T>
+        void Export(ShaderExportID exportID, const T& message) {
+            // Query number of dwords
+            uint32_t dwordCount{};
+            message.Construct(emitter, &dwordCount, nullptr);
+
+            // Construct once, shared by the lookup and the export
+            std::vector<ID> dwords(dwordCount);
+            message.Construct(emitter, &dwordCount, dwords.data());
+
+            // The primary dword is the message key, see GetKey
+            ID key = dwords[0];
+
+            // Slot of the key, upper bits of the multiplicative hash
+            ID slot = emitter.BitShiftRight(
+                emitter.Mul(key, emitter.UInt32(kExportFilterHashMultiplier)),
+                emitter.UInt32(32u - kExportFilterTableBits)
+            );
+
+            // Epoch relative tag
+            ID tag = emitter.Add(key, epochID);
+
+            // Exchange the tag, if the previous tag matches it's a duplicate
+            ID previousTag = emitter.AtomicExchange(emitter.AddressOf(tableDataID, slot), tag);
+            ID isFirst = emitter.NotEqual(previousTag, tag);
+
+            // Allocate blocks
+            BasicBlock* exportBlock = basicBlocks.AllocBlock();
+            BasicBlock* dropBlock = basicBlocks.AllocBlock();
+            BasicBlock* mergeBlock = basicBlocks.AllocBlock();
+
+            // Export first occurrences, otherwise drop
+            emitter.BranchConditional(isFirst, exportBlock, dropBlock, ControlFlow::Selection(mergeBlock));
+
+            // Export the constructed message, and account for the first occurrence
+            Emitter<> exportEmitter(*emitter.GetProgram(), *exportBlock);
+            exportEmitter.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+            exportEmitter.Export(exportID, dwords.data(), dwordCount);
+            exportEmitter.AtomicAdd(exportEmitter.AddressOf(counterDataID, exportEmitter.UInt32(static_cast<uint32_t>(ExportFilterCounter::Hit))), exportEmitter.UInt32(1));
+            exportEmitter.Branch(mergeBlock);
+
+            // Account for the drop, only executed by duplicates
+            Emitter<> dropEmitter(*emitter.GetProgram(), *dropBlock);
+            dropEmitter.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+            dropEmitter.AtomicAdd(dropEmitter.AddressOf(counterDataID, dropEmitter.UInt32(static_cast<uint32_t>(ExportFilterCounter::Drop))), dropEmitter.UInt32(1));
+            dropEmitter.Branch(mergeBlock);
+
+            // Continue in the merge block
+            emitter.SetBasicBlock(mergeBlock);
+            emitter.SetInsertionPoint({});
+            emitter.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+        }
+
+    private:
+        /// Current emitter
+        E& emitter;
+
+        /// Function blocks
+        BasicBlockList& basicBlocks;
+
+        /// Filter data
+        ID tableDataID;
+        ID counterDataID;
+        ID epochID;
+    };
+}
@@ -28,6 +28,7 @@
 
 // Backend
 #include "OpaqueInstructionRef.h"
+#include "RelocationOffset.h"
 
 // Common
 #include <Common/Assert.h>
@@ -35,11 +36,24 @@
 // Std
 #include <list>
 #include <algorithm>
+#include <unordered_map>
 
 namespace IL {
+    /// Materialize a basic block sharing its instructions with a source program, see BasicBlock::CopyTo
+    /// \param basicBlock the block to materialize
+    void MaterializeSharedBlock(BasicBlock* basicBlock);
+
     struct IdentifierMap {
         using BlockUserList = std::vector<OpaqueInstructionRef>;
 
+        /// Create a copy of this identifier map
+        ///   ! References are still resolved against the source blocks, until rebound by the copied blocks
+        /// \param out destination map
+        void CopyTo(IdentifierMap& out) const {
+            out.map = map;
+            out.blocks = blocks;
+        }
+
         /// Allocate a new ID
         /// \return
         ID AllocID() {
@@ -65,6 +79,17 @@ namespace IL {
             map.resize(bound);
         }
 
+        /// Set the number of bound block ids
+        ///   ? Users of blocks within the bound never grow the block list, which allows disjoint blocks to be used concurrently
+        /// \param bound the capacity
+        void SetBlockBound(uint32_t bound) {
+            if (blocks.size() >= bound) {
+                return;
+            }
+
+            blocks.resize(bound);
+        }
+
         /// Get the maximum id
         ID GetMaxID() const {
             return static_cast<ID>(map.size());
@@ -89,7 +114,7 @@ namespace IL {
         /// \param id the resulting id
         /// \return may be invalid if not mapped
         const OpaqueInstructionRef& Get(const ID& id) const {
-            return map.at(id);
+            return Resolve(map.at(id));
         }
 
         /// Add a new user to a block
@@ -107,14 +132,74 @@ namespace IL {
             block.users.erase(std::find(block.users.begin(), block.users.end(), user));
         }
 
+        /// Replace a user of a block
+        /// \param blockId referenced block
+        /// \param relocationOffset the relocation offset of the existing user
+        /// \param user the new user
+        void ReplaceBlockUser(const ID& blockId, const RelocationOffset* relocationOffset, const OpaqueInstructionRef& user) {
+            // May be replaced during user resolution, never grow the block list
+            if (blockId >= blocks.size()) {
+                return;
+            }
+
+            for (OpaqueInstructionRef& existing : blocks[blockId].users) {
+                if (existing.relocationOffset == relocationOffset) {
+                    existing = user;
+                    return;
+                }
+            }
+        }
+
+        /// Add a block sharing its instructions with a source block
+        ///  ? Any reference resolved to the source block materializes the shared block
+        /// \param source the source block, part of another program
+        /// \param basicBlock the block sharing its instructions
+        void AddSharedBlock(const BasicBlock* source, BasicBlock* basicBlock) {
+            sharedBlocks[source] = basicBlock;
+        }
+
+        /// Remove a shared block
+        /// \param source the source block
+        void RemoveSharedBlock(const BasicBlock* source) {
+            sharedBlocks.erase(source);
+        }
+
         /// Get the users for a specific block
         /// \param id the id of the block
         /// \return user list, not mutable
         const BlockUserList& GetBlockUsers(const ID& id) {
-            return GetBlock(id).users;
+            BlockUserList& users = GetBlock(id).users;
+
+            // Users may have migrated since
+            for (OpaqueInstructionRef& user : users) {
+                Resolve(user);
+            }
+
+            return users;
         }
 
     private:
+        /// Resolve the current owning block of a reference
+        ///  ? Instructions migrate with their segments on splits, without updating the map
+        /// \param ref reference to resolve
+        /// \return resolved reference
+        OpaqueInstructionRef& Resolve(OpaqueInstructionRef& ref) const {
+            if (!ref.relocationOffset || !ref.relocationOffset->segment) {
+                return ref;
+            }
+
+            ref.basicBlock = ref.relocationOffset->segment->basicBlock;
+
+            // Owned by a source block? Materializing the shared block rebinds the reference in place
+            if (!sharedBlocks.empty()) {
+                if (auto it = sharedBlocks.find(ref.basicBlock); it != sharedBlocks.end()) {
+                    MaterializeSharedBlock(it->second);
+                }
+            }
+
+            return ref;
+        }
+
         struct Block {
             BlockUserList users;
         };
@@ -132,7 +217,10 @@ namespace IL {
         /// All blocks
         std::vector<Block> blocks;
 
-        /// All instructions
-        std::vector<OpaqueInstructionRef> map;
+        /// All instructions, owning blocks are resolved on access
+        mutable std::vector<OpaqueInstructionRef> map;
+
+        /// All blocks still sharing their instructions, source to shared block
+        std::unordered_map<const BasicBlock*, BasicBlock*> sharedBlocks;
     };
 }
@@ -34,6 +34,7 @@
 #include "FunctionList.h"
 #include "ShaderDataMap.h"
 #include "CapabilityTable.h"
+#include "ResourceTokenCache.h"
 
 // Std
 #include <list>
@@ -61,10 +62,11 @@ namespace IL {
         Program &operator=(const Program &other) = delete;
 
         /// Copy this program
+        ///   ! Parent lifetime tied to the copy, basic blocks share their instructions until first modified
         /// \return
         Program *Copy() const {
             auto program = new(allocators) Program(allocators, shaderGUID);
-            program->identifierMap.SetBound(identifierMap.GetMaxID());
+            identifierMap.CopyTo(program->identifierMap);
             typeMap.CopyTo(program->typeMap);
             constants.CopyTo(program->constants);
 
@@ -72,14 +74,12 @@ namespace IL {
             program->capabilityTable = capabilityTable;
             program->entryPoint = entryPoint;
 
+            // Resource token cache is instrumentation state, not copied
+
             // Copy all functions and their basic blocks
+            //   Users are not reindexed, the copied identifier map is rebound as blocks are materialized
             functions.CopyTo(program->functions);
 
-            // Reindex all users
-            for (IL::Function* fn : program->functions) {
-                fn->IndexUsers();
-            }
-
             // OK
             return program;
         }
@@ -170,6 +170,11 @@ namespace IL {
             return capabilityTable;
         }
 
+        /// Get the resource token cache
+        ResourceTokenCache& GetResourceTokenCache() {
+            return resourceTokenCache;
+        }
+
     private:
         Allocators allocators;
 
@@ -194,6 +199,9 @@ namespace IL {
         /// The capability table
         CapabilityTable capabilityTable;
 
+        /// Shared resource token values
+        ResourceTokenCache resourceTokenCache;
+
         /// Function entry point
         IL::ID entryPoint{IL::InvalidID};
 
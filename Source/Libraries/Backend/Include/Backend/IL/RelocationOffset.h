@@ -29,8 +29,20 @@
 #include <cstdint>
 
 namespace IL {
+    struct BasicBlock;
+
+    /// Relocation segment, a contiguous part of a basic block instruction stream
+    ///  ? Segments migrate between blocks on splits, the owner is therefore tracked per segment
+    struct RelocationSegment {
+        /// Current owning basic block
+        BasicBlock* basicBlock{nullptr};
+    };
+
     struct RelocationOffset {
-        /// Offset from the start of the instruction stream
+        /// Offset from the start of the segment instruction stream
         uint32_t offset;
+
+        /// Segment holding the instruction
+        RelocationSegment* segment;
     };
 }
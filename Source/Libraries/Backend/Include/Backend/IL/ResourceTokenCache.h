@@ -0,0 +1,91 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include "ID.h"
+
+// Common
+#include <Common/Assert.h>
+
+// Std
+#include <unordered_map>
+
+namespace IL {
+    struct ResourceTokenCacheEntry {
+        /// Fetched token
+        ID token{InvalidID};
+
+        /// Decoded token values, emitted on demand
+        ID puid{InvalidID};
+        ID type{InvalidID};
+        ID srb{InvalidID};
+
+        /// Last emitted instruction of this entry, successive decodes are inserted after it
+        ID tail{InvalidID};
+    };
+
+    /// Program wide cache of resource token values
+    ///  ? Tokens are emitted once after the resource definition, which dominates all of its users,
+    ///    allowing all features injected into the same program to share the fetch and decoding
+    class ResourceTokenCache {
+    public:
+        /// Find a cached resource
+        /// \param resource the resource identifier
+        /// \return nullptr if not found, stable for the lifetime of the cache
+        ResourceTokenCacheEntry* Find(ID resource) {
+            auto it = entries.find(resource);
+            if (it == entries.end()) {
+                return nullptr;
+            }
+
+            return &it->second;
+        }
+
+        /// Add a new resource, must be unique
+        /// \param resource the resource identifier
+        /// \return the new entry, stable for the lifetime of the cache
+        ResourceTokenCacheEntry& Add(ID resource) {
+            ASSERT(!entries.contains(resource), "Resource already cached");
+            return entries[resource];
+        }
+
+        /// Clear all cached resources
+        void Clear() {
+            entries.clear();
+        }
+
+        /// Get the number of cached resources
+        uint32_t GetCount() const {
+            return static_cast<uint32_t>(entries.size());
+        }
+
+    private:
+        /// All cached resources
+        std::unordered_map<ID, ResourceTokenCacheEntry> entries;
+    };
+}
@@ -28,13 +28,40 @@
 
 // Backend
 #include "ID.h"
+#include "Emitter.h"
 #include "ResourceTokenPacking.h"
+#include "ResourceTokenCache.h"
 
 namespace IL {
+    enum class ResourceTokenScope {
+        /// Token values are emitted after the resource definition and shared program wide
+        Shared,
+
+        /// Token values are emitted locally, existing shared values are still reused
+        ///  ? Intended for cold paths, such as failure blocks
+        Local
+    };
+
     template<typename E>
     struct ResourceTokenEmitter {
-        ResourceTokenEmitter(E& emitter, ::IL::ID resourceID) : emitter(emitter) {
-            token = emitter.ResourceToken(resourceID);
+        ResourceTokenEmitter(E& emitter, ::IL::ID resourceID, ResourceTokenScope scope = ResourceTokenScope::Shared) : emitter(emitter), scope(scope) {
+            Program& program = *emitter.GetProgram();
+
+            // Already fetched by another user?
+            entry = program.GetResourceTokenCache().Find(resourceID);
+
+            // If not, try to fetch it at the definition
+            if (!entry && scope == ResourceTokenScope::Shared) {
+                entry = AddShared(program, resourceID);
+            }
+
+            // Definition not known, fetch in place
+            if (!entry) {
+                token = emitter.ResourceToken(resourceID);
+                return;
+            }
+
+            token = entry->token;
         }
 
         /// Get the resource physical UID
@@ -43,7 +70,7 @@ namespace IL {
                 return puid;
             }
 
-            return puid = emitter.BitAnd(emitter.BitShiftRight(token, emitter.UInt32(kResourceTokenPUIDShift)), emitter.UInt32(kResourceTokenPUIDMask));
+            return puid = Decode(entry ? &entry->puid : nullptr, kResourceTokenPUIDShift, kResourceTokenPUIDMask);
         }
 
         /// Get the resource type
@@ -52,7 +79,7 @@ namespace IL {
                 return type;
             }
 
-            return type = emitter.BitAnd(emitter.BitShiftRight(token, emitter.UInt32(kResourceTokenTypeShift)), emitter.UInt32(kResourceTokenTypeMask));
+            return type = Decode(entry ? &entry->type : nullptr, kResourceTokenTypeShift, kResourceTokenTypeMask);
         }
 
         /// Get the resource sub-resource base
@@ -61,7 +88,7 @@ namespace IL {
                 return srb;
             }
 
-            return srb = emitter.BitAnd(emitter.BitShiftRight(token, emitter.UInt32(kResourceTokenSRBShift)), emitter.UInt32(kResourceTokenSRBMask));
+            return srb = Decode(entry ? &entry->srb : nullptr, kResourceTokenSRBShift, kResourceTokenSRBMask);
         }
 
         /// Get the token
@@ -69,6 +96,76 @@ namespace IL {
             return token;
         }
 
+    private:
+        /// Add a shared entry, fetching the token after the resource definition
+        /// \param program the program to add to
+        /// \param resourceID the resource to fetch
+        /// \return nullptr if the resource is not defined by an instruction
+        static ResourceTokenCacheEntry* AddShared(Program& program, ::IL::ID resourceID) {
+            const OpaqueInstructionRef& definition = program.GetIdentifierMap().Get(resourceID);
+            if (!definition.IsValid()) {
+                return nullptr;
+            }
+
+            // Fetch the token
+            ::IL::ID tokenID = GetSharedEmitter(program, definition).ResourceToken(resourceID);
+
+            // Create entry
+            ResourceTokenCacheEntry& cached = program.GetResourceTokenCache().Add(resourceID);
+            cached.token = tokenID;
+            cached.tail = tokenID;
+            return &cached;
+        }
+
+        /// Get an emitter inserting after a shared instruction
+        /// \param program the program to emit into
+        /// \param ref the instruction to insert after
+        /// \return the emitter
+        static Emitter<> GetSharedEmitter(Program& program, const OpaqueInstructionRef& ref) {
+            BasicBlock* basicBlock = ref.basicBlock;
+
+            // Phi instructions must remain grouped
+            auto it = std::next(basicBlock->GetIterator(ref));
+            while (it != basicBlock->end() && it->opCode == OpCode::Phi) {
+                ++it;
+            }
+
+            // Insert prior to the next instruction
+            if (it != basicBlock->end()) {
+                return Emitter<>(program, *basicBlock, it);
+            }
+
+            // Append if last, the block may be pending its terminator
+            return Emitter<>(program, *basicBlock);
+        }
+
+        /// Decode a token value
+        /// \param cached the shared value, nullptr if not shared
+        /// \param shift value bit shift
+        /// \param mask value bit mask
+        /// \return decoded value
+        ::IL::ID Decode(::IL::ID* cached, uint32_t shift, uint32_t mask) {
+            // Not shared, or not worth sharing on this path
+            if (!cached || (*cached == IL::InvalidID && scope == ResourceTokenScope::Local)) {
+                return emitter.BitAnd(emitter.BitShiftRight(token, emitter.UInt32(shift)), emitter.UInt32(mask));
+            }
+
+            // Already decoded?
+            if (*cached != IL::InvalidID) {
+                return *cached;
+            }
+
+            Program& program = *emitter.GetProgram();
+
+            // Successive values are inserted after the last shared instruction
+            Emitter<> shared = GetSharedEmitter(program, program.GetIdentifierMap().Get(entry->tail));
+
+            // Decode in the shared block
+            *cached = shared.BitAnd(shared.BitShiftRight(token, shared.UInt32(shift)), shared.UInt32(mask));
+            entry->tail = *cached;
+            return *cached;
+        }
+
     private:
         /// Underlying token
         ::IL::ID token;
@@ -78,7 +175,13 @@ namespace IL {
         ::IL::ID type{IL::InvalidID};
         ::IL::ID srb{IL::InvalidID};
 
+        /// Shared entry, may be nullptr
+        ResourceTokenCacheEntry* entry{nullptr};
+
         /// Current emitter
         E& emitter;
+
+        /// Emission scope
+        ResourceTokenScope scope;
     };
 }
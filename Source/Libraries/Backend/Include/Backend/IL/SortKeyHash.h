@@ -0,0 +1,88 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <tuple>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace Backend::IL {
+    /// Hasher for type and constant sort keys
+    struct SortKeyHash {
+        template<typename T>
+        uint64_t operator()(const T& key) const {
+            uint64_t hash = 0;
+            Combine(hash, key);
+            return hash;
+        }
+
+    private:
+        /// Combine a single word
+        static void CombineWord(uint64_t& hash, uint64_t value) {
+            hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 12) + (hash >> 4);
+        }
+
+        /// Combine a key element
+        template<typename T>
+        static void Combine(uint64_t& hash, const T& value) {
+            if constexpr (std::is_floating_point_v<T>) {
+                // Signed zeros compare equal, hash them equally
+                double normalized = value == 0 ? 0.0 : static_cast<double>(value);
+
+                uint64_t bits;
+                std::memcpy(&bits, &normalized, sizeof(bits));
+                CombineWord(hash, bits);
+            } else if constexpr (std::is_pointer_v<T>) {
+                CombineWord(hash, reinterpret_cast<uintptr_t>(value));
+            } else {
+                CombineWord(hash, static_cast<uint64_t>(value));
+            }
+        }
+
+        /// Combine all elements of a list
+        template<typename T>
+        static void Combine(uint64_t& hash, const std::vector<T>& values) {
+            CombineWord(hash, values.size());
+
+            for (const T& value : values) {
+                Combine(hash, value);
+            }
+        }
+
+        /// Combine all elements of a tuple
+        template<typename... T>
+        static void Combine(uint64_t& hash, const std::tuple<T...>& values) {
+            std::apply([&hash](const T&... elements) {
+                (Combine(hash, elements), ...);
+            }, values);
+        }
+    };
+}
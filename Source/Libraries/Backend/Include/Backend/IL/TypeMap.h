@@ -30,13 +30,18 @@
 #include "Type.h"
 #include "ID.h"
 #include "CapabilityTable.h"
+#include "SortKeyHash.h"
 
 // Common
 #include <Common/Containers/LinearBlockAllocator.h>
+#include <Common/Containers/CopyOnWrite.h>
 
 // Backend
 #include "IdentifierMap.h"
 
+// UnorderedDense
+#include <ankerl/unordered_dense.h>
+
 // Std
 #include <map>
 #include <unordered_map>
@@ -44,7 +49,8 @@
 namespace Backend::IL {
     using namespace ::IL;
     
-    /// Type map, provides unique type identifiers 
+    /// Type map, provides unique type identifiers
+    ///  ? Types are hash-consed and immutable, the interned set and id lookup are shared between copies until changed
     struct TypeMap {
         using Container = std::vector<Type*>;
 
@@ -57,18 +63,17 @@ namespace Backend::IL {
         ///   ! Parent lifetime tied to the copy
         /// \return the new type map
         void CopyTo(TypeMap& out) const {
-            // Copy the maps
+            // Share the maps
+            out.interned = interned;
             out.idMap = idMap;
-            out.maps = maps;
-            out.types = types;
         }
 
         /// Find a type from his map
         /// \param type the type declaration
         /// \return the type pointer, nullptr if not found
         template<typename T>
-        const T* FindType(const T &type) {
-            auto&& sortMap = GetSortMap<T>();
+        const T* FindType(const T &type) const {
+            auto&& sortMap = interned->maps.*GetSortMap<T>();
 
             if (auto it = sortMap.find(type.SortKey()); it != sortMap.end()) {
                 return it->second;
@@ -82,42 +87,31 @@ namespace Backend::IL {
         /// \return the type pointer
         template<typename T>
         const T* FindTypeOrAdd(const T &type) {
-            auto&& sortMap = GetSortMap<T>();
-
-            auto &typePtr = sortMap[type.SortKey()];
-            if (!typePtr) {
-                typePtr = AllocateType<T>(identifierMap.AllocID(), InvalidOffset, type);
+            // Existing types never detach the shared maps
+            if (const T* existing = FindType(type)) {
+                return existing;
             }
 
-            return typePtr;
+            T* allocation = AllocateType<T>(identifierMap.AllocID(), InvalidOffset, type);
+            (interned.GetMutable().maps.*GetSortMap<T>())[type.SortKey()] = allocation;
+            return allocation;
         }
 
         /// Add a type to this map, must be unique
         /// \param type the type to be added
         template<typename T>
         const T* AddType(ID id, const T &type) {
-            auto&& sortMap = GetSortMap<T>();
-
-            T* allocation = AllocateType<T>(id, InvalidOffset, type);
-
-            if (auto &typePtr = sortMap[type.SortKey()]; !typePtr) {
-                typePtr = allocation;
-            }
-
-            return allocation;
+            return AddType(id, InvalidOffset, type);
         }
 
         /// Add a type to this map, must be unique
         /// \param type the type to be added
         template<typename T>
         const T* AddType(ID id, uint32_t sourceOffset, const T &type) {
-            auto&& sortMap = GetSortMap<T>();
-
             T* allocation = AllocateType<T>(id, sourceOffset, type);
 
-            if (auto &typePtr = sortMap[type.SortKey()]; !typePtr) {
-                typePtr = allocation;
-            }
+            // First declaration is the unique one
+            (interned.GetMutable().maps.*GetSortMap<T>()).try_emplace(type.SortKey(), allocation);
 
             return allocation;
         }
@@ -129,7 +123,7 @@ namespace Backend::IL {
             auto *type = blockAllocator.Allocate<T>(decl);
             type->kind = T::kKind;
             type->id = id;
-            types.push_back(type);
+            interned.GetMutable().types.push_back(type);
             return type;
         }
 
@@ -140,43 +134,56 @@ namespace Backend::IL {
             ASSERT(id != InvalidID, "SetType must have a valid id");
             ASSERT(type, "SetType must have a valid type");
 
-            if (idMap.size() <= id) {
-                idMap.resize(id + 1);
+            // Already associated?
+            if (id < idMap->size() && idMap.Get()[id] == type) {
+                return;
+            }
+
+            std::vector<const Type*>& lookup = idMap.GetMutable();
+            if (lookup.size() <= id) {
+                lookup.resize(id + 1);
             }
             
-            idMap[id] = type;
+            lookup[id] = type;
+        }
+
+        /// Set the number of bound ids
+        ///   ? Associations within the bound never grow the lookup, which allows disjoint ids to be set concurrently
+        /// \param bound the capacity
+        void SetBound(uint32_t bound) {
+            if (idMap->size() >= bound) {
+                return;
+            }
+
+            idMap.GetMutable().resize(bound);
         }
 
         /// Get the type for a given id
         /// \param id the id to be looked up
         /// \return the resulting type, may be nullptr
         const Type *GetType(ID id) const {
-            if (idMap.size() <= id) {
+            if (idMap->size() <= id) {
                 return nullptr;
             }
 
-            return idMap[id];
+            return idMap.Get()[id];
         }
 
         /// Remove a type mapping
         /// \param id the id from which to remove the type
         void RemoveType(ID id) {
-            if (idMap.size() <= id) {
+            if (idMap->size() <= id || !idMap.Get()[id]) {
                 return;
             }
 
-            idMap[id] = nullptr;
+            idMap.GetMutable()[id] = nullptr;
         }
 
         /// Iterator accessors
-        Container::iterator begin() { return types.begin(); }
-        Container::reverse_iterator rbegin() { return types.rbegin(); }
-        Container::iterator end() { return types.end(); }
-        Container::reverse_iterator rend() { return types.rend(); }
-        Container::const_iterator begin() const { return types.begin(); }
-        Container::const_reverse_iterator rbegin() const { return types.rbegin(); }
-        Container::const_iterator end() const { return types.end(); }
-        Container::const_reverse_iterator rend() const { return types.rend(); }
+        Container::const_iterator begin() const { return interned->types.begin(); }
+        Container::const_reverse_iterator rbegin() const { return interned->types.rbegin(); }
+        Container::const_iterator end() const { return interned->types.end(); }
+        Container::const_reverse_iterator rend() const { return interned->types.rend(); }
 
     private:
         /// Allocate a new type
@@ -189,42 +196,12 @@ namespace Backend::IL {
             type->kind = T::kKind;
             type->id = id;
             type->sourceOffset = sourceOffset;
-            types.push_back(type);
+            interned.GetMutable().types.push_back(type);
             return type;
         }
 
         template<typename T>
-        using SortMap = std::map<SortKey<T>, T*>;
-
-        /// Map fetchers
-        template<typename T>
-        SortMap<T>& GetSortMap() {}
-
-        /// Map fetcher impl
-        template<> SortMap<UnexposedType>& GetSortMap<UnexposedType>() { return maps.unexposedMap; }
-        template<> SortMap<BoolType>& GetSortMap<BoolType>() { return maps.boolMap; }
-        template<> SortMap<VoidType>& GetSortMap<VoidType>() { return maps.voidMap; }
-        template<> SortMap<IntType>& GetSortMap<IntType>() { return maps.intMap; }
-        template<> SortMap<FPType>& GetSortMap<FPType>() { return maps.fpMap; }
-        template<> SortMap<VectorType>& GetSortMap<VectorType>() { return maps.vectorMap; }
-        template<> SortMap<MatrixType>& GetSortMap<MatrixType>() { return maps.matrixMap; }
-        template<> SortMap<PointerType>& GetSortMap<PointerType>() { return maps.pointerMap; }
-        template<> SortMap<ArrayType>& GetSortMap<ArrayType>() { return maps.arrayMap; }
-        template<> SortMap<TextureType>& GetSortMap<TextureType>() { return maps.textureMap; }
-        template<> SortMap<BufferType>& GetSortMap<BufferType>() { return maps.bufferMap; }
-        template<> SortMap<CBufferType>& GetSortMap<CBufferType>() { return maps.cbufferMap; }
-        template<> SortMap<SamplerType>& GetSortMap<SamplerType>() { return maps.samplerMap; }
-        template<> SortMap<FunctionType>& GetSortMap<FunctionType>() { return maps.functionMap; }
-        template<> SortMap<StructType>& GetSortMap<StructType>() { return maps.structMap; }
-
-    private:
-        Allocators allocators;
-
-        /// Block allocator for types, types never need to be freed
-        LinearBlockAllocator<1024> blockAllocator;
-
-        /// Unique constraints for type mapping
-        const CapabilityTable& capabilityTable;
+        using SortMap = ankerl::unordered_dense::map<SortKey<T>, T*, SortKeyHash>;
 
         /// Type cache
         struct TypeMaps {
@@ -245,15 +222,52 @@ namespace Backend::IL {
             SortMap<StructType> structMap;
         };
 
-        /// Declaration order
-        Container types;
+        /// Map fetchers
+        template<typename T>
+        static SortMap<T> TypeMaps::* GetSortMap() {}
+
+        /// Map fetcher impl
+        template<> SortMap<UnexposedType> TypeMaps::* GetSortMap<UnexposedType>() { return &TypeMaps::unexposedMap; }
+        template<> SortMap<BoolType> TypeMaps::* GetSortMap<BoolType>() { return &TypeMaps::boolMap; }
+        template<> SortMap<VoidType> TypeMaps::* GetSortMap<VoidType>() { return &TypeMaps::voidMap; }
+        template<> SortMap<IntType> TypeMaps::* GetSortMap<IntType>() { return &TypeMaps::intMap; }
+        template<> SortMap<FPType> TypeMaps::* GetSortMap<FPType>() { return &TypeMaps::fpMap; }
+        template<> SortMap<VectorType> TypeMaps::* GetSortMap<VectorType>() { return &TypeMaps::vectorMap; }
+        template<> SortMap<MatrixType> TypeMaps::* GetSortMap<MatrixType>() { return &TypeMaps::matrixMap; }
+        template<> SortMap<PointerType> TypeMaps::* GetSortMap<PointerType>() { return &TypeMaps::pointerMap; }
+        template<> SortMap<ArrayType> TypeMaps::* GetSortMap<ArrayType>() { return &TypeMaps::arrayMap; }
+        template<> SortMap<TextureType> TypeMaps::* GetSortMap<TextureType>() { return &TypeMaps::textureMap; }
+        template<> SortMap<BufferType> TypeMaps::* GetSortMap<BufferType>() { return &TypeMaps::bufferMap; }
+        template<> SortMap<CBufferType> TypeMaps::* GetSortMap<CBufferType>() { return &TypeMaps::cbufferMap; }
+        template<> SortMap<SamplerType> TypeMaps::* GetSortMap<SamplerType>() { return &TypeMaps::samplerMap; }
+        template<> SortMap<FunctionType> TypeMaps::* GetSortMap<FunctionType>() { return &TypeMaps::functionMap; }
+        template<> SortMap<StructType> TypeMaps::* GetSortMap<StructType>() { return &TypeMaps::structMap; }
+
+        /// Interned types
+        struct InternedTypes {
+            /// Unique types
+            TypeMaps maps;
+
+            /// Declaration order
+            Container types;
+        };
+
+    private:
+        Allocators allocators;
+
+        /// Block allocator for types, types never need to be freed
+        LinearBlockAllocator<1024> blockAllocator;
+
+        /// Unique constraints for type mapping
+        const CapabilityTable& capabilityTable;
 
         /// Identifiers
         IdentifierMap& identifierMap;
 
-        TypeMaps maps;
+        /// All interned types, shared between copies
+        CopyOnWrite<InternedTypes> interned;
 
-        /// Id lookup
-        std::vector<const Type*> idMap;
+        /// Id lookup, shared between copies
+        CopyOnWrite<std::vector<const Type*>> idMap;
     };
 }
@@ -32,6 +32,10 @@
 // Common
 #include <Common/Containers/TrivialStackVector.h>
 
+// Std
+#include <vector>
+#include <algorithm>
+
 namespace IL {
     /// Implementation details
     namespace Detail {
@@ -77,76 +81,79 @@ namespace IL {
 
         template<typename F>
         void VisitUserInstructions(IL::Program &program, IL::Function *function, F &&functor) {
-            for (;;) {
-                bool mutated{false};
-
-                // Current revision
-                uint32_t revision = function->GetBasicBlocks().GetBasicBlockRevision();
+            IL::BasicBlockList& basicBlocks = function->GetBasicBlocks();
 
-                // Visit all blocks
-                for (IL::BasicBlock *basicBlock: function->GetBasicBlocks()) {
-                    // If instrumented or visited, skip
-                    if (basicBlock->GetFlags() & (BasicBlockFlag::NoInstrumentation | BasicBlockFlag::Visited)) {
-                        continue;
-                    }
+            // Pending blocks, starts with all existing blocks in list order
+            std::vector<IL::BasicBlock*> worklist(basicBlocks.begin(), basicBlocks.end());
 
-                    // Mark as visited
-                    basicBlock->AddFlag(BasicBlockFlag::Visited);
+            // Number of list blocks enqueued so far, allocated blocks are always appended
+            uint32_t enqueuedCount = basicBlocks.GetBlockCount();
 
-                    // Visit all instructions
-                    bool migratedBlock = VisitUserInstructions(program, function, basicBlock, functor);
+            // Current revision
+            uint32_t revision = basicBlocks.GetBasicBlockRevision();
 
-                    // If the fn revision has changed (block removed, moved, added), we need to re-visit
-                    if (migratedBlock || revision != function->GetBasicBlocks().GetBasicBlockRevision()) {
-                        // Mark as mutated
-                        mutated = true;
+            // Visit all blocks, including those created during visitation
+            for (size_t i = 0; i < worklist.size(); i++) {
+                IL::BasicBlock *basicBlock = worklist[i];
 
-                        // Stop!
-                        break;
-                    }
+                // If instrumented or visited, skip
+                //  ? Resume blocks are visited by the migrating visitation, and marked as such
+                if (basicBlock->GetFlags() & (BasicBlockFlag::NoInstrumentation | BasicBlockFlag::Visited)) {
+                    continue;
                 }
 
-                // Stop if mutated
-                if (!mutated) {
-                    break;
+                // Mark as visited
+                basicBlock->AddFlag(BasicBlockFlag::Visited);
+
+                // Visit all instructions, follows any migrations
+                VisitUserInstructions(program, function, basicBlock, functor);
+
+                // If the fn revision has changed, enqueue the allocated blocks without rescanning the existing ones
+                if (revision != basicBlocks.GetBasicBlockRevision()) {
+                    revision = basicBlocks.GetBasicBlockRevision();
+
+                    // Enqueue all appended blocks
+                    worklist.insert(worklist.end(), basicBlocks.begin() + std::min(enqueuedCount, basicBlocks.GetBlockCount()), basicBlocks.end());
+                    enqueuedCount = basicBlocks.GetBlockCount();
                 }
             }
         }
 
         template<typename F>
         void VisitUserInstructions(IL::Program &program, F &&functor) {
-            for (;;) {
-                bool mutated{false};
-
-                // Current revision
-                uint32_t revision = program.GetFunctionList().GetRevision();
+            IL::FunctionList& functions = program.GetFunctionList();
 
-                // Visit all functions
-                for (IL::Function *function: program.GetFunctionList()) {
-                    // If instrumented or visited, skip
-                    if (function->GetFlags() & (FunctionFlag::NoInstrumentation | FunctionFlag::Visited)) {
-                        continue;
-                    }
+            // Pending functions, starts with all existing functions in list order
+            std::vector<IL::Function*> worklist(functions.begin(), functions.end());
 
-                    // Visit all instructions
-                    VisitUserInstructions(program, function, functor);
+            // Number of list functions enqueued so far, allocated functions are always appended
+            uint32_t enqueuedCount = functions.GetCount();
 
-                    // Mark as visited
-                    function->AddFlag(FunctionFlag::Visited);
+            // Current revision
+            uint32_t revision = functions.GetRevision();
 
-                    // If the pg revision has changed (block removed, moved, added), we need to re-visit
-                    if (revision != program.GetFunctionList().GetRevision()) {
-                        // Mark as mutated
-                        mutated = true;
+            // Visit all functions, including those created during visitation
+            for (size_t i = 0; i < worklist.size(); i++) {
+                IL::Function *function = worklist[i];
 
-                        // Stop!
-                        break;
-                    }
+                // If instrumented or visited, skip
+                if (function->GetFlags() & (FunctionFlag::NoInstrumentation | FunctionFlag::Visited)) {
+                    continue;
                 }
 
-                // Stop if mutated
-                if (!mutated) {
-                    break;
+                // Visit all instructions
+                VisitUserInstructions(program, function, functor);
+
+                // Mark as visited
+                function->AddFlag(FunctionFlag::Visited);
+
+                // If the pg revision has changed, enqueue the allocated functions without rescanning the existing ones
+                if (revision != functions.GetRevision()) {
+                    revision = functions.GetRevision();
+
+                    // Enqueue all appended functions
+                    worklist.insert(worklist.end(), functions.begin() + std::min(enqueuedCount, functions.GetCount()), functions.end());
+                    enqueuedCount = functions.GetCount();
                 }
             }
         }
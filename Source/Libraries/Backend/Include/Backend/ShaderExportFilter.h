@@ -0,0 +1,135 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Backend
+#include "ShaderExport.h"
+#include "CommandContextHandle.h"
+#include "ShaderData/ShaderData.h"
+#include "ShaderData/IShaderDataHost.h"
+#include "IL/Program.h"
+#include "IL/Emitter.h"
+#include "IL/ExportFilterEmitter.h"
+
+// Common
+#include <Common/ComRef.h>
+
+// Std
+#include <mutex>
+#include <unordered_map>
+
+// Forward declarations
+class CommandContext;
+class IMessageStorage;
+
+/// Device side duplicate suppression of shader exports
+///   ? Only the first occurrence of a message key per submission leaves the device, all duplicates are counted
+class ShaderExportFilter {
+public:
+    /// Install this filter
+    /// \param host shader data host to allocate the filter data from
+    /// \param id the export to be filtered
+    /// \return success state
+    bool Install(const ComRef<IShaderDataHost>& host, ShaderExportID id);
+
+    /// Invoked on command context opening, assigns the epoch slot
+    /// \param context the opened context
+    void OnOpen(CommandContext* context);
+
+    /// Invoked prior to a command context submission, assigns a new epoch
+    ///   ? Each submission is a new epoch, resubmitting a context does not inherit the previous filtering
+    /// \param contextHandle the submitted context
+    void OnPreSubmit(CommandContextHandle contextHandle);
+
+    /// Export a message through the filter
+    /// \param program the program being instrumented
+    /// \param emitter the appending emitter, moved to the block following the export
+    /// \param basicBlocks block list of the owning function
+    /// \param message the message to be exported
+    template<typename T>
+    void Export(IL::Program& program, IL::Emitter<>& emitter, IL::BasicBlockList& basicBlocks, const T& message) {
+        IL::ShaderDataMap& shaderDataMap = program.GetShaderDataMap();
+
+        // Read the epoch of the current submission
+        IL::ID epochID = emitter.Extract(emitter.LoadBuffer(emitter.Load(shaderDataMap.Get(epochBufferID)->id), shaderDataMap.Get(epochSlotID)->id), 0u);
+
+        // Filter against the program data
+        IL::ExportFilterEmitter filter(
+            emitter,
+            basicBlocks,
+            shaderDataMap.Get(tableBufferID)->id,
+            shaderDataMap.Get(counterBufferID)->id,
+            epochID
+        );
+
+        // Export first occurrences
+        filter.Export(exportID, message);
+    }
+
+    /// Collect the filter statistics since the last collection
+    /// \param storage the storage to commit to
+    void CollectMessages(IMessageStorage* storage);
+
+private:
+    /// Max number of live epoch slots
+    ///   ? Contexts beyond this share slots, sharing an epoch may only drop repeats of already exported keys
+    static constexpr uint32_t kMaxTrackedEpochSlots = 4096;
+
+    /// Data host
+    ComRef<IShaderDataHost> shaderDataHost{nullptr};
+
+    /// Filtered export
+    ShaderExportID exportID{InvalidShaderExportID};
+
+    /// Shader data
+    ShaderDataID tableBufferID{InvalidShaderDataID};
+    ShaderDataID counterBufferID{InvalidShaderDataID};
+    ShaderDataID epochBufferID{InvalidShaderDataID};
+    ShaderDataID epochSlotID{InvalidShaderDataID};
+
+    /// Host visible counters, mapped on first collection
+    const uint32_t* counters{nullptr};
+
+    /// Host visible epochs, mapped on first submission
+    uint32_t* epochs{nullptr};
+
+    /// Shared lock for the epoch state
+    std::mutex mutex;
+
+    /// Epoch slots of all known contexts
+    std::unordered_map<CommandContextHandle, uint32_t> contextSlots;
+
+    /// Cyclic slot counter
+    uint32_t slotAllocationCounter{0};
+
+    /// Monotonic epoch counter
+    uint32_t epochCounter{0};
+
+    /// Last reported counter values
+    uint32_t reportedHitCount{0};
+    uint32_t reportedDropCount{0};
+};
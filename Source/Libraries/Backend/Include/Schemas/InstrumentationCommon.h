@@ -33,5 +33,14 @@
 inline SetInstrumentationConfigMessage& operator|=(SetInstrumentationConfigMessage& lhs, const SetInstrumentationConfigMessage& rhs) {
     lhs.safeGuard |= rhs.safeGuard;
     lhs.detail |= rhs.detail;
+    lhs.filterDuplicates |= rhs.filterDuplicates;
+    return lhs;
+}
+
+/// Collapse operator
+inline SetLoopInstrumentationConfigMessage& operator|=(SetLoopInstrumentationConfigMessage& lhs, const SetLoopInstrumentationConfigMessage& rhs) {
+    if (rhs.iterationPollInterval) {
+        lhs.iterationPollInterval = rhs.iterationPollInterval;
+    }
     return lhs;
 }
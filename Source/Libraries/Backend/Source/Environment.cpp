@@ -85,12 +85,17 @@ bool Environment::Install(const EnvironmentInfo &info) {
     auto resolver = registry.AddNew<PluginResolver>();
 
     // Install the dispatcher
-    registry.AddNew<Dispatcher>();
+    auto dispatcher = registry.AddNew<Dispatcher>();
 
     // Install bridge
     if (info.memoryBridge) {
         // Intra process
-        registry.AddNew<MemoryBridge>();
+        auto memoryBridge = registry.AddNew<MemoryBridge>();
+
+        // Listeners may be dispatched in parallel
+        if (info.parallelBridgeListeners) {
+            memoryBridge->SetDispatcher(dispatcher);
+        }
     } else {
         // Install the host resolver
         //  ? Ensures that the host resolver is running on the system
@@ -101,6 +106,11 @@ bool Environment::Install(const EnvironmentInfo &info) {
 
         // Networked
         hostServerBridge = registry.AddNew<HostServerBridge>();
+
+        // Listeners may be dispatched in parallel
+        if (info.parallelBridgeListeners) {
+            hostServerBridge->SetDispatcher(dispatcher);
+        }
         
         // Endpoint info
         EndpointConfig endpointConfig;
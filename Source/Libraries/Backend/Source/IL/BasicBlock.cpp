@@ -30,21 +30,142 @@
 #include <Common/Alloca.h>
 #include <Common/Containers/TrivialStackVector.h>
 
+IL::BasicBlock::~BasicBlock() {
+    // Shared segments are owned by the source block
+    if (sharedSource) {
+        return;
+    }
+
+    for (BasicBlockSegment* segment : segments) {
+        destroy(segment, allocators);
+    }
+}
+
+IL::BasicBlock::BasicBlock(BasicBlock &&other) :
+    allocators(other.allocators),
+    id(other.id),
+    count(other.count),
+    sourceSpan(other.sourceSpan),
+    map(other.map),
+    segments(std::move(other.segments)),
+    relocationAllocator(std::move(other.relocationAllocator)),
+    sharedSource(other.sharedSource),
+    flags(other.flags),
+    dirty(other.dirty) {
+#ifndef NDEBUG
+    debugRevision = other.debugRevision;
+#endif
+
+    // Shared segments are still owned by the source block
+    if (sharedSource) {
+        map.AddSharedBlock(sharedSource, this);
+    } else {
+        for (BasicBlockSegment* segment : segments) {
+            segment->basicBlock = this;
+        }
+    }
+
+    other.segments.clear();
+    other.sharedSource = nullptr;
+    other.count = 0;
+}
+
 void IL::BasicBlock::CopyTo(BasicBlock *out) const {
     out->count = count;
     out->dirty = dirty;
-    out->data = data;
     out->sourceSpan = sourceSpan;
     out->flags = flags;
 
-    // Preallocate
-    out->relocationTable.resize(relocationTable.size());
+    // Copies of copies share with the original owner
+    out->sharedSource = sharedSource ? sharedSource : this;
+
+    // Share all segments, the copied identifier map still references the source instructions
+    out->segments.insert(out->segments.end(), segments.begin(), segments.end());
+    out->map.AddSharedBlock(out->sharedSource, out);
+}
+
+void IL::BasicBlock::Materialize() const {
+    if (!sharedSource) {
+        return;
+    }
+
+    // Logically const, the instruction stream is unchanged
+    auto* self = const_cast<BasicBlock*>(this);
+
+    // No longer shared
+    const BasicBlock* source = sharedSource;
+    self->sharedSource = nullptr;
+    map.RemoveSharedBlock(source);
+
+    // Copy all segments
+    for (size_t i = 0; i < segments.size(); i++) {
+        const BasicBlockSegment* segment = segments[i];
+
+        auto* copy = new (allocators) BasicBlockSegment(allocators.Tag("BasicBlock"_AllocTag));
+        copy->basicBlock = self;
+        copy->index = segment->index;
+        copy->data = segment->data;
+        self->segments[i] = copy;
+
+        // Preallocate
+        copy->relocations.resize(segment->relocations.size());
+
+        // Copy the relocation offsets, and rebind all references from the source instructions
+        for (size_t j = 0; j < segment->relocations.size(); j++) {
+            copy->relocations[j] = self->AllocateRelocationOffset(copy, segment->relocations[j]->offset);
+
+            OpaqueInstructionRef ref;
+            ref.basicBlock = self;
+            ref.relocationOffset = copy->relocations[j];
+            self->RebindInstructionReferences(segment->relocations[j], ref);
+        }
+    }
+}
+
+void IL::MaterializeSharedBlock(BasicBlock *basicBlock) {
+    basicBlock->Materialize();
+}
+
+void IL::BasicBlock::Flatten() {
+    // Shared segments are left as is, flattening is not worth a copy
+    if (segments.size() <= 1 || sharedSource) {
+        return;
+    }
+
+    BasicBlockSegment* target = segments.front();
+
+    // Reserve the full stream
+    size_t dataSize = 0;
+    size_t relocationCount = 0;
+    for (const BasicBlockSegment* segment : segments) {
+        dataSize += segment->data.size();
+        relocationCount += segment->relocations.size();
+    }
+
+    target->data.reserve(dataSize);
+    target->relocations.reserve(relocationCount);
 
-    // Copy the relocation offsets
-    for (size_t i = 0; i < relocationTable.size(); i++) {
-        out->relocationTable[i] = out->relocationAllocator.Allocate();
-        out->relocationTable[i]->offset = relocationTable[i]->offset;
+    // Append all succeeding segments to the first
+    for (size_t i = 1; i < segments.size(); i++) {
+        BasicBlockSegment* segment = segments[i];
+
+        // Rebase all offsets, the references themselves are unaffected
+        auto base = static_cast<uint32_t>(target->data.size());
+        for (RelocationOffset* relocationOffset : segment->relocations) {
+            relocationOffset->offset += base;
+            relocationOffset->segment = target;
+            target->relocations.push_back(relocationOffset);
+        }
+
+        target->data.insert(target->data.end(), segment->data.begin(), segment->data.end());
+        destroy(segment, allocators);
     }
+
+    segments.resize(1);
+
+#ifndef NDEBUG
+    debugRevision++;
+#endif
 }
 
 void IL::BasicBlock::IndexUsers() {
@@ -54,6 +175,52 @@ void IL::BasicBlock::IndexUsers() {
     }
 }
 
+void IL::BasicBlock::RebindInstructionReferences(const RelocationOffset *source, const IL::OpaqueInstructionRef &ref) {
+    const Instruction* instruction = GetRelocationInstruction(ref.relocationOffset);
+
+    // Rebind result
+    if (instruction->result != InvalidID) {
+        map.AddInstruction(ref, instruction->result);
+    }
+
+    // Rebind blocks
+    switch (instruction->opCode) {
+        default:
+            break;
+
+        case OpCode::Phi: {
+            auto* phi = instruction->As<PhiInstruction>();
+
+            for (uint32_t i = 0; i < phi->values.count; i++) {
+                map.ReplaceBlockUser(phi->values[i].branch, source, ref);
+            }
+            break;
+        }
+
+        case OpCode::Branch: {
+            auto* branch = instruction->As<BranchInstruction>();
+            map.ReplaceBlockUser(branch->branch, source, ref);
+            break;
+        }
+
+        case OpCode::BranchConditional: {
+            auto* branch = instruction->As<BranchConditionalInstruction>();
+            map.ReplaceBlockUser(branch->pass, source, ref);
+            map.ReplaceBlockUser(branch->fail, source, ref);
+
+            if (branch->controlFlow.merge != InvalidID) {
+                map.ReplaceBlockUser(branch->controlFlow.merge, source, ref);
+
+                if (branch->controlFlow._continue != InvalidID) {
+                    map.ReplaceBlockUser(branch->controlFlow._continue, source, ref);
+                }
+            }
+
+            break;
+        }
+    }
+}
+
 void IL::BasicBlock::AddInstructionReferences(const IL::Instruction *instruction, const IL::OpaqueInstructionRef &ref) {
     // Add reference to result
     if (instruction->result != InvalidID) {
@@ -103,8 +270,8 @@ void IL::BasicBlock::AddInstructionReferences(const IL::Instruction *instruction
 IL::BasicBlock::Iterator IL::BasicBlock::Split(IL::BasicBlock *destBlock, const IL::BasicBlock::Iterator &splitIterator, BasicBlockSplitFlagSet splitFlags) {
     ASSERT(destBlock->IsEmpty(), "Cannot split into a filled basic block");
 
-    // Byte offset to the split point
-    uint32_t splitPointRelocationOffset = relocationTable[splitIterator.relocationIndex]->offset;
+    // Segments are migrated, must be owned
+    Materialize();
 
     // Redirect all branch users if requested
     if (splitFlags & BasicBlockSplitFlag::RedirectBranchUsers) {
@@ -178,25 +345,116 @@ IL::BasicBlock::Iterator IL::BasicBlock::Split(IL::BasicBlock *destBlock, const
         }
     }
 
-    // Append all instructions after the split point to the new basic block
-    Iterator moveIterator = splitIterator;
-    for (; moveIterator != end(); moveIterator++) {
-        destBlock->Append(moveIterator.Get());
-        count--;
-    }
+    // Split point is always at the start of a segment, divide mid-segment points
+    uint32_t segmentIndex = splitIterator.segmentIndex;
+    if (segmentIndex < segments.size()) {
+        BasicBlockSegment* segment = segments[segmentIndex];
 
-    // Erase moved instruction data
-    data.erase(data.begin() + splitPointRelocationOffset, data.end());
+        if (splitIterator.relocationIndex == segment->relocations.size()) {
+            segmentIndex++;
+        } else if (splitIterator.relocationIndex != 0) {
+            DivideSegment(segment, splitIterator.relocationIndex);
+            segmentIndex++;
+        }
+    }
 
-    // Free relocation indices
-    auto relocationIt = relocationTable.begin() + splitIterator.relocationIndex;
-    for (auto it = relocationIt; it != relocationTable.end(); it++) {
-        relocationAllocator.Free(*it);
+    // Migrate all segments after the split point to the new basic block
+    //   Relocation offsets are migrated along with the segments, so all references remain valid. The identifier
+    //   map resolves the new owner through the segment. Note that relocation storage is not migrated, and is
+    //   kept alive by this block.
+    for (size_t i = segmentIndex; i < segments.size(); i++) {
+        BasicBlockSegment* segment = segments[i];
+        segment->basicBlock = destBlock;
+        segment->index = static_cast<uint32_t>(destBlock->segments.size());
+        destBlock->segments.push_back(segment);
+
+        // Move ownership of all instructions
+        count -= static_cast<uint32_t>(segment->relocations.size());
+        destBlock->count += static_cast<uint32_t>(segment->relocations.size());
     }
 
-    // Erase relocation indices
-    relocationTable.erase(relocationIt, relocationTable.end());
+    // Erase moved segments
+    segments.erase(segments.begin() + segmentIndex, segments.end());
+
+    // Both blocks modified
+    MarkAsDirty();
+    destBlock->MarkAsDirty();
+
+#ifndef NDEBUG
+    debugRevision++;
+    destBlock->debugRevision++;
+#endif
 
     // Return first iterator
     return destBlock->begin();
 }
+
+IL::BasicBlockSegment *IL::BasicBlock::InsertSegment(uint32_t index) {
+    auto* segment = new (allocators) BasicBlockSegment(allocators.Tag("BasicBlock"_AllocTag));
+    segment->basicBlock = this;
+    segments.insert(segments.begin() + index, segment);
+
+    // Reindex all succeeding segments
+    for (size_t i = index; i < segments.size(); i++) {
+        segments[i]->index = static_cast<uint32_t>(i);
+    }
+
+    return segment;
+}
+
+void IL::BasicBlock::RemoveSegment(BasicBlockSegment *segment) {
+    ASSERT(segment->relocations.empty(), "Removing non-empty segment");
+
+    uint32_t index = segment->index;
+    segments.erase(segments.begin() + index);
+    destroy(segment, allocators);
+
+    // Reindex all succeeding segments
+    for (size_t i = index; i < segments.size(); i++) {
+        segments[i]->index = static_cast<uint32_t>(i);
+    }
+}
+
+IL::BasicBlockSegment *IL::BasicBlock::DivideSegment(BasicBlockSegment *segment, uint32_t relocationIndex) {
+    ASSERT(relocationIndex > 0 && relocationIndex < segment->relocations.size(), "Dividing segment would produce empty segment");
+
+    BasicBlockSegment* next = InsertSegment(segment->index + 1);
+
+    // Byte offset to the split point
+    uint32_t splitOffset = segment->relocations[relocationIndex]->offset;
+
+    // Move instruction data
+    next->data.insert(next->data.end(), segment->data.begin() + splitOffset, segment->data.end());
+    segment->data.erase(segment->data.begin() + splitOffset, segment->data.end());
+
+    // Move and rebase relocation offsets
+    for (size_t i = relocationIndex; i < segment->relocations.size(); i++) {
+        RelocationOffset* relocationOffset = segment->relocations[i];
+        relocationOffset->offset -= splitOffset;
+        relocationOffset->segment = next;
+        next->relocations.push_back(relocationOffset);
+    }
+
+    segment->relocations.erase(segment->relocations.begin() + relocationIndex, segment->relocations.end());
+    return next;
+}
+
+void IL::BasicBlock::RebalanceSegment(BasicBlockSegment *segment) {
+    // Divide from the back, each divided segment is within the preferred size
+    while (segment->data.size() > kSegmentSize * 2) {
+        auto splitOffset = static_cast<uint32_t>(segment->data.size() - kSegmentSize);
+
+        // First instruction at or past the split offset
+        auto relocationIt = std::lower_bound(segment->relocations.begin(), segment->relocations.end(), splitOffset, [](const RelocationOffset* relocationOffset, uint32_t offset) {
+            return relocationOffset->offset < offset;
+        });
+
+        // Always keep at least one instruction per segment
+        auto relocationIndex = static_cast<uint32_t>(std::min<size_t>(relocationIt - segment->relocations.begin(), segment->relocations.size() - 1));
+        if (relocationIndex == 0) {
+            return;
+        }
+
+        DivideSegment(segment, relocationIndex);
+    }
+}
@@ -0,0 +1,157 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Backend/ShaderExportFilter.h>
+#include <Backend/CommandContext.h>
+#include <Backend/Command/CommandBuilder.h>
+
+// Message
+#include <Message/IMessageStorage.h>
+#include <Message/MessageStream.h>
+
+// Schemas
+#include <Schemas/Diagnostic.h>
+
+bool ShaderExportFilter::Install(const ComRef<IShaderDataHost>& host, ShaderExportID id) {
+    shaderDataHost = host;
+    exportID = id;
+
+    // Allocate the table
+    //   ? Zero initialized, an epoch tag is never zero
+    tableBufferID = shaderDataHost->CreateBuffer(ShaderDataBufferInfo {
+        .elementCount = IL::kExportFilterTableSize,
+        .format = Backend::IL::Format::R32UInt
+    });
+
+    // Allocate the counters, read back on collection
+    counterBufferID = shaderDataHost->CreateBuffer(ShaderDataBufferInfo {
+        .elementCount = static_cast<uint32_t>(IL::ExportFilterCounter::Count),
+        .format = Backend::IL::Format::R32UInt,
+        .hostVisible = true
+    });
+
+    // Allocate the epochs, written by the host on submission
+    epochBufferID = shaderDataHost->CreateBuffer(ShaderDataBufferInfo {
+        .elementCount = kMaxTrackedEpochSlots,
+        .format = Backend::IL::Format::R32UInt,
+        .hostVisible = true
+    });
+
+    // Allocate the epoch slot of the context
+    epochSlotID = shaderDataHost->CreateDescriptorData(ShaderDataDescriptorInfo {
+        .dwordCount = 1u
+    });
+
+    // OK
+    return tableBufferID != InvalidShaderDataID && counterBufferID != InvalidShaderDataID &&
+           epochBufferID != InvalidShaderDataID && epochSlotID != InvalidShaderDataID;
+}
+
+void ShaderExportFilter::OnOpen(CommandContext *context) {
+    std::lock_guard guard(mutex);
+
+    // Assign a new slot, cycle back if needed
+    uint32_t slot = slotAllocationCounter;
+    slotAllocationCounter = (slotAllocationCounter + 1) % kMaxTrackedEpochSlots;
+    contextSlots[context->handle] = slot;
+
+    // Update the descriptor data
+    //   ? Only the slot is recorded, the epoch itself is assigned per submission
+    CommandBuilder builder(context->buffer);
+    builder.SetDescriptorData(epochSlotID, slot);
+}
+
+void ShaderExportFilter::OnPreSubmit(CommandContextHandle contextHandle) {
+    std::lock_guard guard(mutex);
+
+    // Contexts opened prior to installation have no slot
+    auto it = contextSlots.find(contextHandle);
+    if (it == contextSlots.end()) {
+        return;
+    }
+
+    // Map on first submission
+    if (!epochs) {
+        epochs = static_cast<uint32_t*>(shaderDataHost->Map(epochBufferID));
+
+        // Not mappable, e.g. device independent hosts
+        if (!epochs) {
+            return;
+        }
+    }
+
+    // Scatter the epochs, tags are offset by the epoch
+    //   ? Zero is the cleared state, skip it on wrap around
+    uint32_t epoch;
+    do {
+        epoch = (++epochCounter) * IL::kExportFilterHashMultiplier;
+    } while (!epoch);
+
+    // Write prior to the submission, visible to it without further synchronization
+    //   ? If the previous submission of this context is still in flight, it may observe the new epoch, which only
+    //     lets more messages through
+    epochs[it->second] = epoch;
+    shaderDataHost->FlushMappedRange(epochBufferID, sizeof(uint32_t) * it->second, sizeof(uint32_t));
+}
+
+void ShaderExportFilter::CollectMessages(IMessageStorage *storage) {
+    // Map on first collection
+    if (!counters) {
+        counters = static_cast<const uint32_t*>(shaderDataHost->Map(counterBufferID));
+
+        // Not mappable, e.g. device independent hosts
+        if (!counters) {
+            return;
+        }
+    }
+
+    // Read the current counters, may be in flight
+    uint32_t hitCount = counters[static_cast<uint32_t>(IL::ExportFilterCounter::Hit)];
+    uint32_t dropCount = counters[static_cast<uint32_t>(IL::ExportFilterCounter::Drop)];
+
+    // Nothing filtered since the last collection?
+    if (hitCount == reportedHitCount && dropCount == reportedDropCount) {
+        return;
+    }
+
+    // Report the deltas, wrapping is well defined
+    MessageStream stream;
+    {
+        MessageStreamView view(stream);
+
+        auto* diagnostic = view.Add<ExportFilterDiagnosticMessage>();
+        diagnostic->exportID = exportID;
+        diagnostic->hitCount = hitCount - reportedHitCount;
+        diagnostic->dropCount = dropCount - reportedDropCount;
+    }
+
+    // Commit
+    storage->AddStreamAndSwap(stream);
+
+    // Mark as reported
+    reportedHitCount = hitCount;
+    reportedDropCount = dropCount;
+}
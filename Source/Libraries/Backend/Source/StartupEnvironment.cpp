@@ -171,7 +171,9 @@ std::string StartupEnvironment::WriteEnvironment(const MessageStream& stream) {
 
     // Write to output
     std::ofstream file(path, std::ios::binary);
-    file.write(reinterpret_cast<const char*>(stream.GetDataBegin()), stream.GetByteSize());
+    for (const MessagePage* page = stream.GetFirstPage(); page; page = page->next) {
+        file.write(reinterpret_cast<const char*>(page->GetData()), page->size);
+    }
 
     // OK
     return path.string();
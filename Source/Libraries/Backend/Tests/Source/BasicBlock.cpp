@@ -29,6 +29,10 @@
 // Backend
 #include <Backend/IL/Emitter.h>
 
+// Std
+#include <chrono>
+#include <iostream>
+
 TEST_CASE("Backend.IL.BasicBlock") {
     Allocators allocators;
 
@@ -74,3 +78,176 @@ TEST_CASE("Backend.IL.BasicBlock") {
     REQUIRE(addRef->lhs == aRef->result);
     REQUIRE(addRef->rhs == bRef->result);
 }
+
+/// Append a literal instruction
+static IL::InstructionRef<IL::LiteralInstruction> AppendLiteral(IL::IdentifierMap& map, IL::BasicBlock* bb, int64_t value) {
+    IL::LiteralInstruction instr;
+    instr.opCode = IL::OpCode::Literal;
+    instr.result = map.AllocID();
+    instr.source = IL::Source::Invalid();
+    instr.type = IL::LiteralType::Int;
+    instr.bitWidth = 32;
+    instr.signedness = true;
+    instr.value.integral = value;
+    return bb->Append(instr);
+}
+
+/// Insert a literal instruction
+static IL::InstructionRef<IL::LiteralInstruction> InsertLiteral(IL::IdentifierMap& map, IL::BasicBlock* bb, const IL::OpaqueInstructionRef& insertion, int64_t value) {
+    IL::LiteralInstruction instr;
+    instr.opCode = IL::OpCode::Literal;
+    instr.result = map.AllocID();
+    instr.source = IL::Source::Invalid();
+    instr.type = IL::LiteralType::Int;
+    instr.bitWidth = 32;
+    instr.signedness = true;
+    instr.value.integral = value;
+    return bb->Insert(insertion, instr);
+}
+
+/// Validate that a block holds the expected literal sequence
+static void ValidateLiterals(const IL::BasicBlock* bb, const std::vector<int64_t>& expected) {
+    REQUIRE(bb->GetCount() == expected.size());
+
+    size_t index = 0;
+    for (auto it = bb->begin(); it != bb->end(); ++it) {
+        REQUIRE(index < expected.size());
+        REQUIRE(it->As<IL::LiteralInstruction>()->value.integral == expected[index++]);
+    }
+
+    REQUIRE(index == expected.size());
+}
+
+TEST_CASE("Backend.IL.BasicBlock.Segments") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    IL::BasicBlock* bb = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    // Enough instructions to span many segments
+    constexpr int64_t kCount = 4096;
+
+    std::vector<int64_t> expected;
+    std::vector<IL::InstructionRef<IL::LiteralInstruction>> refs;
+
+    for (int64_t i = 0; i < kCount; i++) {
+        refs.push_back(AppendLiteral(map, bb, i));
+        expected.push_back(i);
+    }
+
+    REQUIRE(bb->GetSegmentCount() > 1);
+    ValidateLiterals(bb, expected);
+
+    // Insert before every other instruction, all references must remain valid
+    for (int64_t i = 0; i < kCount; i += 2) {
+        InsertLiteral(map, bb, refs[i], -i);
+    }
+
+    expected.clear();
+    for (int64_t i = 0; i < kCount; i++) {
+        if (i % 2 == 0) {
+            expected.push_back(-i);
+        }
+
+        expected.push_back(i);
+    }
+
+    ValidateLiterals(bb, expected);
+
+    for (int64_t i = 0; i < kCount; i++) {
+        REQUIRE(refs[i]->value.integral == i);
+        REQUIRE(bb->GetIterator(refs[i])->As<IL::LiteralInstruction>()->value.integral == i);
+    }
+
+    // Split mid-block, references to migrated instructions must remain valid
+    IL::BasicBlock* dest = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    auto splitIt = bb->GetIterator(refs[kCount / 2 + 1]);
+    bb->Split(dest, splitIt);
+
+    REQUIRE(bb->GetCount() + dest->GetCount() == expected.size());
+    ValidateLiterals(bb, std::vector<int64_t>(expected.begin(), expected.begin() + bb->GetCount()));
+    ValidateLiterals(dest, std::vector<int64_t>(expected.begin() + bb->GetCount(), expected.end()));
+
+    for (int64_t i = 0; i < kCount; i++) {
+        REQUIRE(refs[i]->value.integral == i);
+
+        // Identifier map must resolve the new owner
+        IL::BasicBlock* owner = i > kCount / 2 ? dest : bb;
+        REQUIRE(map.Get(refs[i]->result).basicBlock == owner);
+    }
+
+    // Remove all even literals from the destination
+    for (int64_t i = kCount / 2 + 2; i < kCount; i += 2) {
+        dest->Remove(refs[i]);
+    }
+
+    std::vector<int64_t> destExpected;
+    for (auto it = dest->begin(); it != dest->end(); ++it) {
+        destExpected.push_back(it->As<IL::LiteralInstruction>()->value.integral);
+    }
+
+    // Flatten must not affect the order or references
+    dest->Flatten();
+    REQUIRE(dest->GetSegmentCount() == 1);
+    ValidateLiterals(dest, destExpected);
+
+    for (int64_t i = kCount / 2 + 1; i < kCount; i += 2) {
+        REQUIRE(refs[i]->value.integral == i);
+    }
+}
+
+TEST_CASE("Backend.IL.BasicBlock.Benchmark", "[.benchmark]") {
+    // 100k instruction blocks
+    constexpr int64_t kCount = 100'000;
+
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    IL::BasicBlock* bb = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    std::vector<IL::InstructionRef<IL::LiteralInstruction>> refs;
+    for (int64_t i = 0; i < kCount; i++) {
+        refs.push_back(AppendLiteral(map, bb, i));
+    }
+
+    // Instrumentation-like pattern, insert before every instruction
+    auto begin = std::chrono::high_resolution_clock::now();
+    for (int64_t i = 0; i < kCount; i++) {
+        InsertLiteral(map, bb, refs[i], -i);
+    }
+    double insertMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    // Split at every 64th instruction, each split continuing from the last block
+    begin = std::chrono::high_resolution_clock::now();
+    IL::BasicBlock* current = bb;
+    for (int64_t i = 64; i < kCount; i += 64) {
+        IL::BasicBlock* next = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        current->Split(next, current->GetIterator(refs[i]));
+        current = next;
+    }
+    double splitMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    // Flatten all blocks prior to compilation
+    begin = std::chrono::high_resolution_clock::now();
+    for (IL::BasicBlock* block : fn->GetBasicBlocks()) {
+        block->Flatten();
+    }
+    double flattenMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+    std::cout << "Instructions " << kCount
+              << ": insert " << insertMs << " ms"
+              << ", split " << splitMs << " ms"
+              << ", flatten " << flattenMs << " ms"
+              << std::endl;
+}
@@ -0,0 +1,167 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/Analysis/BoundsCheckAnalysis.h>
+
+/// Append a raw buffer access
+/// \param map identifier map
+/// \param bb destination block
+/// \param buffer accessed buffer
+/// \param index accessed index
+/// \param isWrite store if true, load otherwise
+/// \return access reference
+static IL::OpaqueInstructionRef AppendAccess(IL::IdentifierMap& map, IL::BasicBlock* bb, IL::ID buffer, IL::ID index, bool isWrite) {
+    if (isWrite) {
+        IL::StoreBufferInstruction instr{};
+        instr.opCode = IL::OpCode::StoreBuffer;
+        instr.source = IL::Source::Invalid();
+        instr.result = IL::InvalidID;
+        instr.buffer = buffer;
+        instr.index = index;
+        instr.value = index;
+        instr.mask = IL::ComponentMask::All;
+        return bb->Append(instr);
+    }
+
+    IL::LoadBufferInstruction instr{};
+    instr.opCode = IL::OpCode::LoadBuffer;
+    instr.source = IL::Source::Invalid();
+    instr.result = map.AllocID();
+    instr.buffer = buffer;
+    instr.index = index;
+    instr.offset = IL::InvalidID;
+    return bb->Append(instr);
+}
+
+TEST_CASE("Backend.IL.BoundsCheckAnalysis") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Integral constants, as parsed from the source module
+    const Backend::IL::IntType* uint32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType{.bitWidth = 32, .signedness = false});
+    IL::ID constant3 = program.GetConstants().AddConstant(map.AllocID(), uint32Type, IL::IntConstant{.value = 3})->id;
+    IL::ID constant5 = program.GetConstants().AddConstant(map.AllocID(), uint32Type, IL::IntConstant{.value = 5})->id;
+
+    // Negative constants never prove other checks
+    const Backend::IL::IntType* int32Type = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType{.bitWidth = 32, .signedness = true});
+    IL::ID constantNegative = program.GetConstants().AddConstant(map.AllocID(), int32Type, IL::IntConstant{.value = -1})->id;
+
+    // Resources and indices not defined by instructions
+    IL::ID buffer = map.AllocID();
+    IL::ID ascendingBuffer = map.AllocID();
+    IL::ID negativeBuffer = map.AllocID();
+    IL::ID loopBuffer = map.AllocID();
+    IL::ID bodyBuffer = map.AllocID();
+    IL::ID index = map.AllocID();
+    IL::ID cond = map.AllocID();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    //   entry -> header <-> body
+    //              |
+    //             exit
+    IL::BasicBlock* entry = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* header = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* body = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* exit = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    // Entry, the loop preheader
+    IL::OpaqueInstructionRef first = AppendAccess(map, entry, buffer, index, false);
+    IL::OpaqueInstructionRef duplicate = AppendAccess(map, entry, buffer, index, false);
+    IL::OpaqueInstructionRef constantLarge = AppendAccess(map, entry, buffer, constant5, false);
+    IL::OpaqueInstructionRef constantSmall = AppendAccess(map, entry, buffer, constant3, false);
+    IL::OpaqueInstructionRef write = AppendAccess(map, entry, buffer, index, true);
+    IL::OpaqueInstructionRef ascendingSmall = AppendAccess(map, entry, ascendingBuffer, constant3, false);
+    IL::OpaqueInstructionRef ascendingLarge = AppendAccess(map, entry, ascendingBuffer, constant5, false);
+    IL::OpaqueInstructionRef negative = AppendAccess(map, entry, negativeBuffer, constantNegative, false);
+    IL::OpaqueInstructionRef afterNegative = AppendAccess(map, entry, negativeBuffer, constant3, false);
+    IL::Emitter<>(program, *entry).Branch(header);
+
+    // Header, executed on each loop entry
+    IL::OpaqueInstructionRef invariant = AppendAccess(map, header, loopBuffer, index, false);
+    IL::OpaqueInstructionRef variantLoad = AppendAccess(map, header, loopBuffer, index, false);
+    IL::ID variantIndex = variantLoad.basicBlock->GetRelocationInstruction(variantLoad.relocationOffset)->result;
+    IL::OpaqueInstructionRef variant = AppendAccess(map, header, loopBuffer, variantIndex, false);
+    IL::Emitter<>(program, *header).BranchConditional(cond, body, exit, IL::ControlFlow::Loop(exit, body));
+
+    // Body, not executed if the loop exits immediately
+    IL::OpaqueInstructionRef conditional = AppendAccess(map, body, bodyBuffer, index, false);
+    IL::Emitter<>(program, *body).Branch(header);
+
+    // Exit
+    IL::OpaqueInstructionRef exitDuplicate = AppendAccess(map, exit, buffer, index, false);
+    IL::Emitter<>(program, *exit).Return();
+
+    IL::BoundsCheckAnalysis analysis(program);
+    analysis.Compute();
+
+    // Dominating checks
+    REQUIRE(analysis.GetResolution(first) == IL::BoundsCheckResolution::Required);
+    REQUIRE(analysis.GetResolution(duplicate) == IL::BoundsCheckResolution::Dominated);
+    REQUIRE(analysis.GetResolution(exitDuplicate) == IL::BoundsCheckResolution::Dominated);
+
+    // Constant folding
+    REQUIRE(analysis.GetResolution(constantLarge) == IL::BoundsCheckResolution::Required);
+    REQUIRE(analysis.GetResolution(constantSmall) == IL::BoundsCheckResolution::Folded);
+
+    // Larger dominated constant indices keep their check
+    REQUIRE(analysis.GetResolution(ascendingSmall) == IL::BoundsCheckResolution::Required);
+    REQUIRE(analysis.GetResolution(ascendingLarge) == IL::BoundsCheckResolution::Required);
+
+    // Negative indices are not folded against
+    REQUIRE(analysis.GetResolution(negative) == IL::BoundsCheckResolution::Required);
+    REQUIRE(analysis.GetResolution(afterNegative) == IL::BoundsCheckResolution::Required);
+
+    // Writes are reported separately from reads
+    REQUIRE(analysis.GetResolution(write) == IL::BoundsCheckResolution::Required);
+
+    // Loop invariant checks, the duplicate is proven by the hoisted check
+    REQUIRE(analysis.GetResolution(invariant) == IL::BoundsCheckResolution::Hoisted);
+    REQUIRE(analysis.GetResolution(variantLoad) == IL::BoundsCheckResolution::Dominated);
+    REQUIRE(analysis.GetResolution(variant) == IL::BoundsCheckResolution::Required);
+    REQUIRE(analysis.GetResolution(conditional) == IL::BoundsCheckResolution::Required);
+
+    REQUIRE(analysis.GetHoists().size() == 1);
+    REQUIRE(analysis.GetHoists()[0].preheader == entry);
+
+    const IL::BoundsCheckStatistics& statistics = analysis.GetStatistics();
+    REQUIRE(statistics.accesses == 14);
+    REQUIRE(statistics.dominated == 3);
+    REQUIRE(statistics.folded == 1);
+    REQUIRE(statistics.hoisted == 1);
+    REQUIRE(statistics.GetEliminated() == 5);
+
+    // Folding disabled
+    IL::BoundsCheckAnalysis exactAnalysis(program);
+    exactAnalysis.Compute(false);
+    REQUIRE(exactAnalysis.GetResolution(constantSmall) == IL::BoundsCheckResolution::Required);
+}
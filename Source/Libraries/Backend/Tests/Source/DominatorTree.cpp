@@ -0,0 +1,300 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/CFG/DominatorTree.h>
+
+// Std
+#include <unordered_map>
+#include <iostream>
+#include <chrono>
+
+/// Create a chain of diamonds, each diamond branching from a header and joining before the next
+///   header -> (left | right) -> join -> header ...
+/// \param program destination program
+/// \param diamondCount number of diamonds
+/// \return the function
+static IL::Function* CreateDiamondProgram(IL::Program& program, uint32_t diamondCount) {
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    // Shared condition
+    IL::ID cond = map.AllocID();
+
+    IL::BasicBlock* header = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    for (uint32_t i = 0; i < diamondCount; i++) {
+        IL::BasicBlock* left = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        IL::BasicBlock* right = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+        IL::BasicBlock* join = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+        IL::Emitter<>(program, *header).BranchConditional(cond, left, right, IL::ControlFlow::Selection(join));
+        IL::Emitter<>(program, *left).Branch(join);
+        IL::Emitter<>(program, *right).Branch(join);
+
+        header = join;
+    }
+
+    IL::Emitter<>(program, *header).Return();
+    return fn;
+}
+
+/// Split a block at its terminator, and insert a side block rejoining the resume block
+///   bb -> (side | resume) -> ...
+/// \param program destination program
+/// \param fn owning function
+/// \param bb block to split
+/// \param dominatorTree if not null, tree to update
+/// \return the resume block
+static IL::BasicBlock* InsertSideBlock(IL::Program& program, IL::Function* fn, IL::BasicBlock* bb, IL::DominatorTree* dominatorTree) {
+    IL::BasicBlock* resume = fn->GetBasicBlocks().AllocBlock();
+    IL::BasicBlock* side = fn->GetBasicBlocks().AllocBlock();
+
+    // Move the terminator to resume
+    bb->Split(resume, bb->GetTerminator());
+
+    // Same edit as instrumentation checks
+    IL::Emitter<>(program, *bb).BranchConditional(program.GetIdentifierMap().AllocID(), side, resume, IL::ControlFlow::Selection(resume));
+    IL::Emitter<>(program, *side).Branch(resume);
+
+    if (dominatorTree) {
+        dominatorTree->SplitBlock(bb, resume);
+        dominatorTree->InsertSideBlock(bb, side, resume);
+    }
+
+    return resume;
+}
+
+/// Split a block at its terminator, and insert a side block exiting the function
+///   bb -> (exit | resume) -> ...
+/// \param program destination program
+/// \param fn owning function
+/// \param bb block to split
+/// \param dominatorTree if not null, tree to update
+/// \return the resume block
+static IL::BasicBlock* InsertExitBlock(IL::Program& program, IL::Function* fn, IL::BasicBlock* bb, IL::DominatorTree* dominatorTree) {
+    IL::BasicBlock* resume = fn->GetBasicBlocks().AllocBlock();
+    IL::BasicBlock* exit = fn->GetBasicBlocks().AllocBlock();
+
+    // Move the terminator to resume
+    bb->Split(resume, bb->GetTerminator());
+
+    // Same edit as early termination
+    IL::Emitter<>(program, *bb).BranchConditional(program.GetIdentifierMap().AllocID(), exit, resume, IL::ControlFlow::None());
+    IL::Emitter<>(program, *exit).Return();
+
+    if (dominatorTree) {
+        dominatorTree->SplitBlock(bb, resume);
+        dominatorTree->InsertSideBlock(bb, exit, nullptr);
+    }
+
+    return resume;
+}
+
+/// Validate that an incrementally updated tree matches a computed one
+/// \param fn function of the trees
+/// \param dominatorTree incrementally updated tree
+static void ValidateDominatorTree(IL::Function* fn, const IL::DominatorTree& dominatorTree) {
+    IL::DominatorTree computed(fn->GetBasicBlocks());
+    computed.Compute();
+
+    for (IL::BasicBlock* first : fn->GetBasicBlocks()) {
+        REQUIRE(dominatorTree.GetImmediateDominator(first) == computed.GetImmediateDominator(first));
+        REQUIRE(dominatorTree.GetPredecessors(first).size() == computed.GetPredecessors(first).size());
+        REQUIRE(dominatorTree.GetSuccessors(first).size() == computed.GetSuccessors(first).size());
+
+        for (IL::BasicBlock* second : fn->GetBasicBlocks()) {
+            REQUIRE(dominatorTree.Dominates(first, second) == computed.Dominates(first, second));
+        }
+    }
+
+    const IL::BasicBlockTraversal::BlockView& view = dominatorTree.GetPostOrderTraversal().GetView();
+    REQUIRE(view.size() == computed.GetPostOrderTraversal().GetView().size());
+
+    // Successors must precede their predecessors, unless back-edges
+    std::unordered_map<IL::BasicBlock*, size_t> order;
+    for (size_t i = 0; i < view.size(); i++) {
+        order[view[i]] = i;
+    }
+
+    for (IL::BasicBlock* bb : view) {
+        for (IL::BasicBlock* successor : dominatorTree.GetSuccessors(bb)) {
+            if (successor != bb && !dominatorTree.Dominates(successor, bb)) {
+                REQUIRE(order.at(successor) < order.at(bb));
+            }
+        }
+    }
+}
+
+TEST_CASE("Backend.IL.DominatorTree") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    //   entry -> header <-> body
+    //              |
+    //             exit
+    IL::BasicBlock* entry = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* header = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* body = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* exit = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* unreachable = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    IL::Emitter<>(program, *entry).Branch(header);
+    IL::Emitter<>(program, *header).BranchConditional(map.AllocID(), body, exit, IL::ControlFlow::Loop(exit, body));
+    IL::Emitter<>(program, *body).Branch(header);
+    IL::Emitter<>(program, *exit).Return();
+    IL::Emitter<>(program, *unreachable).Branch(exit);
+
+    IL::DominatorTree dominatorTree(fn->GetBasicBlocks());
+    dominatorTree.Compute();
+
+    // Immediate dominators
+    REQUIRE(dominatorTree.GetImmediateDominator(entry) == entry);
+    REQUIRE(dominatorTree.GetImmediateDominator(header) == entry);
+    REQUIRE(dominatorTree.GetImmediateDominator(body) == header);
+    REQUIRE(dominatorTree.GetImmediateDominator(exit) == header);
+    REQUIRE(dominatorTree.GetImmediateDominator(unreachable) == nullptr);
+
+    // Strict dominance, the entry point dominates all
+    REQUIRE(dominatorTree.Dominates(entry, entry));
+    REQUIRE(dominatorTree.Dominates(entry, exit));
+    REQUIRE(dominatorTree.Dominates(header, body));
+    REQUIRE(dominatorTree.Dominates(header, exit));
+    REQUIRE(!dominatorTree.Dominates(header, header));
+    REQUIRE(!dominatorTree.Dominates(body, exit));
+    REQUIRE(!dominatorTree.Dominates(exit, header));
+
+    // Unreachable blocks dominate nothing, and are dominated by nothing
+    REQUIRE(!dominatorTree.Dominates(unreachable, exit));
+    REQUIRE(!dominatorTree.Dominates(header, unreachable));
+
+    // Edges, only mapped from reachable blocks
+    REQUIRE(dominatorTree.GetPredecessors(header).size() == 2);
+    REQUIRE(dominatorTree.GetSuccessors(header).size() == 2);
+    REQUIRE(dominatorTree.GetPredecessors(exit).size() == 1);
+    REQUIRE(dominatorTree.GetBlock(body->GetID()) == body);
+    REQUIRE(dominatorTree.GetBlock(map.AllocID()) == nullptr);
+
+    // Only reachable blocks are traversed
+    REQUIRE(dominatorTree.GetPostOrderTraversal().GetView().size() == 4);
+
+    // Instrument the loop body and header
+    IL::BasicBlock* bodyResume = InsertSideBlock(program, fn, body, &dominatorTree);
+    REQUIRE(dominatorTree.GetImmediateDominator(bodyResume) == body);
+    ValidateDominatorTree(fn, dominatorTree);
+
+    InsertSideBlock(program, fn, header, &dominatorTree);
+    ValidateDominatorTree(fn, dominatorTree);
+
+    // Instrument the resume block again
+    InsertSideBlock(program, fn, bodyResume, &dominatorTree);
+    ValidateDominatorTree(fn, dominatorTree);
+
+    // Exit the function from the header
+    IL::BasicBlock* headerResume = InsertExitBlock(program, fn, header, &dominatorTree);
+    ValidateDominatorTree(fn, dominatorTree);
+
+    // Exit from a side block
+    InsertSideBlock(program, fn, headerResume, &dominatorTree);
+    InsertExitBlock(program, fn, headerResume, &dominatorTree);
+    ValidateDominatorTree(fn, dominatorTree);
+}
+
+TEST_CASE("Backend.IL.DominatorTree.Incremental") {
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+
+    IL::Function* fn = CreateDiamondProgram(program, 8);
+
+    IL::DominatorTree dominatorTree(fn->GetBasicBlocks());
+    dominatorTree.Compute();
+
+    // Repeatedly instrument the same chain, exhausts the numbering space of the incremental updates
+    IL::BasicBlock* bb = fn->GetBasicBlocks().GetEntryPoint();
+    for (uint32_t i = 0; i < 64; i++) {
+        bb = InsertSideBlock(program, fn, bb, &dominatorTree);
+    }
+
+    // Instrument all original blocks once
+    std::vector<IL::BasicBlock*> blocks(fn->GetBasicBlocks().begin(), fn->GetBasicBlocks().end());
+    for (IL::BasicBlock* block : blocks) {
+        InsertSideBlock(program, fn, block, &dominatorTree);
+    }
+
+    // Exit from all original blocks
+    for (IL::BasicBlock* block : blocks) {
+        InsertExitBlock(program, fn, block, &dominatorTree);
+    }
+
+    ValidateDominatorTree(fn, dominatorTree);
+}
+
+TEST_CASE("Backend.IL.DominatorTree.Benchmark", "[.benchmark]") {
+    for (uint32_t diamondCount = 2'500; diamondCount <= 20'000; diamondCount *= 2) {
+        Allocators allocators;
+        IL::Program program(allocators, 0x0);
+
+        IL::Function* fn = CreateDiamondProgram(program, diamondCount);
+
+        // Full computation
+        auto begin = std::chrono::high_resolution_clock::now();
+        IL::DominatorTree dominatorTree(fn->GetBasicBlocks());
+        dominatorTree.Compute();
+        double computeMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        // Query all blocks against the entry of every diamond
+        std::vector<IL::BasicBlock*> blocks(fn->GetBasicBlocks().begin(), fn->GetBasicBlocks().end());
+        uint32_t dominated = 0;
+
+        begin = std::chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < blocks.size(); i += 256) {
+            for (IL::BasicBlock* second : blocks) {
+                dominated += dominatorTree.Dominates(blocks[i], second);
+            }
+        }
+        double queryMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        // Instrument every block, updating the tree after each edit
+        begin = std::chrono::high_resolution_clock::now();
+        for (IL::BasicBlock* block : blocks) {
+            InsertSideBlock(program, fn, block, &dominatorTree);
+        }
+        double updateMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+
+        std::cout << "Blocks " << blocks.size()
+                  << ": compute " << computeMS << " ms"
+                  << ", query " << queryMS << " ms (" << dominated << " dominated)"
+                  << ", update " << updateMS << " ms (" << (updateMS * 1e6 / blocks.size()) << " ns per edit)"
+                  << std::endl;
+    }
+}
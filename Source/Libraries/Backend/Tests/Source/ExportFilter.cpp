@@ -0,0 +1,166 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/ExportFilterEmitter.h>
+
+/// Minimal two dword export
+struct TestFilterExport {
+    /// Construct the dwords
+    /// \param emitter unused
+    /// \param dwordCount filled with the number of dwords
+    /// \param dwords if not null, filled with all dwords
+    template<typename E>
+    void Construct(E& emitter, uint32_t* dwordCount, IL::ID* dwords) const {
+        if (!dwords) {
+            *dwordCount = 2u;
+            return;
+        }
+
+        dwords[0] = key;
+        dwords[1] = payload;
+    }
+
+    IL::ID key{IL::InvalidID};
+    IL::ID payload{IL::InvalidID};
+};
+
+/// Add a shader data entry
+/// \param program destination program
+/// \param id data identifier
+/// \param type data type
+/// \return program variable
+static IL::ID AddShaderData(IL::Program& program, ShaderDataID id, ShaderDataType type) {
+    ShaderDataInfo info;
+    info.id = id;
+    info.type = type;
+
+    // Buffers are always uint
+    if (type == ShaderDataType::Buffer) {
+        info.buffer.format = Backend::IL::Format::R32UInt;
+    } else {
+        info.descriptor.dwordCount = 1u;
+    }
+
+    program.GetShaderDataMap().Add(info);
+    return program.GetShaderDataMap().Get(id)->id;
+}
+
+/// Count the instructions of an op code
+/// \param bb the block to count in
+/// \param opCode the op code to count
+/// \return number of instructions
+static uint32_t CountOpCode(IL::BasicBlock* bb, IL::OpCode opCode) {
+    uint32_t count = 0;
+    for (auto it = bb->begin(); it != bb->end(); ++it) {
+        count += it->opCode == opCode;
+    }
+    return count;
+}
+
+TEST_CASE("Backend.IL.ExportFilterEmitter") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Filter data
+    IL::ID tableDataID = AddShaderData(program, 0, ShaderDataType::Buffer);
+    IL::ID counterDataID = AddShaderData(program, 1, ShaderDataType::Buffer);
+    IL::ID epochDataID = AddShaderData(program, 2, ShaderDataType::Descriptor);
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    //   failure -> resume
+    IL::BasicBlock* failure = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* resume = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::Emitter<>(program, *resume).Return();
+
+    // Message values
+    IL::Emitter<> emitter(program, *failure);
+    TestFilterExport message;
+    message.key = emitter.UInt32(42);
+    message.payload = emitter.UInt32(7);
+
+    // Filter the export
+    IL::ExportFilterEmitter filter(emitter, fn->GetBasicBlocks(), tableDataID, counterDataID, epochDataID);
+    filter.Export(0u, message);
+
+    // Emitter continues in the merge block
+    IL::BasicBlock* merge = emitter.GetBasicBlock();
+    REQUIRE(merge != failure);
+    REQUIRE(merge->HasFlag(BasicBlockFlag::NoInstrumentation));
+    emitter.Branch(resume);
+
+    // Lookup exchanges the epoch relative tag, only its outcome is counted
+    REQUIRE(CountOpCode(failure, IL::OpCode::AtomicExchange) == 1);
+    REQUIRE(CountOpCode(failure, IL::OpCode::AtomicAdd) == 0);
+    REQUIRE(CountOpCode(failure, IL::OpCode::Export) == 0);
+
+    // Tag is offset by the epoch
+    for (auto it = failure->begin(); it != failure->end(); ++it) {
+        if (it->opCode != IL::OpCode::AtomicExchange) {
+            continue;
+        }
+
+        // Get the tag definition
+        const IL::OpaqueInstructionRef& tagRef = map.Get(it->As<IL::AtomicExchangeInstruction>()->value);
+        auto tag = tagRef.basicBlock->GetIterator(tagRef)->As<IL::AddInstruction>();
+        REQUIRE(tag->lhs == message.key);
+        REQUIRE(tag->rhs == epochDataID);
+    }
+
+    // First occurrences branch to the export, duplicates to the drop
+    auto branch = failure->GetTerminator()->As<IL::BranchConditionalInstruction>();
+    REQUIRE(branch->controlFlow.merge == merge->GetID());
+
+    // Drop block, only duplicates are counted
+    IL::BasicBlock* dropBlock = fn->GetBasicBlocks().GetBlock(branch->fail);
+    REQUIRE(dropBlock->HasFlag(BasicBlockFlag::NoInstrumentation));
+    REQUIRE(CountOpCode(dropBlock, IL::OpCode::AtomicAdd) == 1);
+    REQUIRE(CountOpCode(dropBlock, IL::OpCode::Export) == 0);
+    REQUIRE(dropBlock->GetTerminator()->As<IL::BranchInstruction>()->branch == merge->GetID());
+
+    // Export block, first occurrences are counted
+    IL::BasicBlock* exportBlock = fn->GetBasicBlocks().GetBlock(branch->pass);
+    REQUIRE(exportBlock->HasFlag(BasicBlockFlag::NoInstrumentation));
+    REQUIRE(CountOpCode(exportBlock, IL::OpCode::Export) == 1);
+    REQUIRE(CountOpCode(exportBlock, IL::OpCode::AtomicAdd) == 1);
+
+    // Exported values are constructed once, prior to the lookup
+    auto exportInstr = exportBlock->begin()->As<IL::ExportInstruction>();
+    REQUIRE(exportInstr->values.count == 2);
+    REQUIRE(exportInstr->values[0] == message.key);
+    REQUIRE(exportInstr->values[1] == message.payload);
+
+    // Export rejoins the merge block
+    REQUIRE(exportBlock->GetTerminator()->As<IL::BranchInstruction>()->branch == merge->GetID());
+    REQUIRE(merge->GetTerminator()->As<IL::BranchInstruction>()->branch == resume->GetID());
+}
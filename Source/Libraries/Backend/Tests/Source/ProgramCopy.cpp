@@ -0,0 +1,274 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+
+// Std
+#include <iostream>
+#include <chrono>
+#include <vector>
+
+/// Create a program of chained blocks, each block loading from a shared address
+/// \param program destination program
+/// \param functionCount number of functions
+/// \param blockCount number of blocks per function
+/// \param loadCount number of loads per block
+static void CreateChainProgram(IL::Program& program, uint32_t functionCount, uint32_t blockCount, uint32_t loadCount) {
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Shared address
+    IL::ID address = map.AllocID();
+
+    for (uint32_t functionIndex = 0; functionIndex < functionCount; functionIndex++) {
+        IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+        IL::BasicBlock* bb = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+        for (uint32_t blockIndex = 0; blockIndex < blockCount; blockIndex++) {
+            for (uint32_t i = 0; i < loadCount; i++) {
+                IL::LoadInstruction instr{};
+                instr.opCode = IL::OpCode::Load;
+                instr.source = IL::Source::Code(i);
+                instr.result = map.AllocID();
+                instr.address = address;
+                bb->Append(instr);
+            }
+
+            // Last block returns
+            if (blockIndex + 1 == blockCount) {
+                IL::Emitter<>(program, *bb).Return();
+                break;
+            }
+
+            IL::BasicBlock* next = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+            IL::Emitter<>(program, *bb).Branch(next);
+            bb = next;
+        }
+
+        // Parsed programs are not modified
+        for (IL::BasicBlock* block : fn->GetBasicBlocks()) {
+            block->Immortalize({});
+        }
+    }
+}
+
+/// Check if all blocks of a program share their instructions
+/// \param program program to check
+/// \return number of shared blocks
+static uint32_t GetSharedBlockCount(IL::Program& program) {
+    uint32_t count = 0;
+
+    for (IL::Function* fn : program.GetFunctionList()) {
+        for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+            count += bb->IsShared();
+        }
+    }
+
+    return count;
+}
+
+TEST_CASE("Backend.IL.Program.Copy") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+    CreateChainProgram(program, 2, 4, 8);
+
+    IL::Function* sourceFn = program.GetFunctionList()[0];
+    IL::BasicBlock* sourceEntry = sourceFn->GetBasicBlocks().GetEntryPoint();
+
+    // First load of the entry point
+    IL::ID loadID = sourceEntry->begin()->result;
+
+    IL::Program* copy = program.Copy();
+    IL::Function* copyFn = copy->GetFunctionList()[0];
+    IL::BasicBlock* copyEntry = copyFn->GetBasicBlocks().GetEntryPoint();
+
+    // Nothing modified or referenced yet
+    REQUIRE(GetSharedBlockCount(*copy) == 8);
+    REQUIRE(copyEntry->GetCount() == sourceEntry->GetCount());
+    REQUIRE(copyEntry->begin()->result == loadID);
+
+    // Resolution materializes the owning block only
+    IL::OpaqueInstructionRef ref = copy->GetIdentifierMap().Get(loadID);
+    REQUIRE(ref.basicBlock == copyEntry);
+    REQUIRE(!copyEntry->IsShared());
+    REQUIRE(GetSharedBlockCount(*copy) == 7);
+    REQUIRE(program.GetIdentifierMap().Get(loadID).basicBlock == sourceEntry);
+
+    // Modify the copy, source must be unaffected
+    {
+        IL::Emitter<> emitter(*copy, *copyEntry, copyEntry->GetIterator(ref));
+        emitter.Add(emitter.UInt32(1), emitter.UInt32(2));
+    }
+
+    REQUIRE(copyEntry->GetCount() > sourceEntry->GetCount());
+    REQUIRE(copyEntry->IsModified());
+    REQUIRE(!sourceEntry->IsModified());
+    REQUIRE(sourceEntry->begin()->result == loadID);
+    REQUIRE(copy->GetIdentifierMap().Get(loadID).basicBlock == copyEntry);
+
+    // Splitting migrates segments and redirects users of the split block
+    {
+        IL::BasicBlock* copySecond = *std::next(copyFn->GetBasicBlocks().begin());
+        IL::BasicBlock* sourceSecond = *std::next(sourceFn->GetBasicBlocks().begin());
+
+        IL::BasicBlock* resume = copyFn->GetBasicBlocks().AllocBlock();
+        copySecond->Split(resume, copySecond->GetTerminator());
+        IL::Emitter<>(*copy, *copySecond).Branch(resume);
+
+        REQUIRE(!copySecond->IsShared());
+        REQUIRE(copySecond->GetCount() == sourceSecond->GetCount());
+        REQUIRE(sourceSecond->GetTerminator()->opCode == IL::OpCode::Branch);
+        REQUIRE(sourceSecond->GetTerminator()->As<IL::BranchInstruction>()->branch != resume->GetID());
+
+        // Users of the split block are rebound to the copied entry point
+        for (const IL::OpaqueInstructionRef& user : copy->GetIdentifierMap().GetBlockUsers(copySecond->GetID())) {
+            REQUIRE(user.basicBlock == copyEntry);
+        }
+    }
+
+    // Copies of copies share with the source
+    IL::Program* nestedCopy = copy->Copy();
+    {
+        IL::Function* nestedFn = nestedCopy->GetFunctionList()[1];
+        IL::BasicBlock* nestedEntry = nestedFn->GetBasicBlocks().GetEntryPoint();
+        IL::BasicBlock* sourceLast = program.GetFunctionList()[1]->GetBasicBlocks().GetEntryPoint();
+
+        REQUIRE(nestedEntry->IsShared());
+        REQUIRE(nestedEntry->begin().ptr == sourceLast->begin().ptr);
+
+        // Materialized blocks in the intermediate copy are shared with the intermediate copy
+        IL::BasicBlock* nestedCopyEntry = nestedCopy->GetFunctionList()[0]->GetBasicBlocks().GetEntryPoint();
+        REQUIRE(nestedCopyEntry->GetCount() == copyEntry->GetCount());
+        REQUIRE(nestedCopy->GetIdentifierMap().Get(loadID).basicBlock == nestedCopyEntry);
+    }
+
+    destroy(nestedCopy, allocators);
+    destroy(copy, allocators);
+
+    // Source still intact
+    REQUIRE(sourceEntry->GetCount() == 9);
+    REQUIRE(program.GetIdentifierMap().Get(loadID).basicBlock == sourceEntry);
+}
+
+/// Counting allocator
+static void* CountingAllocate(void* user, size_t size, size_t, AllocationTag) {
+    *static_cast<size_t*>(user) += size;
+    return malloc(size);
+}
+
+TEST_CASE("Backend.IL.Program.Copy.Benchmark", "[.benchmark]") {
+    size_t allocated = 0;
+
+    Allocators allocators;
+    allocators.userData = &allocated;
+    allocators.alloc = CountingAllocate;
+
+    // Synthetic corpus, from small to large shaders
+    struct Shader {
+        uint32_t functionCount;
+        uint32_t blockCount;
+        uint32_t loadCount;
+    };
+
+    const Shader corpus[] = {
+        {1, 4, 16},
+        {4, 16, 32},
+        {16, 32, 64},
+        {100, 50, 100}
+    };
+
+    // Number of instrumentation keys per shader
+    constexpr uint32_t kKeyCount = 8;
+
+    // Fraction of blocks instrumented per key
+    constexpr uint32_t kInstrumentedBlockStride = 8;
+
+    for (const Shader& shader : corpus) {
+        IL::Program program(allocators, 0x0);
+        CreateChainProgram(program, shader.functionCount, shader.blockCount, shader.loadCount);
+
+        size_t sourceBytes = allocated;
+
+        double copyMS = 0;
+        double instrumentMS = 0;
+        double eagerMS = 0;
+        size_t copyBytes = 0;
+        size_t instrumentBytes = 0;
+        size_t eagerBytes = 0;
+
+        for (uint32_t key = 0; key < kKeyCount; key++) {
+            // Copy
+            size_t bytes = allocated;
+            auto begin = std::chrono::high_resolution_clock::now();
+            IL::Program* copy = program.Copy();
+            copyMS += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+            copyBytes += allocated - bytes;
+
+            // Instrument a subset of blocks, as a feature would
+            bytes = allocated;
+            begin = std::chrono::high_resolution_clock::now();
+            for (IL::Function* fn : copy->GetFunctionList()) {
+                uint32_t index = 0;
+                for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+                    if (index++ % kInstrumentedBlockStride != key % kInstrumentedBlockStride) {
+                        continue;
+                    }
+
+                    IL::Emitter<> emitter(*copy, *bb, bb->begin());
+                    emitter.Add(emitter.UInt32(1), emitter.UInt32(2));
+                }
+            }
+            instrumentMS += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+            instrumentBytes += allocated - bytes;
+
+            // Materialize everything, equivalent to a deep copy
+            bytes = allocated;
+            begin = std::chrono::high_resolution_clock::now();
+            for (IL::Function* fn : copy->GetFunctionList()) {
+                for (IL::BasicBlock* bb : fn->GetBasicBlocks()) {
+                    bb->Materialize();
+                }
+            }
+            eagerMS += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+            eagerBytes += allocated - bytes;
+
+            destroy(copy, allocators);
+        }
+
+        std::cout << "Shader " << shader.functionCount << "x" << shader.blockCount << "x" << shader.loadCount
+                  << " (" << sourceBytes / 1024 << " KiB)"
+                  << ": copy " << copyMS / kKeyCount << " ms, " << copyBytes / kKeyCount / 1024 << " KiB"
+                  << ", instrument " << instrumentMS / kKeyCount << " ms, " << instrumentBytes / kKeyCount / 1024 << " KiB"
+                  << ", remaining deep copy " << eagerMS / kKeyCount << " ms, " << eagerBytes / kKeyCount / 1024 << " KiB"
+                  << std::endl;
+
+        allocated = 0;
+    }
+}
@@ -0,0 +1,154 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/ResourceTokenEmitter.h>
+
+/// Append a raw resource load
+/// \param map identifier map
+/// \param bb destination block
+/// \param address loaded address
+/// \return loaded resource
+static IL::ID AppendResource(IL::IdentifierMap& map, IL::BasicBlock* bb, IL::ID address) {
+    IL::LoadInstruction instr{};
+    instr.opCode = IL::OpCode::Load;
+    instr.source = IL::Source::Invalid();
+    instr.result = map.AllocID();
+    instr.address = address;
+    bb->Append(instr);
+    return instr.result;
+}
+
+/// Append a raw buffer load
+/// \param map identifier map
+/// \param bb destination block
+/// \param buffer loaded buffer
+/// \param index loaded index
+/// \return access reference
+static IL::OpaqueInstructionRef AppendAccess(IL::IdentifierMap& map, IL::BasicBlock* bb, IL::ID buffer, IL::ID index) {
+    IL::LoadBufferInstruction instr{};
+    instr.opCode = IL::OpCode::LoadBuffer;
+    instr.source = IL::Source::Invalid();
+    instr.result = map.AllocID();
+    instr.buffer = buffer;
+    instr.index = index;
+    instr.offset = IL::InvalidID;
+    return bb->Append(instr);
+}
+
+/// Collect all op codes of a block
+/// \param bb the block to collect from
+/// \return all op codes, in order
+static std::vector<IL::OpCode> GetOpCodes(IL::BasicBlock* bb) {
+    std::vector<IL::OpCode> opCodes;
+    for (auto it = bb->begin(); it != bb->end(); ++it) {
+        opCodes.push_back(it->opCode);
+    }
+    return opCodes;
+}
+
+TEST_CASE("Backend.IL.ResourceTokenCache") {
+    Allocators allocators;
+
+    IL::Program program(allocators, 0x0);
+
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    // Variables and indices not defined by instructions
+    IL::ID variable = map.AllocID();
+    IL::ID index = map.AllocID();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+
+    //   entry -> exit
+    IL::BasicBlock* entry = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+    IL::BasicBlock* exit = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    // Entry, defines the resource
+    IL::ID resource = AppendResource(map, entry, variable);
+    IL::OpaqueInstructionRef entryLoad = AppendAccess(map, entry, resource, index);
+    IL::Emitter<>(program, *entry).Branch(exit);
+
+    // Exit, dominated by the definition
+    IL::Emitter<> exitEmitter(program, *exit);
+    IL::OpaqueInstructionRef exitLoad = AppendAccess(map, exit, resource, index);
+    exitEmitter.Return();
+
+    IL::ResourceTokenCache& cache = program.GetResourceTokenCache();
+
+    // First feature, instruments the exit load
+    IL::Emitter<> first(program, *exit, exitLoad);
+    IL::ResourceTokenEmitter firstToken(first, resource);
+    IL::ID puid = firstToken.GetPUID();
+
+    // Fetched and decoded after the definition, not at the user
+    REQUIRE(cache.GetCount() == 1);
+    REQUIRE(map.Get(firstToken.GetToken()).basicBlock == entry);
+    REQUIRE(map.Get(puid).basicBlock == entry);
+    REQUIRE(exit->GetCount() == 2);
+
+    // Second feature, instruments the entry load
+    IL::Emitter<> second(program, *entry, entryLoad);
+    IL::ResourceTokenEmitter secondToken(second, resource);
+
+    // Shared values
+    REQUIRE(secondToken.GetToken() == firstToken.GetToken());
+    REQUIRE(secondToken.GetPUID() == puid);
+
+    // Newly decoded values are shared too
+    IL::ID srb = secondToken.GetSRB();
+    REQUIRE(IL::ResourceTokenEmitter(first, resource).GetSRB() == srb);
+
+    // Single fetch, decoded values follow in order, and precede all users
+    REQUIRE(GetOpCodes(entry) == std::vector<IL::OpCode>{
+        IL::OpCode::Load,
+        IL::OpCode::ResourceToken,
+        IL::OpCode::Literal, IL::OpCode::Literal, IL::OpCode::BitShiftRight, IL::OpCode::BitAnd,
+        IL::OpCode::Literal, IL::OpCode::Literal, IL::OpCode::BitShiftRight, IL::OpCode::BitAnd,
+        IL::OpCode::LoadBuffer,
+        IL::OpCode::Branch
+    });
+
+    // Local users reuse shared values, but do not decode into the shared block
+    IL::ResourceTokenEmitter localToken(exitEmitter, resource, IL::ResourceTokenScope::Local);
+    REQUIRE(localToken.GetToken() == firstToken.GetToken());
+    REQUIRE(localToken.GetSRB() == srb);
+    REQUIRE(map.Get(localToken.GetType()).basicBlock == exit);
+    REQUIRE(entry->GetCount() == 12);
+
+    // Local users of uncached resources fetch in place
+    IL::ID otherResource = AppendResource(map, entry, variable);
+    IL::ResourceTokenEmitter otherToken(exitEmitter, otherResource, IL::ResourceTokenScope::Local);
+    REQUIRE(map.Get(otherToken.GetToken()).basicBlock == exit);
+    REQUIRE(cache.GetCount() == 1);
+
+    // Resources not defined by instructions are fetched in place
+    IL::ResourceTokenEmitter variableToken(exitEmitter, variable);
+    REQUIRE(map.Get(variableToken.GetToken()).basicBlock == exit);
+    REQUIRE(cache.GetCount() == 1);
+}
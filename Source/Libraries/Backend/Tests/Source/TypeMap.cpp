@@ -0,0 +1,110 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Program.h>
+
+// Std
+#include <iterator>
+
+TEST_CASE("Backend.IL.TypeMap") {
+    Allocators allocators{};
+    IL::Program program(allocators, 0x0);
+
+    Backend::IL::TypeMap& types = program.GetTypeMap();
+
+    // Identical declarations are interned
+    const Backend::IL::Type* int32 = types.FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = true });
+    REQUIRE(int32 == types.FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = true }));
+    REQUIRE(int32 != types.FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = false }));
+
+    // Composites are keyed by their interned members
+    const Backend::IL::Type* int4 = types.FindTypeOrAdd(Backend::IL::VectorType { .containedType = int32, .dimension = 4 });
+    REQUIRE(int4 == types.FindTypeOrAdd(Backend::IL::VectorType { .containedType = int32, .dimension = 4 }));
+
+    const Backend::IL::Type* structType = types.FindTypeOrAdd(Backend::IL::StructType { .memberTypes = { int32, int4 } });
+    REQUIRE(structType == types.FindTypeOrAdd(Backend::IL::StructType { .memberTypes = { int32, int4 } }));
+    REQUIRE(structType != types.FindTypeOrAdd(Backend::IL::StructType { .memberTypes = { int4, int32 } }));
+
+    // Lookups never add
+    REQUIRE(types.FindType(Backend::IL::FPType { .bitWidth = 16 }) == nullptr);
+
+    Backend::IL::ConstantMap& constants = program.GetConstants();
+
+    // Constants are interned per type
+    const auto* fp32 = types.FindTypeOrAdd(Backend::IL::FPType { .bitWidth = 32 });
+    const Backend::IL::Constant* zero = constants.FindConstantOrAdd(fp32, Backend::IL::FPConstant { .value = 0.0 });
+    REQUIRE(zero == constants.FindConstantOrAdd(fp32, Backend::IL::FPConstant { .value = 0.0 }));
+    REQUIRE(zero == constants.FindConstantOrAdd(fp32, Backend::IL::FPConstant { .value = -0.0 }));
+    REQUIRE(zero != constants.FindConstantOrAdd(fp32, Backend::IL::FPConstant { .value = 1.0 }));
+
+    // Declared constants resolve by id
+    IL::ID id = program.GetIdentifierMap().AllocID();
+    const Backend::IL::Constant* two = constants.AddConstant(id, fp32, Backend::IL::FPConstant { .value = 2.0 });
+    REQUIRE(constants.GetConstant(id) == two);
+    REQUIRE(types.GetType(id) == fp32);
+
+    // Declarations are interned as well
+    REQUIRE(two == constants.FindConstantOrAdd(fp32, Backend::IL::FPConstant { .value = 2.0 }));
+}
+
+TEST_CASE("Backend.IL.TypeMap.Copy") {
+    Allocators allocators{};
+    IL::Program program(allocators, 0x0);
+
+    const auto* int32 = program.GetTypeMap().FindTypeOrAdd(Backend::IL::IntType { .bitWidth = 32, .signedness = true });
+    const auto* one = program.GetConstants().AddConstant(program.GetIdentifierMap().AllocID(), int32, Backend::IL::IntConstant { .value = 1 });
+
+    // Associate a value
+    IL::ID value = program.GetIdentifierMap().AllocID();
+    program.GetTypeMap().SetType(value, int32);
+
+    IL::Program* copy = program.Copy();
+
+    // Copies see the same interned objects
+    REQUIRE(copy->GetTypeMap().FindType(Backend::IL::IntType { .bitWidth = 32, .signedness = true }) == int32);
+    REQUIRE(copy->GetConstants().FindConstant(int32, Backend::IL::IntConstant { .value = 1 }) == one);
+    REQUIRE(copy->GetTypeMap().GetType(value) == int32);
+    REQUIRE(copy->GetConstants().GetConstant(one->id) == one);
+
+    // Additions to the copy stay in the copy
+    const auto* fp32 = copy->GetTypeMap().FindTypeOrAdd(Backend::IL::FPType { .bitWidth = 32 });
+    const auto* two = copy->GetConstants().AddConstant(copy->GetIdentifierMap().AllocID(), int32, Backend::IL::IntConstant { .value = 2 });
+    copy->GetTypeMap().SetType(value, fp32);
+
+    REQUIRE(program.GetTypeMap().FindType(Backend::IL::FPType { .bitWidth = 32 }) == nullptr);
+    REQUIRE(program.GetConstants().FindConstant(int32, Backend::IL::IntConstant { .value = 2 }) == nullptr);
+    REQUIRE(program.GetConstants().GetConstant(two->id) == nullptr);
+    REQUIRE(program.GetTypeMap().GetType(value) == int32);
+
+    // Declaration order is per program
+    REQUIRE(std::distance(program.GetTypeMap().begin(), program.GetTypeMap().end()) + 1 == std::distance(copy->GetTypeMap().begin(), copy->GetTypeMap().end()));
+
+    destroy(copy, allocators);
+}
@@ -0,0 +1,120 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#include <catch2/catch.hpp>
+
+// Backend
+#include <Backend/IL/Emitter.h>
+#include <Backend/IL/Visitor.h>
+
+// Std
+#include <vector>
+
+/// Create a single block program with interleaved user loads and stores
+/// \param program destination program
+/// \param accessCount number of loads and stores
+static void CreateAccessProgram(IL::Program& program, uint32_t accessCount) {
+    IL::IdentifierMap& map = program.GetIdentifierMap();
+
+    IL::Function* fn = program.GetFunctionList().AllocFunction(map.AllocID());
+    IL::BasicBlock* bb = fn->GetBasicBlocks().AllocBlock(map.AllocID());
+
+    // Shared address
+    IL::ID address = map.AllocID();
+
+    for (uint32_t i = 0; i < accessCount; i++) {
+        if (i % 2 == 0) {
+            IL::LoadInstruction load{};
+            load.opCode = IL::OpCode::Load;
+            load.source = IL::Source::Code(i);
+            load.result = map.AllocID();
+            load.address = address;
+            bb->Append(load);
+        } else {
+            IL::StoreInstruction store{};
+            store.opCode = IL::OpCode::Store;
+            store.source = IL::Source::Code(i);
+            store.result = IL::InvalidID;
+            store.address = address;
+            store.value = address;
+            bb->Append(store);
+        }
+    }
+}
+
+/// Instrument all accesses the way features do, split into a resume block with a side block
+/// \param program program to instrument
+/// \param visits per access visitation counter
+static void InstrumentAccesses(IL::Program& program, std::vector<uint32_t>& visits) {
+    IL::VisitUserInstructions(program, [&](IL::VisitContext& context, IL::BasicBlock::Iterator it) -> IL::BasicBlock::Iterator {
+        if (it->opCode != IL::OpCode::Load && it->opCode != IL::OpCode::Store) {
+            return it;
+        }
+
+        visits[it->source.codeOffset]++;
+
+        // Allocate resume
+        IL::BasicBlock* resumeBlock = context.function.GetBasicBlocks().AllocBlock();
+
+        // Split this basic block, move all instructions post and including the instrumented instruction to resume
+        auto instr = context.basicBlock.Split(resumeBlock, it);
+
+        // Side block, never instrumented
+        IL::Emitter<> side(program, *context.function.GetBasicBlocks().AllocBlock());
+        side.AddBlockFlag(BasicBlockFlag::NoInstrumentation);
+        side.Branch(resumeBlock);
+
+        // Pre block branches to the side block
+        IL::Emitter<>(program, context.basicBlock).Branch(side.GetBasicBlock());
+
+        // Continue after the instrumented instruction
+        return instr;
+    });
+}
+
+TEST_CASE("Backend.IL.Visitor") {
+    constexpr uint32_t kAccessCount = 512;
+
+    Allocators allocators;
+    IL::Program program(allocators, 0x0);
+    CreateAccessProgram(program, kAccessCount);
+
+    std::vector<uint32_t> visits(kAccessCount, 0);
+    InstrumentAccesses(program, visits);
+
+    // Every access visited exactly once, including those migrated to resume blocks
+    for (uint32_t i = 0; i < kAccessCount; i++) {
+        REQUIRE(visits[i] == 1);
+    }
+
+    // Pre block, and a resume and side block per access
+    IL::Function* fn = *program.GetFunctionList().begin();
+    REQUIRE(fn->GetBasicBlocks().GetBlockCount() == 1 + kAccessCount * 2);
+
+    // Visitation state is cleaned up
+    for (IL::BasicBlock* basicBlock : fn->GetBasicBlocks()) {
+        REQUIRE(!(basicBlock->GetFlags() & BasicBlockFlag::Visited));
+    }
+}
@@ -80,6 +80,19 @@ public:
         connection.WriteAsync(data, size);
     }
 
+    /// Write async
+    /// \param data data to be sent, lifetime bound to the owner
+    /// \param size byte count of data
+    /// \param owner kept alive until the write has completed
+    void WriteAsync(const void *data, uint64_t size, const std::shared_ptr<const void>& owner) {
+        connection.WriteAsync(data, size, owner);
+    }
+
+    /// Get the write statistics
+    AsioWriteStats GetWriteStats() const {
+        return connection.GetWriteStats();
+    }
+
     /// Check if the client is open
     bool IsOpen() {
         return connection.IsOpen();
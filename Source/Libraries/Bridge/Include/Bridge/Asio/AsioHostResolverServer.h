@@ -146,6 +146,13 @@ protected:
             AsioHostResolverClientRequest::ResolveServerRequest serverRequest;
             serverRequest.clientToken = request->clientToken;
             serverRequest.owner = handler.GetGlobalUID();
+            serverRequest.transportFlags = request->transportFlags;
+
+            // Shared memory is only reachable from the same machine
+            if (!handler.IsLoopback()) {
+                serverRequest.transportFlags &= ~AsioTransportFlagSet(AsioTransportFlag::SharedMemory);
+            }
+
             tokenHandler->WriteAsync(&serverRequest, sizeof(serverRequest));
 
             // Handled!
@@ -35,6 +35,11 @@
 
 // Std
 #include <memory>
+#include <atomic>
+#include <functional>
+
+/// Invoked on shared memory requests, returns true if a segment was created for the owner
+using AsioSharedMemoryDelegate = std::function<bool(const GlobalUID& owner)>;
 
 /// Local server for remote client feedback, handled through the resolver
 struct AsioHostServer {
@@ -59,12 +64,57 @@ struct AsioHostServer {
     }
 
     /// Broadcast a message to all clients
-    void BroadcastServerAsync(const void *data, uint64_t size) {
+    /// \param data data to be sent, lifetime bound to this call
+    /// \param size byte count of data
+    /// \param mask transport features to compare
+    /// \param flags only write to clients with matching transport features after masking
+    void BroadcastServerAsync(const void *data, uint64_t size, AsioTransportFlagSet mask = {}, AsioTransportFlagSet flags = {}) {
+        if (!server) {
+            return;
+        }
+
+        server->WriteAsync(data, size, static_cast<uint32_t>(mask.value), static_cast<uint32_t>(flags.value));
+    }
+
+    /// Broadcast a message to all clients
+    /// \param data data to be sent, lifetime bound to the owner
+    /// \param size byte count of data
+    /// \param owner kept alive until all writes have completed
+    /// \param mask transport features to compare
+    /// \param flags only write to clients with matching transport features after masking
+    void BroadcastServerAsync(const void *data, uint64_t size, const std::shared_ptr<const void>& owner, AsioTransportFlagSet mask = {}, AsioTransportFlagSet flags = {}) {
         if (!server) {
             return;
         }
 
-        server->WriteAsync(data, size);
+        server->WriteAsync(data, size, owner, static_cast<uint32_t>(mask.value), static_cast<uint32_t>(flags.value));
+    }
+
+    /// Get the write statistics of the server
+    AsioWriteStats GetServerWriteStats() {
+        if (!server) {
+            return {};
+        }
+
+        return server->GetWriteStats();
+    }
+
+    /// Get the transport features enabled by any client
+    ///  ? Features are enabled per connection, see SetTransportFlags
+    AsioTransportFlagSet GetTransportFlags() {
+        if (!server) {
+            return {};
+        }
+
+        return AsioTransportFlagSet(server->GetUserFlags());
+    }
+
+    /// Enable transport features for a single client
+    ///  ? Clients announce the features accepted during resolution on their connection
+    /// \param handler the client connection
+    /// \param flags features to enable, must have been accepted
+    static void SetTransportFlags(AsioSocketHandler& handler, AsioTransportFlagSet flags) {
+        handler.SetUserFlags(static_cast<uint32_t>(flags.value));
     }
 
     /// Is the resolver still open?
@@ -100,6 +150,13 @@ struct AsioHostServer {
         }
     }
 
+    /// Set the shared memory delegate
+    ///  ? If not set, shared memory requests are declined
+    /// \param delegate the event delegate
+    void SetSharedMemoryCallback(const AsioSharedMemoryDelegate& delegate) {
+        onSharedMemory = delegate;
+    }
+
     /// Update the server info
     /// \param value host resolver info
     void UpdateInfo(const AsioHostClientInfo& value) {
@@ -190,6 +247,18 @@ protected:
         response.owner = request->owner;
         response.accepted = (server != nullptr);
         response.remotePort = server->GetPort();
+
+        // Accept all supported transport features
+        if (request->transportFlags & AsioTransportFlag::Compression) {
+            response.transportFlags |= AsioTransportFlag::Compression;
+        }
+
+        // Shared memory is per client, the segment must exist before the client is notified
+        if ((request->transportFlags & AsioTransportFlag::SharedMemory) && onSharedMemory && onSharedMemory(request->owner)) {
+            response.transportFlags |= AsioTransportFlag::SharedMemory;
+        }
+
+        // Features are only enabled for the connection once the client announces them on it
         handler.WriteAsync(&response, sizeof(response));
     }
 
@@ -223,6 +292,7 @@ private:
     /// Delegates
     AsioReadDelegate onRead;
     AsioErrorDelegate onError;
+    AsioSharedMemoryDelegate onSharedMemory;
 
     /// On demand server
     std::unique_ptr<AsioServer> server;
@@ -29,6 +29,7 @@
 // Common
 #include <Common/Align.h>
 #include <Common/GlobalUID.h>
+#include <Common/Enum.h>
 
 // Std
 #include <cstdint>
@@ -44,6 +45,20 @@ static constexpr const char* kAsioLocalhost = "127.0.0.1";
 /// Client tokens are managed with GUIDs
 using AsioHostClientToken = GlobalUID;
 
+/// Transport features, negotiated per client request
+enum class AsioTransportFlag : uint32_t {
+    None = 0,
+
+    /// Large streams may be compressed, see NetworkCompression.h
+    Compression = BIT(0),
+
+    /// Streams are exchanged over a shared memory segment, see SharedMemoryBridge.h
+    ///  ? Only granted by the resolver to clients on the same machine
+    SharedMemory = BIT(1),
+};
+
+BIT_SET(AsioTransportFlag);
+
 /// Header type
 enum class AsioHeaderType {
     None,
@@ -181,6 +196,9 @@ struct ALIGN_PACK AsioHostResolverClientRequest : public TAsioHeader<AsioHostRes
 
         /// Owning GUID
         GlobalUID owner;
+
+        /// Requested transport features
+        AsioTransportFlagSet transportFlags;
     };
 
     struct ServerResponse : public TAsioHeader<ServerResponse> {
@@ -194,10 +212,16 @@ struct ALIGN_PACK AsioHostResolverClientRequest : public TAsioHeader<AsioHostRes
 
         /// Requested port to open on address, only valid if accepted
         uint16_t remotePort{0};
+
+        /// Accepted transport features, only valid if accepted
+        AsioTransportFlagSet transportFlags;
     };
 
     /// Client requested
     AsioHostClientToken clientToken{};
+
+    /// Requested transport features
+    AsioTransportFlagSet transportFlags;
 };
 
 /// Remote server to host resolver discovery request
@@ -0,0 +1,126 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <algorithm>
+
+/// Growable receive buffer, data is consumed in place
+///  ? Consumption only advances the read head, the remaining partial data is compacted to the front
+///    when the free tail runs low, so each byte is moved at most once per compaction rather than per read
+class AsioReceiveBuffer {
+public:
+    /// Constructor
+    /// \param capacity initial byte capacity
+    AsioReceiveBuffer(uint64_t capacity) : capacity(capacity) {
+        data = std::make_unique<char[]>(capacity);
+    }
+
+    /// Reserve free space at the tail
+    /// \param minSize minimum number of free bytes
+    /// \return writable tail, see GetFreeSize
+    char* Reserve(uint64_t minSize) {
+        // Nothing to keep? Restart from the front
+        if (head == tail) {
+            head = 0;
+            tail = 0;
+        }
+
+        // Enough space?
+        if (capacity - tail >= minSize) {
+            return data.get() + tail;
+        }
+
+        // Compact the remaining data to the front
+        const uint64_t size = tail - head;
+        if (capacity - size >= minSize) {
+            std::memmove(data.get(), data.get() + head, size);
+        } else {
+            // Grow geometrically
+            uint64_t newCapacity = std::max(capacity * 2, size + minSize);
+
+            // Copy remaining data
+            auto newData = std::make_unique<char[]>(newCapacity);
+            std::memcpy(newData.get(), data.get() + head, size);
+
+            data = std::move(newData);
+            capacity = newCapacity;
+        }
+
+        head = 0;
+        tail = size;
+        return data.get() + tail;
+    }
+
+    /// Commit written bytes at the tail
+    /// \param size number of bytes written
+    void Commit(uint64_t size) {
+        tail += size;
+    }
+
+    /// Consume bytes at the head
+    /// \param size number of bytes consumed
+    void Consume(uint64_t size) {
+        head += size;
+    }
+
+    /// Get the readable data
+    const char* GetData() const {
+        return data.get() + head;
+    }
+
+    /// Get the number of readable bytes
+    uint64_t GetSize() const {
+        return tail - head;
+    }
+
+    /// Get the number of writable bytes at the tail
+    uint64_t GetFreeSize() const {
+        return capacity - tail;
+    }
+
+    /// Check if there's no readable data
+    bool IsEmpty() const {
+        return head == tail;
+    }
+
+private:
+    /// Buffer data
+    std::unique_ptr<char[]> data;
+
+    /// Byte capacity of the buffer
+    uint64_t capacity{0};
+
+    /// Read head
+    uint64_t head{0};
+
+    /// Write tail
+    uint64_t tail{0};
+};
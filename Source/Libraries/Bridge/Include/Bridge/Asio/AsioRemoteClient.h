@@ -40,6 +40,7 @@
 #include <vector>
 #include <mutex>
 #include <string>
+#include <atomic>
 
 /// Delegates
 using AsioRemoteServerDiscoveryDelegate = std::function<void(const AsioRemoteServerResolverDiscoveryRequest::Response& response)>;
@@ -122,12 +123,19 @@ struct AsioRemoteClient {
 
     /// Send an async client request
     /// \param token client token
-    void RequestClientAsync(const AsioHostClientToken& token) {
+    /// \param requestedTransportFlags transport features to request from the host
+    void RequestClientAsync(const AsioHostClientToken& token, AsioTransportFlagSet requestedTransportFlags = {}) {
         AsioHostResolverClientRequest request;
         request.clientToken = token;
+        request.transportFlags = requestedTransportFlags;
         resolveClient.WriteAsync(&request, sizeof(request));
     }
 
+    /// Get the negotiated transport features
+    AsioTransportFlagSet GetTransportFlags() const {
+        return AsioTransportFlagSet(transportFlags.load());
+    }
+
     /// Write to the connected client
     /// \param data data to be written
     /// \param size size of data
@@ -140,6 +148,28 @@ struct AsioRemoteClient {
         endpointClient->WriteAsync(data, size);
     }
 
+    /// Write to the connected client
+    /// \param data data to be written, lifetime bound to the owner
+    /// \param size size of data
+    /// \param owner kept alive until the write has completed
+    void WriteAsync(const void* data, size_t size, const std::shared_ptr<const void>& owner) {
+        if (!endpointClient) {
+            return;
+        }
+
+        // Send to endpoint
+        endpointClient->WriteAsync(data, size, owner);
+    }
+
+    /// Get the write statistics of the connected client
+    AsioWriteStats GetWriteStats() const {
+        if (!endpointClient) {
+            return {};
+        }
+
+        return endpointClient->GetWriteStats();
+    }
+
     /// Set the server wise read callback
     /// \param delegate the event delegate
     void SetServerReadCallback(const AsioReadDelegate& delegate) {
@@ -221,6 +251,13 @@ protected:
             return;
         }
 
+        // Shared memory sessions do not use the endpoint, the segment is opened by the subscriber
+        if (response->transportFlags & AsioTransportFlag::SharedMemory) {
+            transportFlags = response->transportFlags.value;
+            onConnected.Invoke(*response);
+            return;
+        }
+
         // Try to open the client
         ASSERT(!endpointClient, "Endpoint already opened");
         endpointClient = std::make_unique<AsioClient>(ipvxAddress.c_str(), response->remotePort);
@@ -231,6 +268,9 @@ protected:
             return;
         }
 
+        // Accepted transport features
+        transportFlags = response->transportFlags.value;
+
         // Set callbacks
         endpointClient->SetReadCallback(onRead);
         endpointClient->SetErrorCallback(onError);
@@ -257,6 +297,9 @@ private:
     /// Endpoint ip address
     std::string ipvxAddress;
 
+    /// Negotiated transport features
+    std::atomic<uint64_t> transportFlags{0};
+
     /// The endpoint client
     std::unique_ptr<AsioClient> endpointClient;
     AsioAsyncRunner<AsioClient> endpointClientRunner;
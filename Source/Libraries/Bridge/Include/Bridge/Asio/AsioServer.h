@@ -79,7 +79,9 @@ public:
     /// Write async
     /// \param data data to be sent, lifetime bound to this call
     /// \param size byte count of data
-    void WriteAsync(const void *data, uint64_t size) {
+    /// \param userFlagMask user flags to compare, see AsioSocketHandler::SetUserFlags
+    /// \param userFlags only write to handlers with matching user flags after masking
+    void WriteAsync(const void *data, uint64_t size, uint32_t userFlagMask = 0, uint32_t userFlags = 0) {
         std::lock_guard guard(mutex);
 
         // Prune beforehand
@@ -87,10 +89,60 @@ public:
 
         // Write to handlers
         for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
-            connection->WriteAsync(data, size);
+            if ((connection->GetUserFlags() & userFlagMask) == userFlags) {
+                connection->WriteAsync(data, size);
+            }
+        }
+    }
+
+    /// Write async
+    /// \param data data to be sent, lifetime bound to the owner
+    /// \param size byte count of data
+    /// \param owner kept alive until all writes have completed
+    /// \param userFlagMask user flags to compare, see AsioSocketHandler::SetUserFlags
+    /// \param userFlags only write to handlers with matching user flags after masking
+    void WriteAsync(const void *data, uint64_t size, const std::shared_ptr<const void>& owner, uint32_t userFlagMask = 0, uint32_t userFlags = 0) {
+        std::lock_guard guard(mutex);
+
+        // Prune beforehand
+        Prune();
+
+        // Write to handlers
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            if ((connection->GetUserFlags() & userFlagMask) == userFlags) {
+                connection->WriteAsync(data, size, owner);
+            }
         }
     }
 
+    /// Get the union of all user flags
+    uint32_t GetUserFlags() {
+        std::lock_guard guard(mutex);
+
+        // Accumulate live connections
+        uint32_t flags = 0;
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            flags |= connection->GetUserFlags();
+        }
+
+        return flags;
+    }
+
+    /// Get the write statistics, accumulated across all connections
+    AsioWriteStats GetWriteStats() {
+        std::lock_guard guard(mutex);
+
+        // Include all lost connections
+        AsioWriteStats stats = lostWriteStats;
+
+        // Accumulate live connections
+        for (const std::shared_ptr<AsioSocketHandler>& connection : connections) {
+            AccumulateWriteStats(stats, *connection);
+        }
+
+        return stats;
+    }
+
     /// Get a socket handler
     /// \param uuid the socket handler guid
     /// \return nullptr if not found
@@ -129,11 +181,26 @@ public:
 private:
     /// Prune all dead handlers
     void Prune() {
-        connections.erase(std::remove_if(connections.begin(), connections.end(), [](const std::shared_ptr<AsioSocketHandler>& handler) {
-            return !handler->IsOpen();
+        connections.erase(std::remove_if(connections.begin(), connections.end(), [this](const std::shared_ptr<AsioSocketHandler>& handler) {
+            if (handler->IsOpen()) {
+                return false;
+            }
+
+            // Keep the statistics around
+            AccumulateWriteStats(lostWriteStats, *handler);
+            return true;
         }), connections.end());
     }
 
+    /// Accumulate the write statistics of a handler
+    /// \param stats destination statistics
+    /// \param handler source handler
+    static void AccumulateWriteStats(AsioWriteStats& stats, const AsioSocketHandler& handler) {
+        AsioWriteStats handlerStats = handler.GetWriteStats();
+        stats.bytesWritten += handlerStats.bytesWritten;
+        stats.writeCount += handlerStats.writeCount;
+    }
+
     /// Accept an ingoing connection
     void Accept() {
         // Create connection
@@ -194,6 +261,7 @@ private:
         // Consider the socket lost
         if (it != connections.end()) {
             onClientLost.Invoke(handler);
+            AccumulateWriteStats(lostWriteStats, handler);
             connections.erase(it);
         }
 
@@ -211,6 +279,9 @@ private:
     /// All active connections
     std::vector<std::shared_ptr<AsioSocketHandler>> connections;
 
+    /// Write statistics of all lost connections
+    AsioWriteStats lostWriteStats;
+
     /// Read delegate
     AsioReadDelegate onRead;
     AsioErrorDelegate onError;
@@ -30,6 +30,7 @@
 #include "Asio.h"
 #include "AsioDelegates.h"
 #include "AsioConfig.h"
+#include "AsioReceiveBuffer.h"
 
 // Common
 #include <Common/Assert.h>
@@ -37,6 +38,10 @@
 
 // Std
 #include <functional>
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <atomic>
 
 // Forward declarations
 class AsioSocketHandler;
@@ -44,20 +49,36 @@ class AsioSocketHandler;
 /// Read delegate
 using AsioReadDelegate = std::function<uint64_t(AsioSocketHandler& handler, const void *data, uint64_t size)>;
 using AsioErrorDelegate = std::function<bool(AsioSocketHandler& handler, const std::error_code& code, uint32_t repeatCount)>;
+using AsioReadIntoDelegate = std::function<void()>;
+
+/// Socket write statistics
+struct AsioWriteStats {
+    /// Total number of bytes written to the socket
+    uint64_t bytesWritten{0};
+
+    /// Total number of write operations, each operation gathers all queued buffers
+    uint64_t writeCount{0};
+};
 
 /// Shared socket handler
 class AsioSocketHandler {
 public:
-    /// The streaming buffer size
+    /// The initial streaming buffer size
     static constexpr uint64_t kBufferSize = 1'000'000;
 
+    /// Minimum free space for a single read
+    static constexpr uint64_t kMinReadSize = 64'000;
+
+    /// Reads at or above this size should be read directly into their destination, see ReadInto
+    static constexpr uint64_t kDirectReadThreshold = 64'000;
+
+    /// Writes at or below this size are copied into the coalescing buffer instead of being referenced
+    static constexpr uint64_t kCoalesceThreshold = 4096;
+
     /// Create from ASIO service
     /// \param ioService service
-    AsioSocketHandler(asio::io_service &ioService) : socket(ioService) {
+    AsioSocketHandler(asio::io_service &ioService) : socket(ioService), receiveBuffer(kBufferSize) {
         uuid = GlobalUID::New();
-
-        // Create buffer
-        buffer = std::make_unique<char[]>(kBufferSize);
     }
 
     /// No copy or move
@@ -88,6 +109,18 @@ public:
         socket.close();
     }
 
+    /// Set the user flags of this handler
+    ///  ? Opaque to the handler, owned by the protocol on top
+    /// \param value flags to assign
+    void SetUserFlags(uint32_t value) {
+        userFlags = value;
+    }
+
+    /// Get the user flags of this handler
+    uint32_t GetUserFlags() const {
+        return userFlags.load();
+    }
+
     /// Write synchronous
     /// \param data data to be sent, lifetime bound to this call
     /// \param size byte count of data
@@ -100,37 +133,41 @@ public:
         }
     }
 
-    /// Write async
+    /// Write async, the data is copied into the write queue
     /// \param data data to be sent, lifetime bound to this call
     /// \param size byte count of data
     bool WriteAsync(const void *data, uint64_t size) {
-        try {
-#if ASIO_CONTENT_DEBUG
-            fprintf(stdout, "AsioSocketHandler : Writing [");
-            for (uint64_t i = 0; i < size; i++) {
-                uint8_t byte = static_cast<const uint8_t*>(data)[i];
-                fprintf(stdout, i == 0 ? "%i" : ", %i", static_cast<uint32_t>(byte));
-            }
-            fprintf(stdout, "]\n");
-            fflush(stdout);
-#endif 
+        return EnqueueWrite(data, size, nullptr);
+    }
 
-            socket.async_write_some(
-                asio::buffer(data, size),
-                [this](const std::error_code &error, size_t bytes) {
-                    OnWrite(error, bytes);
-                }
-            );
+    /// Write async, the data is referenced by the write queue
+    /// \param data data to be sent, lifetime bound to the owner
+    /// \param size byte count of data
+    /// \param owner kept alive until the write has completed
+    bool WriteAsync(const void *data, uint64_t size, const std::shared_ptr<const void>& owner) {
+        return EnqueueWrite(data, size, &owner);
+    }
 
-            return true;
-        } catch (asio::system_error e) {
-#if ASIO_DEBUG
-            fprintf(stderr, "AsioSocketHandler : %s\n", e.what());
-            fflush(stderr);
-#endif
+    /// Read a number of bytes directly into a destination, bypassing the streaming buffer
+    ///  ? May only be invoked from within the read callback, the bytes following the consumed range are
+    ///    written to the destination, after which the delegate is invoked and regular reads resume
+    /// \param data destination, lifetime must exceed the read
+    /// \param size number of bytes to read
+    /// \param delegate invoked once all bytes have been read
+    void ReadInto(void* data, uint64_t size, const AsioReadIntoDelegate& delegate) {
+        ASSERT(!directRead.data, "Direct read already pending");
+        directRead.data = static_cast<char*>(data);
+        directRead.size = size;
+        directRead.offset = 0;
+        directRead.delegate = delegate;
+    }
 
-            return false;
-        }
+    /// Get the write statistics
+    AsioWriteStats GetWriteStats() const {
+        return AsioWriteStats {
+            .bytesWritten = writeBytesCounter.load(std::memory_order_relaxed),
+            .writeCount = writeCounter.load(std::memory_order_relaxed)
+        };
     }
 
     /// Set the GUID
@@ -148,6 +185,13 @@ public:
         return uuid;
     }
 
+    /// Is the peer on the local machine?
+    bool IsLoopback() const {
+        asio::error_code error;
+        asio::ip::tcp::endpoint endpoint = socket.remote_endpoint(error);
+        return !error && endpoint.address().is_loopback();
+    }
+
     /// Get the socket
     asio::ip::tcp::socket &Socket() {
         return socket;
@@ -158,9 +202,12 @@ private:
     void Read() {
         ASSERT(socket.is_open(), "Socket lost");
 
+        // Read directly into the tail
+        char* tail = receiveBuffer.Reserve(kMinReadSize);
+
         try {
             socket.async_read_some(
-                asio::buffer(buffer.get(), kBufferSize),
+                asio::buffer(tail, receiveBuffer.GetFreeSize()),
                 [this](const std::error_code &error, size_t bytes) {
                     OnRead(error, bytes);
                 }
@@ -177,37 +224,255 @@ private:
             return;
         }
 
-        enqueuedBuffer.insert(enqueuedBuffer.end(), buffer.get(), buffer.get() + bytes);
+        // Mark as readable
+        receiveBuffer.Commit(bytes);
 
-        // Consume enqueued data
-        if (onRead) {
-            // Reduce removal until reads are done
-            uint64_t consumptionHead = 0;
+        // Consume all buffered data, resumes reading if possible
+        Consume();
+    }
 
-            // Consume all chunks possible
-            for (; !enqueuedBuffer.empty();) {
-                uint64_t consumed = onRead(*this, enqueuedBuffer.data() + consumptionHead, enqueuedBuffer.size() - consumptionHead);
-                if (!consumed) {
-                    break;
+    /// Consume all buffered data in place
+    void Consume() {
+        for (;;) {
+            // Pending direct read? Satisfy it from the buffered data first
+            if (directRead.data) {
+                const uint64_t count = std::min(receiveBuffer.GetSize(), directRead.size - directRead.offset);
+                std::memcpy(directRead.data + directRead.offset, receiveBuffer.GetData(), count);
+                receiveBuffer.Consume(count);
+                directRead.offset += count;
+
+                // Remaining bytes are read from the socket
+                if (directRead.offset < directRead.size) {
+                    ReadDirect();
+                    return;
                 }
 
-                // Next!
-                consumptionHead += consumed;
+                CompleteDirectRead();
+                continue;
             }
 
-            enqueuedBuffer.erase(enqueuedBuffer.begin(), enqueuedBuffer.begin() + consumptionHead);
+            // Nothing to consume?
+            if (!onRead || receiveBuffer.IsEmpty()) {
+                break;
+            }
+
+            // Consume a single chunk
+            uint64_t consumed = onRead(*this, receiveBuffer.GetData(), receiveBuffer.GetSize());
+            receiveBuffer.Consume(consumed);
+
+            // Closed by the consumer? Nothing left to read
+            if (!socket.is_open()) {
+                return;
+            }
+
+            // Stop if nothing was consumed, and no direct read was requested
+            if (!consumed && !directRead.data) {
+                break;
+            }
         }
 
         Read();
     }
 
+    /// Read the remaining bytes of the direct read
+    void ReadDirect() {
+        try {
+            asio::async_read(
+                socket,
+                asio::buffer(directRead.data + directRead.offset, directRead.size - directRead.offset),
+                [this](const std::error_code &error, size_t bytes) {
+                    if (!CheckError(error)) {
+                        return;
+                    }
+
+                    // Resume on partial reads
+                    directRead.offset += bytes;
+                    if (directRead.offset < directRead.size) {
+                        ReadDirect();
+                        return;
+                    }
+
+                    CompleteDirectRead();
+
+                    // Continue with the buffered data
+                    Consume();
+                }
+            );
+        } catch (asio::system_error) {
+        }
+    }
+
+    /// Complete the pending direct read
+    void CompleteDirectRead() {
+        AsioReadIntoDelegate delegate = std::move(directRead.delegate);
+        directRead = {};
+
+        // Invoke after reset, the delegate may not issue further reads
+        if (delegate) {
+            delegate();
+        }
+    }
+
+    /// Enqueue a write and flush if no write is in flight
+    /// \param data data to be sent
+    /// \param size byte count of data
+    /// \param owner optional owner, if null the data is copied
+    /// \return success state
+    bool EnqueueWrite(const void *data, uint64_t size, const std::shared_ptr<const void>* owner) {
+#if ASIO_CONTENT_DEBUG
+        fprintf(stdout, "AsioSocketHandler : Writing [");
+        for (uint64_t i = 0; i < size; i++) {
+            uint8_t byte = static_cast<const uint8_t*>(data)[i];
+            fprintf(stdout, i == 0 ? "%i" : ", %i", static_cast<uint32_t>(byte));
+        }
+        fprintf(stdout, "]\n");
+        fflush(stdout);
+#endif
+
+        if (!size) {
+            return true;
+        }
+
+        std::lock_guard guard(writeMutex);
+
+        // Small or unowned writes are coalesced into the staging buffer
+        if (!owner || size <= kCoalesceThreshold) {
+            const uint64_t offset = pendingBatch.staging.size();
+            pendingBatch.staging.insert(pendingBatch.staging.end(), static_cast<const char*>(data), static_cast<const char*>(data) + size);
+
+            // Extend the last chunk if it's adjacent in the staging buffer
+            if (!pendingBatch.chunks.empty() && !pendingBatch.chunks.back().data) {
+                pendingBatch.chunks.back().size += size;
+            } else {
+                pendingBatch.chunks.push_back(WriteChunk { .data = nullptr, .offset = offset, .size = size });
+            }
+        } else {
+            pendingBatch.chunks.push_back(WriteChunk { .data = data, .offset = 0, .size = size });
+            pendingBatch.owners.push_back(*owner);
+        }
+
+        // Start writing if idle
+        if (!isWriting) {
+            return Flush();
+        }
+
+        // OK
+        return true;
+    }
+
+    /// Flush all pending writes, write lock must be held
+    /// \return success state
+    bool Flush() {
+        if (pendingBatch.chunks.empty()) {
+            return true;
+        }
+
+        // Pending batch is now in flight, keeps the previous allocations around
+        std::swap(inflightBatch, pendingBatch);
+
+        // Gather all buffers
+        inflightBuffers.clear();
+        for (const WriteChunk& chunk : inflightBatch.chunks) {
+            if (chunk.data) {
+                inflightBuffers.push_back(asio::buffer(chunk.data, chunk.size));
+            } else {
+                inflightBuffers.push_back(asio::buffer(inflightBatch.staging.data() + chunk.offset, chunk.size));
+            }
+        }
+
+        // Write the batch
+        isWriting = true;
+        return WriteSome();
+    }
+
+    /// Write the remaining in flight buffers, write lock must be held
+    /// \return success state
+    bool WriteSome() {
+        try {
+            socket.async_write_some(
+                inflightBuffers,
+                [this](const std::error_code &error, size_t bytes) {
+                    OnWrite(error, bytes);
+                }
+            );
+
+            return true;
+        } catch (asio::system_error e) {
+#if ASIO_DEBUG
+            fprintf(stderr, "AsioSocketHandler : %s\n", e.what());
+            fflush(stderr);
+#endif
+
+            // Drop the batch
+            ReleaseInflight();
+            return false;
+        }
+    }
+
+    /// Release the in flight batch, write lock must be held
+    void ReleaseInflight() {
+        inflightBatch.chunks.clear();
+        inflightBatch.staging.clear();
+        inflightBatch.owners.clear();
+        inflightBuffers.clear();
+        isWriting = false;
+    }
+
     /// Async write callback
     /// \param error error code
     /// \param bytes number of bytes written
     void OnWrite(const std::error_code &error, size_t bytes) {
-        if (!CheckError(error)) {
+        if (!CheckWriteError(error)) {
             return;
         }
+
+        std::lock_guard guard(writeMutex);
+
+        // Failed batches are already released
+        if (!isWriting) {
+            Flush();
+            return;
+        }
+
+        writeBytesCounter.fetch_add(bytes, std::memory_order_relaxed);
+        writeCounter.fetch_add(1, std::memory_order_relaxed);
+
+        // Skip all completed buffers
+        auto it = inflightBuffers.begin();
+        for (; it != inflightBuffers.end() && bytes >= it->size(); it++) {
+            bytes -= it->size();
+        }
+
+        inflightBuffers.erase(inflightBuffers.begin(), it);
+
+        // Partial write? Resume from the first incomplete buffer
+        if (!inflightBuffers.empty()) {
+            inflightBuffers.front() += bytes;
+            WriteSome();
+            return;
+        }
+
+        // Entire batch written, continue with anything enqueued in the meantime
+        ReleaseInflight();
+        Flush();
+    }
+
+    /// Check a write error, drops the in flight batch on failure
+    /// \param code error code
+    /// \return false if writing should stop
+    bool CheckWriteError(const std::error_code& code) {
+        if (!code) {
+            return CheckError(code);
+        }
+
+        // Drop the failed batch
+        {
+            std::lock_guard guard(writeMutex);
+            ReleaseInflight();
+        }
+
+        // Error handlers may acquire external locks, never invoke them under the write lock
+        return CheckError(code);
     }
 
     bool CheckError(const std::error_code& code) {
@@ -242,9 +507,66 @@ private:
     /// Numbers of successive errors
     uint32_t errorRepeatCount{0};
 
-    /// Current enqueued data
-    std::vector<char> enqueuedBuffer;
+    /// Opaque user flags
+    std::atomic<uint32_t> userFlags{0};
+
+    /// Streaming buffer, consumed in place
+    AsioReceiveBuffer receiveBuffer;
+
+    /// Pending direct read, see ReadInto
+    struct DirectRead {
+        /// Destination
+        char* data{nullptr};
+
+        /// Total and read number of bytes
+        uint64_t size{0};
+        uint64_t offset{0};
+
+        /// Completion delegate
+        AsioReadIntoDelegate delegate;
+    } directRead;
+
+private:
+    /// A single queued write
+    struct WriteChunk {
+        /// Referenced data, if null, the chunk lives in the staging buffer
+        const void* data{nullptr};
+
+        /// Offset into the staging buffer
+        uint64_t offset{0};
+
+        /// Byte count of the chunk
+        uint64_t size{0};
+    };
+
+    /// A batch of queued writes, written as a single gather
+    struct WriteBatch {
+        /// All chunks, in submission order
+        std::vector<WriteChunk> chunks;
+
+        /// Coalesced copies of small writes
+        std::vector<char> staging;
+
+        /// Owners of all referenced chunks
+        std::vector<std::shared_ptr<const void>> owners;
+    };
+
+    /// Shared write lock
+    std::mutex writeMutex;
+
+    /// Batch accumulating writes while another is in flight
+    WriteBatch pendingBatch;
+
+    /// Batch currently being written
+    WriteBatch inflightBatch;
+
+    /// Remaining gather buffers of the in flight batch
+    std::vector<asio::const_buffer> inflightBuffers;
+
+    /// Is a batch in flight?
+    bool isWriting{false};
 
-    /// Streaming buffer
-    std::unique_ptr<char[]> buffer;
+    /// Write statistics
+    std::atomic<uint64_t> writeBytesCounter{0};
+    std::atomic<uint64_t> writeCounter{0};
 };
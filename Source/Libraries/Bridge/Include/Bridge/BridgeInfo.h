@@ -35,4 +35,15 @@ struct BridgeInfo {
 
     /// Total number of bytes read
     uint64_t bytesRead{0};
+
+    /// Total number of bytes written to sockets, across all connections
+    uint64_t socketBytesWritten{0};
+
+    /// Total number of socket write operations, across all connections
+    uint64_t socketWriteCount{0};
+
+    /// Get the average number of bytes per socket write operation
+    double GetBytesPerSocketWrite() const {
+        return socketWriteCount ? static_cast<double>(socketBytesWritten) / socketWriteCount : 0.0;
+    }
 };
@@ -33,10 +33,15 @@
 // Std
 #include <thread>
 #include <atomic>
+#include <mutex>
+#include <memory>
 #include <condition_variable>
 
 // Forward declarations
 struct AsioHostServer;
+struct MessageStreamHeaderProtocol;
+class AsioSocketHandler;
+class SharedMemoryBridge;
 
 /// Network Bridge
 class HostServerBridge final : public IBridge {
@@ -51,6 +56,10 @@ public:
     /// \param config given configuration
     void UpdateDeviceConfig(const EndpointDeviceConfig& config);
 
+    /// Set the dispatcher for parallel listener dispatch
+    /// \param value dispatcher, null for serial dispatch
+    void SetDispatcher(const ComRef<Dispatcher>& value);
+
     /// Overrides
     void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
     void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
@@ -63,15 +72,44 @@ public:
 
 private:
     /// Async read callback
+    /// \param handler the reading socket handler
     /// \param data the enqueued data
     /// \param size the enqueued size
     /// \return number of consumed bytes
-    uint64_t OnReadAsync(const void* data, uint64_t size);
+    uint64_t OnReadAsync(AsioSocketHandler& handler, const void* data, uint64_t size);
+
+    /// Write a stream to all matching clients
+    /// \param protocol stream header, copied
+    /// \param stream stream to write, pages are referenced
+    /// \param owner keeps the stream alive until all writes have completed
+    /// \param mask transport features to compare
+    /// \param flags only write to clients with matching transport features after masking
+    void WriteStream(const MessageStreamHeaderProtocol& protocol, const MessageStream& stream, const std::shared_ptr<const void>& owner, AsioTransportFlagSet mask, AsioTransportFlagSet flags);
+
+    /// Invoked on fully received streams
+    /// \param stream received stream, ownership is transferred
+    void OnStreamReceived(MessageStream& stream);
+
+    /// Invoked on shared memory requests from local clients
+    /// \param owner requesting client
+    /// \return true if the session was created
+    bool OnSharedMemoryRequest(const GlobalUID& owner);
+
+    /// Write streams to all shared memory sessions, closed sessions are released
+    ///  ? Never waits on the sessions, writes are handed over to their writers
+    /// \param streams all streams to write, lifetime bound to the owner
+    /// \param count number of streams
+    /// \param owner kept alive until all sessions have written the streams
+    void WriteSharedMemorySessions(const MessageStream* streams, uint32_t count, const std::shared_ptr<const void>& owner);
 
 private:
     /// Current endpoint
     AsioHostServer* server{nullptr};
 
+    /// Shared memory sessions of local clients, created on the resolver thread
+    std::mutex sharedMemoryMutex;
+    std::vector<std::unique_ptr<SharedMemoryBridge>> sharedMemorySessions;
+
     /// Local storage
     OrderedMessageStorage storage;
 
@@ -86,4 +124,7 @@ private:
 
     /// Cache for commits
     std::vector<MessageStream> streamCache;
+
+    /// Intermediate stream for compression
+    MessageStream compressionScratch;
 };
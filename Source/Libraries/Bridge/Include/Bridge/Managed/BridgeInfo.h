@@ -36,5 +36,11 @@ namespace Bridge::CLR {
 
         /// Total number of bytes read
         UInt64 bytesRead{0};
+
+        /// Total number of bytes written to sockets, across all connections
+        UInt64 socketBytesWritten{0};
+
+        /// Total number of socket write operations, across all connections
+        UInt64 socketWriteCount{0};
     };
 }
@@ -48,9 +48,15 @@ namespace Bridge::CLR {
             for (uint32_t i = 0; i < count; i++) {
                 const ::MessageStream& stream = streams[i];
 
+                // Managed streams are contiguous, coalesce paged streams
+                ::MessageStream linear;
+                if (!stream.IsContiguous()) {
+                    linear = stream;
+                }
+
                 // Create clr object
                 auto clrStream = gcnew Message::CLR::ReadOnlyMessageStream;
-                clrStream->Ptr = const_cast<uint8_t*>(stream.GetDataBegin());
+                clrStream->Ptr = const_cast<uint8_t*>(stream.IsContiguous() ? stream.GetDataBegin() : linear.GetDataBegin());
                 clrStream->Size = stream.GetByteSize();
                 clrStream->Count = stream.GetCount();
                 clrStream->VersionID = stream.GetVersionID();
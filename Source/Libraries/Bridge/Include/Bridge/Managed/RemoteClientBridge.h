@@ -85,6 +85,9 @@ namespace Bridge::CLR {
         /// Enables auto commits on remote appends
         void SetCommitOnAppend(bool enabled);
 
+        /// Request stream compression on client requests, negotiated with the host
+        void SetCompression(bool enabled);
+
     private:
         /// Intermediate entry
         ref struct InteropEntry {
@@ -34,10 +34,25 @@
 
 // Common
 #include <Common/Dispatcher/Mutex.h>
+#include <Common/ComRef.h>
+
+// Std
+#include <vector>
+#include <map>
+
+// Forward declarations
+class Dispatcher;
+struct DispatcherBucket;
 
 /// In memory bridge
 class MemoryBridge : public IBridge {
 public:
+    /// Set the dispatcher for parallel listener dispatch
+    ///  ? Listeners may then be invoked concurrently with other listeners, a single listener is never invoked concurrently
+    ///  ? Ordered listeners are always invoked serially on the committing thread
+    /// \param value dispatcher, null for serial dispatch
+    void SetDispatcher(const ComRef<Dispatcher>& value);
+
     /// Overrides
     void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
     void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
@@ -55,6 +70,46 @@ private:
     /// Caches
     std::vector<MessageStream> storageConsumeCache;
 
+private:
+    /// Contiguous range of consumed streams
+    struct StreamRange {
+        uint32_t offset{0};
+        uint32_t count{0};
+    };
+
+    /// All ranges destined for a single listener
+    struct ListenerBatch {
+        /// Bridge for the job
+        MemoryBridge* bridge{nullptr};
+
+        /// Target listener
+        IBridgeListener* listener{nullptr};
+
+        /// All stream ranges, in order
+        std::vector<StreamRange> ranges;
+    };
+
+    /// Dispatch a run of unordered streams to their listeners
+    ///  ? Streams within the run are bucketed by schema
+    /// \param runOffset first stream of the run
+    /// \param runEnd end of the run, exclusive
+    void DispatchRun(uint32_t runOffset, uint32_t runEnd);
+
+    /// Invoke a listener for all of its ranges
+    void HandleBatch(void* data);
+
+    /// Invoked on parallel dispatch completion
+    void OnBatchesCompleted(void* data);
+
+    /// Listener batches, reused between commits
+    std::vector<ListenerBatch> listenerBatches;
+
+    /// Number of used listener batches
+    uint32_t listenerBatchCount{0};
+
+    /// Optional, parallel dispatcher
+    ComRef<Dispatcher> dispatcher;
+
 private:
     struct MessageBucket {
         /// All listeners for this message type
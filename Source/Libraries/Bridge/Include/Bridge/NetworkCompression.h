@@ -0,0 +1,49 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <cstdint>
+
+// Forward declarations
+struct MessageStream;
+
+/// Streams below this byte size are never compressed
+static constexpr uint64_t kNetworkCompressionThreshold = 4096;
+
+/// Compress the payload of a stream
+/// \param stream stream to compress, on success the payload is replaced by the compressed payload
+/// \param scratch intermediate stream, contents are discarded
+/// \return false if compression was not beneficial, the stream is then left untouched
+bool CompressMessageStreamPayload(MessageStream& stream, MessageStream& scratch);
+
+/// Decompress a compressed payload
+/// \param data compressed payload, see MessageStreamCompressedProtocol
+/// \param size byte size of the compressed payload
+/// \param stream destination stream, the payload is replaced
+/// \return success state
+bool DecompressMessageStreamPayload(const void* data, uint64_t size, MessageStream& stream);
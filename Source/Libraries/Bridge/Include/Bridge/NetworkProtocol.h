@@ -28,9 +28,19 @@
 
 #include <Message/MessageStream.h>
 
+// Common
+#include <Common/Enum.h>
+
 struct MessageStreamHeaderProtocol {
     static constexpr uint64_t kMagic = 'GRSS';
 
+    /// The payload is compressed, see NetworkCompression.h
+    static constexpr uint32_t kFlagCompressed = BIT(0);
+
+    /// Transport announcement, sent once by clients on connection
+    ///  ? No payload follows, the version holds the transport features accepted during resolution
+    static constexpr uint32_t kFlagTransport = BIT(1);
+
     /// Magic header for validation
     uint64_t magic = kMagic;
 
@@ -39,10 +49,18 @@ struct MessageStreamHeaderProtocol {
 
     /// Version of the stream
     uint32_t versionID;
-    uint32_t : 32;
+
+    /// Payload flags
+    uint32_t flags{0};
 
     /// Size of the succeeding stream
     uint64_t size{};
 };
 
 static_assert(sizeof(MessageStreamHeaderProtocol) == 32, "Unexpected message stream protocol size");
+
+/// Prefix of compressed payloads
+struct MessageStreamCompressedProtocol {
+    /// Size of the decompressed payload
+    uint64_t decompressedSize{};
+};
@@ -35,9 +35,12 @@
 // Std
 #include <thread>
 #include <atomic>
+#include <memory>
 
 // Forward declarations
 struct AsioRemoteClient;
+class AsioSocketHandler;
+class SharedMemoryBridge;
 
 /// Network Bridge
 class RemoteClientBridge final : public IBridge {
@@ -86,6 +89,17 @@ public:
         commitOnAppend = enabled;
     }
 
+    /// Set the transport features requested on client requests
+    ///  ? Features are negotiated with the host, see GetTransportFlags for the accepted set
+    ///  ? Shared memory is only granted if the resolver is reached through loopback
+    /// \param flags requested features
+    void SetRequestedTransportFlags(AsioTransportFlagSet flags) {
+        requestedTransportFlags = flags;
+    }
+
+    /// Get the negotiated transport features
+    AsioTransportFlagSet GetTransportFlags() const;
+
 private:
     /// Invoked on client connections
     /// \param response
@@ -100,15 +114,23 @@ private:
     void OnDiscovery(const AsioRemoteServerResolverDiscoveryRequest::Response& response);
 
     /// Async read callback
+    /// \param handler the reading socket handler
     /// \param data the enqueued data
     /// \param size the enqueued size
     /// \return number of consumed bytes
-    uint64_t OnReadAsync(const void* data, uint64_t size);
+    uint64_t OnReadAsync(AsioSocketHandler& handler, const void* data, uint64_t size);
+
+    /// Invoked on fully received streams
+    /// \param stream received stream, ownership is transferred
+    void OnStreamReceived(MessageStream& stream);
 
 private:
     /// Current endpoint
     AsioRemoteClient* client{nullptr};
 
+    /// Shared memory session, replaces the endpoint for local hosts
+    std::unique_ptr<SharedMemoryBridge> sharedMemory;
+
     /// Local storage
     OrderedMessageStorage storage;
 
@@ -121,6 +143,12 @@ private:
     /// Commit when streams are added
     bool commitOnAppend = false;
 
+    /// Transport features to request
+    AsioTransportFlagSet requestedTransportFlags;
+
     /// Cache for commits
     std::vector<MessageStream> streamCache;
+
+    /// Intermediate stream for compression
+    MessageStream compressionScratch;
 };
@@ -0,0 +1,167 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <atomic>
+#include <string>
+#include <cstdint>
+
+/// Shared ring state, lives in shared memory ahead of the ring data
+///  ? Producer and consumer words are kept on separate cache lines
+struct SharedMemoryRingHeader {
+    /// Published producer position, monotonic byte count
+    alignas(64) std::atomic<uint64_t> tail;
+
+    /// Data sequence, incremented on every publish
+    std::atomic<uint32_t> dataSequence;
+
+    /// Is the consumer waiting on the data sequence?
+    std::atomic<uint32_t> consumerWaiting;
+
+    /// Consumed position, monotonic byte count
+    alignas(64) std::atomic<uint64_t> head;
+
+    /// Space sequence, incremented on every consumption
+    std::atomic<uint32_t> spaceSequence;
+
+    /// Is the producer waiting on the space sequence?
+    std::atomic<uint32_t> producerWaiting;
+
+    /// Consumer liveness, incremented on every consumer wait
+    alignas(64) std::atomic<uint32_t> consumerHeartbeat;
+
+    /// Set if either side has closed the ring
+    std::atomic<uint32_t> closed;
+};
+
+/// Cross process atomics must not rely on process local locks
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "Shared memory rings require lock free 64 bit atomics");
+
+/// Process shared wait primitive over a shared sequence word
+class SharedMemorySignal {
+public:
+    /// Destructor
+    ~SharedMemorySignal();
+
+    /// Install this signal
+    /// \param name system wide name, used where the platform requires named objects
+    /// \param word shared sequence word
+    /// \return success state
+    bool Install(const std::string& name, std::atomic<uint32_t>* word);
+
+    /// Wait until the sequence word no longer matches
+    ///  ? May return spuriously
+    /// \param expected the last observed sequence
+    /// \param timeoutMS maximum number of milliseconds to wait
+    void Wait(uint32_t expected, uint32_t timeoutMS);
+
+    /// Wake all waiters
+    void Wake();
+
+private:
+    /// Shared sequence word
+    std::atomic<uint32_t>* word{nullptr};
+
+#ifdef _WIN64
+    /// Named auto reset event
+    void* event{nullptr};
+#endif // _WIN64
+};
+
+/// Single producer, single consumer byte ring in shared memory
+///  ? Writes block while the ring is full, the consumer heartbeat guards against stalled peers
+class SharedMemoryRing {
+public:
+    /// Number of milliseconds the consumer may stall before the producer gives up
+    static constexpr uint32_t kPeerTimeoutMS = 5000;
+
+    /// Install this ring
+    /// \param name system wide name of the ring, used for signals
+    /// \param header shared header, zero initialized by the creator
+    /// \param data shared ring data
+    /// \param capacity byte capacity of the ring data
+    /// \return success state
+    bool Install(const std::string& name, SharedMemoryRingHeader* header, uint8_t* data, uint64_t capacity);
+
+    /// Write data, not visible to the consumer until published
+    ///  ? Blocks while the ring is full, partially full rings are published before waiting
+    /// \param data data to be written
+    /// \param size byte count of data
+    /// \return false if the ring was closed or the consumer stalled
+    bool Write(const void* data, uint64_t size);
+
+    /// Publish all written data to the consumer
+    void Publish();
+
+    /// Read data
+    /// \param data destination data
+    /// \param size maximum byte count to read
+    /// \return number of bytes read
+    uint64_t Read(void* data, uint64_t size);
+
+    /// Get the number of readable bytes
+    uint64_t GetReadable() const;
+
+    /// Wait for readable data, consumer only
+    /// \param timeoutMS maximum number of milliseconds to wait
+    /// \return true if data is readable
+    bool WaitForData(uint32_t timeoutMS);
+
+    /// Close the ring, wakes all waiters
+    void Close();
+
+    /// Has either side closed the ring?
+    bool IsClosed() const;
+
+    /// Get the ring capacity
+    uint64_t GetCapacity() const {
+        return capacity;
+    }
+
+private:
+    /// Wait for free space, producer only
+    /// \return false if the ring was closed or the consumer stalled
+    bool WaitForSpace();
+
+private:
+    /// Shared state
+    SharedMemoryRingHeader* header{nullptr};
+
+    /// Shared ring data
+    uint8_t* data{nullptr};
+
+    /// Byte capacity of the ring
+    uint64_t capacity{0};
+
+    /// Local producer position, published on demand
+    uint64_t localTail{0};
+
+    /// Signals
+    SharedMemorySignal dataSignal;
+    SharedMemorySignal spaceSignal;
+};
@@ -0,0 +1,93 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <string>
+#include <cstdint>
+
+/// Named, process shared memory segment
+class SharedMemorySegment {
+public:
+    /// Constructor
+    SharedMemorySegment() = default;
+
+    /// Destructor
+    ~SharedMemorySegment();
+
+    /// No copy
+    SharedMemorySegment(const SharedMemorySegment&) = delete;
+    SharedMemorySegment& operator=(const SharedMemorySegment&) = delete;
+
+    /// Create a new segment, the contents are zero initialized
+    ///  ? The creator owns the name, released on destruction
+    /// \param name system wide name of the segment
+    /// \param size byte size of the segment
+    /// \return success state
+    bool Create(const std::string& name, uint64_t size);
+
+    /// Open an existing segment
+    /// \param name system wide name of the segment
+    /// \return success state
+    bool Open(const std::string& name);
+
+    /// Release the segment mapping
+    void Release();
+
+    /// Get the mapped data
+    uint8_t* GetData() const {
+        return data;
+    }
+
+    /// Get the mapped byte size
+    uint64_t GetSize() const {
+        return size;
+    }
+
+    /// Is this segment mapped?
+    bool IsMapped() const {
+        return data != nullptr;
+    }
+
+private:
+    /// Mapped view
+    uint8_t* data{nullptr};
+
+    /// Mapped byte size
+    uint64_t size{0};
+
+#ifdef _WIN64
+    /// Mapping handle
+    void* handle{nullptr};
+#else // _WIN64
+    /// Mapping descriptor
+    int fd{-1};
+
+    /// Name to unlink on release, owner only
+    std::string ownedName;
+#endif // _WIN64
+};
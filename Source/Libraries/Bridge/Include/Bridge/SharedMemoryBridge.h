@@ -0,0 +1,202 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Bridge
+#include "MemoryBridge.h"
+#include "NetworkProtocol.h"
+#include "SharedMemory/SharedMemorySegment.h"
+#include "SharedMemory/SharedMemoryRing.h"
+
+// Common
+#include <Common/GlobalUID.h>
+
+// Std
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+/// Delegates
+using SharedMemoryStreamDelegate = std::function<void(MessageStream& stream)>;
+
+/// Shared memory bridge, for hosts and frontends on the same machine
+///  ? Streams are exchanged over two single producer, single consumer rings, one per direction
+///  ? Streams exceeding the ring capacity are streamed through the ring
+///  ? Committed streams are written by a dedicated writer, committing never waits on the peer
+class SharedMemoryBridge final : public IBridge {
+public:
+    /// Default byte capacity of each ring
+    static constexpr uint64_t kDefaultRingSize = 16ull << 20;
+
+    /// Maximum number of bytes pending on the writer, the bridge is closed if the peer falls further behind
+    static constexpr uint64_t kMaxPendingWriteSize = 64ull << 20;
+
+    /// Destructor
+    ~SharedMemoryBridge();
+
+    /// Create a new segment, host side
+    /// \param name system wide name of the segment
+    /// \param ringSize byte capacity of each ring
+    /// \return success state
+    bool Create(const std::string& name, uint64_t ringSize = kDefaultRingSize);
+
+    /// Open an existing segment, frontend side
+    /// \param name system wide name of the segment
+    /// \return success state
+    bool Open(const std::string& name);
+
+    /// Stop the bridge, closes both rings
+    void Stop();
+
+    /// Is this bridge open?
+    ///  ? Closed if either side stopped, or if the peer stalled
+    bool IsOpen() const;
+
+    /// Set the received stream delegate, invoked on the reader thread
+    ///  ? If set, received streams are not added to the bridge input
+    ///  ? Must be set before creation or opening
+    /// \param delegate delegate, stream ownership is transferred
+    void SetStreamDelegate(const SharedMemoryStreamDelegate& delegate) {
+        streamDelegate = delegate;
+    }
+
+    /// Write streams to the peer, bypassing the output storage
+    ///  ? Blocks while the outbound ring is full
+    /// \param streams all streams to write
+    /// \param count number of streams
+    /// \return false if the bridge is no longer open
+    bool WriteStreams(const MessageStream* streams, uint32_t count);
+
+    /// Write streams to the peer on the writer thread, bypassing the output storage
+    ///  ? Never blocks, if the peer falls behind by more than kMaxPendingWriteSize the bridge is closed
+    /// \param streams all streams to write, lifetime bound to the owner
+    /// \param count number of streams
+    /// \param owner kept alive until all streams have been written
+    /// \return false if the bridge is no longer open
+    bool WriteStreamsAsync(const MessageStream* streams, uint32_t count, const std::shared_ptr<const void>& owner);
+
+    /// Get the segment name for a host token
+    /// \param token host token
+    /// \return segment name
+    static std::string GetSegmentName(const GlobalUID& token);
+
+    /// Overrides
+    void Register(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) override;
+    void Register(const ComRef<IBridgeListener>& listener) override;
+    void Deregister(const ComRef<IBridgeListener>& listener) override;
+    IMessageStorage *GetInput() override;
+    IMessageStorage *GetOutput() override;
+    BridgeInfo GetInfo() override;
+    void Commit() override;
+
+private:
+    /// Install the rings and start the reader
+    /// \param name system wide name of the segment
+    /// \param isHost host or frontend side
+    /// \return success state
+    bool Install(const std::string& name, bool isHost);
+
+    /// Reader thread entry
+    void ReaderThreadEntry();
+
+    /// Writer thread entry
+    void WriterThreadEntry();
+
+    /// Read the next stream from the inbound ring
+    /// \return false if the stream is incomplete
+    bool ReadStream();
+
+private:
+    /// Shared segment
+    SharedMemorySegment segment;
+
+    /// Rings, relative to this side
+    SharedMemoryRing outbound;
+    SharedMemoryRing inbound;
+
+    /// Reader thread
+    std::thread readerThread;
+
+    /// Reader exit flag
+    std::atomic<bool> readerExit{false};
+
+    /// Pending asynchronous write
+    struct PendingWrite {
+        /// Streams to write
+        const MessageStream* streams{nullptr};
+        uint32_t count{0};
+
+        /// Total byte size, including headers
+        uint64_t size{0};
+
+        /// Keeps the streams alive
+        std::shared_ptr<const void> owner;
+    };
+
+    /// Writer thread
+    std::thread writerThread;
+
+    /// Writer state, all guarded by the writer mutex
+    std::mutex writerMutex;
+    std::condition_variable writerCondition;
+    std::deque<PendingWrite> pendingWrites;
+    uint64_t pendingWriteSize{0};
+    bool writerExit{false};
+
+    /// Has the segment been installed?
+    std::atomic<bool> installed{false};
+
+    /// Received stream delegate
+    SharedMemoryStreamDelegate streamDelegate;
+
+    /// Partially received header
+    MessageStreamHeaderProtocol pendingHeader;
+    uint64_t pendingHeaderSize{0};
+
+    /// Partially received stream
+    MessageStream pendingStream;
+    uint8_t* pendingPayload{nullptr};
+    uint64_t pendingPayloadSize{0};
+
+    /// Local storage
+    OrderedMessageStorage storage;
+
+    /// Piggybacked memory bridge
+    MemoryBridge memoryBridge;
+
+    /// Tracking, written from the committing and reader threads
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> bytesRead{0};
+
+    /// Cache for commits
+    std::vector<MessageStream> streamCache;
+};
@@ -28,6 +28,8 @@
 #include <Bridge/IBridgeListener.h>
 #include <Bridge/EndpointConfig.h>
 #include <Bridge/NetworkProtocol.h>
+#include <Bridge/NetworkCompression.h>
+#include <Bridge/SharedMemoryBridge.h>
 #include <Bridge/Asio/AsioHostServer.h>
 
 // Common
@@ -36,6 +38,9 @@
 // Message
 #include <Message/MessageStream.h>
 
+// Std
+#include <cstdio>
+
 bool HostServerBridge::Install(const EndpointConfig &config) {
     // Port config
     AsioConfig asioConfig;
@@ -59,7 +64,12 @@ bool HostServerBridge::Install(const EndpointConfig &config) {
 
     // Set read callback
     server->SetServerReadCallback([this](AsioSocketHandler& handler, const void *data, uint64_t size) {
-        return OnReadAsync(data, size);
+        return OnReadAsync(handler, data, size);
+    });
+
+    // Local clients may bypass the socket entirely
+    server->SetSharedMemoryCallback([this](const GlobalUID& owner) {
+        return OnSharedMemoryRequest(owner);
     });
 
     // OK
@@ -80,34 +90,133 @@ void HostServerBridge::UpdateDeviceConfig(const EndpointDeviceConfig& config) {
 HostServerBridge::~HostServerBridge() {
     // Release endpoint
     destroy(server, allocators);
+
+    // Release all sessions, the endpoint no longer creates new ones
+    sharedMemorySessions.clear();
 }
 
-uint64_t HostServerBridge::OnReadAsync(const void *data, uint64_t size) {
+uint64_t HostServerBridge::OnReadAsync(AsioSocketHandler& handler, const void *data, uint64_t size) {
     auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
 
-    // Entire stream present?
-    if (size < sizeof(MessageStreamHeaderProtocol) ||
-        size < sizeof(MessageStreamHeaderProtocol) + protocol->size) {
+    // Header present?
+    if (size < sizeof(MessageStreamHeaderProtocol)) {
         return 0;
     }
 
     // Validate header
     ASSERT(protocol->magic == MessageStreamHeaderProtocol::kMagic, "Unexpected magic header");
 
+    // Transport announcement? Only features the host may send are enabled
+    if (protocol->flags & MessageStreamHeaderProtocol::kFlagTransport) {
+        AsioTransportFlagSet flags(protocol->versionID);
+        flags &= AsioTransportFlagSet(AsioTransportFlag::Compression);
+        AsioHostServer::SetTransportFlags(handler, flags);
+        return sizeof(MessageStreamHeaderProtocol);
+    }
+
+    // Determine byte count
+    const size_t bytes = sizeof(MessageStreamHeaderProtocol) + protocol->size;
+
+    // Compressed streams are decompressed from the buffer
+    const bool isCompressed = protocol->flags & MessageStreamHeaderProtocol::kFlagCompressed;
+
+    // Large streams are read directly into the stream, avoiding the intermediate buffering
+    if (!isCompressed && protocol->size >= AsioSocketHandler::kDirectReadThreshold) {
+        auto stream = std::make_shared<MessageStream>(protocol->schema);
+        stream->SetVersionID(protocol->versionID);
+
+        // Read the payload, the stream is handed over on completion
+        handler.ReadInto(stream->ResizeData(protocol->size), protocol->size, [this, stream, bytes] {
+            info.bytesRead += bytes;
+            OnStreamReceived(*stream);
+        });
+
+        // Only the header is consumed from the buffer
+        return sizeof(MessageStreamHeaderProtocol);
+    }
+
+    // Entire stream present?
+    if (size < bytes) {
+        return 0;
+    }
+
     // Create the stream
     MessageStream stream(protocol->schema);
     stream.SetVersionID(protocol->versionID);
-    stream.SetData(static_cast<const uint8_t*>(data) + sizeof(MessageStreamHeaderProtocol), protocol->size, 0);
-    memoryBridge.GetOutput()->AddStream(stream);
 
-    // Determine byte count
-    const size_t bytes = sizeof(MessageStreamHeaderProtocol) + protocol->size;
-    info.bytesRead += bytes;
+    // Set the payload
+    const uint8_t* payload = static_cast<const uint8_t *>(data) + sizeof(MessageStreamHeaderProtocol);
+    if (isCompressed) {
+        // Corrupt payload, the remainder of the connection cannot be trusted
+        if (!DecompressMessageStreamPayload(payload, protocol->size, stream)) {
+            fprintf(stderr, "HostServerBridge : Failed to decompress stream of %llu bytes, closing connection\n", static_cast<unsigned long long>(protocol->size));
+            handler.Close();
+            return bytes;
+        }
+    } else {
+        stream.SetData(payload, protocol->size, 0);
+    }
+
+    OnStreamReceived(stream);
 
     // Consume entire stream
+    info.bytesRead += bytes;
     return bytes;
 }
 
+void HostServerBridge::WriteStream(const MessageStreamHeaderProtocol& protocol, const MessageStream& stream, const std::shared_ptr<const void>& owner, AsioTransportFlagSet mask, AsioTransportFlagSet flags) {
+    // Enqueue header (copied) and stream pages, coalesced into gathered writes
+    server->BroadcastServerAsync(&protocol, sizeof(protocol), mask, flags);
+    for (const MessagePage* page = stream.GetFirstPage(); page; page = page->next) {
+        server->BroadcastServerAsync(page->GetData(), page->size, owner, mask, flags);
+    }
+
+    // Tracking
+    info.bytesWritten += sizeof(protocol);
+    info.bytesWritten += protocol.size;
+}
+
+void HostServerBridge::OnStreamReceived(MessageStream &stream) {
+    // Transfer ownership, no copy
+    memoryBridge.GetOutput()->AddStreamAndSwap(stream);
+}
+
+bool HostServerBridge::OnSharedMemoryRequest(const GlobalUID &owner) {
+    auto session = std::make_unique<SharedMemoryBridge>();
+
+    // Received streams are treated as any other
+    session->SetStreamDelegate([this](MessageStream& stream) {
+        OnStreamReceived(stream);
+    });
+
+    // Segment is named after the requesting client
+    if (!session->Create(SharedMemoryBridge::GetSegmentName(owner))) {
+        return false;
+    }
+
+    std::lock_guard guard(sharedMemoryMutex);
+    sharedMemorySessions.push_back(std::move(session));
+    return true;
+}
+
+void HostServerBridge::WriteSharedMemorySessions(const MessageStream *streams, uint32_t count, const std::shared_ptr<const void>& owner) {
+    std::lock_guard guard(sharedMemoryMutex);
+
+    for (auto it = sharedMemorySessions.begin(); it != sharedMemorySessions.end();) {
+        // Release sessions of stopped, stalled or lagging clients
+        if (!(*it)->WriteStreamsAsync(streams, count, owner)) {
+            it = sharedMemorySessions.erase(it);
+            continue;
+        }
+
+        ++it;
+    }
+}
+
+void HostServerBridge::SetDispatcher(const ComRef<Dispatcher>& value) {
+    memoryBridge.SetDispatcher(value);
+}
+
 void HostServerBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
     memoryBridge.Register(mid, listener);
 }
@@ -133,7 +242,16 @@ IMessageStorage *HostServerBridge::GetOutput() {
 }
 
 BridgeInfo HostServerBridge::GetInfo() {
-    return info;
+    BridgeInfo out = info;
+
+    // Append socket statistics
+    if (server) {
+        AsioWriteStats stats = server->GetServerWriteStats();
+        out.socketBytesWritten = stats.bytesWritten;
+        out.socketWriteCount = stats.writeCount;
+    }
+
+    return out;
 }
 
 void HostServerBridge::Commit() {
@@ -150,22 +268,57 @@ void HostServerBridge::Commit() {
     streamCache.resize(streamCount);
     storage.ConsumeStreams(&streamCount, streamCache.data());
 
-    // Push all streams
-    for (const MessageStream &stream: streamCache) {
-        MessageStreamHeaderProtocol protocol;
-        protocol.schema = stream.GetSchema();
-        protocol.versionID = stream.GetVersionID();
-        protocol.size = stream.GetByteSize();
+    // Nothing to write?
+    if (streamCache.empty()) {
+        memoryBridge.Commit();
+        return;
+    }
+
+    // Hand the streams over to the write queue, kept alive until all writes have completed
+    auto streams = std::make_shared<std::vector<MessageStream>>(std::move(streamCache));
+    std::shared_ptr<const void> owner = streams;
+    streamCache.clear();
 
-        // Send header and stream data (sync)
-        server->BroadcastServerAsync(&protocol, sizeof(protocol));
-        server->BroadcastServerAsync(stream.GetDataBegin(), protocol.size);
+    // Compress large streams if any client enabled it
+    const bool compression = server->GetTransportFlags() & AsioTransportFlag::Compression;
 
-        // Tracking
-        info.bytesWritten += sizeof(protocol);
-        info.bytesWritten += protocol.size;
+    // Compressed copies are kept after the streams, never reallocated while writing
+    if (compression) {
+        streams->reserve(streamCount * 2);
     }
 
+    // Push all streams
+    for (uint32_t i = 0; i < streamCount; i++) {
+        MessageStreamHeaderProtocol protocol;
+        protocol.schema = (*streams)[i].GetSchema();
+        protocol.versionID = (*streams)[i].GetVersionID();
+
+        // Features are enabled per client, so the compressed copy is written alongside the original
+        AsioTransportFlagSet mask;
+        if (compression && CompressMessageStreamPayload((*streams)[i], compressionScratch)) {
+            MessageStream& compressed = streams->emplace_back();
+            compressed.Swap((*streams)[i]);
+            (*streams)[i].Swap(compressionScratch);
+
+            // Write the compressed stream to all clients that enabled it
+            MessageStreamHeaderProtocol compressedProtocol = protocol;
+            compressedProtocol.flags |= MessageStreamHeaderProtocol::kFlagCompressed;
+            compressedProtocol.size = compressed.GetByteSize();
+            WriteStream(compressedProtocol, compressed, owner, AsioTransportFlag::Compression, AsioTransportFlag::Compression);
+
+            // Others receive the original
+            mask = AsioTransportFlag::Compression;
+        }
+
+        protocol.size = (*streams)[i].GetByteSize();
+
+        // Write the original to all remaining clients
+        WriteStream(protocol, (*streams)[i], owner, mask, {});
+    }
+
+    // Local clients receive the originals, only handed over once compression no longer touches them
+    WriteSharedMemorySessions(streams->data(), streamCount, owner);
+
     // Commit all inbound streams
     memoryBridge.Commit();
 }
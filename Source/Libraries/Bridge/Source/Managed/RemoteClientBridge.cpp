@@ -195,6 +195,8 @@ Bridge::CLR::BridgeInfo^ Bridge::CLR::RemoteClientBridge::GetInfo() {
     BridgeInfo^ info = gcnew BridgeInfo;
     info->bytesWritten = _privateInfo.bytesWritten;
     info->bytesRead = _privateInfo.bytesRead;
+    info->socketBytesWritten = _privateInfo.socketBytesWritten;
+    info->socketWriteCount = _privateInfo.socketWriteCount;
     return info;
 }
 
@@ -205,3 +207,7 @@ void Bridge::CLR::RemoteClientBridge::Commit() {
 void Bridge::CLR::RemoteClientBridge::SetCommitOnAppend(bool enabled) {
     _private->bridge->SetCommitOnAppend(enabled);
 }
+
+void Bridge::CLR::RemoteClientBridge::SetCompression(bool enabled) {
+    _private->bridge->SetRequestedTransportFlags(enabled ? AsioTransportFlag::Compression : AsioTransportFlag::None);
+}
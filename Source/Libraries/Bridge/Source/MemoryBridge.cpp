@@ -30,6 +30,14 @@
 // Message
 #include <Message/MessageStream.h>
 
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+#include <Common/Dispatcher/DispatcherBucket.h>
+#include <Common/Dispatcher/Event.h>
+
+// Std
+#include <algorithm>
+
 void MemoryBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
     MutexGuard guard(mutex);
     
@@ -74,6 +82,11 @@ BridgeInfo MemoryBridge::GetInfo() {
     return {};
 }
 
+void MemoryBridge::SetDispatcher(const ComRef<Dispatcher>& value) {
+    MutexGuard guard(mutex);
+    dispatcher = value;
+}
+
 void MemoryBridge::Commit() {
     MutexGuard guard(mutex);
 
@@ -81,33 +94,139 @@ void MemoryBridge::Commit() {
     uint32_t streamCount;
     sharedStorage.ConsumeStreams(&streamCount, nullptr);
 
+    // Nothing to dispatch?
+    if (!streamCount) {
+        return;
+    }
+
     // Consume all streams
     storageConsumeCache.clear();
     storageConsumeCache.resize(streamCount);
     sharedStorage.ConsumeStreams(&streamCount, storageConsumeCache.data());
 
-    // Invoke streams in-order
-    // TODO: This can be bucketed pretty easily if performance becomes a problem
-    for (MessageStream& stream : storageConsumeCache) {
-        if (stream.GetSchema().type == MessageSchemaType::Ordered) {
+    // Dispatch in runs, ordered streams act as barriers
+    //  ? Ordered listeners see all streams in their original order
+    for (uint32_t runOffset = 0; runOffset < streamCount;) {
+        // Find the end of this run
+        bool orderedRun = storageConsumeCache[runOffset].GetSchema().type == MessageSchemaType::Ordered;
+        uint32_t runEnd = runOffset + 1;
+        while (runEnd < streamCount && (storageConsumeCache[runEnd].GetSchema().type == MessageSchemaType::Ordered) == orderedRun) {
+            runEnd++;
+        }
+
+        // Ordered listeners are always serial, the whole run in one go
+        if (orderedRun) {
             for (const ComRef<IBridgeListener>& listener : orderedListeners) {
-                listener->Handle(&stream, 1u);
+                listener->Handle(storageConsumeCache.data() + runOffset, runEnd - runOffset);
             }
         } else {
-            // No listener?
-            auto bucketIt = buckets.find(stream.GetSchema().id);
-            if (bucketIt == buckets.end()) {
-                // TODO: Log warning
-                continue;
-            }
+            DispatchRun(runOffset, runEnd);
+        }
+
+        // Next run
+        runOffset = runEnd;
+    }
+}
 
-            // Get the bucket
-            MessageBucket& bucket = bucketIt->second;
+void MemoryBridge::DispatchRun(uint32_t runOffset, uint32_t runEnd) {
+    // Bucket streams by schema
+    //  ? Stable, the order of streams within the same schema is preserved
+    std::stable_sort(storageConsumeCache.begin() + runOffset, storageConsumeCache.begin() + runEnd, [](const MessageStream& a, const MessageStream& b) {
+        return a.GetSchema().id < b.GetSchema().id;
+    });
+
+    // Reset batches
+    listenerBatchCount = 0;
+
+    // Assign all ranges
+    for (uint32_t offset = runOffset; offset < runEnd;) {
+        const MessageSchema& schema = storageConsumeCache[offset].GetSchema();
+
+        // Find the end of this bucket
+        uint32_t end = offset + 1;
+        while (end < runEnd && storageConsumeCache[end].GetSchema().id == schema.id) {
+            end++;
+        }
 
-            // Pass through all listeners
-            for (const ComRef<IBridgeListener>& listener : bucket.listeners) {
-                listener->Handle(&stream, 1);
+        // Assign to all listeners of the schema
+        if (auto bucketIt = buckets.find(schema.id); bucketIt != buckets.end()) {
+            for (const ComRef<IBridgeListener>& listener : bucketIt->second.listeners) {
+                // Find existing batch, listeners are few
+                ListenerBatch* batch = nullptr;
+                for (uint32_t i = 0; i < listenerBatchCount; i++) {
+                    if (listenerBatches[i].listener == listener.GetUnsafe()) {
+                        batch = &listenerBatches[i];
+                        break;
+                    }
+                }
+
+                // None found, allocate a new one
+                if (!batch) {
+                    if (listenerBatchCount == listenerBatches.size()) {
+                        listenerBatches.emplace_back();
+                    }
+
+                    batch = &listenerBatches[listenerBatchCount++];
+                    batch->bridge = this;
+                    batch->listener = listener.GetUnsafe();
+                    batch->ranges.clear();
+                }
+
+                // Add range
+                batch->ranges.push_back(StreamRange {
+                    .offset = offset,
+                    .count = end - offset
+                });
             }
+        } else {
+            // TODO: Log warning
+        }
+
+        // Next bucket
+        offset = end;
+    }
+
+    // Serial dispatch if there's nothing to parallelize
+    if (!dispatcher || listenerBatchCount <= 1) {
+        for (uint32_t i = 0; i < listenerBatchCount; i++) {
+            HandleBatch(&listenerBatches[i]);
         }
+
+        return;
+    }
+
+    // Completion event
+    Event event;
+
+    // Parallel dispatch, one job per listener
+    DispatcherBucket bucket;
+    bucket.completionFunctor = BindDelegate(this, MemoryBridge::OnBatchesCompleted);
+    bucket.userData = &event;
+    bucket.SetCounter(1);
+
+    // Submit all batches, the first one is handled on this thread
+    //  ? The committing thread waits on the batches, never queue them behind background jobs
+    for (uint32_t i = 1; i < listenerBatchCount; i++) {
+        dispatcher->Add(BindDelegate(this, MemoryBridge::HandleBatch), &listenerBatches[i], &bucket, DispatcherJobPriority::Blocking);
     }
+
+    // Handle the first batch locally
+    HandleBatch(&listenerBatches[0]);
+
+    // Release the guard count and wait for all jobs
+    bucket.Decrement();
+    event.Wait();
+}
+
+void MemoryBridge::HandleBatch(void *data) {
+    auto* batch = static_cast<ListenerBatch*>(data);
+
+    // Invoke for all ranges
+    for (const StreamRange& range : batch->ranges) {
+        batch->listener->Handle(storageConsumeCache.data() + range.offset, range.count);
+    }
+}
+
+void MemoryBridge::OnBatchesCompleted(void *data) {
+    static_cast<Event*>(data)->Signal();
 }
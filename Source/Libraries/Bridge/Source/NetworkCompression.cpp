@@ -0,0 +1,103 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/NetworkCompression.h>
+#include <Bridge/NetworkProtocol.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+// LZ4
+#include <lz4.h>
+
+bool CompressMessageStreamPayload(MessageStream& stream, MessageStream& scratch) {
+    const uint64_t size = stream.GetByteSize();
+
+    // Small streams are not worth the overhead
+    if (size < kNetworkCompressionThreshold || size > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+
+    // Compression requires contiguous data
+    const uint8_t* source = stream.Linearize();
+
+    // Reserve the worst case, clear beforehand to avoid copying stale contents
+    const int bound = LZ4_compressBound(static_cast<int>(size));
+    scratch.Clear();
+    uint8_t* dest = scratch.ResizeData(sizeof(MessageStreamCompressedProtocol) + bound);
+
+    // Compress after the prefix
+    const int compressedSize = LZ4_compress_default(
+        reinterpret_cast<const char*>(source),
+        reinterpret_cast<char*>(dest + sizeof(MessageStreamCompressedProtocol)),
+        static_cast<int>(size),
+        bound
+    );
+
+    // Not beneficial?
+    if (compressedSize <= 0 || sizeof(MessageStreamCompressedProtocol) + compressedSize >= size) {
+        return false;
+    }
+
+    // Write prefix
+    auto* prefix = reinterpret_cast<MessageStreamCompressedProtocol*>(dest);
+    prefix->decompressedSize = size;
+
+    // Trim to the compressed size, the page is retained
+    scratch.ResizeData(sizeof(MessageStreamCompressedProtocol) + compressedSize);
+
+    // Hand over the compressed payload, keeps the stream identity
+    scratch.SetSchema(stream.GetSchema());
+    scratch.SetVersionID(stream.GetVersionID());
+    stream.Swap(scratch);
+
+    // OK
+    return true;
+}
+
+bool DecompressMessageStreamPayload(const void* data, uint64_t size, MessageStream& stream) {
+    if (size < sizeof(MessageStreamCompressedProtocol)) {
+        return false;
+    }
+
+    // Get prefix
+    auto* prefix = static_cast<const MessageStreamCompressedProtocol*>(data);
+    if (prefix->decompressedSize > LZ4_MAX_INPUT_SIZE) {
+        return false;
+    }
+
+    // Decompress directly into the stream
+    uint8_t* dest = stream.ResizeData(prefix->decompressedSize);
+    const int decompressedSize = LZ4_decompress_safe(
+        static_cast<const char*>(data) + sizeof(MessageStreamCompressedProtocol),
+        reinterpret_cast<char*>(dest),
+        static_cast<int>(size - sizeof(MessageStreamCompressedProtocol)),
+        static_cast<int>(prefix->decompressedSize)
+    );
+
+    // Must match exactly
+    return decompressedSize >= 0 && static_cast<uint64_t>(decompressedSize) == prefix->decompressedSize;
+}
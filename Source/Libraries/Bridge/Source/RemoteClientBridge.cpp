@@ -28,6 +28,8 @@
 #include <Bridge/IBridgeListener.h>
 #include <Bridge/EndpointConfig.h>
 #include <Bridge/NetworkProtocol.h>
+#include <Bridge/NetworkCompression.h>
+#include <Bridge/SharedMemoryBridge.h>
 #include <Bridge/Asio/AsioRemoteClient.h>
 
 // Message
@@ -36,6 +38,9 @@
 // Schemas
 #include <Schemas/HostResolve.h>
 
+// Std
+#include <cstdio>
+
 
 RemoteClientBridge::RemoteClientBridge() {
     // Create the client
@@ -48,11 +53,14 @@ RemoteClientBridge::RemoteClientBridge() {
 
     // Set read callback
     client->SetServerReadCallback([this](AsioSocketHandler &handler, const void *data, uint64_t size) {
-        return OnReadAsync(data, size);
+        return OnReadAsync(handler, data, size);
     });
 }
 
 RemoteClientBridge::~RemoteClientBridge() {
+    // Release the session before the endpoint, the reader may still append
+    sharedMemory.reset();
+
     // Release endpoint
     destroy(client, allocators);
 }
@@ -83,6 +91,11 @@ void RemoteClientBridge::Cancel() {
 
 void RemoteClientBridge::Stop() {
     client->Stop();
+
+    // Stop the shared memory session, if any
+    if (sharedMemory) {
+        sharedMemory->Stop();
+    }
 }
 
 void RemoteClientBridge::SetAsyncConnectedDelegate(const AsioClientAsyncConnectedDelegate &delegate) {
@@ -94,17 +107,47 @@ void RemoteClientBridge::DiscoverAsync() {
 }
 
 void RemoteClientBridge::RequestClientAsync(const AsioHostClientToken &guid) {
-    client->RequestClientAsync(AsioHostClientToken(guid));
+    client->RequestClientAsync(AsioHostClientToken(guid), requestedTransportFlags);
+}
+
+AsioTransportFlagSet RemoteClientBridge::GetTransportFlags() const {
+    return client->GetTransportFlags();
 }
 
 void RemoteClientBridge::OnConnected(const AsioHostResolverClientRequest::ServerResponse& response) {
+    bool accepted = response.accepted;
+
+    // Open the segment created by the host
+    if (accepted && (response.transportFlags & AsioTransportFlag::SharedMemory)) {
+        sharedMemory = std::make_unique<SharedMemoryBridge>();
+        sharedMemory->SetStreamDelegate([this](MessageStream& stream) {
+            info.bytesRead += sizeof(MessageStreamHeaderProtocol) + stream.GetByteSize();
+            OnStreamReceived(stream);
+        });
+
+        // Failed?
+        if (!sharedMemory->Open(SharedMemoryBridge::GetSegmentName(response.owner))) {
+            sharedMemory.reset();
+            accepted = false;
+        }
+    }
+
+    // Announce the accepted transport features on the endpoint, the host enables them for this connection only
+    if (accepted && !sharedMemory) {
+        MessageStreamHeaderProtocol protocol;
+        protocol.flags = MessageStreamHeaderProtocol::kFlagTransport;
+        protocol.versionID = static_cast<uint32_t>(response.transportFlags.value);
+        protocol.size = 0;
+        client->WriteAsync(&protocol, sizeof(protocol));
+    }
+
     MessageStream stream;
 
     MessageStreamView view(stream);
 
     // Push message
     auto* message = view.Add<HostConnectedMessage>();
-    message->accepted = response.accepted;
+    message->accepted = accepted;
 
     memoryBridge.GetOutput()->AddStream(stream);
 
@@ -185,37 +228,77 @@ void RemoteClientBridge::OnDiscovery(const AsioRemoteServerResolverDiscoveryRequ
     }
 }
 
-uint64_t RemoteClientBridge::OnReadAsync(const void *data, uint64_t size) {
+uint64_t RemoteClientBridge::OnReadAsync(AsioSocketHandler& handler, const void *data, uint64_t size) {
     auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
 
-    // Entire stream present?
-    if (size < sizeof(MessageStreamHeaderProtocol) ||
-        size < sizeof(MessageStreamHeaderProtocol) + protocol->size) {
+    // Header present?
+    if (size < sizeof(MessageStreamHeaderProtocol)) {
         return 0;
     }
 
     // Validate header
     ASSERT(protocol->magic == MessageStreamHeaderProtocol::kMagic, "Unexpected magic header");
 
+    // Determine byte count
+    const size_t bytes = sizeof(MessageStreamHeaderProtocol) + protocol->size;
+
+    // Compressed streams are decompressed from the buffer
+    const bool isCompressed = protocol->flags & MessageStreamHeaderProtocol::kFlagCompressed;
+
+    // Large streams are read directly into the stream, avoiding the intermediate buffering
+    if (!isCompressed && protocol->size >= AsioSocketHandler::kDirectReadThreshold) {
+        auto stream = std::make_shared<MessageStream>(protocol->schema);
+        stream->SetVersionID(protocol->versionID);
+
+        // Read the payload, the stream is handed over on completion
+        handler.ReadInto(stream->ResizeData(protocol->size), protocol->size, [this, stream, bytes] {
+            info.bytesRead += bytes;
+            OnStreamReceived(*stream);
+        });
+
+        // Only the header is consumed from the buffer
+        return sizeof(MessageStreamHeaderProtocol);
+    }
+
+    // Entire stream present?
+    if (size < bytes) {
+        return 0;
+    }
+
     // Create the stream
     MessageStream stream(protocol->schema);
     stream.SetVersionID(protocol->versionID);
-    stream.SetData(static_cast<const uint8_t *>(data) + sizeof(MessageStreamHeaderProtocol), protocol->size, 0);
-    memoryBridge.GetOutput()->AddStream(stream);
 
-    // Commit all inbound streams if requested
-    if (commitOnAppend) {
-        memoryBridge.Commit();
+    // Set the payload
+    const uint8_t* payload = static_cast<const uint8_t *>(data) + sizeof(MessageStreamHeaderProtocol);
+    if (isCompressed) {
+        // Corrupt payload, the remainder of the connection cannot be trusted
+        if (!DecompressMessageStreamPayload(payload, protocol->size, stream)) {
+            fprintf(stderr, "RemoteClientBridge : Failed to decompress stream of %llu bytes, closing connection\n", static_cast<unsigned long long>(protocol->size));
+            handler.Close();
+            return bytes;
+        }
+    } else {
+        stream.SetData(payload, protocol->size, 0);
     }
 
-    // Determine byte count
-    const size_t bytes = sizeof(MessageStreamHeaderProtocol) + protocol->size;
-    info.bytesRead += bytes;
+    OnStreamReceived(stream);
 
     // Consume entire stream
+    info.bytesRead += bytes;
     return bytes;
 }
 
+void RemoteClientBridge::OnStreamReceived(MessageStream &stream) {
+    // Transfer ownership, no copy
+    memoryBridge.GetOutput()->AddStreamAndSwap(stream);
+
+    // Commit all inbound streams if requested
+    if (commitOnAppend) {
+        memoryBridge.Commit();
+    }
+}
+
 void RemoteClientBridge::Register(MessageID mid, const ComRef<IBridgeListener> &listener) {
     memoryBridge.Register(mid, listener);
 }
@@ -241,7 +324,13 @@ IMessageStorage *RemoteClientBridge::GetOutput() {
 }
 
 BridgeInfo RemoteClientBridge::GetInfo() {
-    return info;
+    BridgeInfo out = info;
+
+    // Append socket statistics
+    AsioWriteStats stats = client->GetWriteStats();
+    out.socketBytesWritten = stats.bytesWritten;
+    out.socketWriteCount = stats.writeCount;
+    return out;
 }
 
 void RemoteClientBridge::Commit() {
@@ -253,16 +342,51 @@ void RemoteClientBridge::Commit() {
     streamCache.resize(streamCount);
     storage.ConsumeStreams(&streamCount, streamCache.data());
 
+    // Nothing to write?
+    if (streamCache.empty()) {
+        memoryBridge.Commit();
+        return;
+    }
+
+    // Local hosts are written through the segment, never compressed
+    if (sharedMemory) {
+        if (sharedMemory->WriteStreams(streamCache.data(), static_cast<uint32_t>(streamCache.size()))) {
+            for (const MessageStream& stream : streamCache) {
+                info.bytesWritten += sizeof(MessageStreamHeaderProtocol) + stream.GetByteSize();
+            }
+        }
+
+        streamCache.clear();
+        memoryBridge.Commit();
+        return;
+    }
+
+    // Hand the streams over to the write queue, kept alive until all writes have completed
+    auto streams = std::make_shared<std::vector<MessageStream>>(std::move(streamCache));
+    std::shared_ptr<const void> owner = streams;
+    streamCache.clear();
+
+    // Compress large streams if negotiated
+    const bool compression = client->GetTransportFlags() & AsioTransportFlag::Compression;
+
     // Push all streams
-    for (const MessageStream &stream: streamCache) {
+    for (MessageStream &stream: *streams) {
         MessageStreamHeaderProtocol protocol;
         protocol.schema = stream.GetSchema();
         protocol.versionID = stream.GetVersionID();
+
+        // Replace the payload if beneficial
+        if (compression && CompressMessageStreamPayload(stream, compressionScratch)) {
+            protocol.flags |= MessageStreamHeaderProtocol::kFlagCompressed;
+        }
+
         protocol.size = stream.GetByteSize();
 
-        // Send header and stream data (sync)
+        // Enqueue header (copied) and stream pages, coalesced into gathered writes
         client->WriteAsync(&protocol, sizeof(protocol));
-        client->WriteAsync(stream.GetDataBegin(), protocol.size);
+        for (const MessagePage* page = stream.GetFirstPage(); page; page = page->next) {
+            client->WriteAsync(page->GetData(), page->size, owner);
+        }
 
         // Tracking
         info.bytesWritten += sizeof(protocol);
@@ -0,0 +1,277 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/SharedMemory/SharedMemoryRing.h>
+
+// System
+#ifdef _WIN64
+#include <Windows.h>
+#elif defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <climits>
+#include <ctime>
+#endif // _WIN64
+
+// Std
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstring>
+
+SharedMemorySignal::~SharedMemorySignal() {
+#ifdef _WIN64
+    if (event) {
+        CloseHandle(event);
+    }
+#endif // _WIN64
+}
+
+bool SharedMemorySignal::Install(const std::string &name, std::atomic<uint32_t> *value) {
+    word = value;
+
+#ifdef _WIN64
+    // Opens the existing event if already created by the peer
+    event = CreateEventA(nullptr, FALSE, FALSE, ("Local\\" + name).c_str());
+    return event != nullptr;
+#else // _WIN64
+    return true;
+#endif // _WIN64
+}
+
+void SharedMemorySignal::Wait(uint32_t expected, uint32_t timeoutMS) {
+    // Changed since observed?
+    if (word->load() != expected) {
+        return;
+    }
+
+#ifdef _WIN64
+    // Auto reset events keep the signalled state, wakes in between are not lost
+    WaitForSingleObject(event, timeoutMS);
+#elif defined(__linux__)
+    timespec timeout;
+    timeout.tv_sec = timeoutMS / 1000;
+    timeout.tv_nsec = static_cast<long>(timeoutMS % 1000) * 1'000'000;
+
+    // Shared futex, the kernel checks the word against the expected value
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+#else // _WIN64
+    // No shared wait primitive, poll the word
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMS);
+    while (word->load() == expected && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::microseconds(250));
+    }
+#endif // _WIN64
+}
+
+void SharedMemorySignal::Wake() {
+#ifdef _WIN64
+    SetEvent(event);
+#elif defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif // _WIN64
+}
+
+bool SharedMemoryRing::Install(const std::string &name, SharedMemoryRingHeader *shared, uint8_t *ringData, uint64_t ringCapacity) {
+    header = shared;
+    data = ringData;
+    capacity = ringCapacity;
+
+    // Resume from the published position
+    localTail = header->tail.load();
+
+    // Create signals
+    return dataSignal.Install(name + ".data", &header->dataSequence) &&
+           spaceSignal.Install(name + ".space", &header->spaceSequence);
+}
+
+bool SharedMemoryRing::Write(const void *source, uint64_t size) {
+    auto* bytes = static_cast<const uint8_t*>(source);
+
+    while (size) {
+        if (header->closed.load(std::memory_order_relaxed)) {
+            return false;
+        }
+
+        // Full?
+        uint64_t free = capacity - (localTail - header->head.load(std::memory_order_acquire));
+        if (!free) {
+            if (!WaitForSpace()) {
+                return false;
+            }
+
+            continue;
+        }
+
+        // Copy up until the end of the ring, wrapped writes are split
+        uint64_t offset = localTail % capacity;
+        uint64_t count = std::min({size, free, capacity - offset});
+        std::memcpy(data + offset, bytes, count);
+
+        // Next!
+        localTail += count;
+        bytes += count;
+        size -= count;
+    }
+
+    // OK
+    return true;
+}
+
+void SharedMemoryRing::Publish() {
+    // Nothing written since last publish?
+    if (header->tail.load(std::memory_order_relaxed) == localTail) {
+        return;
+    }
+
+    // Publish data, then bump the sequence so that waits observing the old sequence are woken
+    header->tail.store(localTail, std::memory_order_release);
+    header->dataSequence.fetch_add(1);
+
+    // Only wake if the consumer is actually waiting, avoids a system call per publish
+    if (header->consumerWaiting.load()) {
+        dataSignal.Wake();
+    }
+}
+
+uint64_t SharedMemoryRing::Read(void *destination, uint64_t size) {
+    uint64_t head = header->head.load(std::memory_order_relaxed);
+    uint64_t readable = header->tail.load(std::memory_order_acquire) - head;
+
+    // Copy all readable data, wrapped reads are split
+    uint64_t count = std::min(size, readable);
+    for (uint64_t copied = 0; copied < count;) {
+        uint64_t offset = (head + copied) % capacity;
+        uint64_t chunk = std::min(count - copied, capacity - offset);
+        std::memcpy(static_cast<uint8_t*>(destination) + copied, data + offset, chunk);
+        copied += chunk;
+    }
+
+    // Nothing read?
+    if (!count) {
+        return 0;
+    }
+
+    // Release the space to the producer
+    header->head.store(head + count, std::memory_order_release);
+    header->spaceSequence.fetch_add(1);
+
+    // Only wake if the producer is actually waiting
+    if (header->producerWaiting.load()) {
+        spaceSignal.Wake();
+    }
+
+    return count;
+}
+
+uint64_t SharedMemoryRing::GetReadable() const {
+    return header->tail.load(std::memory_order_acquire) - header->head.load(std::memory_order_relaxed);
+}
+
+bool SharedMemoryRing::WaitForData(uint32_t timeoutMS) {
+    // Consumer is alive
+    header->consumerHeartbeat.fetch_add(1, std::memory_order_relaxed);
+
+    // Anything to read?
+    if (GetReadable()) {
+        return true;
+    }
+
+    // Observe the sequence before announcing the wait, any later publish changes the sequence
+    uint32_t sequence = header->dataSequence.load();
+    header->consumerWaiting.store(1);
+
+    // Published in between?
+    if (!GetReadable() && !IsClosed()) {
+        dataSignal.Wait(sequence, timeoutMS);
+    }
+
+    header->consumerWaiting.store(0);
+    return GetReadable() != 0;
+}
+
+bool SharedMemoryRing::WaitForSpace() {
+    // Let the consumer drain what has been written so far
+    Publish();
+
+    // Last observed heartbeat of the consumer
+    uint32_t heartbeat = header->consumerHeartbeat.load(std::memory_order_relaxed);
+    auto heartbeatStamp = std::chrono::steady_clock::now();
+
+    for (;;) {
+        if (IsClosed()) {
+            return false;
+        }
+
+        // Observe the sequence before announcing the wait, any later consumption changes the sequence
+        uint32_t sequence = header->spaceSequence.load();
+        header->producerWaiting.store(1);
+
+        // Consumed in between?
+        if (localTail - header->head.load(std::memory_order_acquire) < capacity) {
+            header->producerWaiting.store(0);
+            return true;
+        }
+
+        // Wait for consumption, timed to check the consumer liveness
+        spaceSignal.Wait(sequence, 100);
+        header->producerWaiting.store(0);
+
+        // Consumed?
+        if (localTail - header->head.load(std::memory_order_acquire) < capacity) {
+            return true;
+        }
+
+        // Consumer still alive?
+        uint32_t currentHeartbeat = header->consumerHeartbeat.load(std::memory_order_relaxed);
+        if (currentHeartbeat != heartbeat) {
+            heartbeat = currentHeartbeat;
+            heartbeatStamp = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        // Stalled consumer, give up on the ring entirely as the stream framing cannot be recovered
+        if (std::chrono::steady_clock::now() - heartbeatStamp > std::chrono::milliseconds(kPeerTimeoutMS)) {
+            Close();
+            return false;
+        }
+    }
+}
+
+void SharedMemoryRing::Close() {
+    header->closed.store(1);
+
+    // Bump both sequences to release any waiters
+    header->dataSequence.fetch_add(1);
+    header->spaceSequence.fetch_add(1);
+    dataSignal.Wake();
+    spaceSignal.Wake();
+}
+
+bool SharedMemoryRing::IsClosed() const {
+    return header->closed.load() != 0;
+}
@@ -0,0 +1,181 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/SharedMemory/SharedMemorySegment.h>
+
+// System
+#ifdef _WIN64
+#include <Windows.h>
+#else // _WIN64
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#endif // _WIN64
+
+SharedMemorySegment::~SharedMemorySegment() {
+    Release();
+}
+
+bool SharedMemorySegment::Create(const std::string &name, uint64_t byteSize) {
+    Release();
+
+#ifdef _WIN64
+    // Session local mapping, backed by the page file
+    std::string systemName = "Local\\" + name;
+    handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(byteSize >> 32u), static_cast<DWORD>(byteSize), systemName.c_str());
+    if (!handle) {
+        return false;
+    }
+
+    // Another owner?
+    if (GetLastError() == ERROR_ALREADY_EXISTS) {
+        Release();
+        return false;
+    }
+
+    // Map the entire segment
+    data = static_cast<uint8_t*>(MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, byteSize));
+#else // _WIN64
+    std::string systemName = "/" + name;
+
+    // Create exclusively, a stale segment may linger if the previous owner was terminated
+    fd = shm_open(systemName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0 && errno == EEXIST) {
+        shm_unlink(systemName.c_str());
+        fd = shm_open(systemName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    }
+
+    // Failed?
+    if (fd < 0) {
+        return false;
+    }
+
+    // The owner unlinks on release
+    ownedName = systemName;
+
+    // Size the segment, zero filled
+    if (ftruncate(fd, static_cast<off_t>(byteSize)) != 0) {
+        Release();
+        return false;
+    }
+
+    // Map the entire segment
+    void* view = mmap(nullptr, byteSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    data = view != MAP_FAILED ? static_cast<uint8_t*>(view) : nullptr;
+#endif // _WIN64
+
+    // Mapped?
+    if (!data) {
+        Release();
+        return false;
+    }
+
+    // OK
+    size = byteSize;
+    return true;
+}
+
+bool SharedMemorySegment::Open(const std::string &name) {
+    Release();
+
+#ifdef _WIN64
+    std::string systemName = "Local\\" + name;
+    handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, systemName.c_str());
+    if (!handle) {
+        return false;
+    }
+
+    // Map the entire segment
+    data = static_cast<uint8_t*>(MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, 0));
+    if (!data) {
+        Release();
+        return false;
+    }
+
+    // Query the mapped size, page aligned
+    MEMORY_BASIC_INFORMATION memoryInfo{};
+    VirtualQuery(data, &memoryInfo, sizeof(memoryInfo));
+    size = memoryInfo.RegionSize;
+#else // _WIN64
+    fd = shm_open(("/" + name).c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Get the segment size
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        Release();
+        return false;
+    }
+
+    // Map the entire segment
+    void* view = mmap(nullptr, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (view == MAP_FAILED) {
+        Release();
+        return false;
+    }
+
+    data = static_cast<uint8_t*>(view);
+    size = status.st_size;
+#endif // _WIN64
+
+    // OK
+    return true;
+}
+
+void SharedMemorySegment::Release() {
+#ifdef _WIN64
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (handle) {
+        CloseHandle(handle);
+        handle = nullptr;
+    }
+#else // _WIN64
+    if (data) {
+        munmap(data, size);
+    }
+
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+
+    // Existing mappings stay valid after unlinking
+    if (!ownedName.empty()) {
+        shm_unlink(ownedName.c_str());
+        ownedName.clear();
+    }
+#endif // _WIN64
+
+    data = nullptr;
+    size = 0;
+}
@@ -0,0 +1,383 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Bridge/SharedMemoryBridge.h>
+#include <Bridge/IBridgeListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+// Common
+#include <Common/Assert.h>
+
+// Std
+#include <new>
+#include <algorithm>
+
+/// Shared segment layout, followed by the data of both rings
+struct SharedMemoryBridgeLayout {
+    static constexpr uint64_t kMagic = 'GRSM';
+
+    /// Magic header, written last by the creator
+    std::atomic<uint64_t> magic;
+
+    /// Byte capacity of each ring
+    uint64_t ringCapacity;
+
+    /// Ring states, host to frontend and frontend to host
+    SharedMemoryRingHeader rings[2];
+};
+
+/// Number of milliseconds the reader waits before checking for exits
+static constexpr uint32_t kReaderWaitMS = 100;
+
+SharedMemoryBridge::~SharedMemoryBridge() {
+    Stop();
+}
+
+bool SharedMemoryBridge::Create(const std::string &name, uint64_t ringSize) {
+    // Create zero initialized segment
+    if (!segment.Create(name, sizeof(SharedMemoryBridgeLayout) + ringSize * 2)) {
+        return false;
+    }
+
+    // Initialize layout
+    auto* layout = new (segment.GetData()) SharedMemoryBridgeLayout();
+    layout->ringCapacity = ringSize;
+
+    // Install rings
+    if (!Install(name, true)) {
+        segment.Release();
+        return false;
+    }
+
+    // Layout is now visible to frontends
+    layout->magic.store(SharedMemoryBridgeLayout::kMagic, std::memory_order_release);
+    return true;
+}
+
+bool SharedMemoryBridge::Open(const std::string &name) {
+    if (!segment.Open(name) || segment.GetSize() < sizeof(SharedMemoryBridgeLayout)) {
+        return false;
+    }
+
+    // Validate the layout
+    auto* layout = reinterpret_cast<SharedMemoryBridgeLayout*>(segment.GetData());
+    if (layout->magic.load(std::memory_order_acquire) != SharedMemoryBridgeLayout::kMagic ||
+        segment.GetSize() < sizeof(SharedMemoryBridgeLayout) + layout->ringCapacity * 2) {
+        segment.Release();
+        return false;
+    }
+
+    // Install rings
+    if (!Install(name, false)) {
+        segment.Release();
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+bool SharedMemoryBridge::Install(const std::string &name, bool isHost) {
+    auto* layout = reinterpret_cast<SharedMemoryBridgeLayout*>(segment.GetData());
+
+    // Ring data follows the layout
+    uint8_t* ringData = segment.GetData() + sizeof(SharedMemoryBridgeLayout);
+
+    // Hosts write to the first ring, frontends to the second
+    uint32_t outboundIndex = isHost ? 0 : 1;
+    uint32_t inboundIndex = isHost ? 1 : 0;
+
+    // Install both rings
+    if (!outbound.Install(name + "." + std::to_string(outboundIndex), &layout->rings[outboundIndex], ringData + outboundIndex * layout->ringCapacity, layout->ringCapacity) ||
+        !inbound.Install(name + "." + std::to_string(inboundIndex), &layout->rings[inboundIndex], ringData + inboundIndex * layout->ringCapacity, layout->ringCapacity)) {
+        return false;
+    }
+
+    // Start the reader
+    readerExit = false;
+    readerThread = std::thread([this] { ReaderThreadEntry(); });
+
+    // Start the writer
+    writerExit = false;
+    writerThread = std::thread([this] { WriterThreadEntry(); });
+
+    // OK
+    installed = true;
+    return true;
+}
+
+void SharedMemoryBridge::Stop() {
+    if (!installed.exchange(false)) {
+        return;
+    }
+
+    // Request the reader exit before waking it
+    readerExit = true;
+
+    // Close both directions, releases any blocked peer
+    outbound.Close();
+    inbound.Close();
+
+    // Wait for the reader
+    if (readerThread.joinable()) {
+        readerThread.join();
+    }
+
+    // Wait for the writer, pending writes are dropped
+    {
+        std::lock_guard guard(writerMutex);
+        writerExit = true;
+        pendingWrites.clear();
+        pendingWriteSize = 0;
+    }
+    writerCondition.notify_one();
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+
+    // Release the mapping
+    segment.Release();
+}
+
+bool SharedMemoryBridge::IsOpen() const {
+    return installed.load() && !outbound.IsClosed();
+}
+
+std::string SharedMemoryBridge::GetSegmentName(const GlobalUID &token) {
+    return "GRS.Bridge." + token.ToString();
+}
+
+void SharedMemoryBridge::ReaderThreadEntry() {
+    while (!readerExit.load()) {
+        // Wait for data, also signals the consumer liveness to the producer
+        if (!inbound.WaitForData(kReaderWaitMS)) {
+            // Drained and closed?
+            if (inbound.IsClosed()) {
+                break;
+            }
+
+            continue;
+        }
+
+        // Read all complete streams
+        while (ReadStream());
+    }
+}
+
+void SharedMemoryBridge::WriterThreadEntry() {
+    for (;;) {
+        PendingWrite write;
+
+        // Wait for the next write
+        {
+            std::unique_lock lock(writerMutex);
+            writerCondition.wait(lock, [this] { return writerExit || !pendingWrites.empty(); });
+
+            // Exit requested?
+            if (writerExit) {
+                return;
+            }
+
+            write = std::move(pendingWrites.front());
+            pendingWrites.pop_front();
+        }
+
+        // Write all streams, may block on the peer, dropped if the peer is gone
+        WriteStreams(write.streams, write.count);
+
+        // Release the owner before accounting, the streams are no longer referenced
+        write.owner.reset();
+
+        // Written, still accounted during the write to bound the total
+        std::lock_guard guard(writerMutex);
+        pendingWriteSize -= std::min(pendingWriteSize, write.size);
+    }
+}
+
+bool SharedMemoryBridge::ReadStream() {
+    // Read the header first
+    if (pendingHeaderSize < sizeof(MessageStreamHeaderProtocol)) {
+        pendingHeaderSize += inbound.Read(reinterpret_cast<uint8_t*>(&pendingHeader) + pendingHeaderSize, sizeof(MessageStreamHeaderProtocol) - pendingHeaderSize);
+
+        // Partial header?
+        if (pendingHeaderSize < sizeof(MessageStreamHeaderProtocol)) {
+            return false;
+        }
+
+        // Validate header
+        ASSERT(pendingHeader.magic == MessageStreamHeaderProtocol::kMagic, "Unexpected magic header");
+
+        // Prepare the stream, the payload is read in place
+        pendingStream = MessageStream(pendingHeader.schema);
+        pendingStream.SetVersionID(pendingHeader.versionID);
+        pendingPayload = pendingStream.ResizeData(pendingHeader.size);
+        pendingPayloadSize = 0;
+    }
+
+    // Read the payload, possibly across several ring cycles
+    pendingPayloadSize += inbound.Read(pendingPayload + pendingPayloadSize, pendingHeader.size - pendingPayloadSize);
+
+    // Partial payload?
+    if (pendingPayloadSize < pendingHeader.size) {
+        return false;
+    }
+
+    // Tracking
+    bytesRead += sizeof(MessageStreamHeaderProtocol) + pendingHeader.size;
+
+    // Transfer ownership, no copy
+    if (streamDelegate) {
+        streamDelegate(pendingStream);
+    } else {
+        memoryBridge.GetOutput()->AddStreamAndSwap(pendingStream);
+    }
+
+    // Next!
+    pendingHeaderSize = 0;
+    return true;
+}
+
+bool SharedMemoryBridge::WriteStreams(const MessageStream *streams, uint32_t count) {
+    if (!IsOpen()) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const MessageStream& stream = streams[i];
+
+        MessageStreamHeaderProtocol protocol;
+        protocol.schema = stream.GetSchema();
+        protocol.versionID = stream.GetVersionID();
+        protocol.size = stream.GetByteSize();
+
+        // Write header
+        if (!outbound.Write(&protocol, sizeof(protocol))) {
+            return false;
+        }
+
+        // Write all pages, no intermediate copies
+        for (const MessagePage* page = stream.GetFirstPage(); page; page = page->next) {
+            if (!outbound.Write(page->GetData(), page->size)) {
+                return false;
+            }
+        }
+
+        // Tracking
+        bytesWritten += sizeof(protocol) + protocol.size;
+    }
+
+    // Make all streams visible at once
+    outbound.Publish();
+    return true;
+}
+
+bool SharedMemoryBridge::WriteStreamsAsync(const MessageStream *streams, uint32_t count, const std::shared_ptr<const void>& owner) {
+    if (!IsOpen()) {
+        return false;
+    }
+
+    // Total size, including the headers
+    uint64_t size = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        size += sizeof(MessageStreamHeaderProtocol) + streams[i].GetByteSize();
+    }
+
+    {
+        std::lock_guard guard(writerMutex);
+
+        // Peer not keeping up? The first write is always accepted to allow oversized streams
+        if (pendingWriteSize && pendingWriteSize + size > kMaxPendingWriteSize) {
+            outbound.Close();
+            return false;
+        }
+
+        // Hand over to the writer
+        pendingWrites.push_back(PendingWrite {
+            .streams = streams,
+            .count = count,
+            .size = size,
+            .owner = owner
+        });
+        pendingWriteSize += size;
+    }
+
+    // Wake the writer
+    writerCondition.notify_one();
+    return true;
+}
+
+void SharedMemoryBridge::Register(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(mid, listener);
+}
+
+void SharedMemoryBridge::Deregister(MessageID mid, const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(mid, listener);
+}
+
+void SharedMemoryBridge::Register(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Register(listener);
+}
+
+void SharedMemoryBridge::Deregister(const ComRef<IBridgeListener>& listener) {
+    memoryBridge.Deregister(listener);
+}
+
+IMessageStorage *SharedMemoryBridge::GetInput() {
+    return memoryBridge.GetInput();
+}
+
+IMessageStorage *SharedMemoryBridge::GetOutput() {
+    return &storage;
+}
+
+BridgeInfo SharedMemoryBridge::GetInfo() {
+    BridgeInfo out;
+    out.bytesWritten = bytesWritten.load();
+    out.bytesRead = bytesRead.load();
+    return out;
+}
+
+void SharedMemoryBridge::Commit() {
+    // Get number of streams
+    uint32_t streamCount;
+    storage.ConsumeStreams(&streamCount, nullptr);
+
+    // Get all streams
+    streamCache.resize(streamCount);
+    storage.ConsumeStreams(&streamCount, streamCache.data());
+
+    // Hand all streams over to the writer, dropped if the peer is gone
+    if (!streamCache.empty()) {
+        auto streams = std::make_shared<std::vector<MessageStream>>(std::move(streamCache));
+        WriteStreamsAsync(streams->data(), static_cast<uint32_t>(streams->size()), streams);
+        streamCache.clear();
+    }
+
+    // Commit all inbound streams
+    memoryBridge.Commit();
+}
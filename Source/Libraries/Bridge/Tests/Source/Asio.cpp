@@ -31,9 +31,15 @@
 #include <Bridge/Asio/AsioHostResolverServer.h>
 #include <Bridge/Asio/AsioHostServer.h>
 #include <Bridge/Asio/AsioAsyncRunner.h>
+#include <Bridge/Asio/AsioServer.h>
+#include <Bridge/Asio/AsioClient.h>
+#include <Bridge/NetworkProtocol.h>
 
 // Std
 #include <iostream>
+#include <chrono>
+#include <mutex>
+#include <cstring>
 
 TEST_CASE("Bridge.Asio") {
     AsioConfig config;
@@ -306,3 +312,216 @@ TEST_CASE("Bridge.LongStop") {
     REQUIRE(asyncConnectFlag.load());
     asyncConnectFlag.store(false);
 }
+
+TEST_CASE("Bridge.Asio.WriteQueue") {
+    constexpr uint32_t kStreamCount = 4096;
+    constexpr uint32_t kHeaderSize = 32;
+
+    // Loopback server on a system allocated port
+    AsioServer server(0);
+    REQUIRE(server.IsOpen());
+
+    // Collect everything received
+    std::mutex receivedMutex;
+    std::vector<uint8_t> received;
+    server.SetReadCallback([&](AsioSocketHandler& handler, const void *data, uint64_t size) {
+        std::lock_guard guard(receivedMutex);
+        received.insert(received.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + size);
+        return size;
+    });
+
+    AsioAsyncRunner<AsioServer> serverRunner;
+    serverRunner.RunAsync(server);
+
+    AsioClient client(kAsioLocalhost, server.GetPort());
+    REQUIRE(client.IsOpen());
+
+    AsioAsyncRunner<AsioClient> clientRunner;
+    clientRunner.RunAsync(client);
+
+    // Mix of small (coalesced) and large (referenced) payloads, shared owner
+    auto payloads = std::make_shared<std::vector<std::vector<uint8_t>>>(kStreamCount);
+    for (uint32_t i = 0; i < kStreamCount; i++) {
+        std::vector<uint8_t>& payload = (*payloads)[i];
+        payload.resize(i % 64 == 0 ? 64'000 : 16 + (i % 7) * 100);
+
+        for (size_t j = 0; j < payload.size(); j++) {
+            payload[j] = static_cast<uint8_t>(i * 31 + j);
+        }
+    }
+
+    // Expected byte stream
+    std::vector<uint8_t> expected;
+
+    // Header and payload per stream, as the bridges do
+    uint32_t writeCallCount = 0;
+    for (uint32_t i = 0; i < kStreamCount; i++) {
+        const std::vector<uint8_t>& payload = (*payloads)[i];
+
+        uint8_t header[kHeaderSize];
+        std::memset(header, static_cast<int>(i), sizeof(header));
+        client.WriteAsync(header, sizeof(header));
+        client.WriteAsync(payload.data(), payload.size(), payloads);
+        writeCallCount += 2;
+
+        expected.insert(expected.end(), header, header + sizeof(header));
+        expected.insert(expected.end(), payload.begin(), payload.end());
+    }
+
+    // Release local ownership, the write queue must keep the payloads alive
+    payloads.reset();
+
+    // Wait for all data
+    for (uint32_t i = 0; i < 1000; i++) {
+        {
+            std::lock_guard guard(receivedMutex);
+            if (received.size() >= expected.size()) {
+                break;
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    {
+        std::lock_guard guard(receivedMutex);
+        REQUIRE(received.size() == expected.size());
+        REQUIRE(received == expected);
+    }
+
+    // Writes must be coalesced, and all bytes accounted for
+    AsioWriteStats stats = client.GetWriteStats();
+    REQUIRE(stats.bytesWritten == expected.size());
+    REQUIRE(stats.writeCount > 0);
+    REQUIRE(stats.writeCount < writeCallCount);
+
+    client.Stop();
+    clientRunner.Stop();
+    server.Stop();
+    serverRunner.Stop();
+}
+
+/// Loopback stream receiver, mirrors the network bridges
+struct LoopbackStreamReceiver {
+    /// Read callback
+    uint64_t OnReadAsync(AsioSocketHandler& handler, const void *data, uint64_t size) {
+        auto *protocol = static_cast<const MessageStreamHeaderProtocol *>(data);
+
+        // Header present?
+        if (size < sizeof(MessageStreamHeaderProtocol)) {
+            return 0;
+        }
+
+        // Large streams are read in place
+        if (protocol->size >= AsioSocketHandler::kDirectReadThreshold) {
+            auto stream = std::make_shared<MessageStream>(protocol->schema);
+            stream->SetVersionID(protocol->versionID);
+
+            handler.ReadInto(stream->ResizeData(protocol->size), protocol->size, [this, stream] {
+                OnStream(*stream);
+            });
+
+            return sizeof(MessageStreamHeaderProtocol);
+        }
+
+        // Entire stream present?
+        if (size < sizeof(MessageStreamHeaderProtocol) + protocol->size) {
+            return 0;
+        }
+
+        MessageStream stream(protocol->schema);
+        stream.SetVersionID(protocol->versionID);
+        stream.SetData(static_cast<const uint8_t *>(data) + sizeof(MessageStreamHeaderProtocol), protocol->size, 0);
+        OnStream(stream);
+
+        return sizeof(MessageStreamHeaderProtocol) + protocol->size;
+    }
+
+    /// Invoked on received streams
+    void OnStream(MessageStream& stream) {
+        std::lock_guard guard(mutex);
+        streams.emplace_back(std::move(stream));
+        streamCount++;
+    }
+
+    /// Wait for a number of streams
+    bool Wait(uint64_t count) {
+        for (uint32_t i = 0; i < 3000 && streamCount.load() < count; i++) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        return streamCount.load() >= count;
+    }
+
+    /// Received streams
+    std::mutex mutex;
+    std::vector<MessageStream> streams;
+
+    /// Number of received streams
+    std::atomic<uint64_t> streamCount{0};
+};
+
+/// Write a stream as the network bridges do
+static void WriteLoopbackStream(AsioClient& client, uint32_t versionID, const std::shared_ptr<const std::vector<uint8_t>>& payload) {
+    MessageStreamHeaderProtocol protocol;
+    protocol.schema = MessageSchema { .type = MessageSchemaType::Static, .id = 1 };
+    protocol.versionID = versionID;
+    protocol.size = payload->size();
+
+    client.WriteAsync(&protocol, sizeof(protocol));
+    client.WriteAsync(payload->data(), payload->size(), payload);
+}
+
+TEST_CASE("Bridge.Asio.ReadInto") {
+    constexpr uint32_t kStreamCount = 96;
+
+    AsioServer server(0);
+    REQUIRE(server.IsOpen());
+
+    LoopbackStreamReceiver receiver;
+    server.SetReadCallback([&](AsioSocketHandler& handler, const void *data, uint64_t size) {
+        return receiver.OnReadAsync(handler, data, size);
+    });
+
+    AsioAsyncRunner<AsioServer> serverRunner;
+    serverRunner.RunAsync(server);
+
+    AsioClient client(kAsioLocalhost, server.GetPort());
+    REQUIRE(client.IsOpen());
+
+    AsioAsyncRunner<AsioClient> clientRunner;
+    clientRunner.RunAsync(client);
+
+    // Buffered, direct and larger than the streaming buffer
+    const uint64_t sizes[] = { 200, 70'000, 1'500'000 };
+
+    // Write all streams
+    std::vector<std::shared_ptr<const std::vector<uint8_t>>> payloads;
+    for (uint32_t i = 0; i < kStreamCount; i++) {
+        auto payload = std::make_shared<std::vector<uint8_t>>(sizes[i % 3]);
+        for (size_t j = 0; j < payload->size(); j++) {
+            (*payload)[j] = static_cast<uint8_t>(i * 7 + j);
+        }
+
+        WriteLoopbackStream(client, i, payload);
+        payloads.push_back(payload);
+    }
+
+    REQUIRE(receiver.Wait(kStreamCount));
+
+    // Validate all streams, in order
+    std::lock_guard guard(receiver.mutex);
+    REQUIRE(receiver.streams.size() == kStreamCount);
+
+    for (uint32_t i = 0; i < kStreamCount; i++) {
+        MessageStream& stream = receiver.streams[i];
+        REQUIRE(stream.GetVersionID() == i);
+        REQUIRE(stream.GetByteSize() == payloads[i]->size());
+        REQUIRE(std::memcmp(stream.Linearize(), payloads[i]->data(), payloads[i]->size()) == 0);
+    }
+
+    client.Stop();
+    clientRunner.Stop();
+    server.Stop();
+    serverRunner.Stop();
+}
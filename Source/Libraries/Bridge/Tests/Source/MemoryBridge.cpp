@@ -0,0 +1,215 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/MemoryBridge.h>
+#include <Bridge/IBridgeListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+#include <Message/IMessageStorage.h>
+
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+
+// Std
+#include <atomic>
+#include <vector>
+
+/// Counts all received streams and messages
+class CountingListener : public TComponent<CountingListener>, public IBridgeListener {
+public:
+    COMPONENT(CountingListener);
+
+    void Handle(const MessageStream *streams, uint32_t count) override {
+        // Single listeners are never invoked concurrently
+        // Catch assertions are not thread safe, validated after the commit
+        if (isHandling.exchange(true)) {
+            violationCount++;
+        }
+
+        handleCount++;
+
+        for (uint32_t i = 0; i < count; i++) {
+            // Validate schema ordering within a bucket
+            if (i && streams[i].GetSchema().id == streams[i - 1].GetSchema().id && streams[i].GetVersionID() <= streams[i - 1].GetVersionID()) {
+                violationCount++;
+            }
+
+            messageCount += streams[i].GetCount();
+        }
+
+        isHandling = false;
+    }
+
+    /// Number of handle invocations
+    uint32_t handleCount{0};
+
+    /// Number of received messages
+    uint64_t messageCount{0};
+
+    /// Concurrency check
+    std::atomic<bool> isHandling{false};
+
+    /// Number of concurrency or ordering violations
+    std::atomic<uint32_t> violationCount{0};
+};
+
+/// Add a set of single message streams, cycling through schemas
+static void AddStreams(MemoryBridge& bridge, uint32_t streamCount, uint32_t schemaCount) {
+    uint32_t payload = 0;
+
+    for (uint32_t i = 0; i < streamCount; i++) {
+        MessageStream stream;
+        stream.SetSchema(MessageSchema { .type = MessageSchemaType::Static, .id = i % schemaCount });
+        stream.SetVersionID(i);
+        stream.SetData(&payload, sizeof(payload), 1u);
+        bridge.GetOutput()->AddStreamAndSwap(stream);
+    }
+}
+
+TEST_CASE("Bridge.Memory.Bucketed") {
+    MemoryBridge bridge;
+
+    // One listener per schema, one listening to two schemas
+    auto listenerA = new CountingListener;
+    auto listenerB = new CountingListener;
+    auto listenerAB = new CountingListener;
+    bridge.Register(0, ComRef<IBridgeListener>(listenerA));
+    bridge.Register(1, ComRef<IBridgeListener>(listenerB));
+    bridge.Register(0, ComRef<IBridgeListener>(listenerAB));
+    bridge.Register(1, ComRef<IBridgeListener>(listenerAB));
+
+    // Interleaved schemas
+    AddStreams(bridge, 100, 2);
+    bridge.Commit();
+
+    // Each listener receives its bucket in a single call
+    REQUIRE(listenerA->handleCount == 1);
+    REQUIRE(listenerB->handleCount == 1);
+    REQUIRE(listenerA->messageCount == 50);
+    REQUIRE(listenerB->messageCount == 50);
+
+    // One call per schema bucket
+    REQUIRE(listenerAB->handleCount == 2);
+    REQUIRE(listenerAB->messageCount == 100);
+    REQUIRE(listenerAB->violationCount == 0);
+}
+
+TEST_CASE("Bridge.Memory.Parallel") {
+    MemoryBridge bridge;
+    bridge.SetDispatcher(ComRef<Dispatcher>(new Dispatcher(4)));
+
+    // One listener per schema
+    std::vector<ComRef<CountingListener>> listeners;
+    for (uint32_t i = 0; i < 16; i++) {
+        listeners.push_back(ComRef<CountingListener>(new CountingListener));
+        bridge.Register(i, listeners.back());
+    }
+
+    // Listening to all schemas
+    ComRef<CountingListener> sharedListener(new CountingListener);
+    for (uint32_t i = 0; i < 16; i++) {
+        bridge.Register(i, sharedListener);
+    }
+
+    // Commit a few times
+    for (uint32_t i = 0; i < 8; i++) {
+        AddStreams(bridge, 1024, 16);
+        bridge.Commit();
+    }
+
+    // Validate counts
+    for (const ComRef<CountingListener>& listener : listeners) {
+        REQUIRE(listener->messageCount == 8 * 64);
+        REQUIRE(listener->violationCount == 0);
+    }
+
+    REQUIRE(sharedListener->messageCount == 8 * 1024);
+    REQUIRE(sharedListener->violationCount == 0);
+}
+
+/// Records the versions of all received streams into a shared log
+class RecordingListener : public TComponent<RecordingListener>, public IBridgeListener {
+public:
+    COMPONENT(RecordingListener);
+
+    RecordingListener(std::vector<uint32_t>& log) : log(log) {
+        
+    }
+
+    void Handle(const MessageStream *streams, uint32_t count) override {
+        for (uint32_t i = 0; i < count; i++) {
+            log.push_back(streams[i].GetVersionID());
+        }
+    }
+
+    /// Shared log
+    std::vector<uint32_t>& log;
+};
+
+TEST_CASE("Bridge.Memory.Ordered") {
+    MemoryBridge bridge;
+
+    // Shared log of all handled streams
+    std::vector<uint32_t> log;
+    bridge.Register(ComRef<IBridgeListener>(new RecordingListener(log)));
+    bridge.Register(0, ComRef<IBridgeListener>(new RecordingListener(log)));
+    bridge.Register(1, ComRef<IBridgeListener>(new RecordingListener(log)));
+
+    // Unordered schemas interleaved with ordered streams, versioned by submission
+    uint32_t payload = 0;
+    for (uint32_t i = 0; i < 64; i++) {
+        MessageStream stream;
+        if (i % 5 == 4) {
+            stream.SetSchema(MessageSchema { .type = MessageSchemaType::Ordered });
+        } else {
+            stream.SetSchema(MessageSchema { .type = MessageSchemaType::Static, .id = (i * 7) % 2 });
+        }
+
+        stream.SetVersionID(i);
+        stream.SetData(&payload, sizeof(payload), 1u);
+        bridge.GetOutput()->AddStreamAndSwap(stream);
+    }
+
+    bridge.Commit();
+
+    // Everything handled once
+    REQUIRE(log.size() == 64);
+
+    // Ordered streams act as barriers, everything submitted before them is handled first, everything after last
+    for (size_t i = 0; i < log.size(); i++) {
+        if (log[i] % 5 != 4) {
+            continue;
+        }
+
+        for (size_t j = 0; j < log.size(); j++) {
+            REQUIRE((j < i) == (log[j] < log[i]));
+        }
+    }
+}
@@ -0,0 +1,112 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/NetworkCompression.h>
+#include <Bridge/NetworkProtocol.h>
+
+// Message
+#include <Message/MessageStream.h>
+
+// Std
+#include <random>
+#include <cstring>
+
+/// Fill a stream with repetitive records, mimics repeated validation messages
+static void FillRepetitive(MessageStream& stream, uint32_t recordCount) {
+    struct Record {
+        uint32_t sguid;
+        uint32_t token;
+        uint32_t coordinate[3];
+    };
+
+    auto* records = reinterpret_cast<Record*>(stream.ResizeData(sizeof(Record) * recordCount));
+    for (uint32_t i = 0; i < recordCount; i++) {
+        records[i] = Record { .sguid = 42, .token = 7, .coordinate = { i % 4, 0, 0 } };
+    }
+}
+
+TEST_CASE("Bridge.Network.Compression") {
+    MessageStream scratch;
+
+    SECTION("Repetitive") {
+        MessageStream stream(MessageSchema { .type = MessageSchemaType::Static, .id = 3 });
+        stream.SetVersionID(9);
+        FillRepetitive(stream, 10'000);
+
+        // Keep the original around
+        MessageStream original = stream;
+
+        REQUIRE(CompressMessageStreamPayload(stream, scratch));
+        REQUIRE(stream.GetByteSize() < original.GetByteSize() / 10);
+
+        // Identity is retained
+        REQUIRE(stream.GetSchema() == original.GetSchema());
+        REQUIRE(stream.GetVersionID() == 9);
+
+        // Round trip
+        MessageStream decompressed(original.GetSchema());
+        REQUIRE(DecompressMessageStreamPayload(stream.Linearize(), stream.GetByteSize(), decompressed));
+        REQUIRE(decompressed.GetByteSize() == original.GetByteSize());
+        REQUIRE(std::memcmp(decompressed.Linearize(), original.Linearize(), original.GetByteSize()) == 0);
+    }
+
+    SECTION("Below threshold") {
+        MessageStream stream;
+        FillRepetitive(stream, 16);
+
+        REQUIRE(!CompressMessageStreamPayload(stream, scratch));
+        REQUIRE(stream.GetByteSize() == 16 * 20);
+    }
+
+    SECTION("Incompressible") {
+        MessageStream stream;
+
+        std::mt19937 engine(0);
+        uint8_t* data = stream.ResizeData(64'000);
+        for (uint32_t i = 0; i < 64'000; i++) {
+            data[i] = static_cast<uint8_t>(engine());
+        }
+
+        REQUIRE(!CompressMessageStreamPayload(stream, scratch));
+        REQUIRE(stream.GetByteSize() == 64'000);
+    }
+
+    SECTION("Corrupt") {
+        MessageStream stream;
+        FillRepetitive(stream, 10'000);
+        REQUIRE(CompressMessageStreamPayload(stream, scratch));
+
+        // Claim a larger payload than encoded
+        uint8_t* data = stream.ResizeData(stream.GetByteSize());
+        reinterpret_cast<MessageStreamCompressedProtocol*>(data)->decompressedSize += 1;
+
+        MessageStream decompressed;
+        REQUIRE(!DecompressMessageStreamPayload(data, stream.GetByteSize(), decompressed));
+    }
+}
@@ -0,0 +1,198 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Bridge
+#include <Bridge/SharedMemoryBridge.h>
+#include <Bridge/IBridgeListener.h>
+
+// Message
+#include <Message/MessageStream.h>
+#include <Message/IMessageStorage.h>
+
+// Std
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Payload schema
+static constexpr uint32_t kPayloadSchema = 1;
+
+/// Create a stream with a recognizable payload
+static MessageStream CreatePayloadStream(uint32_t schemaID, uint32_t versionID, uint64_t size) {
+    MessageStream stream(MessageSchema { .type = MessageSchemaType::Static, .id = schemaID });
+    stream.SetVersionID(versionID);
+
+    uint8_t* payload = stream.ResizeData(size);
+    for (uint64_t i = 0; i < size; i++) {
+        payload[i] = static_cast<uint8_t>(versionID * 7 + i);
+    }
+
+    return stream;
+}
+
+/// Validate a stream created with CreatePayloadStream
+static bool IsPayloadStream(MessageStream& stream, uint32_t versionID, uint64_t size) {
+    if (stream.GetVersionID() != versionID || stream.GetByteSize() != size) {
+        return false;
+    }
+
+    const uint8_t* payload = stream.Linearize();
+    for (uint64_t i = 0; i < size; i++) {
+        if (payload[i] != static_cast<uint8_t>(versionID * 7 + i)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// Collects all received streams
+class CollectingListener : public TComponent<CollectingListener>, public IBridgeListener {
+public:
+    COMPONENT(CollectingListener);
+
+    void Handle(const MessageStream *streams, uint32_t count) override {
+        for (uint32_t i = 0; i < count; i++) {
+            this->streams.push_back(streams[i]);
+        }
+    }
+
+    /// Received streams
+    std::vector<MessageStream> streams;
+};
+
+TEST_CASE("Bridge.SharedMemory") {
+    // Unique segment, tests may run concurrently
+    std::string name = "GRS.Bridge.Test." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+    // Streams received by the host
+    std::mutex hostMutex;
+    std::vector<MessageStream> hostStreams;
+
+    // Small rings, streams larger than the ring are streamed through it
+    SharedMemoryBridge host;
+    host.SetStreamDelegate([&](MessageStream& stream) {
+        std::lock_guard guard(hostMutex);
+        hostStreams.emplace_back().Swap(stream);
+    });
+    REQUIRE(host.Create(name, 64'000));
+
+    SharedMemoryBridge frontend;
+    REQUIRE(frontend.Open(name));
+    REQUIRE(host.IsOpen());
+    REQUIRE(frontend.IsOpen());
+
+    // Small, wrapping and larger than the ring
+    const uint64_t sizes[] = { 16, 5'000, 200'000, 1'500'000 };
+    constexpr uint32_t kStreamCount = 32;
+
+    SECTION("Host to frontend") {
+        auto listener = ComRef<CollectingListener>(new CollectingListener);
+        frontend.Register(kPayloadSchema, listener);
+
+        // Write all streams through the output storage
+        for (uint32_t i = 0; i < kStreamCount; i++) {
+            MessageStream stream = CreatePayloadStream(kPayloadSchema, i, sizes[i % 4]);
+            host.GetOutput()->AddStreamAndSwap(stream);
+        }
+
+        host.Commit();
+
+        // Received streams are dispatched on commits
+        for (uint32_t i = 0; i < 3000 && listener->streams.size() < kStreamCount; i++) {
+            frontend.Commit();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Validate all streams, in order
+        REQUIRE(listener->streams.size() == kStreamCount);
+        for (uint32_t i = 0; i < kStreamCount; i++) {
+            REQUIRE(IsPayloadStream(listener->streams[i], i, sizes[i % 4]));
+        }
+
+        REQUIRE(host.GetInfo().bytesWritten == frontend.GetInfo().bytesRead);
+    }
+
+    SECTION("Frontend to host") {
+        std::vector<MessageStream> streams;
+        for (uint32_t i = 0; i < kStreamCount; i++) {
+            streams.push_back(CreatePayloadStream(kPayloadSchema, i, sizes[i % 4]));
+        }
+
+        REQUIRE(frontend.WriteStreams(streams.data(), kStreamCount));
+
+        // Wait for the reader
+        for (uint32_t i = 0; i < 3000; i++) {
+            std::lock_guard guard(hostMutex);
+            if (hostStreams.size() >= kStreamCount) {
+                break;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        // Validate all streams, in order
+        std::lock_guard guard(hostMutex);
+        REQUIRE(hostStreams.size() == kStreamCount);
+        for (uint32_t i = 0; i < kStreamCount; i++) {
+            REQUIRE(IsPayloadStream(hostStreams[i], i, sizes[i % 4]));
+        }
+    }
+
+    SECTION("Stopped peer") {
+        frontend.Stop();
+
+        // Writes are dropped once the peer is gone
+        MessageStream stream = CreatePayloadStream(kPayloadSchema, 0, 16);
+        REQUIRE(!host.WriteStreams(&stream, 1));
+        REQUIRE(!host.IsOpen());
+    }
+}
+
+TEST_CASE("Bridge.SharedMemory.LaggingPeer") {
+    std::string name = "GRS.Bridge.Test." + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count());
+
+    // No frontend, nothing is ever consumed
+    SharedMemoryBridge host;
+    REQUIRE(host.Create(name, 64'000));
+
+    auto streams = std::make_shared<std::vector<MessageStream>>();
+    streams->push_back(CreatePayloadStream(kPayloadSchema, 0, SharedMemoryBridge::kMaxPendingWriteSize / 4));
+
+    // Asynchronous writes never wait on the peer, the bridge is closed once too far behind
+    bool accepted = true;
+    for (uint32_t i = 0; i < 8 && accepted; i++) {
+        accepted = host.WriteStreamsAsync(streams->data(), 1u, streams);
+    }
+
+    REQUIRE(!accepted);
+    REQUIRE(!host.IsOpen());
+}
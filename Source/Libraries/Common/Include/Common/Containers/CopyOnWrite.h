@@ -0,0 +1,73 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <memory>
+#include <atomic>
+
+/// Copy on write value, shared between copies until either side writes to it
+///  ! Shared values may be read concurrently, writing requires exclusive ownership of this instance
+template<typename T>
+class CopyOnWrite {
+public:
+    CopyOnWrite() : value(std::make_shared<T>()) {
+
+    }
+
+    /// Get the value for reading, never duplicates
+    const T& Get() const {
+        return *value;
+    }
+
+    /// Accessor
+    const T* operator->() const {
+        return value.get();
+    }
+
+    /// Get the value for writing, duplicates it if shared
+    T& GetMutable() {
+        if (value.use_count() > 1) {
+            value = std::make_shared<T>(*value);
+        } else {
+            // Last owner, make sure all reads of released copies are visible
+            std::atomic_thread_fence(std::memory_order_acquire);
+        }
+
+        return *value;
+    }
+
+    /// Check if the value is shared with other copies
+    bool IsShared() const {
+        return value.use_count() > 1;
+    }
+
+private:
+    /// Shared value
+    std::shared_ptr<T> value;
+};
@@ -0,0 +1,111 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <atomic>
+
+/// Intrusive node of a multi producer single consumer queue
+struct MPSCQueueNode {
+    std::atomic<MPSCQueueNode*> next{nullptr};
+};
+
+/// Intrusive, unbounded, multi producer single consumer queue
+///  ? Push is a single exchange, producers never wait on each other or the consumer
+///  ? Pop may report an empty queue while a push is in flight, later pushes become visible once it completes
+class MPSCQueue {
+public:
+    MPSCQueue() : head(&stub), tail(&stub) {
+
+    }
+
+    /// No copy or move, nodes reference the stub
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    /// Push a node, safe from any thread
+    /// \param node node to push, owned by the queue until popped
+    void Push(MPSCQueueNode* node) {
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        // Publish the node, link the previous head
+        MPSCQueueNode* previous = head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /// Pop a node, consumer only
+    /// \return nullptr if empty or if the next node is still being pushed
+    MPSCQueueNode* Pop() {
+        MPSCQueueNode* node = tail;
+        MPSCQueueNode* next = node->next.load(std::memory_order_acquire);
+
+        // Skip the stub
+        if (node == &stub) {
+            if (!next) {
+                return nullptr;
+            }
+
+            tail = next;
+            node = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+
+        // Next node is linked?
+        if (next) {
+            tail = next;
+            return node;
+        }
+
+        // Push in flight?
+        if (node != head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        // Last node, re-insert the stub so the node can be detached
+        Push(&stub);
+
+        // Detach if the stub was linked
+        next = node->next.load(std::memory_order_acquire);
+        if (next) {
+            tail = next;
+            return node;
+        }
+
+        // Raced with a producer
+        return nullptr;
+    }
+
+private:
+    /// Producer end
+    alignas(64) std::atomic<MPSCQueueNode*> head;
+
+    /// Consumer end
+    alignas(64) MPSCQueueNode* tail;
+
+    /// Placeholder node, the queue is never without a node
+    MPSCQueueNode stub;
+};
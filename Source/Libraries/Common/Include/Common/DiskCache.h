@@ -0,0 +1,142 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Common
+#include <Common/MappedFile.h>
+
+// Std
+#include <filesystem>
+#include <unordered_map>
+#include <mutex>
+#include <cstdint>
+
+/// A single mapped cache entry
+class DiskCacheEntry {
+public:
+    /// Get the payload data
+    const uint8_t* GetData() const {
+        return file.GetData() + payloadOffset;
+    }
+
+    /// Get the payload byte size
+    uint64_t GetSize() const {
+        return file.GetSize() - payloadOffset;
+    }
+
+    /// Is this entry mapped?
+    bool IsMapped() const {
+        return file.IsMapped();
+    }
+
+private:
+    friend class DiskCache;
+
+    /// Underlying file, includes the header
+    MappedFile file;
+
+    /// Offset of the payload
+    uint64_t payloadOffset{0};
+};
+
+/// Content addressed, size bounded, on disk cache
+///  ? Entries are immutable and identified by a 64 bit key, the key must capture all inputs
+///  ? Least recently used entries are evicted once the budget is exceeded, access times are stored on the files
+///    themselves, which keeps the order across sessions and processes without a shared index
+class DiskCache {
+public:
+    /// Install this cache
+    ///  ? Indexes all existing entries, and evicts if the directory exceeds the budget
+    /// \param directory directory of all entries, created if not present
+    /// \param byteBudget maximum number of bytes of all entries
+    /// \return success state
+    bool Install(const std::filesystem::path& directory, uint64_t byteBudget);
+
+    /// Find an entry
+    ///  ? Marks the entry as most recently used
+    /// \param key the content key
+    /// \param out destination mapping, valid until released or destructed
+    /// \return false if not found or invalid
+    bool Find(uint64_t key, DiskCacheEntry& out);
+
+    /// Store an entry
+    ///  ? Existing entries are kept, safe across processes
+    /// \param key the content key
+    /// \param data payload data
+    /// \param size payload byte size
+    /// \return success state
+    bool Store(uint64_t key, const void* data, uint64_t size);
+
+    /// Evict least recently used entries until within budget
+    void Evict();
+
+    /// Get the number of bytes of all entries
+    uint64_t GetSize();
+
+    /// Get the number of entries
+    uint64_t GetCount();
+
+private:
+    /// Get the path of an entry
+    /// \param key the content key
+    /// \return entry path
+    std::filesystem::path GetEntryPath(uint64_t key) const;
+
+    /// Evict least recently used entries until within budget
+    ///  ! Mutex must be acquired
+    void EvictUnsafe();
+
+    /// Remove an entry
+    ///  ! Mutex must be acquired
+    /// \param key the content key
+    void RemoveUnsafe(uint64_t key);
+
+private:
+    struct Entry {
+        /// Byte size of the file
+        uint64_t size{0};
+
+        /// Last access time
+        std::filesystem::file_time_type lastAccess;
+    };
+
+    /// Entry directory
+    std::filesystem::path directory;
+
+    /// Maximum byte size of all entries
+    uint64_t byteBudget{0};
+
+    /// Current byte size of all entries
+    uint64_t byteSize{0};
+
+    /// All known entries
+    std::unordered_map<uint64_t, Entry> entries;
+
+    /// Shared lock
+    std::mutex mutex;
+};
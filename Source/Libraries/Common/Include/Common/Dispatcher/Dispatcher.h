@@ -40,15 +40,10 @@ class Dispatcher : public TComponent<Dispatcher> {
 public:
     COMPONENT(Dispatcher);
 
-    Dispatcher(uint32_t workerCount = 0) {
-        // Automatic worker count?
-        if (!workerCount) {
-            workerCount = std::max(1u, std::thread::hardware_concurrency() / 2u);
-        }
-
+    Dispatcher(uint32_t workerCount = 0) : pool(GetWorkerCount(workerCount)) {
         // Create workers
-        for (uint32_t i = 0; i < workerCount; i++) {
-            workers.emplace_back(pool);
+        for (uint32_t i = 0; i < pool.GetWorkerCount(); i++) {
+            workers.emplace_back(pool, i);
         }
     }
 
@@ -80,12 +75,16 @@ public:
     }
 
     /// Add a job to the dispatcher
-    /// \param job the job to be added
-    void Add(const Delegate<void(void* userData)>& delegate, void* data, DispatcherBucket* bucket = nullptr) {
+    /// \param delegate the job delegate
+    /// \param data the job user data
+    /// \param bucket optional, the completion bucket
+    /// \param priority the scheduling priority
+    void Add(const Delegate<void(void* userData)>& delegate, void* data, DispatcherBucket* bucket = nullptr, DispatcherJobPriority priority = DispatcherJobPriority::Interactive) {
         Add(DispatcherJob{
             .userData = data,
             .delegate = delegate,
-            .bucket = bucket
+            .bucket = bucket,
+            .priority = priority
         });
     }
 
@@ -102,6 +101,19 @@ public:
         return static_cast<uint32_t>(workers.size());
     }
 
+private:
+    /// Get the effective worker count
+    /// \param workerCount requested count, zero for automatic
+    static uint32_t GetWorkerCount(uint32_t workerCount) {
+        // Automatic worker count?
+        if (!workerCount) {
+            workerCount = std::max(1u, std::thread::hardware_concurrency() / 2u);
+        }
+
+        // OK
+        return workerCount;
+    }
+
 private:
     /// Shared pool
     DispatcherJobPool pool;
@@ -29,9 +29,27 @@
 // Common
 #include <Common/Delegate.h>
 
+// Std
+#include <cstdint>
+
 // Forward declarations
 struct DispatcherBucket;
 
+/// Scheduling class of a job, lower values are popped first
+enum class DispatcherJobPriority : uint8_t {
+    /// Someone is, or soon will be, waiting on the result
+    Blocking,
+
+    /// Results are needed soon, fx. recently used objects
+    Interactive,
+
+    /// No one is waiting on the result
+    Background,
+
+    /// Number of priorities
+    Count
+};
+
 struct DispatcherJob {
     /// Userdata for this job
     void* userData{nullptr};
@@ -41,4 +59,7 @@ struct DispatcherJob {
 
     /// Completion bucket
     DispatcherBucket* bucket{nullptr};
+
+    /// Scheduling priority
+    DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
 };
@@ -28,70 +28,133 @@
 
 // Common
 #include "DispatcherJob.h"
+#include "DispatcherWorkStealingDeque.h"
 #include "Mutex.h"
 #include "ConditionVariable.h"
 
 // Std
 #include <vector>
+#include <memory>
+#include <atomic>
 
 /// Job pool for all dispatcher jobs
+///  Each worker owns a work stealing deque, jobs submitted from a worker are pushed to its own deque,
+///  jobs submitted from any other thread are pushed to the shared injection queue. Idle workers steal
+///  from random victims before parking, and submissions only wake as many workers as there are new jobs.
+///  Every priority has its own set of queues, higher priorities are always drained first, except
+///  for periodic aging passes that visit the lower priorities first to avoid starvation.
 struct DispatcherJobPool {
+    /// Constructor
+    /// \param workerCount number of workers that will pop from this pool
+    DispatcherJobPool(uint32_t workerCount);
+
     /// Add a set of jobs to the pool
     /// \param jobs the jobs to submit
     /// \param count the number of jobs
-    void Add(const DispatcherJob* jobs, uint32_t count) {
-        MutexGuard guard(mutex);
-        pool.insert(pool.end(), jobs, jobs + count);
-        var.NotifyAll();
-    }
+    void Add(const DispatcherJob* jobs, uint32_t count);
 
     /// Pop a job from the pool
+    /// \param workerIndex the index of the popping worker
     /// \param out the popped job, if succeeded
     /// \return success
-    bool Pop(DispatcherJob& out) {
-        MutexGuard guard(mutex);
-
-        // Any jobs?
-        if (pool.empty()) {
-            return false;
-        }
-
-        // Pop from back
-        out = pool.back();
-        pool.pop_back();
-        return true;
-    }
+    bool Pop(uint32_t workerIndex, DispatcherJob& out);
 
     /// Perform a blocking wait for a job
+    /// \param workerIndex the index of the popping worker
     /// \param out the job
     /// \return false if abort has been signalled
-    bool PopBlocking(DispatcherJob& out);
+    bool PopBlocking(uint32_t workerIndex, DispatcherJob& out);
+
+    /// Bind the calling thread as a worker of this pool
+    /// \param workerIndex the index of the worker
+    void BindWorker(uint32_t workerIndex);
 
     /// Set the abort flag
     void Abort() {
-        MutexGuard guard(mutex);
+        MutexGuard guard(parkMutex);
         abortFlag = true;
 
         // Wake all threads
-        var.NotifyAll();
+        parkVar.NotifyAll();
     }
 
     /// Is this pool aborted?
     [[nodiscard]]
     bool IsAbort() const {
-        return abortFlag;
+        return abortFlag.load();
+    }
+
+    /// Get the number of worker queues
+    [[nodiscard]]
+    uint32_t GetWorkerCount() const {
+        return static_cast<uint32_t>(workerQueues.size());
     }
 
 private:
-    /// Pool lock
-    Mutex mutex;
+    /// Pop a job of a given priority
+    /// \param workerIndex the index of the popping worker
+    /// \param priority the priority to pop from
+    /// \param out the popped job, if succeeded
+    /// \return success
+    bool PopPriority(uint32_t workerIndex, uint32_t priority, DispatcherJob& out);
 
-    /// Exit flag for the pool
-    bool abortFlag{false};
+    /// Try to take a batch of jobs from the injection queue
+    /// \param workerIndex the index of the popping worker
+    /// \param priority the priority to pop from
+    /// \param out the first job, remaining are moved to the workers deque
+    /// \return success
+    bool PopInjection(uint32_t workerIndex, uint32_t priority, DispatcherJob& out);
 
-    /// Shared var for waits
-    ConditionVariable var;
+    /// Try to steal a job from any other worker
+    /// \param workerIndex the index of the stealing worker
+    /// \param priority the priority to steal from
+    /// \param out the stolen job
+    /// \return success
+    bool Steal(uint32_t workerIndex, uint32_t priority, DispatcherJob& out);
+
+    /// Wake up to a number of parked workers
+    /// \param count the number of submitted jobs
+    void Wake(uint32_t count);
 
-    /// Enqueued jobs
-    std::vector<DispatcherJob> pool;
+private:
+    /// Number of priorities
+    static constexpr uint32_t kPriorityCount = static_cast<uint32_t>(DispatcherJobPriority::Count);
+
+    struct alignas(64) WorkerQueue {
+        /// Local deques per priority, pushed and popped by the owning worker
+        DispatcherWorkStealingDeque<DispatcherJob> deques[kPriorityCount];
+
+        /// Random state for victim selection
+        uint32_t randomState{0};
+
+        /// Number of pops since the last aging pass
+        uint32_t agingCounter{0};
+    };
+
+    /// All worker queues
+    std::vector<std::unique_ptr<WorkerQueue>> workerQueues;
+
+    /// Injection queues per priority for jobs submitted outside the workers
+    std::vector<DispatcherJob> injectionQueues[kPriorityCount];
+
+    /// Number of injected jobs per priority, checked before acquiring the lock
+    std::atomic<uint32_t> injectionCounts[kPriorityCount]{};
+
+    /// Injection queue lock
+    Mutex injectionMutex;
+
+    /// Number of jobs in all queues, not yet popped
+    std::atomic<int64_t> queuedCount{0};
+
+    /// Number of parked workers
+    std::atomic<uint32_t> parkedCount{0};
+
+    /// Park lock
+    Mutex parkMutex;
+
+    /// Shared var for parked workers
+    ConditionVariable parkVar;
+
+    /// Exit flag for the pool
+    std::atomic<bool> abortFlag{false};
 };
@@ -0,0 +1,207 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/// Chase-Lev work stealing deque
+///  The owning thread pushes and pops from the bottom (LIFO), any other thread may steal from the top (FIFO).
+///  Elements are copied bytewise, so the element type must be trivially copyable.
+template<typename T>
+class DispatcherWorkStealingDeque {
+    static_assert(std::is_trivially_copyable_v<T>, "Work stealing elements must be trivially copyable");
+
+public:
+    /// Constructor
+    /// \param capacity initial capacity, must be a power of two
+    explicit DispatcherWorkStealingDeque(int64_t capacity = 256) {
+        buffer.store(new Buffer(capacity), std::memory_order_relaxed);
+    }
+
+    /// Destructor
+    ~DispatcherWorkStealingDeque() {
+        delete buffer.load(std::memory_order_relaxed);
+
+        // Release all retired buffers
+        for (Buffer* retired : retiredBuffers) {
+            delete retired;
+        }
+    }
+
+    /// No copy or move
+    DispatcherWorkStealingDeque(const DispatcherWorkStealingDeque& other) = delete;
+    DispatcherWorkStealingDeque& operator=(const DispatcherWorkStealingDeque& other) = delete;
+
+    /// Push an element to the bottom, owner only
+    /// \param value the value to push
+    void Push(const T& value) {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        Buffer* array = buffer.load(std::memory_order_relaxed);
+
+        // Out of space?
+        if (b - t > array->capacity - 1) {
+            array = Grow(array, t, b);
+        }
+
+        // Write element, publish it to stealers
+        array->Store(b, value);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    /// Pop an element from the bottom, owner only
+    /// \param out the popped element, if succeeded
+    /// \return success
+    bool Pop(T& out) {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* array = buffer.load(std::memory_order_relaxed);
+
+        // Reserve the bottom element
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+
+        // Empty?
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Read the element
+        out = array->Load(b);
+
+        // Not the last element? No contention with stealers
+        if (t != b) {
+            return true;
+        }
+
+        // Last element, race against stealers
+        bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return won;
+    }
+
+    /// Steal an element from the top, any thread
+    /// \param out the stolen element, if succeeded
+    /// \return success, false if empty or if the steal lost a race
+    bool Steal(T& out) {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+
+        // Empty?
+        if (t >= b) {
+            return false;
+        }
+
+        // Speculatively read the element
+        Buffer* array = buffer.load(std::memory_order_acquire);
+        T value = array->Load(t);
+
+        // Claim it
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            return false;
+        }
+
+        // OK
+        out = value;
+        return true;
+    }
+
+    /// Approximate number of elements, may be stale
+    int64_t ApproximateSize() const {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+private:
+    struct Buffer {
+        Buffer(int64_t capacity) : capacity(capacity), mask(capacity - 1) {
+            data = new T[capacity];
+        }
+
+        ~Buffer() {
+            delete[] data;
+        }
+
+        /// Store an element
+        void Store(int64_t index, const T& value) {
+            std::memcpy(static_cast<void*>(&data[index & mask]), &value, sizeof(T));
+        }
+
+        /// Load an element
+        T Load(int64_t index) const {
+            T value;
+            std::memcpy(static_cast<void*>(&value), &data[index & mask], sizeof(T));
+            return value;
+        }
+
+        /// Number of slots, always a power of two
+        int64_t capacity;
+
+        /// Slot mask
+        int64_t mask;
+
+        /// Slot data
+        T* data{nullptr};
+    };
+
+    /// Grow the buffer, owner only
+    Buffer* Grow(Buffer* array, int64_t t, int64_t b) {
+        auto* grown = new Buffer(array->capacity * 2);
+
+        // Copy all live elements
+        for (int64_t i = t; i < b; i++) {
+            grown->Store(i, array->Load(i));
+        }
+
+        // Stealers may still be reading from the old buffer, keep it alive until destruction
+        retiredBuffers.push_back(array);
+        buffer.store(grown, std::memory_order_release);
+        return grown;
+    }
+
+private:
+    /// Stealing end
+    alignas(64) std::atomic<int64_t> top{0};
+
+    /// Owning end
+    alignas(64) std::atomic<int64_t> bottom{0};
+
+    /// Current buffer
+    std::atomic<Buffer*> buffer{nullptr};
+
+    /// All retired buffers, owner only
+    std::vector<Buffer*> retiredBuffers;
+};
@@ -37,7 +37,7 @@
 /// Simple dispatcher worker
 class DispatcherWorker {
 public:
-    DispatcherWorker(DispatcherJobPool& pool) : pool(pool) {
+    DispatcherWorker(DispatcherJobPool& pool, uint32_t workerIndex) : pool(pool), workerIndex(workerIndex) {
         thread = std::thread(&DispatcherWorker::ThreadEntry, this);
     }
 
@@ -53,11 +53,14 @@ public:
 
 private:
     void ThreadEntry() {
+        // Submissions from this thread go to our own queue
+        pool.BindWorker(workerIndex);
+
         for (;;) {
             DispatcherJob job;
 
             // Blocking pop, false indicates abort condition
-            if (!pool.PopBlocking(job)) {
+            if (!pool.PopBlocking(workerIndex, job)) {
                 return;
             }
 
@@ -77,4 +80,7 @@ private:
 
     /// Shared pool
     DispatcherJobPool& pool;
+
+    /// Index of this worker within the pool
+    uint32_t workerIndex;
 };
\ No newline at end of file
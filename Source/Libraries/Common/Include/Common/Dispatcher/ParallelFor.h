@@ -0,0 +1,125 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+#include <Common/Dispatcher/Event.h>
+
+// Std
+#include <atomic>
+#include <functional>
+#include <algorithm>
+
+/// User functor, invoked once per index
+using ParallelForFunctor = std::function<void(uint32_t index)>;
+
+namespace Detail {
+    /// Shared state of a parallel range, outlives the caller if helpers are still queued
+    struct ParallelForState {
+        /// Invoke indices until the range is exhausted
+        void Drain() {
+            for (uint32_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+                functor(index);
+
+                // Last index completed?
+                if (completed.fetch_add(1) + 1 == count) {
+                    event.Signal();
+                }
+            }
+        }
+
+        /// Release a reference
+        void Release() {
+            if (references.fetch_sub(1) == 1) {
+                delete this;
+            }
+        }
+
+        /// Helper job entry point
+        void Run(void*) {
+            Drain();
+            Release();
+        }
+
+        /// User functor
+        ParallelForFunctor functor;
+
+        /// Number of indices
+        uint32_t count{0};
+
+        /// Next index to be invoked
+        std::atomic<uint32_t> next{0};
+
+        /// Number of completed indices
+        std::atomic<uint32_t> completed{0};
+
+        /// Number of outstanding references
+        std::atomic<uint32_t> references{0};
+
+        /// Signalled on range completion
+        Event event;
+    };
+}
+
+/// Invoke a functor for each index in [0, count) across the dispatcher workers
+///   ? The calling thread participates, and only waits for indices already being invoked,
+///     which makes it safe to call from within dispatcher jobs
+/// \param dispatcher the dispatcher to schedule helpers on, if null the range is invoked serially
+/// \param count number of indices
+/// \param functor the functor to invoke
+inline void ParallelFor(Dispatcher* dispatcher, uint32_t count, const ParallelForFunctor& functor) {
+    // Not worth scheduling?
+    if (!dispatcher || count < 2) {
+        for (uint32_t i = 0; i < count; i++) {
+            functor(i);
+        }
+        return;
+    }
+
+    // One helper less than the range, the caller takes part
+    uint32_t helperCount = std::min(dispatcher->WorkerCount(), count - 1);
+
+    // Create state, referenced by all helpers and the caller
+    auto* state = new Detail::ParallelForState();
+    state->functor = functor;
+    state->count = count;
+    state->references = helperCount + 1;
+
+    // Submit helpers, someone is waiting on them
+    for (uint32_t i = 0; i < helperCount; i++) {
+        dispatcher->Add(BindDelegate(state, Detail::ParallelForState::Run), nullptr, nullptr, DispatcherJobPriority::Blocking);
+    }
+
+    // Take part in the range, then wait for the stragglers
+    state->Drain();
+    state->event.Wait();
+
+    // Helpers that have not started yet find an exhausted range
+    state->Release();
+}
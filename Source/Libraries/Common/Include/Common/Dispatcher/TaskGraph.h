@@ -0,0 +1,266 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+#include <Common/Dispatcher/DispatcherBucket.h>
+#include <Common/Containers/LinearBlockAllocator.h>
+
+// Std
+#include <atomic>
+
+/// User functor
+using TaskGraphFunctor = Delegate<void(DispatcherBucket* bucket, void* userData)>;
+
+/// Number of successors per edge chunk
+static constexpr uint32_t kTaskGraphEdgeChunkSize = 6;
+
+/// Single node in a task graph
+///  A node is complete once its functor, and all jobs submitted with its bucket, have completed.
+struct TaskGraphNode {
+    struct EdgeChunk {
+        /// All successors in this chunk
+        TaskGraphNode* successors[kTaskGraphEdgeChunkSize];
+
+        /// Number of successors in this chunk
+        uint32_t count{0};
+
+        /// Next chunk
+        EdgeChunk* next{nullptr};
+    };
+
+    /// User functor
+    TaskGraphFunctor functor;
+
+    /// User data for the functor
+    void* userData{nullptr};
+
+    /// Completion bucket, may be used by the functor to extend the lifetime of the node
+    DispatcherBucket bucket;
+
+    /// Number of incomplete predecessors
+    std::atomic<uint32_t> pendingDependencies{0};
+
+    /// Scheduling priority
+    DispatcherJobPriority priority{DispatcherJobPriority::Interactive};
+
+    /// Successor chunks, immutable after commit
+    EdgeChunk* edges{nullptr};
+
+    /// Next node in the graph
+    TaskGraphNode* next{nullptr};
+};
+
+/// Dependency graph of tasks
+///  Nodes and edges are created up front, after which the graph is committed. Each node keeps an atomic
+///  dependency counter, the last completing predecessor submits it, so no locks are taken while running.
+///  The graph releases itself once all nodes have completed.
+class TaskGraph {
+public:
+    TaskGraph(Dispatcher* dispatcher) {
+        controller = new (dispatcher->allocators) Controller(dispatcher);
+    }
+
+    ~TaskGraph() {
+        // Never committed? Nothing owns the controller
+        if (controller) {
+            controller->Release();
+        }
+    }
+
+    /// No copy or move
+    TaskGraph(const TaskGraph& other) = delete;
+    TaskGraph(TaskGraph&& other) = delete;
+
+    /// No copy or move assignment
+    TaskGraph& operator=(const TaskGraph& other) = delete;
+    TaskGraph& operator=(TaskGraph&& other) = delete;
+
+    /// Add a node, not thread safe
+    /// \param delegate the task delegate
+    /// \param userData optional, the user data for the task
+    /// \param priority the scheduling priority
+    /// \return the node
+    TaskGraphNode* Add(const TaskGraphFunctor& delegate, void* userData, DispatcherJobPriority priority = DispatcherJobPriority::Interactive) {
+        return controller->AddNode(delegate, userData, priority);
+    }
+
+    /// Add a dependency between two nodes, not thread safe
+    /// \param before the node to complete first
+    /// \param after the node to start after completion
+    void AddDependency(TaskGraphNode* before, TaskGraphNode* after) {
+        controller->AddEdge(before, after);
+    }
+
+    /// Commit all nodes, the graph may not be modified after this
+    /// \param parent optional, bucket kept alive until all nodes have completed
+    void Commit(DispatcherBucket* parent = nullptr) {
+        Controller* committed = controller;
+
+        // Ownership is passed to the running graph
+        controller = nullptr;
+        committed->Commit(parent);
+    }
+
+private:
+    struct Controller {
+        Controller(Dispatcher* dispatcher) : dispatcher(dispatcher), allocator(dispatcher->allocators) {
+
+        }
+
+        /// Add a new node
+        TaskGraphNode* AddNode(const TaskGraphFunctor& delegate, void* userData, DispatcherJobPriority priority) {
+            auto* node = allocator.Allocate<TaskGraphNode>();
+            node->functor = delegate;
+            node->userData = userData;
+            node->priority = priority;
+
+            // Completion handler
+            node->bucket.userData = node;
+            node->bucket.completionFunctor = BindDelegate(this, Controller::OnNodeCompleted);
+
+            // Link into the node list
+            node->next = nodes;
+            nodes = node;
+            nodeCount++;
+            return node;
+        }
+
+        /// Add a new edge
+        void AddEdge(TaskGraphNode* before, TaskGraphNode* after) {
+            // Head chunk full?
+            if (!before->edges || before->edges->count == kTaskGraphEdgeChunkSize) {
+                auto* chunk = allocator.Allocate<TaskGraphNode::EdgeChunk>();
+                chunk->next = before->edges;
+                before->edges = chunk;
+            }
+
+            // Append successor
+            before->edges->successors[before->edges->count++] = after;
+            after->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /// Commit all nodes
+        void Commit(DispatcherBucket* parent) {
+            parentBucket = parent;
+
+            // Keep the parent alive until completion
+            if (parentBucket) {
+                parentBucket->Increment();
+            }
+
+            // Guard against completion while submitting
+            remainingNodes.store(nodeCount + 1);
+
+            // Submit all roots
+            for (TaskGraphNode* node = nodes; node; node = node->next) {
+                if (!node->pendingDependencies.load(std::memory_order_relaxed)) {
+                    Submit(node);
+                }
+            }
+
+            // Release guard
+            OnNodeReleased();
+        }
+
+        /// Submit a node to the dispatcher
+        void Submit(TaskGraphNode* node) {
+            dispatcher->Add(DispatcherJob {
+                .userData = node,
+                .delegate = BindDelegate(this, Controller::NodeEntry),
+                .bucket = &node->bucket,
+                .priority = node->priority
+            });
+        }
+
+        /// Node entry point
+        void NodeEntry(void* data) {
+            auto* node = static_cast<TaskGraphNode*>(data);
+            node->functor.Invoke(&node->bucket, node->userData);
+        }
+
+        /// Invoked once a node, and all its bucket jobs, have completed
+        void OnNodeCompleted(void* data) {
+            auto* node = static_cast<TaskGraphNode*>(data);
+
+            // Submit all successors for which this was the last dependency
+            for (TaskGraphNode::EdgeChunk* chunk = node->edges; chunk; chunk = chunk->next) {
+                for (uint32_t i = 0; i < chunk->count; i++) {
+                    TaskGraphNode* successor = chunk->successors[i];
+                    if (successor->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        Submit(successor);
+                    }
+                }
+            }
+
+            // Done with this node
+            OnNodeReleased();
+        }
+
+        /// Invoked once a node has been released
+        void OnNodeReleased() {
+            if (remainingNodes.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+
+            // Release before signalling, the parent may destroy the owner
+            DispatcherBucket* parent = parentBucket;
+            Release();
+
+            // Signal parent
+            if (parent) {
+                parent->Decrement();
+            }
+        }
+
+        /// Destruct this controller
+        void Release() {
+            destroy(this, dispatcher->allocators);
+        }
+
+        /// Owning dispatcher
+        Dispatcher* dispatcher{nullptr};
+
+        /// Node and edge storage, released with the controller
+        LinearBlockAllocator<4096> allocator;
+
+        /// All nodes
+        TaskGraphNode* nodes{nullptr};
+
+        /// Number of nodes
+        uint32_t nodeCount{0};
+
+        /// Number of nodes not yet completed
+        std::atomic<uint32_t> remainingNodes{0};
+
+        /// Optional parent bucket
+        DispatcherBucket* parentBucket{nullptr};
+    };
+
+    Controller* controller{nullptr};
+};
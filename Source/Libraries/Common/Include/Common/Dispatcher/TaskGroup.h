@@ -27,23 +27,16 @@
 #pragma once
 
 // Common
-#include <Common/Dispatcher/Dispatcher.h>
-#include <Common/Dispatcher/DispatcherBucket.h>
-
-// Std
-#include <atomic>
+#include <Common/Dispatcher/TaskGraph.h>
 
 /// User functor
-using TaskGroupFunctor = Delegate<void(DispatcherBucket* bucket, void* userData)>;
+using TaskGroupFunctor = TaskGraphFunctor;
 
+/// Linear chain of tasks, each link starts once the previous link and all its bucket jobs have completed
 class TaskGroup {
 public:
-    TaskGroup(Dispatcher* dispatcher) {
-        controller = new (dispatcher->allocators) Controller(dispatcher);
-    }
+    TaskGroup(Dispatcher* dispatcher) : graph(dispatcher) {
 
-    ~TaskGroup() {
-        controller->Detach();
     }
 
     /// No copy or move
@@ -58,114 +51,31 @@ public:
     /// \param delegate the task delegate
     /// \param userData optional, the user data for the task
     void Chain(const TaskGroupFunctor& delegate, void* userData) {
-        controller->AddLink(delegate, userData);
+        // Links only schedule further work, don't let them wait behind it
+        TaskGraphNode* node = graph.Add(delegate, userData, DispatcherJobPriority::Blocking);
+
+        // Depend on the previous link
+        if (tail) {
+            graph.AddDependency(tail, node);
+        }
+
+        tail = node;
     }
 
     /// Commit all tasks
     void Commit() {
-        controller->Commit();
+        graph.Commit();
     }
 
     /// Get the current bucket, must be disposed of before the last chain finishes
     DispatcherBucket* GetBucket() {
-        return &controller->bucket;
+        return tail ? &tail->bucket : nullptr;
     }
 
 private:
-    struct Controller {
-        struct LinkData {
-            TaskGroupFunctor functor;
-            void* userData{nullptr};
-            DispatcherBucket* bucket{ nullptr };
-        };
-
-        Controller(Dispatcher* dispatcher) : dispatcher(dispatcher) {
-            bucket.userData = nullptr;
-            bucket.completionFunctor = BindDelegate(this, Controller::OnLinkCompleted);
-        }
-
-        /// Invoked once a link has been completed
-        void OnLinkCompleted(void*) {
-            // Out of jobs?
-            mutex.lock();
-            if (jobs.empty()) {
-                mutex.unlock();
-
-                // Release the controller
-                Release();
-                return;
-            }
-
-            // Pop the job
-            DispatcherJob job = jobs.front();
-            jobs.pop_front();
-
-            // Submit!
-            dispatcher->Add(job);
-            mutex.unlock();
-        }
-
-        /// Link entry point
-        void LinkEntry(void* data) {
-            auto* linkData = static_cast<LinkData*>(data);
-            linkData->functor.Invoke(linkData->bucket, linkData->userData);
-            destroy(linkData, dispatcher->allocators);
-        }
-
-        /// Add a link to the controller
-        /// \param delegate the task delegate
-        /// \param userData optional, the user data for the task
-        void AddLink(const TaskGroupFunctor& delegate, void* userData) {
-            std::lock_guard lock(mutex);
-
-            auto linkData = new (dispatcher->allocators) LinkData;
-            linkData->functor = delegate;
-            linkData->userData = userData;
-            linkData->bucket = &bucket;
-
-            jobs.push_back(DispatcherJob {
-                .userData = linkData,
-                .delegate = BindDelegate(this, Controller::LinkEntry),
-                .bucket = &bucket
-            });
-
-            anyLinks = true;
-        }
-
-        /// Commit all jobs
-        void Commit() {
-            // Ignore if empty
-            if (jobs.empty()) {
-                return;
-            }
-
-            /// Pop the first job
-            DispatcherJob job = jobs.front();
-            jobs.pop_front();
-
-            // Submit!
-            dispatcher->Add(job);
-        }
-
-        /// Detach from the TaskGroup
-        void Detach() {
-            // If no links have been submitted, release the controller
-            if (!anyLinks) {
-                Release();
-            }
-        }
-
-        /// Destruct this controller
-        void Release() {
-            destroy(this, dispatcher->allocators);
-        }
-
-        std::mutex mutex;
-        Dispatcher* dispatcher{nullptr};
-        std::list<DispatcherJob> jobs;
-        bool anyLinks{false};
-        DispatcherBucket bucket;
-    };
+    /// Underlying graph
+    TaskGraph graph;
 
-    Controller* controller{nullptr};
-};
\ No newline at end of file
+    /// Last chained node
+    TaskGraphNode* tail{nullptr};
+};
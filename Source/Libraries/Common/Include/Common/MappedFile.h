@@ -0,0 +1,88 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#pragma once
+
+// Std
+#include <filesystem>
+#include <cstdint>
+
+/// Read only, memory mapped file
+class MappedFile {
+public:
+    /// Constructor
+    MappedFile() = default;
+
+    /// Destructor
+    ~MappedFile();
+
+    /// No copy
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// Map an existing file
+    ///  ? Empty files are never mapped
+    /// \param path path of the file
+    /// \return success state
+    bool Open(const std::filesystem::path& path);
+
+    /// Release the file mapping
+    void Release();
+
+    /// Get the mapped data
+    const uint8_t* GetData() const {
+        return data;
+    }
+
+    /// Get the mapped byte size
+    uint64_t GetSize() const {
+        return size;
+    }
+
+    /// Is this file mapped?
+    bool IsMapped() const {
+        return data != nullptr;
+    }
+
+private:
+    /// Mapped view
+    const uint8_t* data{nullptr};
+
+    /// Mapped byte size
+    uint64_t size{0};
+
+#ifdef _WIN64
+    /// File handle
+    void* file{nullptr};
+
+    /// Mapping handle
+    void* handle{nullptr};
+#else // _WIN64
+    /// File descriptor
+    int fd{-1};
+#endif // _WIN64
+};
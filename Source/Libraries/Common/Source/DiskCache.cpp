@@ -0,0 +1,273 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Common/DiskCache.h>
+#include <Common/CRC.h>
+
+// Std
+#include <fstream>
+#include <algorithm>
+#include <vector>
+#include <cstdio>
+#include <random>
+
+/// Entry file magic
+static constexpr uint32_t kDiskCacheMagic = 0x43535247;
+
+/// Header of each entry file
+struct DiskCacheHeader {
+    /// Must be kDiskCacheMagic
+    uint32_t magic{kDiskCacheMagic};
+
+    /// CRC of the payload, guards against truncated or partially written files
+    uint32_t crc{0};
+
+    /// Content key, guards against renamed files
+    uint64_t key{0};
+
+    /// Byte size of the payload
+    uint64_t size{0};
+};
+
+/// Compute the payload crc
+static uint32_t GetPayloadCRC(const void* data, uint64_t size) {
+    uint32_t crc = BufferCRC32LongStart();
+
+    // Long crc's are 32 bit bounded
+    for (uint64_t offset = 0; offset < size; offset += UINT32_MAX) {
+        crc = BufferCRC32Long(static_cast<const uint8_t*>(data) + offset, static_cast<uint32_t>(std::min<uint64_t>(size - offset, UINT32_MAX)), crc);
+    }
+
+    return crc;
+}
+
+bool DiskCache::Install(const std::filesystem::path &path, uint64_t budget) {
+    directory = path;
+    byteBudget = budget;
+
+    // Make sure it exists
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (!std::filesystem::is_directory(directory, error)) {
+        return false;
+    }
+
+    std::lock_guard guard(mutex);
+
+    // Index all entries
+    for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(directory, error)) {
+        if (!file.is_regular_file(error) || file.path().extension() != ".bin") {
+            continue;
+        }
+
+        // Entries are named by their key
+        std::string stem = file.path().stem().string();
+        if (stem.length() != 16 || stem.find_first_not_of("0123456789abcdef") != std::string::npos) {
+            continue;
+        }
+
+        // Add entry
+        Entry& entry = entries[std::stoull(stem, nullptr, 16)];
+        entry.size = file.file_size(error);
+        entry.lastAccess = file.last_write_time(error);
+        byteSize += entry.size;
+    }
+
+    // Previous sessions may have had a larger budget
+    EvictUnsafe();
+
+    // OK
+    return true;
+}
+
+bool DiskCache::Find(uint64_t key, DiskCacheEntry &out) {
+    std::filesystem::path path = GetEntryPath(key);
+
+    // May have been stored by another process, always consult the file system
+    if (!out.file.Open(path)) {
+        std::lock_guard guard(mutex);
+        RemoveUnsafe(key);
+        return false;
+    }
+
+    // Validate the header
+    auto header = reinterpret_cast<const DiskCacheHeader*>(out.file.GetData());
+    if (out.file.GetSize() < sizeof(DiskCacheHeader) ||
+        header->magic != kDiskCacheMagic ||
+        header->key != key ||
+        header->size != out.file.GetSize() - sizeof(DiskCacheHeader) ||
+        header->crc != GetPayloadCRC(header + 1, header->size)) {
+        out.file.Release();
+
+        // Corrupt, never valid again
+        std::lock_guard guard(mutex);
+        RemoveUnsafe(key);
+        return false;
+    }
+
+    // Mark as most recently used, failure only affects the eviction order
+    std::error_code error;
+    std::filesystem::file_time_type now = std::filesystem::file_time_type::clock::now();
+    std::filesystem::last_write_time(path, now, error);
+
+    // Update index
+    std::lock_guard guard(mutex);
+    if (auto it = entries.find(key); it != entries.end()) {
+        it->second.lastAccess = now;
+    } else {
+        entries[key] = Entry {
+            .size = out.file.GetSize(),
+            .lastAccess = now
+        };
+
+        byteSize += out.file.GetSize();
+    }
+
+    // OK
+    out.payloadOffset = sizeof(DiskCacheHeader);
+    return true;
+}
+
+bool DiskCache::Store(uint64_t key, const void *data, uint64_t size) {
+    std::filesystem::path path = GetEntryPath(key);
+
+    // Would never fit
+    if (sizeof(DiskCacheHeader) + size > byteBudget) {
+        return false;
+    }
+
+    // Entries are immutable, nothing to do if already present
+    std::error_code error;
+    if (std::filesystem::exists(path, error)) {
+        return true;
+    }
+
+    // Setup header
+    DiskCacheHeader header;
+    header.crc = GetPayloadCRC(data, size);
+    header.key = key;
+    header.size = size;
+
+    // Write to a unique intermediate file, concurrent writers never see partial entries
+    char intermediateName[64];
+    std::snprintf(intermediateName, sizeof(intermediateName), "%016llx.%08x.tmp", static_cast<unsigned long long>(key), std::random_device{}());
+    std::filesystem::path intermediatePath = directory / intermediateName;
+    {
+        std::ofstream stream(intermediatePath, std::ios::out | std::ios::binary);
+        stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+
+        // Failed to write?
+        if (!stream.good()) {
+            stream.close();
+            std::filesystem::remove(intermediatePath, error);
+            return false;
+        }
+    }
+
+    // Publish the entry
+    std::filesystem::rename(intermediatePath, path, error);
+    if (error) {
+        // Another writer may have published it first
+        std::filesystem::remove(intermediatePath, error);
+        return std::filesystem::exists(path, error);
+    }
+
+    std::lock_guard guard(mutex);
+
+    // Add to index
+    if (!entries.count(key)) {
+        entries[key] = Entry {
+            .size = sizeof(DiskCacheHeader) + size,
+            .lastAccess = std::filesystem::file_time_type::clock::now()
+        };
+
+        byteSize += sizeof(DiskCacheHeader) + size;
+    }
+
+    // Keep within budget
+    EvictUnsafe();
+
+    // OK
+    return true;
+}
+
+void DiskCache::Evict() {
+    std::lock_guard guard(mutex);
+    EvictUnsafe();
+}
+
+uint64_t DiskCache::GetSize() {
+    std::lock_guard guard(mutex);
+    return byteSize;
+}
+
+uint64_t DiskCache::GetCount() {
+    std::lock_guard guard(mutex);
+    return entries.size();
+}
+
+std::filesystem::path DiskCache::GetEntryPath(uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return directory / name;
+}
+
+void DiskCache::EvictUnsafe() {
+    if (byteSize <= byteBudget) {
+        return;
+    }
+
+    // Sort by access time, oldest first
+    std::vector<std::pair<std::filesystem::file_time_type, uint64_t>> order;
+    order.reserve(entries.size());
+    for (auto&& [key, entry] : entries) {
+        order.emplace_back(entry.lastAccess, key);
+    }
+    std::sort(order.begin(), order.end());
+
+    // Evict below the budget, avoids evicting on every subsequent store
+    uint64_t target = byteBudget - byteBudget / 4;
+    for (auto&& [lastAccess, key] : order) {
+        if (byteSize <= target) {
+            break;
+        }
+
+        RemoveUnsafe(key);
+    }
+}
+
+void DiskCache::RemoveUnsafe(uint64_t key) {
+    std::error_code error;
+    std::filesystem::remove(GetEntryPath(key), error);
+
+    // Remove from index
+    if (auto it = entries.find(key); it != entries.end()) {
+        byteSize -= it->second.size;
+        entries.erase(it);
+    }
+}
@@ -26,20 +26,235 @@
 
 #include <Common/Dispatcher/DispatcherJobPool.h>
 
-bool DispatcherJobPool::PopBlocking(DispatcherJob &out) {
-    // Wait for item or abort signal
-    std::unique_lock lock(mutex.Get());
-    var.Get().wait(lock, [this] {
-        return !pool.empty() || abortFlag;
-    });
-
-    // Abort?
-    if (abortFlag) {
+// Std
+#include <algorithm>
+
+/// Maximum number of jobs taken from the injection queue in one go
+static constexpr uint32_t kInjectionBatchLimit = 32;
+
+/// Number of failed steal sweeps before parking
+static constexpr uint32_t kStealSweepCount = 2;
+
+/// Number of pops between aging passes, an aging pass visits the lowest priority first
+static constexpr uint32_t kAgingInterval = 16;
+
+/// Calling worker context
+struct DispatcherWorkerContext {
+    /// Owning pool of the calling worker
+    DispatcherJobPool* pool{nullptr};
+
+    /// Index of the calling worker
+    uint32_t workerIndex{0};
+};
+
+/// Calling thread context, only bound for workers
+static thread_local DispatcherWorkerContext workerContext;
+
+DispatcherJobPool::DispatcherJobPool(uint32_t workerCount) {
+    workerQueues.resize(workerCount);
+
+    // Create all worker queues
+    for (uint32_t i = 0; i < workerCount; i++) {
+        workerQueues[i] = std::make_unique<WorkerQueue>();
+        workerQueues[i]->randomState = 0x9E3779B9u * (i + 1);
+    }
+}
+
+void DispatcherJobPool::BindWorker(uint32_t workerIndex) {
+    workerContext.pool = this;
+    workerContext.workerIndex = workerIndex;
+}
+
+void DispatcherJobPool::Add(const DispatcherJob* jobs, uint32_t count) {
+    if (!count) {
+        return;
+    }
+
+    // Submitted from one of our own workers? Push to its local deque, no locking needed
+    if (workerContext.pool == this) {
+        WorkerQueue& queue = *workerQueues[workerContext.workerIndex];
+        for (uint32_t i = 0; i < count; i++) {
+            queue.deques[static_cast<uint32_t>(jobs[i].priority)].Push(jobs[i]);
+        }
+    } else {
+        MutexGuard guard(injectionMutex);
+        for (uint32_t i = 0; i < count; i++) {
+            injectionQueues[static_cast<uint32_t>(jobs[i].priority)].push_back(jobs[i]);
+            injectionCounts[static_cast<uint32_t>(jobs[i].priority)].fetch_add(1);
+        }
+    }
+
+    // Mark as visible before checking the parked workers
+    queuedCount.fetch_add(count);
+
+    // Wake only as many as needed
+    Wake(count);
+}
+
+void DispatcherJobPool::Wake(uint32_t count) {
+    // No one parked? Running workers will find the jobs
+    uint32_t parked = parkedCount.load();
+    if (!parked) {
+        return;
+    }
+
+    MutexGuard guard(parkMutex);
+
+    // Targeted wakeup, never more than the number of jobs
+    if (count >= parked) {
+        parkVar.NotifyAll();
+    } else {
+        for (uint32_t i = 0; i < count; i++) {
+            parkVar.NotifyOne();
+        }
+    }
+}
+
+bool DispatcherJobPool::Pop(uint32_t workerIndex, DispatcherJob& out) {
+    WorkerQueue& queue = *workerQueues[workerIndex];
+
+    // Aging pass? Let the lowest priorities go first once in a while
+    if (++queue.agingCounter >= kAgingInterval) {
+        queue.agingCounter = 0;
+
+        // Lowest to highest
+        for (uint32_t priority = kPriorityCount; priority-- > 0;) {
+            if (PopPriority(workerIndex, priority, out)) {
+                return true;
+            }
+        }
+
+        // Nothing found
+        return false;
+    }
+
+    // Highest to lowest
+    for (uint32_t priority = 0; priority < kPriorityCount; priority++) {
+        if (PopPriority(workerIndex, priority, out)) {
+            return true;
+        }
+    }
+
+    // Nothing found
+    return false;
+}
+
+bool DispatcherJobPool::PopPriority(uint32_t workerIndex, uint32_t priority, DispatcherJob& out) {
+    WorkerQueue& queue = *workerQueues[workerIndex];
+
+    // Local deque first, most recent job is the hottest in cache
+    if (queue.deques[priority].Pop(out)) {
+        queuedCount.fetch_sub(1);
+        return true;
+    }
+
+    // Then anything submitted from outside
+    if (PopInjection(workerIndex, priority, out)) {
+        return true;
+    }
+
+    // Finally, steal from others
+    for (uint32_t sweep = 0; sweep < kStealSweepCount; sweep++) {
+        if (Steal(workerIndex, priority, out)) {
+            return true;
+        }
+    }
+
+    // Nothing found
+    return false;
+}
+
+bool DispatcherJobPool::PopInjection(uint32_t workerIndex, uint32_t priority, DispatcherJob& out) {
+    // Early out, avoids the lock if nothing was injected
+    if (!injectionCounts[priority].load()) {
         return false;
     }
 
-    // Pop back
-    out = pool.back();
-    pool.pop_back();
+    MutexGuard guard(injectionMutex);
+
+    // Get queue
+    std::vector<DispatcherJob>& injectionQueue = injectionQueues[priority];
+
+    // Any jobs?
+    if (injectionQueue.empty()) {
+        return false;
+    }
+
+    // Take a fair share of the queue, so a large batch spreads across workers without
+    // every worker coming back to the lock for each job
+    auto take = std::min<size_t>(kInjectionBatchLimit, std::max<size_t>(1u, injectionQueue.size() / workerQueues.size()));
+
+    // Pop the first from back
+    out = injectionQueue.back();
+    injectionQueue.pop_back();
+
+    // Move the rest to the local deque, where others may steal them
+    WorkerQueue& queue = *workerQueues[workerIndex];
+    for (size_t i = 1; i < take; i++) {
+        queue.deques[priority].Push(injectionQueue.back());
+        injectionQueue.pop_back();
+    }
+
+    // Remove all taken jobs from the injection count
+    injectionCounts[priority].fetch_sub(static_cast<uint32_t>(take));
+
+    // Only the popped job is accounted for, the rest are still queued
+    queuedCount.fetch_sub(1);
     return true;
 }
+
+bool DispatcherJobPool::Steal(uint32_t workerIndex, uint32_t priority, DispatcherJob& out) {
+    WorkerQueue& queue = *workerQueues[workerIndex];
+
+    auto count = static_cast<uint32_t>(workerQueues.size());
+    if (count <= 1) {
+        return false;
+    }
+
+    // Xorshift, random victim to avoid all thieves hitting the same worker
+    uint32_t& state = queue.randomState;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    // Visit all other workers, starting from the random victim
+    uint32_t start = state % count;
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t victim = (start + i) % count;
+        if (victim == workerIndex) {
+            continue;
+        }
+
+        // Try to steal
+        if (workerQueues[victim]->deques[priority].Steal(out)) {
+            queuedCount.fetch_sub(1);
+            return true;
+        }
+    }
+
+    // Nothing found
+    return false;
+}
+
+bool DispatcherJobPool::PopBlocking(uint32_t workerIndex, DispatcherJob& out) {
+    for (;;) {
+        // Abort?
+        if (abortFlag.load()) {
+            return false;
+        }
+
+        // Try to find any job
+        if (Pop(workerIndex, out)) {
+            return true;
+        }
+
+        // Park until there's work, the parked count is visible before re-checking the queued count,
+        // so a concurrent submission either sees this worker parked or this worker sees its job
+        std::unique_lock lock(parkMutex.Get());
+        parkedCount.fetch_add(1);
+        parkVar.Get().wait(lock, [this] {
+            return queuedCount.load() > 0 || abortFlag.load();
+        });
+        parkedCount.fetch_sub(1);
+    }
+}
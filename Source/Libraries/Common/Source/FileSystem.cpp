@@ -44,8 +44,8 @@ std::filesystem::path GetCurrentExecutableDirectory() {
         return {};
     }
 #else
-    char buffer[FILENAME_MAX];
-    const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
+    char buffer[FILENAME_MAX]{};
+    const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
     if (length <= 0) {
         return {};
     }
@@ -62,8 +62,8 @@ std::string GetCurrentExecutableName() {
         return {};
     }
 #else
-    char buffer[FILENAME_MAX];
-    const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer));
+    char buffer[FILENAME_MAX]{};
+    const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
     if (length <= 0) {
         return {};
     }
@@ -0,0 +1,129 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <Common/MappedFile.h>
+
+// System
+#ifdef _WIN64
+#include <Windows.h>
+#else // _WIN64
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif // _WIN64
+
+MappedFile::~MappedFile() {
+    Release();
+}
+
+bool MappedFile::Open(const std::filesystem::path &path) {
+    Release();
+
+#ifdef _WIN64
+    // Allow concurrent readers, and deletion of the file while mapped
+    file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        return false;
+    }
+
+    // Get the file size
+    LARGE_INTEGER fileSize{};
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0) {
+        Release();
+        return false;
+    }
+
+    // Create the read only mapping
+    handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!handle) {
+        Release();
+        return false;
+    }
+
+    // Map the entire file
+    data = static_cast<const uint8_t*>(MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0));
+    size = static_cast<uint64_t>(fileSize.QuadPart);
+#else // _WIN64
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Get the file size
+    struct stat status{};
+    if (fstat(fd, &status) != 0 || status.st_size <= 0) {
+        Release();
+        return false;
+    }
+
+    // Map the entire file
+    void* view = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    data = view != MAP_FAILED ? static_cast<const uint8_t*>(view) : nullptr;
+    size = status.st_size;
+#endif // _WIN64
+
+    // Mapped?
+    if (!data) {
+        Release();
+        return false;
+    }
+
+    // OK
+    return true;
+}
+
+void MappedFile::Release() {
+#ifdef _WIN64
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+
+    if (handle) {
+        CloseHandle(handle);
+        handle = nullptr;
+    }
+
+    if (file) {
+        CloseHandle(file);
+        file = nullptr;
+    }
+#else // _WIN64
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+#endif // _WIN64
+
+    data = nullptr;
+    size = 0;
+}
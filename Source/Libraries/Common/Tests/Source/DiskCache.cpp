@@ -0,0 +1,145 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/DiskCache.h>
+
+// Std
+#include <vector>
+#include <cstring>
+#include <thread>
+#include <random>
+
+/// Create a unique, empty cache directory
+static std::filesystem::path CreateTestDirectory() {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / ("GRS.DiskCache." + std::to_string(std::random_device{}()));
+    std::filesystem::remove_all(path);
+    return path;
+}
+
+TEST_CASE("Common.DiskCache") {
+    std::filesystem::path path = CreateTestDirectory();
+
+    std::vector<uint32_t> payload(256);
+    for (uint32_t i = 0; i < payload.size(); i++) {
+        payload[i] = i * 3;
+    }
+
+    {
+        DiskCache cache;
+        REQUIRE(cache.Install(path, 1u << 20));
+
+        // Nothing present
+        DiskCacheEntry missing;
+        REQUIRE(!cache.Find(0x1, missing));
+
+        // Store and map back
+        REQUIRE(cache.Store(0x1, payload.data(), payload.size() * sizeof(uint32_t)));
+
+        DiskCacheEntry entry;
+        REQUIRE(cache.Find(0x1, entry));
+        REQUIRE(entry.GetSize() == payload.size() * sizeof(uint32_t));
+        REQUIRE(std::memcmp(entry.GetData(), payload.data(), entry.GetSize()) == 0);
+    }
+
+    // Entries persist across installs
+    {
+        DiskCache cache;
+        REQUIRE(cache.Install(path, 1u << 20));
+        REQUIRE(cache.GetCount() == 1);
+
+        DiskCacheEntry entry;
+        REQUIRE(cache.Find(0x1, entry));
+        REQUIRE(std::memcmp(entry.GetData(), payload.data(), entry.GetSize()) == 0);
+    }
+
+    std::filesystem::remove_all(path);
+}
+
+TEST_CASE("Common.DiskCache.Corrupt") {
+    std::filesystem::path path = CreateTestDirectory();
+
+    DiskCache cache;
+    REQUIRE(cache.Install(path, 1u << 20));
+
+    uint64_t payload = 42;
+    REQUIRE(cache.Store(0x2, &payload, sizeof(payload)));
+
+    // Truncate the entry
+    for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(path)) {
+        std::filesystem::resize_file(file.path(), file.file_size() - 1);
+    }
+
+    // Corrupt entries are never returned, and are removed
+    DiskCacheEntry entry;
+    REQUIRE(!cache.Find(0x2, entry));
+    REQUIRE(cache.GetCount() == 0);
+    REQUIRE(std::filesystem::is_empty(path));
+
+    std::filesystem::remove_all(path);
+}
+
+TEST_CASE("Common.DiskCache.Eviction") {
+    std::filesystem::path path = CreateTestDirectory();
+
+    // Room for roughly four entries
+    std::vector<uint8_t> payload(1000);
+    DiskCache cache;
+    REQUIRE(cache.Install(path, 4500));
+
+    // Fill
+    for (uint64_t key = 0; key < 4; key++) {
+        REQUIRE(cache.Store(key, payload.data(), payload.size()));
+
+        // Distinct access times
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Touch the oldest entry
+    {
+        DiskCacheEntry entry;
+        REQUIRE(cache.Find(0, entry));
+    }
+
+    // Exceed the budget
+    REQUIRE(cache.Store(4, payload.data(), payload.size()));
+    REQUIRE(cache.GetSize() <= 4500);
+
+    // Least recently used evicted first
+    DiskCacheEntry entry;
+    REQUIRE(!cache.Find(1, entry));
+    REQUIRE(cache.Find(0, entry));
+    REQUIRE(cache.Find(4, entry));
+
+    // Payloads larger than the budget are rejected
+    std::vector<uint8_t> large(8000);
+    REQUIRE(!cache.Store(5, large.data(), large.size()));
+
+    std::filesystem::remove_all(path);
+}
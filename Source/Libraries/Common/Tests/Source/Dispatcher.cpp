@@ -0,0 +1,175 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Dispatcher/Dispatcher.h>
+#include <Common/Dispatcher/DispatcherBucket.h>
+#include <Common/Dispatcher/Event.h>
+
+// Std
+#include <atomic>
+
+/// Simple counting job
+struct CounterJob {
+    void Run(void*) {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::atomic<uint64_t> counter{0};
+};
+
+/// Completion helper
+struct CompletionJob {
+    void OnCompleted(void*) {
+        event.Signal();
+    }
+
+    Event event;
+};
+
+/// Submit a number of jobs and wait for their completion
+static void SubmitAndWait(Dispatcher& dispatcher, uint32_t jobCount) {
+    CounterJob counter;
+    CompletionJob completion;
+
+    // Completion bucket, held by the submitter until all jobs are in flight
+    DispatcherBucket bucket;
+    bucket.completionFunctor = BindDelegate(&completion, CompletionJob::OnCompleted);
+    bucket.Increment();
+
+    // Submit all jobs
+    for (uint32_t i = 0; i < jobCount; i++) {
+        dispatcher.Add(DispatcherJob {
+            .delegate = BindDelegate(&counter, CounterJob::Run),
+            .bucket = &bucket
+        });
+    }
+
+    // Release the submitter reference and wait
+    bucket.Decrement();
+    completion.event.Wait();
+
+    // Validate
+    REQUIRE(counter.counter.load() == jobCount);
+}
+
+TEST_CASE("Common.Dispatcher.Completion") {
+    Dispatcher dispatcher(4);
+
+    // All jobs must have executed before the bucket signals
+    for (uint32_t i = 0; i < 16; i++) {
+        SubmitAndWait(dispatcher, 10'000);
+    }
+}
+
+/// Recursive fan out job, each invocation submits two children from the worker
+struct FanOutJob {
+    void Run(void* data) {
+        auto depth = static_cast<uint32_t>(reinterpret_cast<size_t>(data));
+        counter.fetch_add(1, std::memory_order_relaxed);
+
+        // Leaf?
+        if (!depth) {
+            return;
+        }
+
+        // Submit children, pushed to the local deque
+        for (uint32_t i = 0; i < 2; i++) {
+            dispatcher->Add(BindDelegate(this, FanOutJob::Run), reinterpret_cast<void*>(static_cast<size_t>(depth - 1)), bucket);
+        }
+    }
+
+    Dispatcher* dispatcher{nullptr};
+    DispatcherBucket* bucket{nullptr};
+    std::atomic<uint64_t> counter{0};
+};
+
+TEST_CASE("Common.Dispatcher.FanOut") {
+    Dispatcher dispatcher(4);
+
+    CompletionJob completion;
+
+    DispatcherBucket bucket;
+    bucket.completionFunctor = BindDelegate(&completion, CompletionJob::OnCompleted);
+
+    FanOutJob job;
+    job.dispatcher = &dispatcher;
+    job.bucket = &bucket;
+
+    // Full binary tree of depth 14, submitted entirely from the workers
+    dispatcher.Add(BindDelegate(&job, FanOutJob::Run), reinterpret_cast<void*>(static_cast<size_t>(14)), &bucket);
+    completion.event.Wait();
+
+    REQUIRE(job.counter.load() == (1u << 15) - 1);
+}
+
+/// Records the execution order of prioritized jobs
+struct PriorityJob {
+    void Gate(void*) {
+        gateEvent.Wait();
+    }
+
+    void Run(void* data) {
+        order[orderCount++] = static_cast<DispatcherJobPriority>(reinterpret_cast<size_t>(data));
+    }
+
+    Event gateEvent;
+    DispatcherJobPriority order[8];
+    std::atomic<uint32_t> orderCount{0};
+};
+
+TEST_CASE("Common.Dispatcher.Priority") {
+    Dispatcher dispatcher(1);
+
+    CompletionJob completion;
+
+    DispatcherBucket bucket;
+    bucket.completionFunctor = BindDelegate(&completion, CompletionJob::OnCompleted);
+
+    // Occupy the only worker until everything is enqueued
+    PriorityJob job;
+    dispatcher.Add(BindDelegate(&job, PriorityJob::Gate), nullptr, &bucket);
+
+    // Submit background work before the blocking work
+    for (DispatcherJobPriority priority : {DispatcherJobPriority::Background, DispatcherJobPriority::Blocking}) {
+        for (uint32_t i = 0; i < 4; i++) {
+            dispatcher.Add(BindDelegate(&job, PriorityJob::Run), reinterpret_cast<void*>(static_cast<size_t>(priority)), &bucket, priority);
+        }
+    }
+
+    // Release and wait
+    job.gateEvent.Signal();
+    completion.event.Wait();
+
+    // Blocking work must have run first
+    REQUIRE(job.orderCount.load() == 8);
+    for (uint32_t i = 0; i < 4; i++) {
+        REQUIRE(job.order[i] == DispatcherJobPriority::Blocking);
+        REQUIRE(job.order[4 + i] == DispatcherJobPriority::Background);
+    }
+}
@@ -0,0 +1,76 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Dispatcher/ParallelFor.h>
+
+// Std
+#include <atomic>
+#include <vector>
+
+TEST_CASE("Common.ParallelFor") {
+    Dispatcher dispatcher(4);
+
+    // Every index must be invoked exactly once
+    std::vector<std::atomic<uint32_t>> visits(10'000);
+    ParallelFor(&dispatcher, static_cast<uint32_t>(visits.size()), [&](uint32_t index) {
+        visits[index].fetch_add(1);
+    });
+
+    for (const std::atomic<uint32_t>& visit : visits) {
+        REQUIRE(visit.load() == 1);
+    }
+}
+
+TEST_CASE("Common.ParallelFor.Serial") {
+    uint32_t sum = 0;
+
+    // Without a dispatcher the range runs in order on the caller
+    uint32_t expected = 0;
+    ParallelFor(nullptr, 64, [&](uint32_t index) {
+        REQUIRE(index == expected++);
+        sum += index;
+    });
+
+    REQUIRE(sum == 64 * 63 / 2);
+}
+
+TEST_CASE("Common.ParallelFor.Nested") {
+    // Single worker, nested ranges must not wait on queued helpers
+    Dispatcher dispatcher(1);
+
+    std::atomic<uint32_t> counter{0};
+    ParallelFor(&dispatcher, 8, [&](uint32_t) {
+        ParallelFor(&dispatcher, 8, [&](uint32_t) {
+            counter.fetch_add(1);
+        });
+    });
+
+    REQUIRE(counter.load() == 64);
+}
@@ -0,0 +1,122 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+// Common
+#include <Common/Dispatcher/TaskGroup.h>
+#include <Common/Dispatcher/Event.h>
+
+// Std
+#include <atomic>
+
+/// Records the completion order of all nodes
+struct OrderTracker {
+    void Node(DispatcherBucket* bucket, void* data) {
+        stamps[reinterpret_cast<size_t>(data)] = counter++;
+
+        // Extend the node lifetime with a few bucket jobs
+        for (uint32_t i = 0; i < 8; i++) {
+            dispatcher->Add(BindDelegate(this, OrderTracker::BucketJob), nullptr, bucket);
+        }
+    }
+
+    void BucketJob(void*) {
+        bucketJobs++;
+    }
+
+    void Completed(DispatcherBucket*, void*) {
+        event.Signal();
+    }
+
+    Dispatcher* dispatcher{nullptr};
+    std::atomic<uint32_t> counter{0};
+    std::atomic<uint32_t> bucketJobs{0};
+    uint32_t stamps[16]{};
+    Event event;
+};
+
+TEST_CASE("Common.TaskGroup.Chain") {
+    Dispatcher dispatcher(4);
+
+    OrderTracker tracker;
+    tracker.dispatcher = &dispatcher;
+
+    // Linear chain
+    {
+        TaskGroup group(&dispatcher);
+        for (size_t i = 0; i < 8; i++) {
+            group.Chain(BindDelegate(&tracker, OrderTracker::Node), reinterpret_cast<void*>(i));
+        }
+        group.Chain(BindDelegate(&tracker, OrderTracker::Completed), nullptr);
+        group.Commit();
+    }
+
+    tracker.event.Wait();
+
+    // Links must have run in order
+    for (uint32_t i = 0; i < 8; i++) {
+        REQUIRE(tracker.stamps[i] == i);
+    }
+
+    REQUIRE(tracker.bucketJobs.load() == 64);
+}
+
+TEST_CASE("Common.TaskGraph.Diamond") {
+    Dispatcher dispatcher(4);
+
+    OrderTracker tracker;
+    tracker.dispatcher = &dispatcher;
+
+    // Fan out from a single root, fan in to a single sink
+    {
+        TaskGraph graph(&dispatcher);
+
+        TaskGraphNode* root = graph.Add(BindDelegate(&tracker, OrderTracker::Node), reinterpret_cast<void*>(0));
+        TaskGraphNode* sink = graph.Add(BindDelegate(&tracker, OrderTracker::Node), reinterpret_cast<void*>(9));
+
+        for (size_t i = 1; i <= 8; i++) {
+            TaskGraphNode* node = graph.Add(BindDelegate(&tracker, OrderTracker::Node), reinterpret_cast<void*>(i));
+            graph.AddDependency(root, node);
+            graph.AddDependency(node, sink);
+        }
+
+        TaskGraphNode* completed = graph.Add(BindDelegate(&tracker, OrderTracker::Completed), nullptr);
+        graph.AddDependency(sink, completed);
+
+        graph.Commit();
+    }
+
+    tracker.event.Wait();
+
+    // Every intermediate must be between the root and the sink
+    for (uint32_t i = 1; i <= 8; i++) {
+        REQUIRE(tracker.stamps[0] < tracker.stamps[i]);
+        REQUIRE(tracker.stamps[i] < tracker.stamps[9]);
+    }
+
+    REQUIRE(tracker.bucketJobs.load() == 80);
+}
@@ -0,0 +1,287 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#pragma once
+
+// Std
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <algorithm>
+
+/// A single page of message data
+///  ? Messages never straddle pages, every message is contiguous within a page
+struct MessagePage {
+    /// Get the page data
+    uint8_t* GetData() {
+        return reinterpret_cast<uint8_t*>(this + 1);
+    }
+
+    /// Get the page data
+    [[nodiscard]]
+    const uint8_t* GetData() const {
+        return reinterpret_cast<const uint8_t*>(this + 1);
+    }
+
+    /// Get the remaining byte capacity
+    [[nodiscard]]
+    size_t GetRemaining() const {
+        return capacity - size;
+    }
+
+    /// Next page in the owning list
+    MessagePage* next{nullptr};
+
+    /// Byte capacity of the page
+    size_t capacity{0};
+
+    /// Number of written bytes
+    size_t size{0};
+
+    /// Size class of this page, see MessagePagePool
+    uint32_t sizeClass{0};
+};
+
+/// Thread local page pool
+///  ? Pages released on a thread are recycled by that thread, ownership itself is never tied to a thread
+class MessagePagePool {
+public:
+    /// Smallest page size
+    static constexpr size_t kMinPageSize = 256;
+
+    /// Largest pooled page size, larger pages are allocated and freed directly
+    static constexpr size_t kMaxPageSize = 64u * 1024u;
+
+    /// Acquire a page
+    /// \param capacity minimum byte capacity
+    /// \return empty page, capacity may exceed the requested size
+    static MessagePage* Acquire(size_t capacity);
+
+    /// Release a linked list of pages
+    /// \param head first page, all following pages are released
+    static void Release(MessagePage* head);
+};
+
+/// Move only, owning list of pages
+struct MessagePageList {
+    MessagePageList() = default;
+
+    /// Release all pages
+    ~MessagePageList() {
+        MessagePagePool::Release(head);
+    }
+
+    /// Take ownership of all pages
+    MessagePageList(MessagePageList&& other) noexcept : head(other.head), tail(other.tail), byteSize(other.byteSize) {
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.byteSize = 0;
+    }
+
+    /// Take ownership of all pages
+    MessagePageList& operator=(MessagePageList&& other) noexcept {
+        Swap(other);
+        other.Release();
+        return *this;
+    }
+
+    /// No copy
+    MessagePageList(const MessagePageList&) = delete;
+    MessagePageList& operator=(const MessagePageList&) = delete;
+
+    /// Allocate a contiguous range at the end of the list
+    /// \param size byte size of the range
+    /// \return range start
+    uint8_t* Allocate(size_t size) {
+        if (!tail || tail->GetRemaining() < size) {
+            // Grow geometrically up to the largest pooled size
+            size_t capacity = tail ? std::min(tail->capacity * 2u, MessagePagePool::kMaxPageSize) : MessagePagePool::kMinPageSize;
+
+            // Empty pages are replaced, not linked, keeps single allocations contiguous
+            if (!byteSize) {
+                Release();
+            }
+
+            // Link the page
+            Link(MessagePagePool::Acquire(std::max(capacity, size)));
+        }
+
+        // Bump the tail
+        uint8_t* data = tail->GetData() + tail->size;
+        tail->size += size;
+        byteSize += size;
+        return data;
+    }
+
+    /// Move all pages of another list to the end of this list
+    /// \param other list to splice, empty after the call
+    void Splice(MessagePageList& other) {
+        // Nothing to splice?
+        if (!other.byteSize) {
+            return;
+        }
+
+        // If empty, just swap, the other list recycles the pages
+        if (!byteSize) {
+            Swap(other);
+            return;
+        }
+
+        // Link
+        tail->next = other.head;
+        tail = other.tail;
+        byteSize += other.byteSize;
+
+        // Other list no longer owns the pages
+        other.head = nullptr;
+        other.tail = nullptr;
+        other.byteSize = 0;
+    }
+
+    /// Swap all pages with another list
+    void Swap(MessagePageList& other) {
+        std::swap(head, other.head);
+        std::swap(tail, other.tail);
+        std::swap(byteSize, other.byteSize);
+    }
+
+    /// Clear the list, the first page is kept for reuse
+    void Clear() {
+        if (!head) {
+            return;
+        }
+
+        // Release all but the first page
+        MessagePagePool::Release(head->next);
+        head->next = nullptr;
+        head->size = 0;
+
+        // Single page
+        tail = head;
+        byteSize = 0;
+    }
+
+    /// Release all pages
+    void Release() {
+        MessagePagePool::Release(head);
+        head = nullptr;
+        tail = nullptr;
+        byteSize = 0;
+    }
+
+    /// Coalesce all pages into a single page
+    /// \param capacity minimum byte capacity of the single page
+    /// \return data start
+    uint8_t* Linearize(size_t capacity = 0) {
+        capacity = std::max(capacity, byteSize);
+
+        // Already linear?
+        if (head == tail && head && head->capacity >= capacity) {
+            return head->GetData();
+        }
+
+        // Nothing to coalesce and nothing to reserve?
+        if (!capacity) {
+            return head ? head->GetData() : nullptr;
+        }
+
+        // Copy all pages into a single page
+        MessagePage* page = MessagePagePool::Acquire(capacity);
+        for (MessagePage* it = head; it; it = it->next) {
+            std::memcpy(page->GetData() + page->size, it->GetData(), it->size);
+            page->size += it->size;
+        }
+
+        // Replace all pages
+        MessagePagePool::Release(head);
+        head = page;
+        tail = page;
+        return page->GetData();
+    }
+
+    /// Resize a linear list, see Linearize
+    /// \param size new byte size
+    /// \return data start
+    uint8_t* Resize(size_t size) {
+        uint8_t* data = Linearize(size);
+
+        // Update the size
+        if (head) {
+            head->size = size;
+        }
+
+        byteSize = size;
+        return data;
+    }
+
+    /// Erase a byte range of a linear list
+    /// \param begin byte begin
+    /// \param end byte end
+    void Erase(size_t begin, size_t end) {
+        uint8_t* data = Linearize();
+        std::memmove(data + begin, data + end, byteSize - end);
+        head->size -= end - begin;
+        byteSize -= end - begin;
+    }
+
+    /// Check if all data is contiguous
+    [[nodiscard]]
+    bool IsContiguous() const {
+        return head == tail;
+    }
+
+    /// Get the first page
+    [[nodiscard]]
+    const MessagePage* GetHead() const {
+        return head;
+    }
+
+    /// Get the total byte size of all pages
+    [[nodiscard]]
+    size_t GetByteSize() const {
+        return byteSize;
+    }
+
+private:
+    /// Link a page at the end
+    void Link(MessagePage* page) {
+        if (tail) {
+            tail->next = page;
+        } else {
+            head = page;
+        }
+
+        tail = page;
+    }
+
+private:
+    /// Linked pages
+    MessagePage* head{nullptr};
+    MessagePage* tail{nullptr};
+
+    /// Total byte size
+    size_t byteSize{0};
+};
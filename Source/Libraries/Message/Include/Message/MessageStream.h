@@ -34,6 +34,7 @@
 
 // Message
 #include "Message.h"
+#include "MessagePage.h"
 
 /// Stream allocation type
 template<typename T, typename SCHEMA>
@@ -58,12 +59,81 @@ struct MessageHeaderTraits<void> {
     static constexpr size_t kSize = 0;
 };
 
+/// Page cursor of a stream
+///  ? Messages never straddle pages, so iterators only need to advance pages on exhaustion
+struct MessageStreamCursor {
+    /// Begin iteration of a stream
+    template<typename STREAM>
+    void Begin(const STREAM& stream) {
+        if constexpr (requires { stream.GetFirstPage(); }) {
+            page = stream.GetFirstPage();
+            ptr = page ? page->GetData() : nullptr;
+            end = page ? ptr + page->size : nullptr;
+            NextPage();
+        } else {
+            ptr = stream.GetDataBegin();
+            end = stream.GetDataEnd();
+        }
+    }
+
+    /// Move to the next non-empty page if the current one is exhausted
+    void NextPage() {
+        while (ptr >= end && page && page->next) {
+            page = page->next;
+            ptr = page->GetData();
+            end = ptr + page->size;
+        }
+    }
+
+    const uint8_t* ptr{nullptr};
+    const uint8_t* end{nullptr};
+
+    /// Current page, null if the stream is contiguous
+    const MessagePage* page{nullptr};
+};
+
 /// Base message stream, typeless
+///  ? Data is stored in pages, appending and swapping streams never copies messages
 struct MessageStream {
     MessageStream(MessageSchema schema = {}) : schema(schema) {
 
     }
 
+    /// Copy a stream, the copy is linear
+    MessageStream(const MessageStream& other) : schema(other.schema), count(other.count), versionID(other.versionID) {
+        CopyPages(other);
+    }
+
+    /// Take ownership of another stream
+    MessageStream(MessageStream&& other) noexcept : schema(other.schema), count(other.count), versionID(other.versionID), pages(std::move(other.pages)) {
+        other.count = 0;
+    }
+
+    /// Copy a stream, the copy is linear
+    MessageStream& operator=(const MessageStream& other) {
+        if (this != &other) {
+            schema = other.schema;
+            count = other.count;
+            versionID = other.versionID;
+
+            // Copy all data
+            pages.Clear();
+            CopyPages(other);
+        }
+
+        return *this;
+    }
+
+    /// Take ownership of another stream
+    MessageStream& operator=(MessageStream&& other) noexcept {
+        schema = other.schema;
+        count = other.count;
+        versionID = other.versionID;
+        pages = std::move(other.pages);
+        other.count = 0;
+        return *this;
+    }
+
     /// Set the new schema
     /// \param value
     void SetSchema(const MessageSchema& value) {
@@ -103,17 +173,22 @@ struct MessageStream {
     /// \param dataSize byte siz eof data
     /// \param messageCount the number of messages within this stream
     void SetData(const void* data, uint64_t dataSize, uint64_t messageCount) {
-        buffer.resize(dataSize);
-        std::memcpy(buffer.data(), data, dataSize);
+        pages.Clear();
+        std::memcpy(pages.Resize(dataSize), data, dataSize);
         count = messageCount;
     }
 
-    /// Resize this stream
+    /// Resize this stream, the stream is linearized
     /// \param dataSize size of the stream
     /// \return stream start
     uint8_t* ResizeData(uint64_t dataSize) {
-        buffer.resize(dataSize);
-        return buffer.data();
+        return pages.Resize(dataSize);
+    }
+
+    /// Coalesce all pages, required for contiguous access
+    /// \return stream start
+    const uint8_t* Linearize() {
+        return pages.Linearize();
     }
 
     /// Check if this stream hosts a given message
@@ -140,14 +215,13 @@ struct MessageStream {
     MessageStreamAllocation<T, SCHEMA> Allocate(uint64_t size) {
         using Traits = MessageHeaderTraits<typename SCHEMA::Header>;
 
-        // Grow to new size
-        size_t offset = buffer.size();
-        buffer.resize(buffer.size() + size + Traits::kSize);
+        // Allocate within the last page
+        uint8_t* data = pages.Allocate(size + Traits::kSize);
 
         // Set allocation pointers
         MessageStreamAllocation<T, SCHEMA> alloc;
-        alloc.header  = reinterpret_cast<typename Traits::Type*>(&buffer[offset]);
-        alloc.message = reinterpret_cast<T*>(&buffer[offset + Traits::kSize]);
+        alloc.header  = reinterpret_cast<typename Traits::Type*>(data);
+        alloc.message = reinterpret_cast<T*>(data + Traits::kSize);
 
         count++;
         return alloc;
@@ -156,13 +230,13 @@ struct MessageStream {
     /// Get the byte size of this stream
     [[nodiscard]]
     size_t GetByteSize() const {
-        return buffer.size();
+        return pages.GetByteSize();
     }
 
     /// Clear this stream, does not change the schema
     void Clear() {
         count = 0;
-        buffer.clear();
+        pages.Clear();
     }
 
     /// Clear this stream, does not change the schema
@@ -170,7 +244,7 @@ struct MessageStream {
         count = 0;
         schema = {};
         versionID = 0;
-        buffer.clear();
+        pages.Clear();
     }
 
     /// Swap this stream with another, schema must match
@@ -180,10 +254,10 @@ struct MessageStream {
 
         std::swap(count, other.count);
         std::swap(versionID, other.versionID);
-        buffer.swap(other.buffer);
+        pages.Swap(other.pages);
     }
 
-    /// Append another container
+    /// Append another container, copies all data
     template<typename T>
     void Append(const T& other) {
         // Skip empty
@@ -194,34 +268,68 @@ struct MessageStream {
         // Attempt to inherit the schema
         ValidateOrSetSchema(other.GetSchema());
 
-        // Destination offset
-        const size_t offset = buffer.size();
-
-        // Copy all data
-        buffer.resize(offset + other.GetByteSize());
-        std::memcpy(buffer.data() + offset, other.GetDataBegin(), other.GetByteSize());
+        // Copy all data, page wise if paged
+        if constexpr (requires { other.GetFirstPage(); }) {
+            for (const MessagePage* page = other.GetFirstPage(); page; page = page->next) {
+                std::memcpy(pages.Allocate(page->size), page->GetData(), page->size);
+            }
+        } else {
+            std::memcpy(pages.Allocate(other.GetByteSize()), other.GetDataBegin(), other.GetByteSize());
+        }
 
         // Add countsf
         count += other.GetCount();
     }
 
-    /// Erase a message byte range
+    /// Append another stream, takes ownership of all pages without copying
+    /// \param other stream to append, empty after the call
+    void Append(MessageStream&& other) {
+        // Skip empty
+        if (other.IsEmpty()) {
+            return;
+        }
+
+        // Attempt to inherit the schema
+        ValidateOrSetSchema(other.GetSchema());
+
+        // Link all pages
+        pages.Splice(other.pages);
+
+        // Transfer counts
+        count += other.count;
+        other.count = 0;
+    }
+
+    /// Erase a message byte range, the stream is linearized
     /// \param begin byte begin
     /// \param end byte end
     void Erase(size_t begin, size_t end) {
-        buffer.erase(buffer.begin() + begin, buffer.begin() + end);
+        pages.Erase(begin, end);
     }
 
-    /// Get the data begin pointer
+    /// Get the data begin pointer, stream must be contiguous
     [[nodiscard]]
     const uint8_t* GetDataBegin() const {
-        return buffer.data();
+        ASSERT(pages.IsContiguous(), "Contiguous access on paged stream, see Linearize");
+        return pages.GetHead() ? pages.GetHead()->GetData() : nullptr;
     }
 
-    /// Get the data end pointer
+    /// Get the data end pointer, stream must be contiguous
     [[nodiscard]]
     const uint8_t* GetDataEnd() const {
-        return buffer.data() + buffer.size();
+        return GetDataBegin() + GetByteSize();
+    }
+
+    /// Get the first data page
+    [[nodiscard]]
+    const MessagePage* GetFirstPage() const {
+        return pages.GetHead();
+    }
+
+    /// Check if all data is contiguous
+    [[nodiscard]]
+    bool IsContiguous() const {
+        return pages.IsContiguous();
     }
 
     /// Get the current schema
@@ -245,7 +353,17 @@ struct MessageStream {
     /// Check if this stream is empty
     [[nodiscard]]
     bool IsEmpty() const {
-        return buffer.empty();
+        return pages.GetByteSize() == 0;
+    }
+
+private:
+    /// Copy all pages of a stream into a single page
+    void CopyPages(const MessageStream& other) {
+        uint8_t* data = pages.Resize(other.GetByteSize());
+        for (const MessagePage* page = other.GetFirstPage(); page; page = page->next) {
+            std::memcpy(data, page->GetData(), page->size);
+            data += page->size;
+        }
     }
 
 private:
@@ -258,8 +376,8 @@ private:
     /// Version of this stream
     uint32_t versionID{0};
 
-    /// The underlying memory
-    std::vector<uint8_t> buffer;
+    /// The underlying pages
+    MessagePageList pages;
 };
 
 /// Schema representation
@@ -275,7 +393,7 @@ struct MessageStreamSchema<StaticMessageSchema, STREAM> {
 
     /// Static iterator
     template<typename T>
-    struct ConstIterator {
+    struct ConstIterator : MessageStreamCursor {
         /// Get the message
         const T* Get() const {
             return reinterpret_cast<const T*>(ptr);
@@ -296,6 +414,7 @@ struct MessageStreamSchema<StaticMessageSchema, STREAM> {
         /// Pre increment
         ConstIterator& operator++() {
             ptr = ptr + sizeof(T);
+            NextPage();
             return *this;
         }
 
@@ -303,9 +422,6 @@ struct MessageStreamSchema<StaticMessageSchema, STREAM> {
         operator bool() const {
             return ptr < end;
         }
-
-        const uint8_t* ptr;
-        const uint8_t* end;
     };
 
     /// Add a new message
@@ -319,8 +435,7 @@ struct MessageStreamSchema<StaticMessageSchema, STREAM> {
     template<typename T>
     ConstIterator<T> GetIterator() const {
         ConstIterator<T> iterator;
-        iterator.ptr = stream.GetDataBegin();
-        iterator.end = stream.GetDataEnd();
+        iterator.Begin(stream);
         return iterator;
     }
 
@@ -343,7 +458,7 @@ struct MessageStreamSchema<ChunkedMessageSchema, STREAM> {
 
     /// Static iterator
     template<typename T>
-    struct ConstIterator {
+    struct ConstIterator : MessageStreamCursor {
         /// Get the message
         const T* Get() const {
             return reinterpret_cast<const T*>(ptr);
@@ -364,6 +479,7 @@ struct MessageStreamSchema<ChunkedMessageSchema, STREAM> {
         /// Pre increment
         ConstIterator& operator++() {
             ptr = ptr + T::MessageSize(Get());
+            NextPage();
             return *this;
         }
 
@@ -371,9 +487,6 @@ struct MessageStreamSchema<ChunkedMessageSchema, STREAM> {
         operator bool() const {
             return ptr < end;
         }
-
-        const uint8_t* ptr;
-        const uint8_t* end;
     };
 
     /// Add a new message
@@ -387,8 +500,7 @@ struct MessageStreamSchema<ChunkedMessageSchema, STREAM> {
     template<typename T>
     ConstIterator<T> GetIterator() const {
         ConstIterator<T> iterator;
-        iterator.ptr = stream.GetDataBegin();
-        iterator.end = stream.GetDataEnd();
+        iterator.Begin(stream);
         return iterator;
     }
 
@@ -411,7 +523,7 @@ struct MessageStreamSchema<DynamicMessageSchema, STREAM> {
 
     /// Dynamic iterator
     template<typename T>
-    struct ConstIterator {
+    struct ConstIterator : MessageStreamCursor {
         /// Get the message
         const T* Get() const {
             return reinterpret_cast<const T*>(ptr + sizeof(DynamicMessageSchema::Header));
@@ -432,6 +544,7 @@ struct MessageStreamSchema<DynamicMessageSchema, STREAM> {
         /// Pre increment
         ConstIterator& operator++() {
             ptr += sizeof(DynamicMessageSchema::Header) + reinterpret_cast<const DynamicMessageSchema::Header*>(ptr)->byteSize;
+            NextPage();
             return *this;
         }
 
@@ -439,9 +552,6 @@ struct MessageStreamSchema<DynamicMessageSchema, STREAM> {
         operator bool() const {
             return ptr < end;
         }
-
-        const uint8_t* ptr;
-        const uint8_t* end;
     };
 
     /// Add a new message
@@ -465,8 +575,7 @@ struct MessageStreamSchema<DynamicMessageSchema, STREAM> {
     template<typename T>
     ConstIterator<T> GetIterator() const {
         ConstIterator<T> iterator;
-        iterator.ptr = stream.GetDataBegin();
-        iterator.end = stream.GetDataEnd();
+        iterator.Begin(stream);
         return iterator;
     }
 
@@ -488,7 +597,7 @@ struct MessageStreamSchema<OrderedMessageSchema, STREAM> {
     }
 
     /// Ordered iterator
-    struct ConstIterator {
+    struct ConstIterator : MessageStreamCursor {
         /// Get the id of the current message
         [[nodiscard]]
         MessageID GetID() const {
@@ -529,6 +638,7 @@ struct MessageStreamSchema<OrderedMessageSchema, STREAM> {
         /// Pre increment
         ConstIterator& operator++() {
             ptr += sizeof(OrderedMessageSchema::Header) + reinterpret_cast<const OrderedMessageSchema::Header*>(ptr)->byteSize;
+            NextPage();
             return *this;
         }
 
@@ -536,9 +646,6 @@ struct MessageStreamSchema<OrderedMessageSchema, STREAM> {
         operator bool() const {
             return ptr < end;
         }
-
-        const uint8_t* ptr;
-        const uint8_t* end;
     };
 
     /// Add a new message
@@ -563,8 +670,7 @@ struct MessageStreamSchema<OrderedMessageSchema, STREAM> {
     [[nodiscard]]
     ConstIterator GetIterator() const {
         ConstIterator iterator{};
-        iterator.ptr = stream.GetDataBegin();
-        iterator.end = stream.GetDataEnd();
+        iterator.Begin(stream);
         return iterator;
     }
 
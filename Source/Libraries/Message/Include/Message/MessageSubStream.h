@@ -42,7 +42,13 @@ struct ALIGN_PACK MessageSubStream {
     /// \param stream the stream to be copied
     void Set(const MessageStream& stream) {
         ASSERT(stream.GetByteSize() == data.count, "Message sub-stream has incorrect byte size");
-        std::memcpy(data.Get(), stream.GetDataBegin(), stream.GetByteSize());
+
+        // Copy all pages
+        uint8_t* dest = data.Get();
+        for (const MessagePage* page = stream.GetFirstPage(); page; page = page->next) {
+            std::memcpy(dest, page->GetData(), page->size);
+            dest += page->size;
+        }
 
         // Copy properties
         schema = stream.GetSchema();
@@ -32,15 +32,23 @@
 
 // Common
 #include <Common/Dispatcher/Mutex.h>
+#include <Common/Containers/MPSCQueue.h>
+
+// UnorderedDense
+#include <ankerl/unordered_dense.h>
 
 // Std
 #include <vector>
-#include <mutex>
-#include <map>
+#include <atomic>
 
-/// Simple batch ordered message storage
+/// Batch ordered message storage
+///  ? Producers push to per-thread shards without locking, every stream is stamped with a global sequence
+///  ? Streams are consumed in sequence order, any stream added before another (happens-before) is consumed first
 class OrderedMessageStorage final : public IMessageStorage {
 public:
+    /// Release all pending streams
+    ~OrderedMessageStorage();
+
     /// Overrides
     void AddStream(const MessageStream &stream) override;
     void AddStreamAndSwap(MessageStream& stream) override;
@@ -49,19 +57,69 @@ public:
     uint32_t StreamCount() override;
 
 private:
-    Mutex mutex;
+    /// Pushed stream
+    struct StreamNode : MPSCQueueNode {
+        /// Global sequence
+        uint64_t sequence{0};
+
+        /// Owned stream
+        MessageStream stream;
+    };
+
+    /// Get a stream node, recycled if possible
+    ///  ? Assumes the recycling lock is held if any
+    StreamNode* PopFreeNodeNoLock();
+
+    /// Push a stream node to the current thread's shard
+    void Push(StreamNode* node);
+
+    /// Move all shard nodes to the pending list, consumer only
+    /// \return number of streams ready for consumption
+    uint32_t Drain();
+
+private:
+    /// Number of producer shards
+    static constexpr uint32_t kShardCount = 16;
 
-    /// Cache for message types
-    struct MessageBucket {
-        std::vector<MessageStream> freeStreams;
+    /// Single producer shard
+    struct Shard {
+        MPSCQueue queue;
     };
 
-    /// All message buckets
-    std::map<MessageID, MessageBucket> messageBuckets;
+    /// All producer shards
+    Shard shards[kShardCount];
+
+    /// Next sequence to assign
+    alignas(64) std::atomic<uint64_t> pushSequence{0};
+
+private:
+    /// Consumer lock
+    Mutex consumerMutex;
+
+    /// Drained nodes, sorted by sequence, may contain gaps while pushes are in flight
+    std::vector<StreamNode*> pending;
+
+    /// Next sequence to consume
+    uint64_t consumeSequence{0};
+
+private:
+    /// Get the free-list key of a schema
+    static uint64_t GetSchemaKey(const MessageSchema& schema) {
+        return (static_cast<uint64_t>(schema.type) << 32ull) | schema.id;
+    }
+
+    /// Recycling lock
+    Mutex freeMutex;
+
+    /// Number of free streams, checked before acquiring the recycling lock
+    std::atomic<uint32_t> freeCount{0};
+
+    /// Free streams, keyed by schema
+    ankerl::unordered_dense::map<uint64_t, std::vector<MessageStream>> freeStreams;
 
-    /// Free ordered streams, message invariant
-    std::vector<MessageStream> freeOrderedStreams;
+    /// Number of free nodes, checked before acquiring the recycling lock
+    std::atomic<uint32_t> freeNodeCount{0};
 
-    /// Current pushed streams
-    std::vector<MessageStream> storage;
+    /// Free nodes, returned on consumption
+    std::vector<StreamNode*> freeNodes;
 };
@@ -0,0 +1,140 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <Message/MessagePage.h>
+
+// Std
+#include <cstdlib>
+#include <new>
+
+/// Number of pooled size classes, power of two from the min to the max page size
+static constexpr uint32_t kPageSizeClassCount = 9;
+
+/// Size class of pages not pooled
+static constexpr uint32_t kUnpooledSizeClass = kPageSizeClassCount;
+
+/// Maximum number of pooled bytes per size class and thread
+static constexpr size_t kMaxPooledBytesPerClass = 512u * 1024u;
+
+static_assert((MessagePagePool::kMinPageSize << (kPageSizeClassCount - 1)) == MessagePagePool::kMaxPageSize, "Unexpected page size class count");
+
+/// Free pages of a thread
+struct MessagePageFreeList {
+    ~MessagePageFreeList();
+
+    /// Free list per size class
+    MessagePage* heads[kPageSizeClassCount]{};
+
+    /// Number of pages per size class
+    uint32_t counts[kPageSizeClassCount]{};
+};
+
+/// Local free pages
+static thread_local MessagePageFreeList freeList;
+
+/// Set once the local free list has been destroyed, trivially destructible
+static thread_local bool isFreeListDestroyed{false};
+
+/// Get the size class of a capacity
+static uint32_t GetSizeClass(size_t capacity) {
+    uint32_t sizeClass = 0;
+    while ((MessagePagePool::kMinPageSize << sizeClass) < capacity) {
+        sizeClass++;
+    }
+
+    return sizeClass;
+}
+
+/// Free a page immediately
+static void FreePage(MessagePage* page) {
+    page->~MessagePage();
+    std::free(page);
+}
+
+MessagePageFreeList::~MessagePageFreeList() {
+    for (MessagePage*& head : heads) {
+        while (head) {
+            MessagePage* next = head->next;
+            FreePage(head);
+            head = next;
+        }
+    }
+
+    // Any page released past this point is freed directly
+    isFreeListDestroyed = true;
+}
+
+MessagePage* MessagePagePool::Acquire(size_t capacity) {
+    if (capacity <= kMaxPageSize) {
+        uint32_t sizeClass = GetSizeClass(capacity);
+
+        // Pop from the local pool if possible
+        if (!isFreeListDestroyed) {
+            if (MessagePage* page = freeList.heads[sizeClass]) {
+                freeList.heads[sizeClass] = page->next;
+                freeList.counts[sizeClass]--;
+
+                // Reset the page
+                page->next = nullptr;
+                page->size = 0;
+                return page;
+            }
+        }
+
+        // Round up to the size class
+        capacity = kMinPageSize << sizeClass;
+
+        // Allocate a new page
+        auto page = new (std::malloc(sizeof(MessagePage) + capacity)) MessagePage;
+        page->capacity = capacity;
+        page->sizeClass = sizeClass;
+        return page;
+    }
+
+    // Too large to be pooled
+    auto page = new (std::malloc(sizeof(MessagePage) + capacity)) MessagePage;
+    page->capacity = capacity;
+    page->sizeClass = kUnpooledSizeClass;
+    return page;
+}
+
+void MessagePagePool::Release(MessagePage* head) {
+    while (head) {
+        MessagePage* next = head->next;
+
+        // Recycle if pooled and within budget
+        if (head->sizeClass != kUnpooledSizeClass && !isFreeListDestroyed && freeList.counts[head->sizeClass] * head->capacity < kMaxPooledBytesPerClass) {
+            head->next = freeList.heads[head->sizeClass];
+            freeList.heads[head->sizeClass] = head;
+            freeList.counts[head->sizeClass]++;
+        } else {
+            FreePage(head);
+        }
+
+        // Next!
+        head = next;
+    }
+}
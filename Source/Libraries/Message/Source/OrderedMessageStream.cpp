@@ -27,68 +27,166 @@
 #include <Message/OrderedMessageStorage.h>
 #include <Message/MessageStream.h>
 
+// Std
+#include <algorithm>
+
+/// Shard index of the current thread, assigned round robin on first use
+static uint32_t GetThreadShardIndex() {
+    static std::atomic<uint32_t> shardCounter{0};
+    static thread_local uint32_t shardIndex = shardCounter.fetch_add(1, std::memory_order_relaxed);
+    return shardIndex;
+}
+
+OrderedMessageStorage::~OrderedMessageStorage() {
+    // Release drained nodes
+    for (StreamNode* node : pending) {
+        delete node;
+    }
+
+    // Release all undrained nodes
+    for (Shard& shard : shards) {
+        while (MPSCQueueNode* node = shard.queue.Pop()) {
+            delete static_cast<StreamNode*>(node);
+        }
+    }
+
+    // Release all recycled nodes
+    for (StreamNode* node : freeNodes) {
+        delete node;
+    }
+}
+
 void OrderedMessageStorage::AddStream(const MessageStream &stream) {
     // Ignore if empty
     if (stream.IsEmpty()) {
         return;
     }
 
-    // Add to storage, no recycling
-    MutexGuard guard(mutex);
-    storage.push_back(stream);
+    // Get a node
+    StreamNode* node;
+    if (freeNodeCount.load(std::memory_order_relaxed)) {
+        MutexGuard guard(freeMutex);
+        node = PopFreeNodeNoLock();
+    } else {
+        node = new StreamNode;
+    }
+
+    // Copy the stream, no stream recycling
+    node->stream = stream;
+    Push(node);
 }
 
 void OrderedMessageStorage::AddStreamAndSwap(MessageStream &stream) {
-    MessageSchema schema = stream.GetSchema();
-
     // Ignore if empty
     if (stream.IsEmpty()) {
         return;
     }
 
-    MutexGuard guard(mutex);
+    // Nothing to recycle?
+    if (!freeCount.load(std::memory_order_relaxed) && !freeNodeCount.load(std::memory_order_relaxed)) {
+        auto* node = new StreamNode;
+        node->stream = std::move(stream);
+        Push(node);
+        return;
+    }
+
+    MutexGuard guard(freeMutex);
 
-    // Target stream
-    MessageStream target;
+    // Take ownership of all pages
+    StreamNode* node = PopFreeNodeNoLock();
+    node->stream = std::move(stream);
 
-    // Ordered?
-    if (schema == OrderedMessageSchema::GetSchema()) {
-        // Pop one if possible
-        if (!freeOrderedStreams.empty()) {
-            target.Swap(freeOrderedStreams.back());
-            freeOrderedStreams.pop_back();
+    // Recycle a previously freed stream if any
+    if (freeCount.load(std::memory_order_relaxed)) {
+        auto it = freeStreams.find(GetSchemaKey(node->stream.GetSchema()));
+        if (it != freeStreams.end() && !it->second.empty()) {
+            it->second.back().Clear();
+            stream.Swap(it->second.back());
+            it->second.pop_back();
+            freeCount--;
         }
-    } else {
-        MessageBucket& bucket = messageBuckets[schema.id];
+    }
 
-        // Pop one if possible
-        if (!bucket.freeStreams.empty()) {
-            target.Swap(bucket.freeStreams.back());
-            bucket.freeStreams.pop_back();
+    // Publish
+    Push(node);
+}
+
+OrderedMessageStorage::StreamNode* OrderedMessageStorage::PopFreeNodeNoLock() {
+    // None free?
+    if (freeNodes.empty()) {
+        return new StreamNode;
+    }
+
+    // Pop last
+    StreamNode* node = freeNodes.back();
+    freeNodes.pop_back();
+    freeNodeCount--;
+    return node;
+}
+
+void OrderedMessageStorage::Push(StreamNode *node) {
+    // The sequence is assigned before publishing, so consumers can detect in flight pushes
+    node->sequence = pushSequence.fetch_add(1, std::memory_order_relaxed);
+    shards[GetThreadShardIndex() % kShardCount].queue.Push(node);
+}
+
+uint32_t OrderedMessageStorage::Drain() {
+    size_t drainOffset = pending.size();
+
+    // Pop all published nodes, each shard is ordered per producer
+    for (Shard& shard : shards) {
+        while (MPSCQueueNode* node = shard.queue.Pop()) {
+            pending.push_back(static_cast<StreamNode*>(node));
         }
     }
 
-    // Swap with target
-    //  The target stream, possibly recycled, contains the produced messages,
-    //  and the source stream swapped.
-    target.Swap(stream);
+    // Merge into the sequence order
+    if (drainOffset != pending.size()) {
+        std::sort(pending.begin() + drainOffset, pending.end(), [](const StreamNode* a, const StreamNode* b) {
+            return a->sequence < b->sequence;
+        });
+
+        std::inplace_merge(pending.begin(), pending.begin() + drainOffset, pending.end(), [](const StreamNode* a, const StreamNode* b) {
+            return a->sequence < b->sequence;
+        });
+    }
+
+    // Streams are ready up until the first gap, a gap is a push in flight
+    uint32_t readyCount = 0;
+    while (readyCount < pending.size() && pending[readyCount]->sequence == consumeSequence + readyCount) {
+        readyCount++;
+    }
 
-    // Add the target
-    storage.push_back(target);
+    // OK
+    return readyCount;
 }
 
 void OrderedMessageStorage::ConsumeStreams(uint32_t *count, MessageStream *streams) {
-    MutexGuard guard(mutex);
+    MutexGuard guard(consumerMutex);
+
+    // Get all ready streams
+    uint32_t readyCount = Drain();
 
     if (streams) {
+        ASSERT(*count <= readyCount, "Consuming more streams than available");
+
         for (uint32_t i = 0; i < *count; i++) {
             streams[i].ClearWithSchemaInvalidate();
-            streams[i].Swap(storage[i]);
+            streams[i].Swap(pending[i]->stream);
         }
 
-        storage.erase(storage.begin(), storage.begin() + *count);
+        // Recycle all consumed nodes in one go
+        if (*count) {
+            MutexGuard freeGuard(freeMutex);
+            freeNodes.insert(freeNodes.end(), pending.begin(), pending.begin() + *count);
+            freeNodeCount += *count;
+        }
+
+        // Remove consumed nodes, only in flight gaps remain
+        pending.erase(pending.begin(), pending.begin() + *count);
+        consumeSequence += *count;
     } else if (count) {
-        *count = static_cast<uint32_t>(storage.size());
+        *count = readyCount;
     }
 }
 
@@ -100,20 +198,14 @@ void OrderedMessageStorage::Free(const MessageStream &stream) {
         return;
     }
 
-    MutexGuard guard(mutex);
-
-    // Ordered?
-    if (schema == OrderedMessageSchema::GetSchema()) {
-        freeOrderedStreams.push_back(stream);
-        return;
-    }
+    MutexGuard guard(freeMutex);
 
     // Let the bucket acquire it
-    MessageBucket& bucket = messageBuckets[schema.id];
-    bucket.freeStreams.push_back(stream);
+    freeStreams[GetSchemaKey(schema)].push_back(stream);
+    freeCount++;
 }
 
 uint32_t OrderedMessageStorage::StreamCount() {
-    MutexGuard guard(mutex);
-    return static_cast<uint32_t>(storage.size());
+    MutexGuard guard(consumerMutex);
+    return Drain();
 }
@@ -0,0 +1,132 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+#include <Message/IMessageStorage.h>
+#include <Message/MessageStream.h>
+#include <Message/OrderedMessageStorage.h>
+
+// Schema
+#include <Schemas/Schema.h>
+
+// Std
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/// Produce tagged streams from a set of threads while consuming concurrently
+static void ProduceAndConsume(IMessageStorage& storage, uint32_t producerCount, uint32_t streamCount) {
+    std::atomic<uint32_t> completedProducers{0};
+
+    // Start all producers
+    std::vector<std::thread> producers;
+    for (uint32_t producerIndex = 0; producerIndex < producerCount; producerIndex++) {
+        producers.emplace_back([&, producerIndex] {
+            MessageStream stream;
+
+            for (uint32_t i = 0; i < streamCount; i++) {
+                MessageStreamView<FooMessage>(stream).Add()->life = (producerIndex << 24u) | i;
+                storage.AddStreamAndSwap(stream);
+            }
+
+            completedProducers++;
+        });
+    }
+
+    // Last seen index per producer
+    std::vector<int64_t> lastIndices(producerCount, -1);
+
+    // Consume until all producers have completed and the storage is empty
+    std::vector<MessageStream> streams;
+    uint64_t consumed = 0;
+    for (;;) {
+        bool isComplete = completedProducers.load() == producerCount;
+
+        uint32_t count;
+        storage.ConsumeStreams(&count, nullptr);
+
+        // Consume all ready streams
+        if (count) {
+            streams.resize(count);
+            storage.ConsumeStreams(&count, streams.data());
+        }
+
+        // Validate per producer ordering
+        for (uint32_t i = 0; i < count; i++) {
+            for (auto it = MessageStreamView<FooMessage>(streams[i]).GetIterator(); it; ++it) {
+                uint32_t producerIndex = it->life >> 24u;
+                uint32_t index = it->life & 0xFFFFFFu;
+
+                REQUIRE(static_cast<int64_t>(index) == lastIndices[producerIndex] + 1);
+
+                lastIndices[producerIndex] = index;
+                consumed++;
+            }
+        }
+
+        // Done?
+        if (isComplete && !count) {
+            break;
+        }
+    }
+
+    for (std::thread& thread : producers) {
+        thread.join();
+    }
+
+    REQUIRE(consumed == static_cast<uint64_t>(producerCount) * streamCount);
+}
+
+TEST_CASE("Message.Storage.ProducerOrdering") {
+    OrderedMessageStorage storage;
+    ProduceAndConsume(storage, 8, 10'000);
+}
+
+TEST_CASE("Message.Storage.HappensBefore") {
+    OrderedMessageStorage storage;
+
+    // Each thread adds after the previous one completed, possibly on different shards
+    for (uint32_t i = 0; i < 32; i++) {
+        std::thread([&, i] {
+            MessageStream stream;
+            MessageStreamView<FooMessage>(stream).Add()->life = i;
+            storage.AddStreamAndSwap(stream);
+        }).join();
+    }
+
+    uint32_t count;
+    storage.ConsumeStreams(&count, nullptr);
+    REQUIRE(count == 32);
+
+    std::vector<MessageStream> streams(count);
+    storage.ConsumeStreams(&count, streams.data());
+
+    // Must be consumed in order of addition
+    for (uint32_t i = 0; i < count; i++) {
+        REQUIRE(MessageStreamView<FooMessage>(streams[i]).GetIterator()->life == i);
+    }
+}
@@ -0,0 +1,249 @@
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2024 Advanced Micro Devices, Inc.,
+// Fatalist Development AB (Avalanche Studio Group),
+// and Miguel Petersen.
+// 
+// All Rights Reserved.
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy 
+// of this software and associated documentation files (the "Software"), to deal 
+// in the Software without restriction, including without limitation the rights 
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+// of the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+// INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+// PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+// FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+// ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+// 
+
+#include <catch2/catch.hpp>
+
+#include <Message/IMessageStorage.h>
+#include <Message/MessageStream.h>
+#include <Message/OrderedMessageStorage.h>
+
+// Schema
+#include <Schemas/Schema.h>
+
+// Std
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+/// Replica of the previous contiguous stream, grows a single buffer per message and copies on append
+struct ContiguousStream {
+    /// Allocate a new message
+    uint8_t* Allocate(size_t size) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        count++;
+        return buffer.data() + offset;
+    }
+
+    /// Append another stream
+    void Append(const ContiguousStream& other) {
+        const size_t offset = buffer.size();
+        buffer.resize(offset + other.buffer.size());
+        std::memcpy(buffer.data() + offset, other.buffer.data(), other.buffer.size());
+        count += other.count;
+    }
+
+    std::vector<uint8_t> buffer;
+    uint64_t count{0};
+};
+
+TEST_CASE("Message.Stream.Pages") {
+    MessageStream stream;
+
+    // Enough messages to span many pages
+    constexpr uint32_t kCount = 100'000;
+
+    // Static schema
+    MessageStreamView<FooMessage> view(stream);
+    for (uint32_t i = 0; i < kCount; i++) {
+        view.Add()->life = i;
+    }
+
+    REQUIRE(stream.GetCount() == kCount);
+    REQUIRE(stream.GetByteSize() == kCount * sizeof(FooMessage));
+    REQUIRE(!stream.IsContiguous());
+
+    // Iterate across all pages
+    uint32_t index = 0;
+    for (auto it = view.GetIterator(); it; ++it) {
+        REQUIRE(it->life == index++);
+    }
+
+    REQUIRE(index == kCount);
+
+    // Copies are linear
+    MessageStream copy(stream);
+    REQUIRE(copy.IsContiguous());
+    REQUIRE(copy.GetByteSize() == stream.GetByteSize());
+
+    // Validate copy data
+    auto* messages = reinterpret_cast<const FooMessage*>(copy.GetDataBegin());
+    for (uint32_t i = 0; i < kCount; i++) {
+        REQUIRE(messages[i].life == i);
+    }
+}
+
+TEST_CASE("Message.Stream.Splice") {
+    MessageStream streamA;
+    MessageStream streamB;
+
+    // Ordered schema
+    MessageStreamView viewA(streamA);
+    MessageStreamView viewB(streamB);
+
+    // Mix static and dynamic messages in both streams
+    for (uint32_t i = 0; i < 64; i++) {
+        viewA.Add<FooMessage>()->life = i;
+        viewB.Add<InstructionPixelInvocationDebugMessage>(InstructionPixelInvocationDebugMessage::AllocationInfo { .dataCount = i })->guid = i;
+    }
+
+    // Keep the first page of B for validation
+    const MessagePage* pageB = streamB.GetFirstPage();
+
+    // Splice B onto A
+    size_t byteSize = streamA.GetByteSize() + streamB.GetByteSize();
+    streamA.Append(std::move(streamB));
+
+    REQUIRE(streamB.IsEmpty());
+    REQUIRE(streamB.GetCount() == 0);
+    REQUIRE(streamA.GetCount() == 128);
+    REQUIRE(streamA.GetByteSize() == byteSize);
+
+    // Pages must have been linked, not copied
+    bool found = false;
+    for (const MessagePage* page = streamA.GetFirstPage(); page; page = page->next) {
+        found |= page == pageB;
+    }
+
+    REQUIRE(found);
+
+    // Validate ordering
+    uint32_t index = 0;
+    for (auto it = viewA.GetIterator(); it; ++it, ++index) {
+        if (index < 64) {
+            REQUIRE(it.Get<FooMessage>()->life == index);
+        } else {
+            REQUIRE(it.Get<InstructionPixelInvocationDebugMessage>()->guid == index - 64);
+            REQUIRE(it.Get<InstructionPixelInvocationDebugMessage>()->data.count == index - 64);
+        }
+    }
+
+    REQUIRE(index == 128);
+}
+
+TEST_CASE("Message.Stream.Linearize") {
+    MessageStream stream;
+
+    // Dynamic schema, messages larger than the smallest page
+    MessageStreamView<InstructionPixelInvocationDebugMessage> view(stream);
+    for (uint32_t i = 0; i < 32; i++) {
+        auto message = view.Add(InstructionPixelInvocationDebugMessage::AllocationInfo { .dataCount = 256 });
+        message->guid = i;
+        message->data[255] = static_cast<float>(i);
+    }
+
+    REQUIRE(!stream.IsContiguous());
+
+    // Coalesce
+    stream.Linearize();
+    REQUIRE(stream.IsContiguous());
+    REQUIRE(stream.GetDataEnd() - stream.GetDataBegin() == static_cast<ptrdiff_t>(stream.GetByteSize()));
+
+    // Validate
+    uint32_t index = 0;
+    for (auto it = view.GetIterator(); it; ++it, ++index) {
+        REQUIRE(it->guid == index);
+        REQUIRE(it->data[255] == static_cast<float>(index));
+    }
+
+    REQUIRE(index == 32);
+}
+
+TEST_CASE("Message.Stream.Benchmark", "[.benchmark]") {
+    constexpr uint32_t kMessageCount = 1'000'000;
+
+    // Number of producer streams merged into the final stream
+    constexpr uint32_t kProducerCount = 16;
+
+    // Previous contiguous stream
+    double contiguousMS;
+    {
+        auto begin = std::chrono::high_resolution_clock::now();
+
+        // Produce
+        std::vector<ContiguousStream> producers(kProducerCount);
+        for (uint32_t i = 0; i < kMessageCount; i++) {
+            new (producers[i % kProducerCount].Allocate(sizeof(FooMessage))) FooMessage();
+        }
+
+        // Merge
+        ContiguousStream merged;
+        for (ContiguousStream& producer : producers) {
+            merged.Append(producer);
+        }
+
+        // Consume
+        uint64_t sum = 0;
+        for (auto* it = merged.buffer.data(); it < merged.buffer.data() + merged.buffer.size(); it += sizeof(FooMessage)) {
+            sum += reinterpret_cast<const FooMessage*>(it)->life;
+        }
+
+        REQUIRE(sum == 42ull * kMessageCount);
+        contiguousMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    }
+
+    // Paged stream
+    double pagedMS;
+    {
+        auto begin = std::chrono::high_resolution_clock::now();
+
+        // Produce
+        std::vector<MessageStream> producers(kProducerCount);
+        for (uint32_t i = 0; i < kMessageCount; i++) {
+            MessageStreamView<FooMessage>(producers[i % kProducerCount]).Add();
+        }
+
+        // Merge
+        MessageStream merged;
+        for (MessageStream& producer : producers) {
+            merged.Append(std::move(producer));
+        }
+
+        // Pass through storage
+        OrderedMessageStorage storage;
+        storage.AddStreamAndSwap(merged);
+
+        uint32_t consumeCount;
+        storage.ConsumeStreams(&consumeCount, nullptr);
+
+        std::vector<MessageStream> consumeStreams(consumeCount);
+        storage.ConsumeStreams(&consumeCount, consumeStreams.data());
+
+        // Consume
+        uint64_t sum = 0;
+        for (auto it = MessageStreamView<FooMessage>(consumeStreams[0]).GetIterator(); it; ++it) {
+            sum += it->life;
+        }
+
+        REQUIRE(sum == 42ull * kMessageCount);
+        pagedMS = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count();
+    }
+
+    std::cout << "Messages " << kMessageCount
+              << ", contiguous: " << static_cast<uint64_t>(kMessageCount / (contiguousMS / 1e3)) << " messages/s"
+              << ", paged: " << static_cast<uint64_t>(kMessageCount / (pagedMS / 1e3)) << " messages/s"
+              << std::endl;
+}
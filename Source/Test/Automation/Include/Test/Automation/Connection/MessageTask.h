@@ -171,7 +171,7 @@ private:
         }
 
         // Copy all data
-        snapshot.SetData(stream.GetDataBegin(), stream.GetByteSize(), stream.GetCount());
+        snapshot.SetData(stream.Linearize(), stream.GetByteSize(), stream.GetCount());
         return true;
     }
 
@@ -33,8 +33,13 @@ void PoolingListener::Handle(const MessageStream* streams, uint32_t count) {
         // Get stream
         const MessageStream& stream = streams[i];
 
-        // Commit for the entire schema
-        Commit(stream.GetSchema(), stream.GetDataBegin(), stream.GetByteSize(), stream.GetCount());
+        // Commit for the entire schema, requires contiguous data
+        if (stream.IsContiguous()) {
+            Commit(stream.GetSchema(), stream.GetDataBegin(), stream.GetByteSize(), stream.GetCount());
+        } else {
+            MessageStream linear(stream);
+            Commit(linear.GetSchema(), linear.GetDataBegin(), linear.GetByteSize(), linear.GetCount());
+        }
 
         // If ordered, commit for all the individual messages within
         if (stream.GetSchema().type == MessageSchemaType::Ordered) {
@@ -67,6 +67,20 @@ namespace Studio.ViewModels.Workspace.Properties.Config
             }
         }
 
+        /// <summary>
+        /// Enables device side suppression of duplicate messages
+        /// </summary>
+        [PropertyField]
+        public bool FilterDuplicates
+        {
+            get => _filterDuplicates;
+            set
+            {
+                this.RaiseAndSetIfChanged(ref _filterDuplicates, value);
+                this.EnqueueFirstParentBus();
+            }
+        }
+
         /// <summary>
         /// Constructor
         /// </summary>
@@ -82,7 +96,7 @@ namespace Studio.ViewModels.Workspace.Properties.Config
         public void Commit(InstrumentationState state)
         {
             // Reduce stream size if not needed
-            if (!_safeGuard && !_detail)
+            if (!_safeGuard && !_detail && !_filterDuplicates)
             {
                 return;
             }
@@ -91,6 +105,7 @@ namespace Studio.ViewModels.Workspace.Properties.Config
             var request = state.GetOrDefault<SetInstrumentationConfigMessage>();
             request.safeGuard |= _safeGuard ? 1 : 0;
             request.detail |= _detail ? 1 : 0;
+            request.filterDuplicates |= _filterDuplicates ? 1 : 0;
         }
 
         /// <summary>
@@ -102,5 +117,10 @@ namespace Studio.ViewModels.Workspace.Properties.Config
         /// Internal detail state
         /// </summary>
         private bool _detail = false;
+
+        /// <summary>
+        /// Internal duplicate filtering state
+        /// </summary>
+        private bool _filterDuplicates = false;
     }
 }
\ No newline at end of file
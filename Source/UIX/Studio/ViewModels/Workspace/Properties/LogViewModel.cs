@@ -54,6 +54,8 @@ namespace Studio.ViewModels.Workspace.Properties
             // Register to messages
             ConnectionViewModel?.Bridge?.Register(this);
             ConnectionViewModel?.Bridge?.Register(LogMessage.ID, this);
+            ConnectionViewModel?.Bridge?.Register(ExportFilterDiagnosticMessage.ID, this);
+            ConnectionViewModel?.Bridge?.Register(ExportStreamOverflowDiagnosticMessage.ID, this);
 
             // Create all properties
             CreateProperties();
@@ -66,6 +68,8 @@ namespace Studio.ViewModels.Workspace.Properties
         {
             // Remove listeners
             ConnectionViewModel?.Bridge?.Deregister(LogMessage.ID, this);
+            ConnectionViewModel?.Bridge?.Deregister(ExportFilterDiagnosticMessage.ID, this);
+            ConnectionViewModel?.Bridge?.Deregister(ExportStreamOverflowDiagnosticMessage.ID, this);
         }
 
         /// <summary>
@@ -112,6 +116,12 @@ namespace Studio.ViewModels.Workspace.Properties
                     case LogMessage.ID:
                         Handle(new DynamicMessageView<LogMessage>(streams), events);
                         break;
+                    case ExportFilterDiagnosticMessage.ID:
+                        Handle(new StaticMessageView<ExportFilterDiagnosticMessage>(streams), events);
+                        break;
+                    case ExportStreamOverflowDiagnosticMessage.ID:
+                        Handle(new StaticMessageView<ExportStreamOverflowDiagnosticMessage>(streams), events);
+                        break;
                 }  
             }
 
@@ -147,6 +157,44 @@ namespace Studio.ViewModels.Workspace.Properties
             }
         }
 
+        /// <summary>
+        /// Handle all device side export filter reports
+        /// </summary>
+        public void Handle(StaticMessageView<ExportFilterDiagnosticMessage> view, List<LogEvent> events)
+        {
+            // Enumerate all messages
+            foreach (ExportFilterDiagnosticMessage message in view)
+            {
+                // Nothing suppressed?
+                if (message.dropCount == 0)
+                {
+                    continue;
+                }
+
+                events.Add(new LogEvent
+                {
+                    Severity = LogSeverity.Info,
+                    Message = $"{ConnectionViewModel?.Application?.Name} - Suppressed {message.dropCount} duplicate messages on the device, {message.hitCount} first occurrences exported"
+                });
+            }
+        }
+
+        /// <summary>
+        /// Handle all export stream overflow reports
+        /// </summary>
+        public void Handle(StaticMessageView<ExportStreamOverflowDiagnosticMessage> view, List<LogEvent> events)
+        {
+            // Enumerate all messages
+            foreach (ExportStreamOverflowDiagnosticMessage message in view)
+            {
+                events.Add(new LogEvent
+                {
+                    Severity = LogSeverity.Warning,
+                    Message = $"{ConnectionViewModel?.Application?.Name} - Export stream {message.exportID} overflowed, {message.droppedCount} messages dropped and results are truncated, resizing from {message.streamSize} to {message.nextStreamSize} bytes"
+                });
+            }
+        }
+
         /// <summary>
         /// Handle an instrumentation report
         /// </summary>
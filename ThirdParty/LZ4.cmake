@@ -0,0 +1,45 @@
+# 
+# The MIT License (MIT)
+# 
+# Copyright (c) 2024 Advanced Micro Devices, Inc.,
+# Fatalist Development AB (Avalanche Studio Group),
+# and Miguel Petersen.
+# 
+# All Rights Reserved.
+# 
+# Permission is hereby granted, free of charge, to any person obtaining a copy 
+# of this software and associated documentation files (the "Software"), to deal 
+# in the Software without restriction, including without limitation the rights 
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies 
+# of the Software, and to permit persons to whom the Software is furnished to do so, 
+# subject to the following conditions:
+# 
+# The above copyright notice and this permission notice shall be included in all 
+# copies or substantial portions of the Software.
+# 
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, 
+# INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR 
+# PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE 
+# FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, 
+# ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+# 
+
+# LZ4, fast compression library
+ExternalProject_Add(
+    LZ4
+    GIT_REPOSITORY https://github.com/lz4/lz4
+    GIT_TAG v1.9.4
+    SOURCE_DIR ${CMAKE_CURRENT_SOURCE_DIR}/LZ4
+    SOURCE_SUBDIR build/cmake
+    USES_TERMINAL_INSTALL 0
+    UPDATE_DISCONNECTED ${ThirdPartyDisconnected}
+    CMAKE_ARGS
+        -DCMAKE_INSTALL_PREFIX=${CMAKE_BINARY_DIR}/External
+        -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE}
+        -DCMAKE_MAKE_PROGRAM=${CMAKE_MAKE_PROGRAM}
+        -DBUILD_SHARED_LIBS=OFF
+        -DBUILD_STATIC_LIBS=ON
+        -DLZ4_BUILD_CLI=OFF
+        -DLZ4_BUILD_LEGACY_LZ4C=OFF
+        -G ${CMAKE_GENERATOR}
+)